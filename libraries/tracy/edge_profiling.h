@@ -6,8 +6,11 @@
 struct ECFrameStats
 {
 	int draw_runits;
+	int draw_mergedunits;
+	int draw_sortmicros;
 	int draw_planes;
 	int draw_wallparts;
+	int draw_geomcached;
 	int draw_things;
 	int draw_lightiterator;
 	int draw_sectorglowiterator;
@@ -17,7 +20,10 @@ struct ECFrameStats
 	void Clear()
 	{		
 		draw_runits = 0;
+		draw_mergedunits = 0;
+		draw_sortmicros = 0;
 		draw_wallparts = 0;
+		draw_geomcached = 0;
 		draw_planes = 0;
 		draw_things = 0;
 		draw_lightiterator  = 0;
@@ -53,6 +59,72 @@ extern ECFrameStats ecframe_stats;
 	#define EDGE_FrameMarkStart(name) FrameMarkStart(name)
 	#define EDGE_FrameMarkEnd(name) FrameMarkEnd(name)
 
+#elif defined(EDGE_SIM_BENCH)
+
+	// The headless benchmark (edge-sim-bench) keeps its own simple
+	// per-function timings instead of using Tracy.  Only the outermost
+	// call of a recursive function is timed, and zones are assumed to
+	// run on the main thread.
+
+	#include <chrono>
+	#include <stdint.h>
+
+	struct ECBenchZoneInfo
+	{
+		const char *name;
+		int64_t calls;
+		int64_t nanosecs;
+		int depth;
+
+		ECBenchZoneInfo *next;
+
+		ECBenchZoneInfo(const char *_name);
+	};
+
+	// list of every zone entered so far
+	extern ECBenchZoneInfo *ecbench_zones;
+
+	struct ECBenchZone
+	{
+		ECBenchZoneInfo *info;
+		std::chrono::steady_clock::time_point start;
+
+		ECBenchZone(ECBenchZoneInfo *_info) : info(_info)
+		{
+			if (info->depth++ == 0)
+				start = std::chrono::steady_clock::now();
+		}
+
+		~ECBenchZone()
+		{
+			info->calls++;
+
+			if (--info->depth == 0)
+				info->nanosecs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - start).count();
+		}
+	};
+
+	#define EDGE_ZoneNamed(varname, active)
+	#define EDGE_ZoneNamedN(varname, name, active)
+	#define EDGE_ZoneNamedC(varname, color, active)
+	#define EDGE_ZoneNamedNC(varname, name, color, active)
+
+	#define EDGE_ZoneScoped static ECBenchZoneInfo ec_zone_info_(__func__); ECBenchZone ec_zone_(&ec_zone_info_)
+	#define EDGE_ZoneScopedN(name) static ECBenchZoneInfo ec_zone_info_(name); ECBenchZone ec_zone_(&ec_zone_info_)
+	#define EDGE_ZoneScopedC(color) EDGE_ZoneScoped
+	#define EDGE_ZoneScopedNC(name, color) EDGE_ZoneScopedN(name)
+
+	#define EDGE_ZoneText(txt, size)
+	#define EDGE_ZoneName(txt, size)
+
+	#define EDGE_TracyPlot(name, val)
+
+	#define EDGE_FrameMark
+	#define EDGE_FrameMarkNamed(name)
+	#define EDGE_FrameMarkStart(name)
+	#define EDGE_FrameMarkEnd(name)
+
 #else
 
 	#define EDGE_ZoneNamed(varname, active)
@@ -26,7 +26,7 @@
 // EPI
 #include "endianess.h"
 #include "math_crc.h"
-#include "str_lexer.h"
+#include "udmf_parser.h"
 
 #include "miniz.h"
 
@@ -44,15 +44,6 @@ extern void E_ProgressMessage(const char *message);
 namespace ajbsp
 {
 
-enum UDMFTypes
-{
-    kUDMFThing   = 1,
-    kUDMFVertex  = 2,
-    kUDMFSector  = 3,
-    kUDMFSidedef = 4,
-    kUDMFLinedef = 5
-};
-
 WadFile *cur_wad;
 WadFile *xwa_wad;
 
@@ -590,158 +581,88 @@ static inline int VanillaSegAngle(const Seg *seg)
 
 /* ----- UDMF reading routines ------------------------- */
 
-void ParseThingField(Thing *thing, const std::string &key, const std::string &value)
+void ParseUDMF()
 {
-    // Do we need more precision than an int for things? I think this would only be
-    // an issue if/when polyobjects happen, as I think other thing types are ignored - Dasho
-
-    if (key == "x")
-        thing->x = I_ROUND(epi::LexDouble(value));
+    Lump *lump = FindLevelLump("TEXTMAP");
 
-    if (key == "y")
-        thing->y = I_ROUND(epi::LexDouble(value));
+    if (lump == NULL || !lump->Seek(0))
+        I_Error("AJBSP: Error finding TEXTMAP lump.\n");
 
-    if (key == "type")
-        thing->type = epi::LexInteger(value);
-}
+    int length = lump->Length();
 
-void ParseVertexField(Vertex *vertex, const std::string &key, const std::string &value)
-{
-    if (key == "x")
-        vertex->x_ = epi::LexDouble(value);
+    uint8_t *data = new uint8_t[length];
 
-    if (key == "y")
-        vertex->y_ = epi::LexDouble(value);
-}
+    if (!lump->Read(data, length))
+        I_Error("AJBSP: Error reading TEXTMAP lump.\n");
 
-void ParseSidedefField(Sidedef *side, const std::string &key, const std::string &value)
-{
-    if (key == "sector")
-    {
-        int num = epi::LexInteger(value);
+    // parse it in a single pass.  the UDMF spec does not require objects
+    // to be in a dependency order (e.g. sidedefs may occur *after* the
+    // linedefs which refer to them), which is fine since all references
+    // are resolved afterwards from the complete arrays.
 
-        if (num < 0 || num >= level_sectors.size())
-            I_Error("AJBSP: illegal sector number #%d\n", (int)num);
+    epi::UDMFMap map;
 
-        side->sector = level_sectors[num];
-    }
-}
+    epi::ParseUDMF((const char *)data, length, map, "AJBSP: ");
 
-void ParseLinedefField(Linedef *line, const std::string &key, const std::string &value)
-{
-    if (key == "v1")
-        line->start = SafeLookupVertex(epi::LexInteger(value));
+    delete[] data;
 
-    if (key == "v2")
-        line->end = SafeLookupVertex(epi::LexInteger(value));
+    for (const epi::UDMFVertex &V : map.vertices)
+    {
+        Vertex *vertex = NewVertex();
 
-    if (key == "special")
-        line->type = epi::LexInteger(value);
+        vertex->x_ = V.x;
+        vertex->y_ = V.y;
+    }
 
-    if (key == "twosided")
-        line->two_sided = epi::LexBoolean(value);
+    for (size_t i = 0; i < map.sectors.size(); i++)
+        NewSector(); // we only need the sector numbers
 
-    if (key == "sidefront")
+    for (const epi::UDMFThing &T : map.things)
     {
-        int num = epi::LexInteger(value);
+        Thing *thing = NewThing();
 
-        if (num < 0 || num >= (int)level_sidedefs.size())
-            line->right = NULL;
-        else
-            line->right = level_sidedefs[num];
+        // Do we need more precision than an int for things? I think this would only be
+        // an issue if/when polyobjects happen, as I think other thing types are ignored - Dasho
+        thing->x    = I_ROUND(T.x);
+        thing->y    = I_ROUND(T.y);
+        thing->type = HMM_MAX(0, T.type);
     }
 
-    if (key == "sideback")
+    for (const epi::UDMFSidedef &SD : map.sidedefs)
     {
-        int num = epi::LexInteger(value);
+        Sidedef *side = NewSidedef();
 
-        if (num < 0 || num >= (int)level_sidedefs.size())
-            line->left = NULL;
-        else
-            line->left = level_sidedefs[num];
-    }
-}
+        // a missing sector field leaves it NULL
+        if (SD.sector < 0)
+            continue;
 
-void ParseUDMF_Block(epi::Lexer &lex, int cur_type)
-{
-    Vertex  *vertex = NULL;
-    Thing   *thing  = NULL;
-    Sidedef *side   = NULL;
-    Linedef *line   = NULL;
+        if (SD.sector >= (int)level_sectors.size())
+            I_Error("AJBSP: illegal sector number #%d\n", SD.sector);
 
-    switch (cur_type)
-    {
-    case kUDMFVertex:
-        vertex = NewVertex();
-        break;
-    case kUDMFThing:
-        thing = NewThing();
-        break;
-    case kUDMFSector:
-        NewSector(); // We don't use the returned pointer in this function
-        break;
-    case kUDMFSidedef:
-        side = NewSidedef();
-        break;
-    case kUDMFLinedef:
-        line = NewLinedef();
-        break;
-    default:
-        break;
+        side->sector = level_sectors[SD.sector];
     }
 
-    for (;;)
+    for (const epi::UDMFLinedef &L : map.linedefs)
     {
-        if (lex.Match("}"))
-            break;
-
-        std::string key;
-        std::string value;
-
-        epi::TokenKind tok = lex.Next(key);
-
-        if (tok == epi::kTokenEOF)
-            I_Error("AJBSP: Malformed TEXTMAP lump: unclosed block\n");
-
-        if (tok != epi::kTokenIdentifier)
-            I_Error("AJBSP: Malformed TEXTMAP lump: missing key\n");
+        Linedef *line = NewLinedef();
 
-        if (!lex.Match("="))
-            I_Error("AJBSP: Malformed TEXTMAP lump: missing '='\n");
+        if (L.v1 >= 0)
+            line->start = SafeLookupVertex(L.v1);
 
-        tok = lex.Next(value);
+        if (L.v2 >= 0)
+            line->end = SafeLookupVertex(L.v2);
 
-        if (tok == epi::kTokenEOF || tok == epi::kTokenError || value == "}")
-            I_Error("AJBSP: Malformed TEXTMAP lump: missing value\n");
+        line->type      = L.special;
+        line->two_sided = (L.flags & epi::kUDMFLineTwoSided) ? true : false;
 
-        if (!lex.Match(";"))
-            I_Error("AJBSP: Malformed TEXTMAP lump: missing ';'\n");
-
-        switch (cur_type)
-        {
-        case kUDMFVertex:
-            ParseVertexField(vertex, key, value);
-            break;
-        case kUDMFThing:
-            ParseThingField(thing, key, value);
-            break;
-        case kUDMFSidedef:
-            ParseSidedefField(side, key, value);
-            break;
-        case kUDMFLinedef:
-            ParseLinedefField(line, key, value);
-            break;
+        if (L.sidefront >= 0 && L.sidefront < (int)level_sidedefs.size())
+            line->right = level_sidedefs[L.sidefront];
 
-        case kUDMFSector:
-        default: /* just skip it */
-            break;
-        }
-    }
+        if (L.sideback >= 0 && L.sideback < (int)level_sidedefs.size())
+            line->left = level_sidedefs[L.sideback];
 
-    // validate stuff
+        // validate stuff
 
-    if (line != NULL)
-    {
         if (line->start == NULL || line->end == NULL)
             I_Error("AJBSP: Linedef #%d is missing a vertex!\n", line->index);
 
@@ -753,96 +674,6 @@ void ParseUDMF_Block(epi::Lexer &lex, int cur_type)
         if (line->self_referencing)
             line->is_precious = true;
     }
-}
-
-void ParseUDMF_Pass(const std::string &data, int pass)
-{
-    // pass = 1 : vertices, sectors, things
-    // pass = 2 : sidedefs
-    // pass = 3 : linedefs
-
-    epi::Lexer lex(data);
-
-    for (;;)
-    {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
-
-        if (tok == epi::kTokenEOF)
-            return;
-
-        if (tok != epi::kTokenIdentifier)
-        {
-            I_Error("AJBSP: Malformed TEXTMAP lump.\n");
-            return;
-        }
-
-        // ignore top-level assignments
-        if (lex.Match("="))
-        {
-            lex.Next(section);
-            if (!lex.Match(";"))
-                I_Error("AJBSP: Malformed TEXTMAP lump: missing ';'\n");
-            continue;
-        }
-
-        if (!lex.Match("{"))
-            I_Error("AJBSP: Malformed TEXTMAP lump: missing '{'\n");
-
-        int cur_type = 0;
-
-        if (section == "thing")
-        {
-            if (pass == 1)
-                cur_type = kUDMFThing;
-        }
-        else if (section == "vertex")
-        {
-            if (pass == 1)
-                cur_type = kUDMFVertex;
-        }
-        else if (section == "sector")
-        {
-            if (pass == 1)
-                cur_type = kUDMFSector;
-        }
-        else if (section == "sidedef")
-        {
-            if (pass == 2)
-                cur_type = kUDMFSidedef;
-        }
-        else if (section == "linedef")
-        {
-            if (pass == 3)
-                cur_type = kUDMFLinedef;
-        }
-
-        // process the block
-        ParseUDMF_Block(lex, cur_type);
-    }
-}
-
-void ParseUDMF()
-{
-    Lump *lump = FindLevelLump("TEXTMAP");
-
-    if (lump == NULL || !lump->Seek(0))
-        I_Error("AJBSP: Error finding TEXTMAP lump.\n");
-
-    // load the lump into this string
-    std::string data(lump->Length(), 0);
-    if (!lump->Read(data.data(), lump->Length()))
-        I_Error("AJBSP: Error reading TEXTMAP lump.\n");
-
-    // now parse it...
-
-    // the UDMF spec does not require objects to be in a dependency order.
-    // for example: sidedefs may occur *after* the linedefs which refer to
-    // them.  hence we perform multiple passes over the TEXTMAP data.
-
-    ParseUDMF_Pass(data, 1);
-    ParseUDMF_Pass(data, 2);
-    ParseUDMF_Pass(data, 3);
 
     num_old_vert = level_vertices.size();
 }
@@ -1917,6 +1748,9 @@ BuildResult SaveXWA(Node *root_node)
     {
         SortSegs();
         SaveXGL3Format(lump, root_node);
+
+        // the engine expects this right after the level's nodes
+        PutXReject(xwa_wad);
     }
 
     xwa_wad->EndWrite();
@@ -556,6 +556,15 @@ void NormaliseBspTree();
 // rounded coordinates degenerate to the same point).
 void RoundOffBspTree();
 
+//------------------------------------------------------------------------
+// REJECT : Sector visibility for XWA files
+//------------------------------------------------------------------------
+
+// compute a conservative sector-to-sector visibility table from the
+// subsectors, and add it to the XWA file as an XREJECT lump.  must be
+// called after ClockwiseBspTree() and SortSegs().
+void PutXReject(WadFile *wad);
+
 } // namespace ajbsp
 
 #endif /* __AJBSP_LOCAL_H__ */
@@ -0,0 +1,765 @@
+//------------------------------------------------------------------------
+//  REJECT : Conservative sector visibility for XWA files
+//------------------------------------------------------------------------
+//
+//  Copyright (C) 2024 The EDGE Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//------------------------------------------------------------------------
+//
+//  The engine never trusts the REJECT lump of a map (it is often empty
+//  or made by broken tools), so we compute our own table right after
+//  the nodes and store it beside them in the XWA file.
+//
+//  Visibility is found between subsectors, which are convex, by flowing
+//  through chains of portals (segs which have a partner) and narrowing
+//  the set of lines that can pass through the whole chain, like the vis
+//  tool of Quake but in 2D.  Only one-sided linedefs block sight here:
+//  heights are never looked at, so doors, lifts and any other movable
+//  sector are always treated as open.  Every shortcut errs on the side
+//  of "visible", the table is only used to skip work for sectors which
+//  can never see each other.
+//
+//  XREJECT lump format (all values little-endian):
+//
+//     "XRJ1"
+//     int32    number of sectors
+//     int32    number of subsectors
+//     int32[]  sector of each subsector used for the table, -1 if none
+//     bits     sector x sector matrix in the same layout as a REJECT
+//              lump (bit set means "cannot see")
+//
+//------------------------------------------------------------------------
+
+#include <math.h>
+
+#include "bsp_local.h"
+#include "bsp_utility.h"
+#include "bsp_wad.h"
+
+// EPI
+#include "endianess.h"
+
+#define DEBUG_REJECT 0
+
+namespace ajbsp
+{
+
+// points this far (in map units) on the wrong side of a line still
+// count as being on it.
+static constexpr double kVisEpsilon = 0.1;
+
+// beyond these limits no table is written (the engine copes fine
+// without one).
+static constexpr size_t kVisMaxMatrixBytes   = 16 * 1024 * 1024;
+static constexpr size_t kVisMaxMightseeBytes = 64 * 1024 * 1024;
+
+// when a source subsector uses more work than this, or a chain gets
+// deeper than kVisMaxDepth, the much cheaper (but looser) result of
+// the base flood is used for it instead.  Past kVisMaxWork in total
+// every remaining subsector gets the base flood result.
+static constexpr int64_t kVisMaxWork       = 100000000;
+static constexpr int64_t kVisMaxSourceWork = 2000000;
+static constexpr int     kVisMaxDepth      = 512;
+
+static const uint8_t *level_XRJ1_magic = (uint8_t *)"XRJ1";
+
+struct VisWinding
+{
+    double x1, y1;
+    double x2, y2;
+};
+
+struct VisPlane
+{
+    // a point is inside when Distance() >= -kVisEpsilon
+    double a, b, c;
+
+    inline double Distance(double x, double y) const
+    {
+        return a * x + b * y + c;
+    }
+};
+
+struct VisPortal
+{
+    // the seg, and its line with the destination side positive
+    VisWinding w;
+    VisPlane   plane;
+
+    // subsector on the other side
+    int dest;
+};
+
+struct VisCell
+{
+    // the portals leading out of this subsector
+    int first_portal;
+    int num_portals;
+
+    int sector;
+};
+
+static std::vector<VisPortal> vis_portals;
+static std::vector<VisCell>   vis_cells;
+
+// number of uint64_t in a set of sectors
+static int vis_words;
+
+// sectors which might be seen through each portal (the base flood)
+static std::vector<uint64_t> vis_mightsee;
+
+// sectors seen by each sector
+static std::vector<uint64_t> vis_rows;
+
+// state for the subsector being flowed from
+static std::vector<uint64_t> vis_might_stack;
+static std::vector<VisPlane> vis_planes;
+static std::vector<uint8_t>  vis_on_stack;
+
+static uint64_t *vis_cur_row;
+
+static int64_t vis_work;
+static int64_t vis_source_limit;
+static bool    vis_overflow;
+
+static inline void SetVisBit(uint64_t *set, int n)
+{
+    set[n >> 6] |= (uint64_t)1 << (n & 63);
+}
+
+static inline bool TestVisBit(const uint64_t *set, int n)
+{
+    return (set[n >> 6] & ((uint64_t)1 << (n & 63))) != 0;
+}
+
+static void FreeVisData()
+{
+    vis_portals.clear();
+    vis_cells.clear();
+    vis_mightsee.clear();
+    vis_rows.clear();
+    vis_might_stack.clear();
+    vis_planes.clear();
+    vis_on_stack.clear();
+
+    vis_portals.shrink_to_fit();
+    vis_mightsee.shrink_to_fit();
+    vis_rows.shrink_to_fit();
+}
+
+//
+// Clips the winding to the inside of the plane, returns false when
+// nothing is left.
+//
+static bool ClipWinding(VisWinding &w, const VisPlane &p)
+{
+    double d1 = p.Distance(w.x1, w.y1) + kVisEpsilon;
+    double d2 = p.Distance(w.x2, w.y2) + kVisEpsilon;
+
+    if (d1 >= 0 && d2 >= 0)
+        return true;
+
+    if (d1 < 0 && d2 < 0)
+        return false;
+
+    double frac = d1 / (d1 - d2);
+
+    double mx = w.x1 + frac * (w.x2 - w.x1);
+    double my = w.y1 + frac * (w.y2 - w.y1);
+
+    if (d1 < 0)
+    {
+        w.x1 = mx;
+        w.y1 = my;
+    }
+    else
+    {
+        w.x2 = mx;
+        w.y2 = my;
+    }
+
+    return true;
+}
+
+//
+// Makes the plane through (ax,ay) and (bx,by) which has (px,py) on its
+// inside.  Returns false when any of that is degenerate.
+//
+static bool PlaneThroughPoints(double ax, double ay, double bx, double by, double px, double py, VisPlane &out)
+{
+    double dx = bx - ax;
+    double dy = by - ay;
+
+    double len = sqrt(dx * dx + dy * dy);
+
+    if (len < kVisEpsilon)
+        return false;
+
+    out.a = -dy / len;
+    out.b = dx / len;
+    out.c = -(out.a * ax + out.b * ay);
+
+    double d = out.Distance(px, py);
+
+    if (fabs(d) <= kVisEpsilon)
+        return false;
+
+    if (d < 0)
+    {
+        out.a = -out.a;
+        out.b = -out.b;
+        out.c = -out.c;
+    }
+
+    return true;
+}
+
+//
+// Finds the separating planes between A and B, which bound everything
+// a line passing through A and then B can reach beyond B.  Each one
+// goes through an end of A and an end of B, with the rest of A on one
+// side and the rest of B on the other.  Returns the number found (a
+// missing plane simply means less narrowing).
+//
+static int FindSeparators(const VisWinding &A, const VisWinding &B, VisPlane *out)
+{
+    const double ax[2] = {A.x1, A.x2};
+    const double ay[2] = {A.y1, A.y2};
+    const double bx[2] = {B.x1, B.x2};
+    const double by[2] = {B.y1, B.y2};
+
+    int count = 0;
+
+    for (int i = 0; i < 2; i++)
+    {
+        for (int j = 0; j < 2; j++)
+        {
+            VisPlane P;
+
+            if (!PlaneThroughPoints(ax[j], ay[j], bx[i], by[i], bx[1 - i], by[1 - i], P))
+                continue;
+
+            if (P.Distance(ax[1 - j], ay[1 - j]) > -kVisEpsilon)
+                continue;
+
+            out[count++] = P;
+            break;
+        }
+    }
+
+    return count;
+}
+
+static int DetermineCellSector(const Subsector *sub)
+{
+    // same preference as the engine: a real seg which is not on a
+    // self-referencing linedef, otherwise any real seg.
+
+    const Seg *found = NULL;
+
+    for (const Seg *seg = sub->seg_list_; seg; seg = seg->next_)
+    {
+        if (seg->linedef_ == NULL)
+            continue;
+
+        if (!seg->linedef_->self_referencing)
+        {
+            found = seg;
+            break;
+        }
+
+        if (found == NULL)
+            found = seg;
+    }
+
+    if (found == NULL)
+        return -1;
+
+    const Sidedef *side = found->side_ ? found->linedef_->left : found->linedef_->right;
+
+    if (side == NULL || side->sector == NULL)
+        return -1;
+
+    return side->sector->index;
+}
+
+static void CreateVisPortals()
+{
+    std::vector<int> seg_cell(level_segs.size(), -1);
+
+    for (size_t i = 0; i < level_subsecs.size(); i++)
+        for (const Seg *seg = level_subsecs[i]->seg_list_; seg; seg = seg->next_)
+            seg_cell[seg->index_] = (int)i;
+
+    vis_cells.resize(level_subsecs.size());
+
+    for (size_t i = 0; i < level_subsecs.size(); i++)
+    {
+        const Subsector *sub  = level_subsecs[i];
+        VisCell         &cell = vis_cells[i];
+
+        cell.first_portal = (int)vis_portals.size();
+        cell.sector       = DetermineCellSector(sub);
+
+        for (const Seg *seg = sub->seg_list_; seg; seg = seg->next_)
+        {
+            if (seg->partner_ == NULL)
+                continue;
+
+            int dest = seg_cell[seg->partner_->index_];
+
+            if (dest < 0 || dest == (int)i)
+                continue;
+
+            VisPortal P;
+
+            P.w.x1 = seg->start_->x_;
+            P.w.y1 = seg->start_->y_;
+            P.w.x2 = seg->end_->x_;
+            P.w.y2 = seg->end_->y_;
+            P.dest = dest;
+
+            // the subsector is on the right of its segs, so the other
+            // one is on the left.  tiny segs just face away from the
+            // middle of the subsector.
+            double dx  = P.w.x2 - P.w.x1;
+            double dy  = P.w.y2 - P.w.y1;
+            double len = sqrt(dx * dx + dy * dy);
+
+            if (len > 0.001)
+            {
+                P.plane.a = -dy / len;
+                P.plane.b = dx / len;
+            }
+            else
+            {
+                dx  = P.w.x1 - sub->mid_x_;
+                dy  = P.w.y1 - sub->mid_y_;
+                len = sqrt(dx * dx + dy * dy);
+
+                P.plane.a = (len > 0) ? dx / len : 1;
+                P.plane.b = (len > 0) ? dy / len : 0;
+            }
+
+            P.plane.c = -(P.plane.a * P.w.x1 + P.plane.b * P.w.y1);
+
+            if (P.plane.Distance(sub->mid_x_, sub->mid_y_) > kVisEpsilon)
+            {
+                P.plane.a = -P.plane.a;
+                P.plane.b = -P.plane.b;
+                P.plane.c = -P.plane.c;
+            }
+
+            vis_portals.push_back(P);
+        }
+
+        cell.num_portals = (int)vis_portals.size() - cell.first_portal;
+    }
+}
+
+//
+// Can anything which passes through P go on through Q?  The base flood
+// uses this, it is a cheap but loose test: some part of Q must be in
+// front of P, and some part of P must be behind Q.
+//
+static inline bool PortalMightSee(const VisPortal &P, const VisPortal &Q)
+{
+    if (P.plane.Distance(Q.w.x1, Q.w.y1) <= -kVisEpsilon && P.plane.Distance(Q.w.x2, Q.w.y2) <= -kVisEpsilon)
+        return false;
+
+    if (Q.plane.Distance(P.w.x1, P.w.y1) >= kVisEpsilon && Q.plane.Distance(P.w.x2, P.w.y2) >= kVisEpsilon)
+        return false;
+
+    return true;
+}
+
+static bool BaseVisFlood()
+{
+    size_t total = vis_portals.size();
+
+    vis_mightsee.assign(total * vis_words, 0);
+
+    std::vector<int> cell_mark(vis_cells.size(), -1);
+    std::vector<int> stack;
+
+    for (size_t p = 0; p < total; p++)
+    {
+        const VisPortal &P    = vis_portals[p];
+        uint64_t        *bits = &vis_mightsee[p * vis_words];
+
+        cell_mark[P.dest] = (int)p;
+        stack.push_back(P.dest);
+
+        while (!stack.empty())
+        {
+            const VisCell &C = vis_cells[stack.back()];
+            stack.pop_back();
+
+            if (C.sector >= 0)
+                SetVisBit(bits, C.sector);
+
+            for (int k = 0; k < C.num_portals; k++)
+            {
+                const VisPortal &Q = vis_portals[C.first_portal + k];
+
+                vis_work++;
+
+                if (cell_mark[Q.dest] == (int)p)
+                    continue;
+
+                if (!PortalMightSee(P, Q))
+                    continue;
+
+                cell_mark[Q.dest] = (int)p;
+                stack.push_back(Q.dest);
+            }
+        }
+
+        if (vis_work > kVisMaxWork)
+            return false;
+    }
+
+    return true;
+}
+
+//
+// Visits every portal leading out of 'cell', which has been reached
+// via a chain of portals beginning with 'source' and ending with
+// 'pass' (NULL for the first subsector).  'vis_planes' holds the
+// separators of every step so far.
+//
+static void RecursiveFlow(int cell, const VisWinding &source, const VisWinding *pass, int depth)
+{
+    const VisCell &C = vis_cells[cell];
+
+    const uint64_t *might      = &vis_might_stack[depth * vis_words];
+    uint64_t       *next_might = &vis_might_stack[(depth + 1) * vis_words];
+
+    size_t num_planes = vis_planes.size();
+
+    for (int k = 0; k < C.num_portals; k++)
+    {
+        const VisPortal &Q = vis_portals[C.first_portal + k];
+
+        if (vis_on_stack[Q.dest])
+            continue;
+
+        int dest_sector = vis_cells[Q.dest].sector;
+
+        if (dest_sector >= 0 && !TestVisBit(might, dest_sector))
+            continue;
+
+        vis_work++;
+
+        // clip the portal to what the chain can see
+        VisWinding target = Q.w;
+
+        bool visible = true;
+
+        for (size_t n = 0; n < num_planes && visible; n++)
+            visible = ClipWinding(target, vis_planes[n]);
+
+        if (!visible)
+            continue;
+
+        if (dest_sector >= 0)
+            SetVisBit(vis_cur_row, dest_sector);
+
+        // can anything new be found further on?
+        const uint64_t *q_might = &vis_mightsee[(size_t)(C.first_portal + k) * vis_words];
+
+        bool more = false;
+
+        for (int w = 0; w < vis_words; w++)
+        {
+            next_might[w] = might[w] & q_might[w];
+
+            if (next_might[w] & ~vis_cur_row[w])
+                more = true;
+        }
+
+        if (!more)
+            continue;
+
+        if (depth + 1 >= kVisMaxDepth || vis_work > vis_source_limit)
+        {
+            vis_overflow = true;
+            return;
+        }
+
+        // narrow the source down to the part that can see the target
+        // through the pass portal.
+        VisWinding new_source = source;
+
+        if (pass != NULL)
+        {
+            VisPlane back[2];
+            int      num_back = FindSeparators(target, *pass, back);
+
+            for (int n = 0; n < num_back && visible; n++)
+                visible = ClipWinding(new_source, back[n]);
+
+            if (!visible)
+                continue;
+        }
+
+        VisPlane seps[2];
+        int      num_seps = FindSeparators(new_source, target, seps);
+
+        for (int n = 0; n < num_seps; n++)
+            vis_planes.push_back(seps[n]);
+
+        vis_on_stack[Q.dest] = 1;
+
+        RecursiveFlow(Q.dest, new_source, &target, depth + 1);
+
+        vis_on_stack[Q.dest] = 0;
+
+        vis_planes.resize(num_planes);
+
+        if (vis_overflow)
+            return;
+    }
+}
+
+static void CellFlow(int cell)
+{
+    const VisCell &C = vis_cells[cell];
+
+    vis_cur_row = &vis_rows[(size_t)C.sector * vis_words];
+
+    SetVisBit(vis_cur_row, C.sector);
+
+    if (vis_work <= kVisMaxWork)
+    {
+        vis_source_limit = vis_work + kVisMaxSourceWork;
+        vis_overflow     = false;
+
+        vis_on_stack[cell] = 1;
+
+        for (int k = 0; k < C.num_portals && !vis_overflow; k++)
+        {
+            const VisPortal &S = vis_portals[C.first_portal + k];
+
+            int dest_sector = vis_cells[S.dest].sector;
+
+            if (dest_sector >= 0)
+                SetVisBit(vis_cur_row, dest_sector);
+
+            const uint64_t *s_might = &vis_mightsee[(size_t)(C.first_portal + k) * vis_words];
+
+            bool more = false;
+
+            for (int w = 0; w < vis_words; w++)
+            {
+                vis_might_stack[w] = s_might[w];
+
+                if (s_might[w] & ~vis_cur_row[w])
+                    more = true;
+            }
+
+            if (!more)
+                continue;
+
+            // everything seen must be beyond the first portal
+            vis_planes.clear();
+            vis_planes.push_back(S.plane);
+
+            vis_on_stack[S.dest] = 1;
+
+            RecursiveFlow(S.dest, S.w, NULL, 0);
+
+            vis_on_stack[S.dest] = 0;
+        }
+
+        vis_on_stack[cell] = 0;
+
+        if (!vis_overflow)
+            return;
+    }
+
+    // too much work, fall back to the base flood
+    for (int k = 0; k < C.num_portals; k++)
+    {
+        const uint64_t *s_might = &vis_mightsee[(size_t)(C.first_portal + k) * vis_words];
+
+        for (int w = 0; w < vis_words; w++)
+            vis_cur_row[w] |= s_might[w];
+    }
+}
+
+static void WriteXReject(WadFile *wad)
+{
+    int num_sectors = (int)level_sectors.size();
+    int num_subsecs = (int)vis_cells.size();
+
+    Lump *lump = wad->AddLump("XREJECT");
+
+    lump->Write(level_XRJ1_magic, 4);
+
+    int32_t raw = AlignedLittleEndianS32(num_sectors);
+    lump->Write(&raw, 4);
+
+    raw = AlignedLittleEndianS32(num_subsecs);
+    lump->Write(&raw, 4);
+
+    for (int i = 0; i < num_subsecs; i++)
+    {
+        raw = AlignedLittleEndianS32(vis_cells[i].sector);
+        lump->Write(&raw, 4);
+    }
+
+    // rows of a REJECT lump are packed together, not padded to a byte
+    size_t total_bits = (size_t)num_sectors * num_sectors;
+
+    std::vector<uint8_t> matrix((total_bits + 7) / 8, 0);
+
+    for (int a = 0; a < num_sectors; a++)
+    {
+        const uint64_t *row = &vis_rows[(size_t)a * vis_words];
+
+        for (int b = 0; b < num_sectors; b++)
+        {
+            if (TestVisBit(row, b))
+                continue;
+
+            size_t bit = (size_t)a * num_sectors + b;
+
+            matrix[bit >> 3] |= (uint8_t)(1 << (bit & 7));
+        }
+    }
+
+    lump->Write(matrix.data(), (int)matrix.size());
+    lump->Finish();
+}
+
+void PutXReject(WadFile *wad)
+{
+    size_t num_sectors = level_sectors.size();
+
+    if (num_sectors == 0)
+        return;
+
+    vis_words = (int)((num_sectors + 63) / 64);
+
+    if (num_sectors * num_sectors / 8 > kVisMaxMatrixBytes)
+    {
+        I_Debugf("    Too many sectors for XREJECT, skipped\n");
+        return;
+    }
+
+    CreateVisPortals();
+
+    if (vis_portals.size() * vis_words * sizeof(uint64_t) > kVisMaxMightseeBytes)
+    {
+        I_Debugf("    Too many portals for XREJECT, skipped\n");
+        FreeVisData();
+        return;
+    }
+
+    vis_work = 0;
+
+    if (!BaseVisFlood())
+    {
+        I_Debugf("    XREJECT base flood too large, skipped\n");
+        FreeVisData();
+        return;
+    }
+
+    int64_t base_work = vis_work;
+
+    vis_work = 0;
+
+    vis_rows.assign(num_sectors * vis_words, 0);
+    vis_might_stack.assign((size_t)(kVisMaxDepth + 1) * vis_words, 0);
+    vis_on_stack.assign(vis_cells.size(), 0);
+
+    int fallbacks = 0;
+
+    for (size_t i = 0; i < vis_cells.size(); i++)
+    {
+        if (vis_cells[i].sector < 0)
+            continue;
+
+        vis_overflow = false;
+
+        CellFlow((int)i);
+
+        if (vis_overflow || vis_work > kVisMaxWork)
+            fallbacks++;
+    }
+
+    // sight works both ways, so anything only seen one way round was a
+    // loose result.  sectors without any subsector (e.g. 3D floor
+    // control sectors) are made to see everything.
+    std::vector<bool> has_cells(num_sectors, false);
+
+    for (const VisCell &cell : vis_cells)
+        if (cell.sector >= 0)
+            has_cells[cell.sector] = true;
+
+    for (size_t a = 0; a < num_sectors; a++)
+    {
+        uint64_t *row = &vis_rows[a * vis_words];
+
+        if (!has_cells[a])
+        {
+            for (size_t b = 0; b < num_sectors; b++)
+                SetVisBit(row, (int)b);
+
+            continue;
+        }
+
+        for (size_t b = 0; b < a; b++)
+        {
+            uint64_t *other = &vis_rows[b * vis_words];
+
+            if (!has_cells[b])
+                continue;
+
+            if (!TestVisBit(row, (int)b) || !TestVisBit(other, (int)a))
+            {
+                row[b >> 6] &= ~((uint64_t)1 << (b & 63));
+                other[a >> 6] &= ~((uint64_t)1 << (a & 63));
+            }
+        }
+    }
+
+    for (size_t a = 0; a < num_sectors; a++)
+        if (!has_cells[a])
+            for (size_t b = 0; b < num_sectors; b++)
+                SetVisBit(&vis_rows[b * vis_words], (int)a);
+
+#if DEBUG_REJECT
+    size_t hidden = 0;
+
+    for (size_t a = 0; a < num_sectors; a++)
+        for (size_t b = 0; b < num_sectors; b++)
+            if (!TestVisBit(&vis_rows[a * vis_words], (int)b))
+                hidden++;
+
+    I_Debugf("    XREJECT: %zu of %zu sector pairs hidden\n", hidden, num_sectors * num_sectors);
+#endif
+
+    I_Debugf("    Built XREJECT: %d portals, work %lld + %lld, %d fallbacks\n", (int)vis_portals.size(),
+             (long long)base_work, (long long)vis_work, fallbacks);
+
+    WriteXReject(wad);
+
+    FreeVisData();
+}
+
+} // namespace ajbsp
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
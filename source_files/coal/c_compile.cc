@@ -2175,6 +2175,103 @@ void real_vm_c::SetVectorZ(const char *mod_name, const char *var_name, double va
     return;
 }
 
+int real_vm_c::FindVariable(const char *mod_name, const char *var_name, int var_type)
+{
+    scope_c *scope = &comp.global_scope;
+
+    if (mod_name)
+    {
+        def_t *mod_def = FindDef(&type_module, (char *)mod_name, &comp.global_scope);
+        if (!mod_def)
+            return vm_c::NOT_FOUND;
+
+        scope = comp.all_modules[mod_def->ofs];
+    }
+
+    type_t *type;
+
+    switch (var_type)
+    {
+    case VAR_FLOAT:
+        type = &type_float;
+        break;
+    case VAR_STRING:
+        type = &type_string;
+        break;
+    case VAR_VECTOR:
+        type = &type_vector;
+        break;
+    default:
+        return vm_c::NOT_FOUND;
+    }
+
+    // unlike FindDef, a type mismatch here is not a compile error
+    for (def_t *def = scope->names; def; def = def->next)
+    {
+        if (strcmp(def->name, var_name) != 0)
+            continue;
+
+        if (def->type != type || def->ofs <= 0)
+            return vm_c::NOT_FOUND;
+
+        return def->ofs;
+    }
+
+    return vm_c::NOT_FOUND;
+}
+
+double real_vm_c::GetFloat(int var)
+{
+    if (var == vm_c::NOT_FOUND)
+        RunError("GetFloat failed: unresolved variable handle\n");
+
+    return G_FLOAT(var);
+}
+
+const char *real_vm_c::GetString(int var)
+{
+    if (var == vm_c::NOT_FOUND)
+        RunError("GetString failed: unresolved variable handle\n");
+
+    return G_STRING(var);
+}
+
+double *real_vm_c::GetVector(int var)
+{
+    if (var == vm_c::NOT_FOUND)
+        RunError("GetVector failed: unresolved variable handle\n");
+
+    return G_VECTOR(var);
+}
+
+void real_vm_c::SetFloat(int var, double value)
+{
+    if (var == vm_c::NOT_FOUND)
+        return;
+
+    G_FLOAT(var) = value;
+}
+
+void real_vm_c::SetString(int var, const char *value)
+{
+    if (var == vm_c::NOT_FOUND)
+        return;
+
+    *REF_GLOBAL(var) = (double)InternaliseString(value ? value : "");
+}
+
+void real_vm_c::SetVector(int var, double val_1, double val_2, double val_3)
+{
+    if (var == vm_c::NOT_FOUND)
+        return;
+
+    double *vec = G_VECTOR(var);
+
+    vec[0] = val_1;
+    vec[1] = val_2;
+    vec[2] = val_3;
+}
+
 vm_c *CreateVM()
 {
     assert(sizeof(double) == 8);
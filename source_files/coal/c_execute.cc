@@ -123,13 +123,6 @@ int real_vm_c::FindFunction(const char *func_name)
     return vm_c::NOT_FOUND;
 }
 
-int real_vm_c::FindVariable(const char *var_name)
-{
-    // FIXME
-
-    return vm_c::NOT_FOUND;
-}
-
 // returns an offset from the string heap
 int real_vm_c::InternaliseString(const char *new_s)
 {
@@ -634,6 +627,870 @@ void real_vm_c::DoExecute(int fnum)
     }
 }
 
+//================================================================
+//  PRE-DECODED EXECUTION
+//================================================================
+
+static void DecodeOperand(doperand_t *o, int ofs, const bmaster_c &global_mem)
+{
+    if (ofs > 0)
+    {
+        o->global = (double *)global_mem.deref(ofs);
+        o->local  = 0;
+    }
+    else
+    {
+        // OFS_NULL operands are never accessed
+        o->global = NULL;
+        o->local  = (ofs < 0) ? -(ofs + 1) : 0;
+    }
+}
+
+static int FusedCompare(short op)
+{
+    switch (op)
+    {
+    case OP_EQ_F:
+        return DOP_EQ_F_IFNOT;
+    case OP_NE_F:
+        return DOP_NE_F_IFNOT;
+    case OP_LE:
+        return DOP_LE_IFNOT;
+    case OP_GE:
+        return DOP_GE_IFNOT;
+    case OP_LT:
+        return DOP_LT_IFNOT;
+    case OP_GT:
+        return DOP_GT_IFNOT;
+    default:
+        return -1;
+    }
+}
+
+static int FusedArithmetic(short op, short next_op)
+{
+    if (next_op == OP_MOVE_F)
+    {
+        switch (op)
+        {
+        case OP_ADD_F:
+            return DOP_ADD_F_MOVE;
+        case OP_SUB_F:
+            return DOP_SUB_F_MOVE;
+        case OP_MUL_F:
+            return DOP_MUL_F_MOVE;
+        default:
+            break;
+        }
+    }
+    else if (next_op == OP_MOVE_V)
+    {
+        switch (op)
+        {
+        case OP_ADD_V:
+            return DOP_ADD_V_MOVE;
+        case OP_SUB_V:
+            return DOP_SUB_V_MOVE;
+        default:
+            break;
+        }
+    }
+
+    return -1;
+}
+
+// plain mapping, for everything which is not handled specially
+static const short decoded_ops[NUM_OPERATIONS] = {
+    -1,          // OP_NULL
+    DOP_CALL,    DOP_RET,     DOP_PARM_NULL, DOP_PARM_F, DOP_PARM_V, DOP_IF,     DOP_IFNOT,  DOP_GOTO,  DOP_ERROR,
+
+    DOP_MOVE_F,  DOP_MOVE_V,  DOP_MOVE_S,    DOP_MOVE_F, // OP_MOVE_FNC
+
+    DOP_NOT_F,   DOP_NOT_V,   DOP_NOT_F,     DOP_NOT_F, // OP_NOT_S, OP_NOT_FNC
+
+    DOP_INC,     DOP_DEC,
+
+    DOP_POWER_F, DOP_MUL_F,   DOP_MUL_V,     DOP_MUL_FV, DOP_MUL_VF, DOP_DIV_F,  DOP_DIV_V,  DOP_MOD_F,
+
+    DOP_ADD_F,   DOP_ADD_V,   DOP_ADD_S,     DOP_ADD_SF, DOP_ADD_SV, DOP_SUB_F,  DOP_SUB_V,
+
+    DOP_EQ_F,    DOP_EQ_V,    DOP_EQ_S,      DOP_EQ_F, // OP_EQ_FNC
+    DOP_NE_F,    DOP_NE_V,    DOP_NE_S,      DOP_NE_F, // OP_NE_FNC
+
+    DOP_LE,      DOP_GE,      DOP_LT,        DOP_GT,
+
+    DOP_AND,     DOP_OR,      DOP_BITAND,    DOP_BITOR,
+};
+
+//
+// Translates the statements of a function into dstatement_t form.
+// The result is kept with the function, and stays valid for the life
+// of the VM (global memory never moves).
+//
+dstatement_t *real_vm_c::DecodeFunction(function_t *f)
+{
+    assert(f->first_statement > 0);
+
+    const int step  = (int)sizeof(statement_t);
+    int       count = (f->last_statement - f->first_statement) / step + 1;
+
+    // map statement index --> decoded index (OP_NULL is dropped)
+    std::vector<int> index_map(count + 1);
+
+    int total = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        index_map[i] = total;
+
+        if (REF_OP(f->first_statement + i * step)->op != OP_NULL)
+            total++;
+    }
+
+    index_map[count] = total;
+
+    // one extra slot, so that a stray branch past the end just returns
+    dstatement_t *code = new dstatement_t[total + 1];
+    memset(code, 0, sizeof(dstatement_t) * (total + 1));
+
+    for (int i = 0; i < count; i++)
+    {
+        int          ofs = f->first_statement + i * step;
+        statement_t *st  = REF_OP(ofs);
+
+        if (st->op == OP_NULL)
+            continue;
+
+        if (st->op < 0 || st->op >= NUM_OPERATIONS)
+            RunError("Bad opcode %i", st->op);
+
+        dstatement_t *d = &code[index_map[i]];
+
+        d->op  = decoded_ops[st->op];
+        d->src = ofs;
+
+        // the "exotic" ops keep other values in their a / b / c fields
+        if (st->op >= OP_MOVE_F)
+        {
+            DecodeOperand(&d->a, st->a, global_mem);
+            DecodeOperand(&d->b, st->b, global_mem);
+            DecodeOperand(&d->c, st->c, global_mem);
+        }
+        else if (st->op != OP_GOTO && st->op != OP_ERROR)
+        {
+            DecodeOperand(&d->a, st->a, global_mem);
+        }
+
+        switch (st->op)
+        {
+        case OP_CALL:
+            d->argc = st->b;
+            break;
+
+        case OP_PARM_NULL:
+        case OP_PARM_F:
+        case OP_PARM_V:
+            // parameters go just past the caller's locals
+            d->b.global = NULL;
+            d->b.local  = f->locals_end + st->b;
+            break;
+
+        case OP_IF:
+        case OP_IFNOT:
+        case OP_GOTO: {
+            int target = (st->b - f->first_statement) / step;
+
+            if (target < 0 || target > count)
+                RunError("Bad branch target in %s()", f->name);
+
+            d->target = &code[index_map[target]];
+            break;
+        }
+
+        case OP_MOVE_S:
+            // temp strings only need internalising when going to a global
+            if (st->b <= OFS_RETURN * 8)
+                d->op = DOP_MOVE_F;
+            break;
+
+        case OP_ADD_S:
+        case OP_ADD_SF:
+        case OP_ADD_SV:
+            d->intern = (st->c > OFS_RETURN * 8) ? 1 : 0;
+            break;
+
+        default:
+            break;
+        }
+
+        // fuse with the next statement?  It keeps its own slot, which
+        // supplies the branch target or destination operand.
+        if (i + 1 < count)
+        {
+            statement_t *next = REF_OP(ofs + step);
+
+            if (next->a == st->c && st->c != 0)
+            {
+                int fused = -1;
+
+                if (next->op == OP_IFNOT)
+                    fused = FusedCompare(st->op);
+                else
+                    fused = FusedArithmetic(st->op, next->op);
+
+                if (fused >= 0)
+                    d->op = (short)fused;
+            }
+        }
+    }
+
+    code[total].op  = DOP_RET;
+    code[total].src = f->last_statement;
+
+    f->decoded = code;
+
+    return code;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define COAL_COMPUTED_GOTO
+#endif
+
+#define D_OPERAND(o) ((o).global ? (o).global : frame + (o).local)
+
+#define D_ERROR(...)                                                                                                   \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        exec.s = pc->src + (int)sizeof(statement_t);                                                                   \
+        RunError(__VA_ARGS__);                                                                                         \
+    } while (0)
+
+// runaway checking is only done on branches and calls, since a
+// straight run of statements always ends.
+#define D_BRANCH(dest)                                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!--runaway)                                                                                                \
+            D_ERROR("runaway loop error");                                                                             \
+        pc = (dest);                                                                                                   \
+    } while (0)
+
+#ifdef COAL_COMPUTED_GOTO
+#define D_CASE(op) L_##op:
+#define D_NEXT()   goto *dispatch_table[pc->op]
+#else
+#define D_CASE(op) case op:
+#define D_NEXT()   continue
+#endif
+
+void real_vm_c::DoExecuteDecoded(int fnum)
+{
+#ifdef COAL_COMPUTED_GOTO
+    static const void *dispatch_table[NUM_DECODED_OPS] = {
+        &&L_DOP_CALL,       &&L_DOP_RET,        &&L_DOP_PARM_NULL,  &&L_DOP_PARM_F,     &&L_DOP_PARM_V,
+        &&L_DOP_IF,         &&L_DOP_IFNOT,      &&L_DOP_GOTO,       &&L_DOP_ERROR,      &&L_DOP_MOVE_F,
+        &&L_DOP_MOVE_V,     &&L_DOP_MOVE_S,     &&L_DOP_NOT_F,      &&L_DOP_NOT_V,      &&L_DOP_INC,
+        &&L_DOP_DEC,        &&L_DOP_POWER_F,    &&L_DOP_MUL_F,      &&L_DOP_MUL_V,      &&L_DOP_MUL_FV,
+        &&L_DOP_MUL_VF,     &&L_DOP_DIV_F,      &&L_DOP_DIV_V,      &&L_DOP_MOD_F,      &&L_DOP_ADD_F,
+        &&L_DOP_ADD_V,      &&L_DOP_ADD_S,      &&L_DOP_ADD_SF,     &&L_DOP_ADD_SV,     &&L_DOP_SUB_F,
+        &&L_DOP_SUB_V,      &&L_DOP_EQ_F,       &&L_DOP_EQ_V,       &&L_DOP_EQ_S,       &&L_DOP_NE_F,
+        &&L_DOP_NE_V,       &&L_DOP_NE_S,       &&L_DOP_LE,         &&L_DOP_GE,         &&L_DOP_LT,
+        &&L_DOP_GT,         &&L_DOP_AND,        &&L_DOP_OR,         &&L_DOP_BITAND,     &&L_DOP_BITOR,
+        &&L_DOP_EQ_F_IFNOT, &&L_DOP_NE_F_IFNOT, &&L_DOP_LE_IFNOT,   &&L_DOP_GE_IFNOT,   &&L_DOP_LT_IFNOT,
+        &&L_DOP_GT_IFNOT,   &&L_DOP_ADD_F_MOVE, &&L_DOP_SUB_F_MOVE, &&L_DOP_MUL_F_MOVE, &&L_DOP_ADD_V_MOVE,
+        &&L_DOP_SUB_V_MOVE,
+    };
+#endif
+
+    // return addresses, indexed by call depth
+    const dstatement_t *ret_pc[MAX_CALL_STACK + 1];
+
+    int runaway = MAX_RUNAWAY;
+
+    // make a stack frame
+    int exitdepth = exec.call_depth;
+
+    EnterFunction(fnum);
+
+    function_t *f = functions[fnum];
+
+    const dstatement_t *pc    = f->decoded ? f->decoded : DecodeFunction(f);
+    double             *frame = &exec.stack[exec.stack_depth];
+
+#ifdef COAL_COMPUTED_GOTO
+    D_NEXT();
+#else
+    for (;;)
+    {
+        switch (pc->op)
+        {
+#endif
+
+    D_CASE(DOP_CALL)
+    {
+        int fnum_call = (int)*D_OPERAND(pc->a);
+        if (fnum_call <= 0)
+            D_ERROR("NULL function");
+
+        function_t *newf = functions[fnum_call];
+
+        // saved 's' value points to the statement _after_ OP_CALL
+        exec.s = pc->src + (int)sizeof(statement_t);
+
+        /* negative statements are built in functions */
+        if (newf->first_statement < 0)
+        {
+            EnterNative(fnum_call, pc->argc);
+            pc++;
+            D_NEXT();
+        }
+
+        if (!--runaway)
+            D_ERROR("runaway loop error");
+
+        ret_pc[exec.call_depth] = pc + 1;
+
+        EnterFunction(fnum_call);
+
+        pc    = newf->decoded ? newf->decoded : DecodeFunction(newf);
+        frame = &exec.stack[exec.stack_depth];
+        D_NEXT();
+    }
+
+    D_CASE(DOP_RET)
+    {
+        LeaveFunction();
+
+        // all done?
+        if (exec.call_depth == exitdepth)
+            return;
+
+        pc    = ret_pc[exec.call_depth];
+        frame = &exec.stack[exec.stack_depth];
+        D_NEXT();
+    }
+
+    D_CASE(DOP_PARM_NULL)
+    {
+        // Trying to pick a reliable but very unlikely value for a parameter - Dasho
+        frame[pc->b.local] = -FLT_MAX;
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_PARM_F)
+    {
+        frame[pc->b.local] = *D_OPERAND(pc->a);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_PARM_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = frame + pc->b.local;
+
+        b[0] = a[0];
+        b[1] = a[1];
+        b[2] = a[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_IF)
+    {
+        if (*D_OPERAND(pc->a))
+            D_BRANCH(pc->target);
+        else
+            pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_IFNOT)
+    {
+        if (!*D_OPERAND(pc->a))
+            D_BRANCH(pc->target);
+        else
+            pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_GOTO)
+    {
+        D_BRANCH(pc->target);
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ERROR)
+    {
+        statement_t *st = REF_OP(pc->src);
+        D_ERROR("Assertion failed @ %s:%d\n", REF_STRING(st->a), st->b);
+        D_NEXT(); /* NOT REACHED */
+    }
+
+    D_CASE(DOP_MOVE_F)
+    {
+        *D_OPERAND(pc->b) = *D_OPERAND(pc->a);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MOVE_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        b[0] = a[0];
+        b[1] = a[1];
+        b[2] = a[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MOVE_S)
+    {
+        double *a = D_OPERAND(pc->a);
+
+        // temp strings must be internalised when assigned
+        // to a global variable.
+        if (*a < 0)
+            *pc->b.global = InternaliseString(REF_STRING((int)*a));
+        else
+            *pc->b.global = *a;
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_NOT_F)
+    {
+        *D_OPERAND(pc->c) = !*D_OPERAND(pc->a);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_NOT_V)
+    {
+        double *a = D_OPERAND(pc->a);
+
+        *D_OPERAND(pc->c) = !a[0] && !a[1] && !a[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_INC)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) + 1;
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_DEC)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) - 1;
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_POWER_F)
+    {
+        *D_OPERAND(pc->c) = powf(*D_OPERAND(pc->a), *D_OPERAND(pc->b));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MUL_F)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) * *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MUL_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c) = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MUL_FV)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+
+        c[0] = a[0] * b[0];
+        c[1] = a[0] * b[1];
+        c[2] = a[0] * b[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MUL_VF)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+
+        c[0] = b[0] * a[0];
+        c[1] = b[0] * a[1];
+        c[2] = b[0] * a[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_DIV_F)
+    {
+        double *b = D_OPERAND(pc->b);
+
+        if (AlmostEquals(*b, 0.0))
+            D_ERROR("Division by zero");
+
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) / *b;
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_DIV_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+
+        if (AlmostEquals(*b, 0.0))
+            D_ERROR("Division by zero");
+
+        c[0] = a[0] / *b;
+        c[1] = a[1] / *b;
+        c[2] = a[2] / *b;
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MOD_F)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        if (AlmostEquals(*b, 0.0))
+            D_ERROR("Division by zero");
+
+        float d           = floorf(*a / *b);
+        *D_OPERAND(pc->c) = *a - d * (*b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ADD_F)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) + *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ADD_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+
+        c[0] = a[0] + b[0];
+        c[1] = a[1] + b[1];
+        c[2] = a[2] + b[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ADD_S)
+    {
+        double *c = D_OPERAND(pc->c);
+
+        *c = STR_Concat(REF_STRING((int)*D_OPERAND(pc->a)), REF_STRING((int)*D_OPERAND(pc->b)));
+        if (pc->intern)
+            *c = InternaliseString(REF_STRING((int)*c));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ADD_SF)
+    {
+        double *c = D_OPERAND(pc->c);
+
+        *c = STR_ConcatFloat(REF_STRING((int)*D_OPERAND(pc->a)), *D_OPERAND(pc->b));
+        if (pc->intern)
+            *c = InternaliseString(REF_STRING((int)*c));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ADD_SV)
+    {
+        double *c = D_OPERAND(pc->c);
+
+        *c = STR_ConcatVector(REF_STRING((int)*D_OPERAND(pc->a)), D_OPERAND(pc->b));
+        if (pc->intern)
+            *c = InternaliseString(REF_STRING((int)*c));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_SUB_F)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) - *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_SUB_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+
+        c[0] = a[0] - b[0];
+        c[1] = a[1] - b[1];
+        c[2] = a[2] - b[2];
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_EQ_F)
+    {
+        *D_OPERAND(pc->c) = AlmostEquals(*D_OPERAND(pc->a), *D_OPERAND(pc->b));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_EQ_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c) =
+            (AlmostEquals(a[0], b[0])) && (AlmostEquals(a[1], b[1])) && (AlmostEquals(a[2], b[2]));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_EQ_S)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c) = (AlmostEquals(*a, *b)) ? 1 : !strcmp(REF_STRING((int)*a), REF_STRING((int)*b));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_NE_F)
+    {
+        *D_OPERAND(pc->c) = !AlmostEquals(*D_OPERAND(pc->a), *D_OPERAND(pc->b));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_NE_V)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c) =
+            (!AlmostEquals(a[0], b[0])) || (!AlmostEquals(a[1], b[1])) || (!AlmostEquals(a[2], b[2]));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_NE_S)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c) = (AlmostEquals(*a, *b)) ? 0 : !!strcmp(REF_STRING((int)*a), REF_STRING((int)*b));
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_LE)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) <= *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_GE)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) >= *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_LT)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) < *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_GT)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) > *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_AND)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) && *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_OR)
+    {
+        *D_OPERAND(pc->c) = *D_OPERAND(pc->a) || *D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_BITAND)
+    {
+        *D_OPERAND(pc->c) = (int)*D_OPERAND(pc->a) & (int)*D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_BITOR)
+    {
+        *D_OPERAND(pc->c) = (int)*D_OPERAND(pc->a) | (int)*D_OPERAND(pc->b);
+        pc++;
+        D_NEXT();
+    }
+
+    // compare + IFNOT : the IFNOT in the next slot holds the target.
+    // The comparison result is still stored, like the separate ops.
+
+#define D_COMPARE_IFNOT(expr)                                                                                          \
+    {                                                                                                                  \
+        double *a = D_OPERAND(pc->a);                                                                                  \
+        double *b = D_OPERAND(pc->b);                                                                                  \
+        double  r = (expr);                                                                                            \
+                                                                                                                       \
+        *D_OPERAND(pc->c) = r;                                                                                         \
+                                                                                                                       \
+        if (!r)                                                                                                        \
+        {                                                                                                              \
+            pc++;                                                                                                      \
+            D_BRANCH(pc->target);                                                                                      \
+        }                                                                                                              \
+        else                                                                                                           \
+            pc += 2;                                                                                                   \
+        D_NEXT();                                                                                                      \
+    }
+
+    D_CASE(DOP_EQ_F_IFNOT)
+    D_COMPARE_IFNOT(AlmostEquals(*a, *b))
+
+    D_CASE(DOP_NE_F_IFNOT)
+    D_COMPARE_IFNOT(!AlmostEquals(*a, *b))
+
+    D_CASE(DOP_LE_IFNOT)
+    D_COMPARE_IFNOT(*a <= *b)
+
+    D_CASE(DOP_GE_IFNOT)
+    D_COMPARE_IFNOT(*a >= *b)
+
+    D_CASE(DOP_LT_IFNOT)
+    D_COMPARE_IFNOT(*a < *b)
+
+    D_CASE(DOP_GT_IFNOT)
+    D_COMPARE_IFNOT(*a > *b)
+
+#undef D_COMPARE_IFNOT
+
+    // arithmetic + MOVE : the MOVE in the next slot holds the destination.
+
+    D_CASE(DOP_ADD_F_MOVE)
+    {
+        double r = *D_OPERAND(pc->a) + *D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c)    = r;
+        *D_OPERAND(pc[1].b) = r;
+        pc += 2;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_SUB_F_MOVE)
+    {
+        double r = *D_OPERAND(pc->a) - *D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c)    = r;
+        *D_OPERAND(pc[1].b) = r;
+        pc += 2;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_MUL_F_MOVE)
+    {
+        double r = *D_OPERAND(pc->a) * *D_OPERAND(pc->b);
+
+        *D_OPERAND(pc->c)    = r;
+        *D_OPERAND(pc[1].b) = r;
+        pc += 2;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_ADD_V_MOVE)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+        double *d = D_OPERAND(pc[1].b);
+
+        c[0] = a[0] + b[0];
+        c[1] = a[1] + b[1];
+        c[2] = a[2] + b[2];
+
+        d[0] = c[0];
+        d[1] = c[1];
+        d[2] = c[2];
+        pc += 2;
+        D_NEXT();
+    }
+
+    D_CASE(DOP_SUB_V_MOVE)
+    {
+        double *a = D_OPERAND(pc->a);
+        double *b = D_OPERAND(pc->b);
+        double *c = D_OPERAND(pc->c);
+        double *d = D_OPERAND(pc[1].b);
+
+        c[0] = a[0] - b[0];
+        c[1] = a[1] - b[1];
+        c[2] = a[2] - b[2];
+
+        d[0] = c[0];
+        d[1] = c[1];
+        d[2] = c[2];
+        pc += 2;
+        D_NEXT();
+    }
+
+#ifndef COAL_COMPUTED_GOTO
+        default:
+            D_ERROR("Bad opcode %i", pc->op);
+        }
+    }
+#endif
+}
+
+#undef D_OPERAND
+#undef D_ERROR
+#undef D_BRANCH
+#undef D_CASE
+#undef D_NEXT
+
 int real_vm_c::Execute(int func_id)
 {
     // re-use the temporary string space
@@ -644,7 +1501,10 @@ int real_vm_c::Execute(int func_id)
         RunError("vm_c::Execute: NULL function");
     }
 
-    DoExecute(func_id);
+    if (exec.tracing)
+        DoExecute(func_id);
+    else
+        DoExecuteDecoded(func_id);
 
     return 0;
 }
@@ -654,7 +1514,7 @@ int real_vm_c::Execute(int func_id)
 //=================================================================
 
 const char *opcode_names[] = {
-    "NULL",   "CALL",   "RET",    "PARM_F",   "PARM_V", "IF",    "IFNOT", "GOTO",   "ERROR",
+    "NULL",   "CALL",   "RET",    "PARM_NULL", "PARM_F", "PARM_V", "IF",    "IFNOT",  "GOTO",  "ERROR",
 
     "MOVE_F", "MOVE_V", "MOVE_S", "MOVE_FNC",
 
@@ -30,6 +30,116 @@ struct call_stack_c
     int func;
 };
 
+//
+// Pre-decoded statements
+//
+// Each function is translated into this form the first time it runs.
+// Operands are resolved to direct pointers (globals) or offsets into the
+// current stack frame (locals and parameters), branch targets become
+// pointers to the decoded statement, OP_NULL statements are dropped, and
+// a few common statement pairs are fused into a single instruction.  The
+// plain statement loop is still used when tracing.
+//
+typedef struct
+{
+    double *global; // NULL when the operand lives on the stack
+    int     local;  // offset from the current stack frame
+} doperand_t;
+
+typedef struct dstatement_s
+{
+    short op;     // a DOP_XXX value
+    short intern; // result must be internalised (string ops)
+
+    int src;  // offset of the original statement, for errors
+    int argc; // for CALL
+
+    const struct dstatement_s *target; // for branches
+
+    doperand_t a, b, c;
+} dstatement_t;
+
+enum
+{
+    DOP_CALL = 0,
+    DOP_RET,
+
+    DOP_PARM_NULL,
+    DOP_PARM_F,
+    DOP_PARM_V,
+
+    DOP_IF,
+    DOP_IFNOT,
+    DOP_GOTO,
+    DOP_ERROR,
+
+    DOP_MOVE_F, // also MOVE_FNC, and MOVE_S to a local
+    DOP_MOVE_V,
+    DOP_MOVE_S,
+
+    DOP_NOT_F, // also NOT_S and NOT_FNC
+    DOP_NOT_V,
+
+    DOP_INC,
+    DOP_DEC,
+
+    DOP_POWER_F,
+    DOP_MUL_F,
+    DOP_MUL_V,
+    DOP_MUL_FV,
+    DOP_MUL_VF,
+
+    DOP_DIV_F,
+    DOP_DIV_V,
+    DOP_MOD_F,
+
+    DOP_ADD_F,
+    DOP_ADD_V,
+    DOP_ADD_S,
+    DOP_ADD_SF,
+    DOP_ADD_SV,
+
+    DOP_SUB_F,
+    DOP_SUB_V,
+
+    DOP_EQ_F, // also EQ_FNC
+    DOP_EQ_V,
+    DOP_EQ_S,
+
+    DOP_NE_F, // also NE_FNC
+    DOP_NE_V,
+    DOP_NE_S,
+
+    DOP_LE,
+    DOP_GE,
+    DOP_LT,
+    DOP_GT,
+
+    DOP_AND,
+    DOP_OR,
+    DOP_BITAND,
+    DOP_BITOR,
+
+    // fused pairs: the second statement is kept in the following slot
+    // (so branches into it still work) and supplies the extra operand
+    // or branch target.
+
+    DOP_EQ_F_IFNOT,
+    DOP_NE_F_IFNOT,
+    DOP_LE_IFNOT,
+    DOP_GE_IFNOT,
+    DOP_LT_IFNOT,
+    DOP_GT_IFNOT,
+
+    DOP_ADD_F_MOVE,
+    DOP_SUB_F_MOVE,
+    DOP_MUL_F_MOVE,
+    DOP_ADD_V_MOVE,
+    DOP_SUB_V_MOVE,
+
+    NUM_DECODED_OPS
+};
+
 class execution_c
 {
   public:
@@ -153,6 +153,9 @@ typedef struct
 
     int first_statement; // negative numbers are builtins
     int last_statement;
+
+    // pre-decoded code, built on first execution
+    struct dstatement_s *decoded;
 } function_t;
 
 // offset in global data block (if > 0)
@@ -218,8 +221,17 @@ class real_vm_c : public vm_c
     void SetVectorY(const char *mod_name, const char *var_name, double val);
     void SetVectorZ(const char *mod_name, const char *var_name, double val);
 
+    int FindVariable(const char *mod_name, const char *var_name, int var_type);
+
+    double      GetFloat(int var);
+    const char *GetString(int var);
+    double     *GetVector(int var);
+
+    void SetFloat(int var, double value);
+    void SetString(int var, const char *value);
+    void SetVector(int var, double val_1, double val_2, double val_3);
+
     int FindFunction(const char *name);
-    int FindVariable(const char *name);
 
     int Execute(int func_id);
 
@@ -307,6 +319,9 @@ class real_vm_c : public vm_c
     // c_execute.cc
   private:
     void DoExecute(int func_id);
+    void DoExecuteDecoded(int func_id);
+
+    dstatement_t *DecodeFunction(function_t *f);
 
     void EnterNative(int func, int argc);
     void EnterFunction(int func);
@@ -76,8 +76,28 @@ class vm_c
     virtual void SetVectorY(const char *mod_name, const char *var_name, double val)                              = 0;
     virtual void SetVectorZ(const char *mod_name, const char *var_name, double val)                              = 0;
 
+    // Resolved handles: look a global variable up once with FindVariable()
+    // and then access it by handle, skipping the name lookups.  A handle is
+    // an offset into the global data and stays valid for the life of the VM.
+    // FindVariable() returns NOT_FOUND when the name or type does not match.
+    enum var_type_e
+    {
+        VAR_FLOAT = 1,
+        VAR_STRING,
+        VAR_VECTOR
+    };
+
+    virtual int FindVariable(const char *mod_name, const char *var_name, int var_type) = 0;
+
+    virtual double      GetFloat(int var)  = 0;
+    virtual const char *GetString(int var) = 0;
+    virtual double     *GetVector(int var) = 0;
+
+    virtual void SetFloat(int var, double value)                            = 0;
+    virtual void SetString(int var, const char *value)                      = 0;
+    virtual void SetVector(int var, double val_1, double val_2, double val_3) = 0;
+
     virtual int FindFunction(const char *name) = 0;
-    virtual int FindVariable(const char *name) = 0;
 
     virtual int Execute(int func_id) = 0;
 
@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------
+//  COAL INTERPRETER MICROBENCHMARKS
+//----------------------------------------------------------------------
+//
+//  Copyright (C) 2024 The EDGE Team
+//
+//  Coal is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as
+//  published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  Coal is distributed in the hope that it will be useful, but
+//  WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+//  the GNU General Public License for more details.
+//
+//----------------------------------------------------------------------
+//
+//  Standalone program (EDGE_COAL_BENCH option) which compiles a few
+//  small scripts and reports the time per loop iteration of each.
+//
+//----------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "coal.h"
+
+void I_Error(const char *error, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, error);
+    vfprintf(stderr, error, argptr);
+    va_end(argptr);
+
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+static void BenchPrinter(const char *msg, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, msg);
+    vprintf(msg, argptr);
+    va_end(argptr);
+}
+
+static void BenchNative(coal::vm_c *vm, int argc)
+{
+    (void)argc;
+
+    vm->ReturnFloat(*vm->AccessParam(0) + 1);
+}
+
+static char bench_source[] = "var iterations = 0\n"
+                             "var total = 0\n"
+                             "var vtotal : vector = '0 0 0'\n"
+                             "var text : string = \"\"\n"
+                             "\n"
+                             "function bump(x) : float = native\n"
+                             "\n"
+                             "function add_one(x) : float =\n"
+                             "{\n"
+                             "    return x + 1\n"
+                             "}\n"
+                             "\n"
+                             "function bench_loop() =\n"
+                             "{\n"
+                             "    var i = 0\n"
+                             "    for (i = 1, iterations)\n"
+                             "    {\n"
+                             "        total = total + i * 2\n"
+                             "        if (total > 1000000)\n"
+                             "            total = 0\n"
+                             "    }\n"
+                             "}\n"
+                             "\n"
+                             "function bench_vector() =\n"
+                             "{\n"
+                             "    var i = 0\n"
+                             "    var v : vector = '1 2 3'\n"
+                             "    for (i = 1, iterations)\n"
+                             "    {\n"
+                             "        vtotal = vtotal + v * 0.5 - '0.5 1 1.5'\n"
+                             "        v = v + '0 0 1'\n"
+                             "        total = vtotal * v\n"
+                             "    }\n"
+                             "}\n"
+                             "\n"
+                             "function bench_string() =\n"
+                             "{\n"
+                             "    var i = 0\n"
+                             "    var s : string = \"\"\n"
+                             "    for (i = 1, iterations)\n"
+                             "    {\n"
+                             "        s = \"abc\" + \"def\"\n"
+                             "        s = s + i\n"
+                             "    }\n"
+                             "    text = s\n"
+                             "}\n"
+                             "\n"
+                             "function bench_call() =\n"
+                             "{\n"
+                             "    var i = 0\n"
+                             "    for (i = 1, iterations)\n"
+                             "    {\n"
+                             "        total = add_one(total)\n"
+                             "        total = bump(total)\n"
+                             "    }\n"
+                             "}\n";
+
+struct bench_info_t
+{
+    const char *func;
+    const char *what;
+
+    int iterations; // per Execute() call
+    int repeats;
+};
+
+// iterations are kept low enough for the runaway check of the plain
+// statement loop (one million statements), so numbers can be compared.
+static const bench_info_t benchmarks[] = {
+    {"bench_loop", "float loop", 20000, 1000},
+    {"bench_vector", "vector math", 20000, 1000},
+    {"bench_string", "string concat", 1000, 2000},
+    {"bench_call", "calls", 10000, 1000},
+};
+
+int main(void)
+{
+    coal::vm_c *vm = coal::CreateVM();
+
+    vm->SetPrinter(BenchPrinter);
+    vm->AddNativeFunction("bump", BenchNative);
+
+    if (!vm->CompileFile(bench_source, "coal_bench"))
+    {
+        fprintf(stderr, "coal-bench: failed to compile scripts\n");
+        return 1;
+    }
+
+    int iterations = vm->FindVariable(NULL, "iterations", coal::vm_c::VAR_FLOAT);
+    int total      = vm->FindVariable(NULL, "total", coal::vm_c::VAR_FLOAT);
+
+    printf("COAL microbenchmarks\n\n");
+
+    for (const bench_info_t &B : benchmarks)
+    {
+        int func = vm->FindFunction(B.func);
+
+        if (func == coal::vm_c::NOT_FOUND)
+            I_Error("coal-bench: missing function %s", B.func);
+
+        // the iteration count is passed via a global, since Execute()
+        // does not take parameters.
+        vm->SetFloat(iterations, B.iterations);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int r = 0; r < B.repeats; r++)
+        {
+            vm->SetFloat(total, 0);
+            vm->Execute(func);
+        }
+
+        auto   finish  = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::nano>(finish - start).count();
+
+        printf("  %-14s %10.2f ns/op\n", B.what, elapsed / ((double)B.repeats * B.iterations));
+    }
+
+    delete vm;
+
+    return 0;
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
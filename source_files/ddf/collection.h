@@ -52,6 +52,31 @@ enum ddf_type_e
     DDF_NUM_TYPES
 };
 
+// A DDF command which is already split into its parts, as produced by
+// converters like DEH_EDGE.  These are fed straight to the DDF parsers
+// without going through the text reader.  Names and values are stored
+// exactly as the text reader would produce them.
+class ddf_record_c
+{
+  public:
+    // true for the start of a new entry, false for a command
+    bool is_entry;
+
+    // entry name (including any "++" prefix) or command name
+    std::string name;
+
+    // the comma separated values of a command
+    std::vector<std::string> values;
+
+    ddf_record_c(bool _entry, const std::string &_name) : is_entry(_entry), name(_name), values()
+    {
+    }
+
+    ~ddf_record_c()
+    {
+    }
+};
+
 class ddf_file_c
 {
   public:
@@ -59,11 +84,14 @@ class ddf_file_c
     std::string source;
     std::string data;
 
-    ddf_file_c(ddf_type_e _t, const std::string &_s) : type(_t), source(_s), data()
+    // when not empty, these are read instead of the text in `data`
+    std::vector<ddf_record_c> records;
+
+    ddf_file_c(ddf_type_e _t, const std::string &_s) : type(_t), source(_s), data(), records()
     {
     }
 
-    ddf_file_c(ddf_type_e _t, const std::string &_s, std::string &_d) : type(_t), source(_s), data(_d)
+    ddf_file_c(ddf_type_e _t, const std::string &_s, std::string &_d) : type(_t), source(_s), data(_d), records()
     {
     }
 
@@ -195,7 +195,7 @@ void DDF_MainReadFile(readinfo_t *readinfo, const std::string &data);
 extern int         cur_ddf_line_num;
 extern std::string cur_ddf_filename;
 extern std::string cur_ddf_entryname;
-extern std::string cur_ddf_linedata;
+extern std::string_view cur_ddf_linedata;
 
 void DDF_Error(const char *err, ...) GCCATTR((format(printf, 1, 2)));
 void DDF_Debug(const char *err, ...) GCCATTR((format(printf, 1, 2)));
@@ -26,6 +26,9 @@
 
 #include <limits.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 // EPI
 #include "epi.h"
 #include "str_util.h"
@@ -74,8 +77,6 @@ typedef enum
     ok_char
 } readchar_t;
 
-#define DEBUG_DDFREAD 0
-
 bool strict_errors = false;
 bool lax_errors    = false;
 bool no_warnings   = false;
@@ -88,7 +89,7 @@ bool no_warnings   = false;
 int         cur_ddf_line_num;
 std::string cur_ddf_filename;
 std::string cur_ddf_entryname;
-std::string cur_ddf_linedata;
+std::string_view cur_ddf_linedata;
 
 void DDF_Error(const char *err, ...)
 {
@@ -117,9 +118,9 @@ void DDF_Error(const char *err, ...)
         pos += strlen(pos);
     }
 
-    if (cur_ddf_linedata != "")
+    if (!cur_ddf_linedata.empty())
     {
-        sprintf(pos, "Line contents: %s\n", cur_ddf_linedata.c_str());
+        sprintf(pos, "Line contents: %.*s\n", (int)cur_ddf_linedata.size(), cur_ddf_linedata.data());
         pos += strlen(pos);
     }
 
@@ -159,7 +160,7 @@ void DDF_Warning(const char *err, ...)
 
     if (!cur_ddf_linedata.empty())
     {
-        I_Printf("  with line contents: %s\n", cur_ddf_linedata.c_str());
+        I_Printf("  with line contents: %.*s\n", (int)cur_ddf_linedata.size(), cur_ddf_linedata.data());
     }
 }
 
@@ -189,7 +190,7 @@ void DDF_Debug(const char *err, ...)
 
     if (!cur_ddf_linedata.empty())
     {
-        I_Debugf("  with line contents: %s\n", cur_ddf_linedata.c_str());
+        I_Debugf("  with line contents: %.*s\n", (int)cur_ddf_linedata.size(), cur_ddf_linedata.data());
     }
 }
 
@@ -481,25 +482,75 @@ void DDF_GetLumpNameForFile(const char *filename, char *lumpname)
 //
 // The maximum size of BUFFER is set in the BUFFERSIZE define.
 //
-// DDF_MainReadFile & DDF_MainProcessChar handle the main processing of the file, all
-// the procedures in the other DDF files (which the exceptions of the Inits) are
-// called directly or indirectly. DDF_MainReadFile handles to opening, closing and
-// calling of procedures, DDF_MainProcessChar makes sense from the character read
-// from the file.
+// DDF_MainReadFile handles the main processing of the file, all the procedures
+// in the other DDF files (with the exception of the Inits) are called directly
+// or indirectly.  The data is read in place, without making a copy of it.
+// Runs of characters which cannot change the parser's mode (plain token
+// characters, whitespace, string and remark contents) are consumed in one go,
+// and DDF_MainProcessChar makes sense of the remaining characters one by one.
 //
 
+// character classes for the fast paths of DDF_MainReadFile.
+// Note that '#' and '\n' are never part of a run, since they need to
+// be checked for directives and line tracking.
+#define DDF_CC_SPACE   (1 << 0) // whitespace (skipped)
+#define DDF_CC_NEWDEF  (1 << 1) // ordinary characters of an entry name
+#define DDF_CC_COMMAND (1 << 2) // ordinary characters of a command name
+#define DDF_CC_DATA    (1 << 3) // ordinary characters of a command value
+#define DDF_CC_STRING  (1 << 4) // ordinary characters of a quoted string
+#define DDF_CC_REMARK  (1 << 5) // characters ignored inside a {} remark
+
+static uint8_t ddf_char_class[256];
+
+static void DDF_MainInitCharClasses(void)
+{
+    static bool done = false;
+
+    if (done)
+        return;
+
+    for (int i = 0; i < 256; i++)
+    {
+        uint8_t cls = 0;
+
+        if (i == '#' || i == '\n')
+        {
+            ddf_char_class[i] = 0;
+            continue;
+        }
+
+        if (isspace(i))
+            cls |= DDF_CC_SPACE;
+
+        if (isalnum(i) || i == '_' || i == ':' || i == '+')
+            cls |= DDF_CC_NEWDEF;
+
+        if (isalnum(i) || i == '_' || i == '(' || i == ')' || i == '.')
+            cls |= DDF_CC_COMMAND;
+
+        if (isalnum(i) || i == '_' || i == '-' || i == ':' || i == '.' || i == '[' || i == ']' || i == '\\' ||
+            i == '!' || i == '%' || i == '+' || i == '@' || i == '?')
+            cls |= DDF_CC_DATA;
+
+        if (i != '\"' && i != '\\')
+            cls |= DDF_CC_STRING;
+
+        if (i != '{' && i != '}')
+            cls |= DDF_CC_REMARK;
+
+        ddf_char_class[i] = cls;
+    }
+
+    done = true;
+}
+
 //
 // DDF_MainProcessChar
 //
 // 1998/08/10 Added String reading code.
 //
-static readchar_t DDF_MainProcessChar(char character, std::string &token, int status)
+static readchar_t DDF_MainProcessChar(char character, std::string &token, int status, bool &formatchar)
 {
-    // int len;
-
-    // -ACB- 1998/08/11 Used for detecting formatting in a string
-    static bool formatchar = false;
-
     // With the exception of reading_string, whitespace is ignored.
     if (status != reading_string)
     {
@@ -508,6 +559,7 @@ static readchar_t DDF_MainProcessChar(char character, std::string &token, int st
     }
     else // check for formatting char in a string
     {
+        // -ACB- 1998/08/11 Used for detecting formatting in a string
         if (!formatchar && character == '\\')
         {
             formatchar = true;
@@ -682,6 +734,72 @@ static readchar_t DDF_MainProcessChar(char character, std::string &token, int st
     return nothing;
 }
 
+// when set, DDF_MainReadFile reads these instead of the given text
+static const std::vector<ddf_record_c> *pending_records = NULL;
+
+// when set, DDF_MainReadFile also stores what it reads here (this is
+// how the DDF snapshot gets filled, see DDF_LoadSnapshot).
+static std::vector<ddf_record_c> *capture_records  = NULL;
+static readinfo_t                *capture_readinfo = NULL;
+
+static void DDF_CaptureStartEntry(const char *name, bool extend);
+static void DDF_CaptureParseField(const char *field, const char *contents, int index, bool is_last);
+static void DDF_CaptureClearAll(void);
+
+//
+// DDF_MainReadRecords
+//
+// Feeds pre-split commands (e.g. from DEH_EDGE) to the parse routines
+// of a DDF type, in the same way the text reader below would.
+//
+static void DDF_MainReadRecords(readinfo_t *readinfo, const std::vector<ddf_record_c> &records)
+{
+    bool firstgo = true;
+
+    cur_ddf_line_num = 0;
+    cur_ddf_filename = std::string(readinfo->lumpname);
+    cur_ddf_entryname.clear();
+
+    for (const ddf_record_c &rec : records)
+    {
+        if (rec.is_entry)
+        {
+            // finish off previous entry
+            if (!firstgo)
+                (*readinfo->finish_entry)();
+
+            firstgo = false;
+
+            cur_ddf_entryname = epi::StringFormat("[%s]", rec.name.c_str());
+
+            if (rec.name[0] == '+' && rec.name[1] == '+')
+                (*readinfo->start_entry)(rec.name.c_str() + 2, true);
+            else
+                (*readinfo->start_entry)(rec.name.c_str(), false);
+
+            continue;
+        }
+
+        if (firstgo)
+            DDF_Error("Command %s used outside of any entry\n", rec.name.c_str());
+
+        SYS_ASSERT(!rec.values.empty());
+
+        int count = (int)rec.values.size();
+
+        // values may name a #DEFINE, just like in the text
+        for (int i = 0; i < count; i++)
+            (*readinfo->parse_field)(rec.name.c_str(), DDF_MainGetDefine(rec.values[i].c_str()), i,
+                                     (i == count - 1));
+    }
+
+    if (!firstgo)
+        (*readinfo->finish_entry)();
+
+    cur_ddf_entryname.clear();
+    cur_ddf_filename.clear();
+}
+
 //
 // DDF_MainReadFile
 //
@@ -692,141 +810,196 @@ static readchar_t DDF_MainProcessChar(char character, std::string &token, int st
 //
 void DDF_MainReadFile(readinfo_t *readinfo, const std::string &data)
 {
+    if (pending_records)
+    {
+        DDF_MainReadRecords(readinfo, *pending_records);
+        return;
+    }
+
+    readinfo_t capture_info;
+
+    if (capture_records)
+    {
+        capture_readinfo = readinfo;
+
+        capture_info             = *readinfo;
+        capture_info.start_entry = DDF_CaptureStartEntry;
+        capture_info.parse_field = DDF_CaptureParseField;
+        capture_info.clear_all   = DDF_CaptureClearAll;
+
+        readinfo = &capture_info;
+    }
+
     std::string token;
     std::string current_cmd;
 
-    char *name  = NULL;
-    char *value = NULL;
-
     int current_index = 0;
     int entry_count   = 0;
 
-#if (DEBUG_DDFREAD)
-    char charcount = 0;
-#endif
-
     int status       = waiting_tag;
     int formerstatus = nothing;
 
     int  comment_level = 0;
     int  bracket_level = 0;
     bool firstgo       = true;
+    bool formatchar    = false;
 
     cur_ddf_line_num = 1;
     cur_ddf_filename = std::string(readinfo->lumpname);
     cur_ddf_entryname.clear();
 
-    // WISH: don't make this copy, parse directly from the string
-    char *memfile = new char[data.size() + 1];
-    data.copy(memfile, std::string::npos);
-    memfile[data.size()] = 0;
+    DDF_MainInitCharClasses();
+
+    token.reserve(256);
+    current_cmd.reserve(64);
 
-    char *memfileptr = memfile;
-    int   memsize    = (int)data.size();
+    const char *pos = data.data();
+    const char *end = pos + data.size();
 
-    // -ACB- 1998/09/12 Copy file to memory: Read until end. Speed optimisation.
-    while (memfileptr < &memfile[memsize])
+    while (pos < end)
     {
-        // -KM- 1998/12/16 Added #define command to ddf files.
-        if (epi::StringPrefixCaseCompareASCII(std::string_view(memfileptr, 7), "#DEFINE") == 0)
+        // consume runs of characters which cannot change the status
+        int run_mask;
+
+        switch (status)
         {
-            bool line = false;
+        case reading_string:
+            run_mask = formatchar ? 0 : DDF_CC_STRING;
+            break;
+        case reading_remark:
+            run_mask = DDF_CC_REMARK;
+            break;
+        case reading_newdef:
+            run_mask = DDF_CC_SPACE | DDF_CC_NEWDEF;
+            break;
+        case reading_command:
+            run_mask = DDF_CC_SPACE | DDF_CC_COMMAND;
+            break;
+        case reading_data:
+            run_mask = DDF_CC_SPACE | DDF_CC_DATA;
+            break;
+        default:
+            run_mask = DDF_CC_SPACE;
+            break;
+        }
 
-            memfileptr += 8;
-            name = memfileptr;
+        if (ddf_char_class[(uint8_t)*pos] & run_mask)
+        {
+            const char *run = pos;
 
-            while (*memfileptr != ' ' && memfileptr < &memfile[memsize])
-                memfileptr++;
+            while (pos < end && (ddf_char_class[(uint8_t)*pos] & run_mask))
+                pos++;
 
-            if (memfileptr < &memfile[memsize])
+            if (status == reading_string)
+                token.append(run, pos - run);
+            else if (run_mask != DDF_CC_SPACE && run_mask != DDF_CC_REMARK)
             {
-                *memfileptr++ = 0;
-                value         = memfileptr;
-            }
-            else
-            {
-                DDF_Error("#DEFINE '%s' as what?!\n", name);
+                for (; run < pos; run++)
+                    if (!(ddf_char_class[(uint8_t)*run] & DDF_CC_SPACE))
+                        token += toupper(*run);
             }
 
+            continue;
+        }
+
+        // -KM- 1998/12/16 Added #define command to ddf files.
+        if (*pos == '#' && end - pos >= 7 && epi::StringPrefixCaseCompareASCII(std::string_view(pos, 7), "#DEFINE") == 0)
+        {
+            bool line = false;
+
+            pos = (end - pos > 8) ? pos + 8 : end;
+
+            const char *name = pos;
+
+            while (pos < end && *pos != ' ')
+                pos++;
+
+            if (pos >= end)
+                DDF_Error("#DEFINE '%s' as what?!\n", std::string(name, pos - name).c_str());
+
+            std::string def_name(name, pos - name);
+
+            const char *value = ++pos;
+
             // FIXME handle comments, stop at "//"
 
-            while (memfileptr < &memfile[memsize])
+            while (pos < end)
             {
-                if (*memfileptr == '\r')
-                    *memfileptr = ' ';
-                if (*memfileptr == '\\')
+                if (*pos == '\\')
                     line = true;
-                if (*memfileptr == '\n' && !line)
+                if (*pos == '\n' && !line)
                     break;
-                memfileptr++;
+                pos++;
             }
 
-            if (*memfileptr == '\n')
-                cur_ddf_line_num++;
+            std::string def_value(value, pos - value);
+
+            for (char &ch : def_value)
+                if (ch == '\r')
+                    ch = ' ';
 
-            *memfileptr++ = 0;
+            if (pos < end && *pos == '\n')
+            {
+                cur_ddf_line_num++;
+                pos++;
+            }
 
-            DDF_MainAddDefine(name, value);
+            DDF_MainAddDefine(def_name, def_value);
 
             token.clear();
             continue;
         }
 
         // -AJA- 1999/10/27: Not the greatest place for it, but detect //
-        //       comments here and ignore them.  Ow the pain of long
-        //       identifier names...  Ow the pain of &memfile[size] :-)
+        //       comments here and ignore them.
 
-        if (comment_level == 0 && status != reading_string && memfileptr + 1 < &memfile[memsize] &&
-            memfileptr[0] == '/' && memfileptr[1] == '/')
+        if (comment_level == 0 && status != reading_string && end - pos >= 2 && pos[0] == '/' && pos[1] == '/')
         {
-            while (memfileptr < &memfile[memsize] && *memfileptr != '\n')
-                memfileptr++;
+            pos = (const char *)memchr(pos, '\n', end - pos);
 
-            if (memfileptr >= &memfile[memsize])
+            if (!pos)
                 break;
         }
 
-        char character = *memfileptr++;
+        char character = *pos++;
 
         if (character == '\n')
         {
-            int l_len;
-
             cur_ddf_line_num++;
 
-            // -AJA- 2000/03/21: determine linedata.  Ouch.
-            for (l_len = 0;
-                 &memfileptr[l_len] < &memfile[memsize] && memfileptr[l_len] != '\n' && memfileptr[l_len] != '\r';
-                 l_len++)
-            {
-            }
+            // -AJA- 2000/03/21: determine linedata.  This is just a view
+            // into the data, nothing gets copied unless an error occurs.
+            const char *eol = pos;
+
+            while (eol < end && *eol != '\n' && *eol != '\r')
+                eol++;
 
-            cur_ddf_linedata = std::string(memfileptr, l_len);
+            cur_ddf_linedata = std::string_view(pos, eol - pos);
 
             // -AJA- 2001/05/21: handle directives (lines beginning with #).
             // This code is more hackitude -- to be fixed when the whole
             // parsing code gets the overhaul it needs.
 
-            if (epi::StringPrefixCaseCompareASCII(std::string_view(memfileptr, 9), "#CLEARALL") == 0)
+            if (epi::StringPrefixCaseCompareASCII(cur_ddf_linedata, "#CLEARALL") == 0)
             {
                 if (!firstgo)
                     DDF_Error("#CLEARALL cannot be used inside an entry !\n");
 
                 (*readinfo->clear_all)();
 
-                memfileptr += l_len;
+                pos = eol;
                 continue;
             }
 
-            if (epi::StringPrefixCaseCompareASCII(std::string_view(memfileptr, 8), "#VERSION") == 0)
+            if (epi::StringPrefixCaseCompareASCII(cur_ddf_linedata, "#VERSION") == 0)
             {
                 // just ignore it
-                memfileptr += l_len;
+                pos = eol;
                 continue;
             }
         }
 
-        int response = DDF_MainProcessChar(character, token, status);
+        int response = DDF_MainProcessChar(character, token, status, formatchar);
 
         switch (response)
         {
@@ -848,10 +1021,7 @@ void DDF_MainReadFile(readinfo_t *readinfo, const std::string &data)
             break;
 
         case command_read:
-            if (!token.empty())
-                current_cmd = token.c_str();
-            else
-                current_cmd.clear();
+            current_cmd = token;
 
             SYS_ASSERT(current_index == 0);
 
@@ -884,7 +1054,7 @@ void DDF_MainReadFile(readinfo_t *readinfo, const std::string &data)
             }
             else
             {
-                cur_ddf_linedata.clear();
+                cur_ddf_linedata = std::string_view();
 
                 // finish off previous entry
                 (*readinfo->finish_entry)();
@@ -974,28 +1144,13 @@ void DDF_MainReadFile(readinfo_t *readinfo, const std::string &data)
             DDF_WarnError("Badly formed command: Unexpected semicolon `;'\n");
             break;
 
-        case nothing:
-            break;
-
-        case ok_char:
-#if (DEBUG_DDFREAD)
-            charcount++;
-            I_Debugf("%c", character);
-            if (charcount == 75)
-            {
-                charcount = 0;
-                I_Debugf("\n");
-            }
-#endif
-            break;
-
         default:
             break;
         }
     }
 
     current_cmd.clear();
-    cur_ddf_linedata.clear();
+    cur_ddf_linedata = std::string_view();
 
     // -AJA- 1999/10/21: check for unclosed comments
     if (comment_level > 0)
@@ -1017,8 +1172,6 @@ void DDF_MainReadFile(readinfo_t *readinfo, const std::string &data)
     if (!firstgo)
         (*readinfo->finish_entry)();
 
-    delete[] memfile;
-
     cur_ddf_entryname.clear();
     cur_ddf_filename.clear();
 
@@ -1119,14 +1272,70 @@ void DDF_MainGetString(const char *info, void *storage)
 }
 
 //
-// DDF_MainParseField
+// Field lookup tables for DDF_MainParseField.
 //
-// Check if the command exists, and call the parser function if it
-// does (and return true), otherwise return false.
+// Each command list gets a table of its field names, normalised the same
+// way DDF_CompareName compares them (upper case, spaces and underscores
+// removed) and sorted for a binary search.  The tables are built the first
+// time a command list is used.  When a name occurs more than once, the
+// earliest entry is kept, same as a linear scan of the list would find.
 //
-bool DDF_MainParseField(const commandlist_t *commands, const char *field, const char *contents, uint8_t *obj_base)
+class field_lookup_c
 {
-    SYS_ASSERT(obj_base);
+  public:
+    // normalised name and index into the command list, sorted by name
+    std::vector<std::pair<std::string, int>> fields;
+
+    // indices of sub-field lists ("*" entries), in list order
+    std::vector<int> sub_lists;
+};
+
+static std::unordered_map<const commandlist_t *, field_lookup_c> field_lookups;
+
+static const char *DDF_MainCommandName(const commandlist_t *cmd)
+{
+    const char *name = cmd->name;
+
+    if (name[0] == '!')
+        name++;
+
+    if (name[0] == '*')
+        name++;
+
+    return name;
+}
+
+// returns false if the name does not fit into the buffer
+static bool DDF_MainNormaliseName(const char *name, char *buf, size_t buf_len)
+{
+    size_t len = 0;
+
+    for (; *name; name++)
+    {
+        if (*name == ' ' || *name == '_')
+            continue;
+
+        if (len + 1 >= buf_len)
+        {
+            buf[len] = 0;
+            return false;
+        }
+
+        buf[len++] = toupper(*name);
+    }
+
+    buf[len] = 0;
+    return true;
+}
+
+static const field_lookup_c &DDF_MainGetFieldLookup(const commandlist_t *commands)
+{
+    auto find = field_lookups.find(commands);
+
+    if (find != field_lookups.end())
+        return find->second;
+
+    field_lookup_c &lookup = field_lookups[commands];
 
     for (int i = 0; commands[i].name; i++)
     {
@@ -1135,36 +1344,100 @@ bool DDF_MainParseField(const commandlist_t *commands, const char *field, const
         if (name[0] == '!')
             name++;
 
-        // handle subfields
         if (name[0] == '*')
         {
-            name++;
+            SYS_ASSERT(name[1] != 0);
+            lookup.sub_lists.push_back(i);
+            continue;
+        }
 
-            int len = strlen(name);
-            SYS_ASSERT(len > 0);
+        char buf[256];
+        if (!DDF_MainNormaliseName(name, buf, sizeof(buf)))
+            I_Error("DDF: command name too long: %s\n", name);
 
-            if (strncmp(field, name, len) == 0 && field[len] == '.' && isalnum(field[len + 1]))
-            {
-                // recursively parse the sub-field
-                return DDF_MainParseField(commands[i].sub_comms, field + len + 1, contents,
-                                          obj_base + commands[i].offset);
-            }
+        lookup.fields.push_back({std::string(buf), i});
+    }
 
-            continue;
+    // sorting the pairs puts duplicate names in list order, so keep the first
+    std::sort(lookup.fields.begin(), lookup.fields.end());
+
+    auto last = std::unique(lookup.fields.begin(), lookup.fields.end(),
+                            [](const std::pair<std::string, int> &A, const std::pair<std::string, int> &B) {
+                                return A.first == B.first;
+                            });
+    lookup.fields.erase(last, lookup.fields.end());
+
+    return lookup;
+}
+
+//
+// DDF_MainParseField
+//
+// Check if the command exists, and call the parser function if it
+// does (and return true), otherwise return false.
+//
+bool DDF_MainParseField(const commandlist_t *commands, const char *field, const char *contents, uint8_t *obj_base)
+{
+    SYS_ASSERT(obj_base);
+
+    const field_lookup_c &lookup = DDF_MainGetFieldLookup(commands);
+
+    int  match  = -1;
+    bool is_sub = false;
+
+    // handle subfields
+    for (int i : lookup.sub_lists)
+    {
+        const char *name = DDF_MainCommandName(&commands[i]);
+
+        int len = strlen(name);
+
+        if (strncmp(field, name, len) == 0 && field[len] == '.' && isalnum(field[len + 1]))
+        {
+            match  = i;
+            is_sub = true;
+            break;
         }
+    }
 
-        if (DDF_CompareName(field, name) != 0)
-            continue;
+    char key[256];
+
+    // no command has a name that long, so it is treated as unknown
+    if (!DDF_MainNormaliseName(field, key, sizeof(key)))
+    {
+        DDF_Warning("Field name too long (%d characters): %.40s...\n", (int)strlen(field), field);
+        key[0] = 0;
+    }
 
-        // found it, so call parse routine
-        SYS_ASSERT(commands[i].parse_command);
+    auto pos = std::lower_bound(lookup.fields.begin(), lookup.fields.end(), key,
+                                [](const std::pair<std::string, int> &A, const char *B) {
+                                    return strcmp(A.first.c_str(), B) < 0;
+                                });
 
-        (*commands[i].parse_command)(contents, obj_base + commands[i].offset);
+    if (pos != lookup.fields.end() && pos->first == key && (match < 0 || pos->second < match))
+    {
+        match  = pos->second;
+        is_sub = false;
+    }
+
+    if (match < 0)
+        return false;
+
+    if (is_sub)
+    {
+        const char *name = DDF_MainCommandName(&commands[match]);
 
-        return true;
+        // recursively parse the sub-field
+        return DDF_MainParseField(commands[match].sub_comms, field + strlen(name) + 1, contents,
+                                  obj_base + commands[match].offset);
     }
 
-    return false;
+    // found it, so call parse routine
+    SYS_ASSERT(commands[match].parse_command);
+
+    (*commands[match].parse_command)(contents, obj_base + commands[match].offset);
+
+    return true;
 }
 
 void DDF_MainGetLumpName(const char *info, void *storage)
@@ -2104,6 +2377,13 @@ weakness_info_c &weakness_info_c::operator=(weakness_info_c &rhs)
 
 static ddf_collection_c unread_ddf;
 
+// set when unread_ddf came from a snapshot, new files are ignored then
+static bool snapshot_loaded = false;
+
+// set when the files being read should be stored into a new snapshot
+static bool             snapshot_capture = false;
+static ddf_collection_c snapshot_ddf;
+
 struct ddf_reader_t
 {
     ddf_type_e  type;
@@ -2171,6 +2451,13 @@ ddf_type_e DDF_FilenameToType(const std::string &path)
 
 void DDF_AddFile(ddf_type_e type, std::string &data, const std::string &source)
 {
+    // everything was already read from the snapshot
+    if (snapshot_loaded)
+    {
+        data.clear();
+        return;
+    }
+
     unread_ddf.files.push_back(ddf_file_c(type, source));
 
     // transfer the caller's data
@@ -2179,8 +2466,15 @@ void DDF_AddFile(ddf_type_e type, std::string &data, const std::string &source)
 
 void DDF_AddCollection(ddf_collection_c *col, const std::string &source)
 {
+    if (snapshot_loaded)
+        return;
+
     for (auto &it : col->files)
+    {
         DDF_AddFile(it.type, it.data, source);
+
+        unread_ddf.files.back().records.swap(it.records);
+    }
 }
 
 void DDF_DumpFile(const std::string &data)
@@ -2216,25 +2510,44 @@ void DDF_DumpCollection(ddf_collection_c *col)
 
 static void DDF_ParseUnreadFile(size_t d)
 {
-    for (auto &it : unread_ddf.files)
+    for (size_t f = 0; f < unread_ddf.files.size(); f++)
     {
+        ddf_file_c &it = unread_ddf.files[f];
+
         if (it.type == ddf_readers[d].type)
         {
             I_Printf("Parsing %s from: %s\n", ddf_readers[d].lump_name, it.source.c_str());
 
+            ddf_file_c *snap = snapshot_capture ? &snapshot_ddf.files[f] : NULL;
+
             if (it.type == DDF_RadScript)
             {
                 RAD_ReadScript(it.data, it.source);
+
+                if (snap)
+                    snap->data.swap(it.data);
             }
             else
             {
                 // FIXME store `source` in cur_ddf_filename (or so)
 
+                if (!it.records.empty())
+                    pending_records = &it.records;
+                else if (snap)
+                    capture_records = &snap->records;
+
                 (*ddf_readers[d].func)(it.data);
+
+                pending_records = NULL;
+                capture_records = NULL;
+
+                if (snap && !it.records.empty())
+                    snap->records.swap(it.records);
             }
 
             // can free the memory now
             it.data.clear();
+            it.records.clear();
         }
     }
 }
@@ -2245,8 +2558,307 @@ void DDF_ParseEverything()
     //       sense to load all lumps of a certain type together, for example
     //       all DDFSFX lumps before all the DDFTHING lumps.
 
+    if (snapshot_capture)
+    {
+        snapshot_ddf.files.clear();
+
+        for (auto &it : unread_ddf.files)
+            snapshot_ddf.files.push_back(ddf_file_c(it.type, it.source));
+    }
+
     for (size_t d = 0; d < DDF_NUM_TYPES; d++)
         DDF_ParseUnreadFile(d);
+
+    // files added from now on are read as normal
+    snapshot_loaded = false;
+}
+
+//----------------------------------------------------------------------------
+//  SNAPSHOTS
+//----------------------------------------------------------------------------
+//
+// A snapshot holds everything that DDF_ParseEverything() read in, with
+// DDF text already split into entries and commands (just like the output
+// of DEH_EDGE), so that the next run with the same set of files can skip
+// the DeHackEd conversion and the DDF text reader.  RTS scripts are kept
+// as text.  The parse callbacks of each DDF module are still run on the
+// stored commands, so changes to those do not affect the snapshot, but
+// it also means most of the time in DDF_ParseEverything() is not saved.
+// The caller provides a key (see W_LoadOrderKey) which must change
+// whenever any of the input files does.
+//
+
+#define DDF_SNAPSHOT_MAGIC "EDGEDDFS"
+
+// must be bumped whenever the layout changes, or the DDF text reader or
+// DEH_EDGE would produce different commands from the same input
+#define DDF_SNAPSHOT_VERSION 1
+
+static void DDF_CaptureStartEntry(const char *name, bool extend)
+{
+    std::string full_name(extend ? "++" : "");
+    full_name += name;
+
+    capture_records->push_back(ddf_record_c(true, full_name));
+
+    (*capture_readinfo->start_entry)(name, extend);
+}
+
+static void DDF_CaptureParseField(const char *field, const char *contents, int index, bool is_last)
+{
+    if (index == 0)
+        capture_records->push_back(ddf_record_c(false, field));
+
+    capture_records->back().values.push_back(contents);
+
+    (*capture_readinfo->parse_field)(field, contents, index, is_last);
+}
+
+static void DDF_CaptureClearAll(void)
+{
+    // cannot be stored in a snapshot, so don't make one
+    I_Debugf("DDF snapshot: not saved, #CLEARALL was used\n");
+
+    snapshot_capture = false;
+
+    (*capture_readinfo->clear_all)();
+}
+
+static void DDF_SnapshotPutU32(std::string &buf, uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+        buf += (char)((value >> (i * 8)) & 0xFF);
+}
+
+static void DDF_SnapshotPutString(std::string &buf, const std::string &str)
+{
+    DDF_SnapshotPutU32(buf, (uint32_t)str.size());
+
+    buf += str;
+}
+
+class snapshot_reader_c
+{
+  private:
+    const uint8_t *pos;
+    const uint8_t *end;
+
+  public:
+    // set when reading past the end of the data
+    bool failed;
+
+  public:
+    snapshot_reader_c(const uint8_t *data, int length) : pos(data), end(data + length), failed(false)
+    {
+    }
+
+    ~snapshot_reader_c()
+    {
+    }
+
+    uint32_t GetU32()
+    {
+        if (end - pos < 4)
+        {
+            failed = true;
+            return 0;
+        }
+
+        uint32_t value = (uint32_t)pos[0] | ((uint32_t)pos[1] << 8) | ((uint32_t)pos[2] << 16) | ((uint32_t)pos[3] << 24);
+
+        pos += 4;
+        return value;
+    }
+
+    std::string GetString()
+    {
+        uint32_t len = GetU32();
+
+        if (failed || (uint32_t)(end - pos) < len)
+        {
+            failed = true;
+            return std::string();
+        }
+
+        std::string str((const char *)pos, len);
+
+        pos += len;
+        return str;
+    }
+
+    size_t Remaining() const
+    {
+        return end - pos;
+    }
+
+    bool AtEnd() const
+    {
+        return pos == end;
+    }
+};
+
+static bool DDF_DecodeSnapshot(const uint8_t *data, int length, uint32_t key, ddf_collection_c *col)
+{
+    const size_t magic_len = strlen(DDF_SNAPSHOT_MAGIC);
+
+    if (length < (int)magic_len || memcmp(data, DDF_SNAPSHOT_MAGIC, magic_len) != 0)
+        return false;
+
+    snapshot_reader_c reader(data + magic_len, length - (int)magic_len);
+
+    if (reader.GetU32() != DDF_SNAPSHOT_VERSION || reader.GetU32() != key)
+        return false;
+
+    uint32_t num_files = reader.GetU32();
+
+    for (uint32_t f = 0; f < num_files && !reader.failed; f++)
+    {
+        uint32_t type = reader.GetU32();
+
+        if (type >= DDF_NUM_TYPES)
+            return false;
+
+        col->files.push_back(ddf_file_c((ddf_type_e)type, reader.GetString()));
+
+        ddf_file_c &file = col->files.back();
+
+        file.data = reader.GetString();
+
+        uint32_t num_records = reader.GetU32();
+
+        // every record takes at least 12 bytes
+        if (reader.failed || num_records > reader.Remaining() / 12)
+            return false;
+
+        file.records.reserve(num_records);
+
+        for (uint32_t r = 0; r < num_records && !reader.failed; r++)
+        {
+            bool is_entry = (reader.GetU32() != 0);
+
+            file.records.push_back(ddf_record_c(is_entry, reader.GetString()));
+
+            std::vector<std::string> &values = file.records.back().values;
+
+            uint32_t num_values = reader.GetU32();
+
+            // every value takes at least 4 bytes
+            if (reader.failed || num_values > reader.Remaining() / 4)
+                return false;
+
+            values.reserve(num_values);
+
+            for (uint32_t v = 0; v < num_values && !reader.failed; v++)
+                values.push_back(reader.GetString());
+        }
+    }
+
+    return !reader.failed && reader.AtEnd();
+}
+
+//
+// DDF_LoadSnapshot
+//
+// Called before any files are added.  When the snapshot matches the
+// key, its contents replace the files which would have been added, and
+// true is returned.  Otherwise what DDF_ParseEverything() reads will be
+// kept for DDF_SaveSnapshot().
+//
+bool DDF_LoadSnapshot(const std::string &filename, uint32_t key)
+{
+    snapshot_capture = true;
+
+    epi::File *F = epi::FileOpen(filename, epi::kFileAccessRead | epi::kFileAccessBinary);
+    if (F == NULL)
+        return false;
+
+    int      length = F->GetLength();
+    uint8_t *data   = F->LoadIntoMemory();
+
+    delete F;
+
+    if (data == NULL)
+        return false;
+
+    ddf_collection_c col;
+
+    bool ok = DDF_DecodeSnapshot(data, length, key, &col);
+
+    delete[] data;
+
+    if (!ok)
+    {
+        I_Debugf("DDF snapshot: %s is out of date\n", filename.c_str());
+        return false;
+    }
+
+    I_Printf("Using DDF snapshot: %s\n", filename.c_str());
+
+    unread_ddf.files.swap(col.files);
+
+    snapshot_loaded  = true;
+    snapshot_capture = false;
+
+    return true;
+}
+
+bool DDF_SnapshotLoaded()
+{
+    return snapshot_loaded;
+}
+
+void DDF_SaveSnapshot(const std::string &filename, uint32_t key)
+{
+    if (!snapshot_capture)
+        return;
+
+    snapshot_capture = false;
+
+    std::string buf(DDF_SNAPSHOT_MAGIC);
+
+    DDF_SnapshotPutU32(buf, DDF_SNAPSHOT_VERSION);
+    DDF_SnapshotPutU32(buf, key);
+    DDF_SnapshotPutU32(buf, (uint32_t)snapshot_ddf.files.size());
+
+    for (auto &file : snapshot_ddf.files)
+    {
+        DDF_SnapshotPutU32(buf, (uint32_t)file.type);
+        DDF_SnapshotPutString(buf, file.source);
+        DDF_SnapshotPutString(buf, file.data);
+        DDF_SnapshotPutU32(buf, (uint32_t)file.records.size());
+
+        for (auto &rec : file.records)
+        {
+            DDF_SnapshotPutU32(buf, rec.is_entry ? 1 : 0);
+            DDF_SnapshotPutString(buf, rec.name);
+            DDF_SnapshotPutU32(buf, (uint32_t)rec.values.size());
+
+            for (auto &value : rec.values)
+                DDF_SnapshotPutString(buf, value);
+        }
+    }
+
+    snapshot_ddf.files.clear();
+
+    epi::File *F = epi::FileOpen(filename, epi::kFileAccessWrite | epi::kFileAccessBinary);
+    if (F == NULL)
+    {
+        I_Warning("Unable to write DDF snapshot: %s\n", filename.c_str());
+        return;
+    }
+
+    bool ok = (F->Write(buf.data(), buf.size()) == buf.size());
+
+    delete F;
+
+    if (!ok)
+    {
+        I_Warning("Unable to write DDF snapshot: %s\n", filename.c_str());
+        epi::FileDelete(filename);
+        return;
+    }
+
+    I_Debugf("DDF snapshot: saved %s (%d bytes)\n", filename.c_str(), (int)buf.size());
 }
 
 //--- editor settings ---
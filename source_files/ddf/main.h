@@ -165,6 +165,10 @@ void DDF_AddFile(ddf_type_e type, std::string &data, const std::string &source);
 void DDF_AddCollection(ddf_collection_c *col, const std::string &source);
 void DDF_ParseEverything();
 
+bool DDF_LoadSnapshot(const std::string &filename, uint32_t key);
+void DDF_SaveSnapshot(const std::string &filename, uint32_t key);
+bool DDF_SnapshotLoaded();
+
 void DDF_DumpFile(const std::string &data);
 void DDF_DumpCollection(ddf_collection_c *col);
 
@@ -42,6 +42,7 @@ static const commandlist_t sfx_commands[] = {
     DDF_FIELD("LOOP", looping, DDF_MainGetBoolean),
     DDF_FIELD("PRECIOUS", precious, DDF_MainGetBoolean),
     DDF_FIELD("MAX_DISTANCE", max_distance, DDF_MainGetFloat),
+    DDF_FIELD("STREAM", streamed, DDF_MainGetBoolean),
 
     DDF_CMD_END};
 
@@ -206,6 +207,7 @@ void sfxdef_c::CopyDetail(sfxdef_c &src)
     looping      = src.looping;      // looping
     precious     = src.precious;     // precious
     max_distance = src.max_distance; // max_distance
+    streamed     = src.streamed;     // streamed
 }
 
 //
@@ -227,6 +229,7 @@ void sfxdef_c::Default()
     looping      = false;             // looping
     precious     = false;             // precious
     max_distance = S_CLIPPING_DIST;   // max_distance
+    streamed     = false;             // streamed
 }
 
 // --> Sound Effect Definition Containter Class
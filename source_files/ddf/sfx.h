@@ -88,6 +88,10 @@ class sfxdef_c
     // then the this sound won't be played at all.
     float max_distance;
 
+    // keep the sound compressed and decode it while playing (long
+    // sounds are streamed anyway)
+    bool streamed;
+
   private:
     // disable copy construct and assignment operator
     explicit sfxdef_c(sfxdef_c &rhs)
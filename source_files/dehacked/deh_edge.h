@@ -73,6 +73,10 @@ const char *DehEdgeGetError(void);
 // set quiet mode (disables warnings).
 dehret_e DehEdgeSetQuiet(int quiet);
 
+// keep the DDF text of the converted lumps (normally only the parsed
+// entries are produced).  Only useful for debugging.
+dehret_e DehEdgeSetKeepText(int keep);
+
 // add a single patch file (possibly from a WAD lump).
 dehret_e DehEdgeAddLump(const char *data, int length);
 
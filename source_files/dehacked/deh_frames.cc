@@ -795,7 +795,7 @@ void Frames::UpdateAttacks(char group, char *act_name, int action)
         return;
     }
 
-    WAD::Printf("    // Specialising %s\n", act_name);
+    WAD::Comment("Specialising %s", act_name);
 
     // do some magic to put the attack name into parenthesis,
     // for example RANGE_ATTACK(IMP_FIREBALL).
@@ -1097,15 +1097,15 @@ void Frames::OutputState(char group, int cur, bool do_action)
     // need to add an A_Fall action for proper operation in EDGE.
     if (action_info[action].act_flags & AF_MAKEDEAD)
     {
-        WAD::Printf("    %s:%c:0:%s:MAKEDEAD,  // %s\n", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
-                    (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL",
-                    (action == A_PainDie) ? "A_PainDie" : "A_KeenDie");
+        WAD::AddValue("%s:%c:0:%s:MAKEDEAD", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
+                      (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
+        WAD::Comment("%s", (action == A_PainDie) ? "A_PainDie" : "A_KeenDie");
     }
 
     if (action_info[action].act_flags & AF_FACE)
     {
-        WAD::Printf("    %s:%c:0:%s:FACE_TARGET,\n", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
-                    (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
+        WAD::AddValue("%s:%c:0:%s:FACE_TARGET", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
+                      (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
     }
 
     // special handling for Mancubus attacks...
@@ -1113,12 +1113,13 @@ void Frames::OutputState(char group, int cur, bool do_action)
     {
         if ((act_flags & AF_SPREAD) == 0)
         {
-            WAD::Printf("    %s:%c:0:%s:RESET_SPREADER,\n", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
-                        (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
+            WAD::AddValue("%s:%c:0:%s:RESET_SPREADER", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
+                          (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
         }
 
-        WAD::Printf("    %s:%c:0:%s:%s,  // A_FatAttack\n", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
-                    (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL", act_name);
+        WAD::AddValue("%s:%c:0:%s:%s", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
+                      (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL", act_name);
+        WAD::Comment("A_FatAttack");
     }
 
     // special handling for A_CloseShotgun2
@@ -1127,8 +1128,8 @@ void Frames::OutputState(char group, int cur, bool do_action)
     // even with the refire noises (ex: Harmony re-release chaingun will constantly play its wind-down noise)
     if (StrCaseCmp(action_info[action].bex_name, "A_CloseShotgun2") == 0)
     {
-        WAD::Printf("    %s:%c:0:%s:REFIRE,\n", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
-                    (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
+        WAD::AddValue("%s:%c:0:%s:REFIRE", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31),
+                      (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL");
     }
 
     int tics = (int)st->tics;
@@ -1139,8 +1140,8 @@ void Frames::OutputState(char group, int cur, bool do_action)
     if (tics >= 0 && tics < 44 && StrCaseCmp(act_name, "BRAINDIE") == 0)
         tics = 44;
 
-    WAD::Printf("    %s:%c:%d:%s:%s", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31), tics,
-                (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL", act_name);
+    WAD::AddValue("%s:%c:%d:%s:%s", Sprites::GetSprite(st->sprite), 'A' + ((int)st->frame & 31), tics,
+                  (st->frame >= 32768 || force_fullbright) ? "BRIGHT" : "NORMAL", act_name);
 
     if (action != A_NULL && weap_act == !IS_WEAPON(group))
         return;
@@ -1153,7 +1154,7 @@ bool Frames::OutputSpawnState(int first)
     // returns true if no IDLE states will be needed
 
     WAD::Printf("\n");
-    WAD::Printf("STATES(SPAWN) =\n");
+    WAD::BeginField("STATES(SPAWN)");
 
     const state_t *st = NewStateElseOld(first);
     if (st == NULL)
@@ -1166,17 +1167,19 @@ bool Frames::OutputSpawnState(int first)
     if (st->tics < 0)
     {
         // goes into hibernation
-        WAD::Printf(";\n");
+        WAD::EndField();
         return true;
     }
     else if (next == S_NULL)
     {
-        WAD::Printf(",#REMOVE;\n");
+        WAD::AddValue("#REMOVE");
+        WAD::EndField();
         return true;
     }
     else
     {
-        WAD::Printf(",#%s;\n", RedirectorName(next));
+        WAD::AddValue("#%s", RedirectorName(next));
+        WAD::EndField();
         return false;
     }
 }
@@ -1200,7 +1203,7 @@ void Frames::OutputGroup(char group)
     }
 
     WAD::Printf("\n");
-    WAD::Printf("STATES(%s) =\n", GroupToName(group));
+    WAD::BeginField("STATES(%s)", GroupToName(group));
 
     for (size_t i = 0; i < G.states.size(); i++)
     {
@@ -1220,20 +1223,18 @@ void Frames::OutputGroup(char group)
         }
         else if (next == S_NULL)
         {
-            WAD::Printf(",#REMOVE");
+            WAD::AddValue("#REMOVE");
         }
         else if (is_last || next != G.states[i + 1])
         {
-            WAD::Printf(",#%s", RedirectorName(next));
+            WAD::AddValue("#%s", RedirectorName(next));
         }
 
         if (is_last)
         {
-            WAD::Printf(";\n");
+            WAD::EndField();
             return;
         }
-
-        WAD::Printf(",\n");
     }
 }
 
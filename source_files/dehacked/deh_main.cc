@@ -168,6 +168,13 @@ dehret_e DehEdgeSetQuiet(int quiet)
     return DEH_OK;
 }
 
+dehret_e DehEdgeSetKeepText(int keep)
+{
+    Deh_Edge::WAD::keep_text = (keep != 0);
+
+    return DEH_OK;
+}
+
 dehret_e DehEdgeAddLump(const char *data, int length)
 {
     auto buf = new Deh_Edge::input_buffer_c(data, length);
@@ -188,5 +195,6 @@ void DehEdgeShutdown(void)
 {
     Deh_Edge::Shutdown();
     Deh_Edge::WAD::dest_container = NULL;
+    Deh_Edge::WAD::keep_text      = false;
     Deh_Edge::cur_funcs           = NULL;
 }
@@ -209,8 +209,8 @@ void Music::WriteEntry(int num)
     const musicinfo_t *mod = S_music[num];
 
     WAD::Printf("\n");
-    WAD::Printf("[%02d] ", mod->ddf_num);
-    WAD::Printf("MUSICINFO = MUS:LUMP:\"D_%s\";\n", StrUpper(mod->name));
+    WAD::Entry("%02d", mod->ddf_num);
+    WAD::Field("MUSICINFO", "MUS:LUMP:\"D_%s\"", StrUpper(mod->name));
 }
 
 void Music::ConvertMUS()
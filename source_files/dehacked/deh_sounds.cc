@@ -29,6 +29,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <string>
+
 #include "deh_i_defs.h"
 #include "deh_edge.h"
 
@@ -462,7 +464,7 @@ void Sounds::WriteSound(int sound_id)
     if (ddf_name == NULL)
         I_Error("Dehacked: Error - No DDF name for sound %d ??\n", sound_id);
 
-    WAD::Printf("[%s]\n", ddf_name);
+    WAD::Entry("%s", ddf_name);
 
     // only one sound has a `link` field in standard DOOM.
     // we emulate that here.
@@ -477,14 +479,17 @@ void Sounds::WriteSound(int sound_id)
             lump = link->name;
     }
 
-    WAD::Printf("LUMP_NAME = \"DS%s\";\n", StrUpper(lump));
-    WAD::Printf("PRIORITY = %d;\n", sound->priority);
+    std::string lump_name("DS");
+    lump_name += StrUpper(lump);
+
+    WAD::StringField("LUMP_NAME", lump_name.c_str());
+    WAD::Field("PRIORITY", "%d", sound->priority);
 
     if (sound->singularity != 0)
-        WAD::Printf("SINGULAR = %d;\n", sound->singularity);
+        WAD::Field("SINGULAR", "%d", sound->singularity);
 
     if (sound_id == sfx_stnmov)
-        WAD::Printf("LOOP = TRUE;\n");
+        WAD::Field("LOOP", "TRUE");
 
     WAD::Printf("\n");
 }
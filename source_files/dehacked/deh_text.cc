@@ -589,7 +589,7 @@ void TextStr::BeginTextLump()
     WAD::NewLump(DDF_Language);
 
     WAD::Printf("<LANGUAGES>\n\n");
-    WAD::Printf("[ENGLISH]\n");
+    WAD::Entry("ENGLISH");
 }
 
 void TextStr::FinishTextLump()
@@ -605,29 +605,10 @@ void TextStr::WriteTextString(const langinfo_t *info)
         BeginTextLump();
     }
 
-    WAD::Printf("%s = \"", info->ldf_name);
-
     const char *str = info->new_text ? info->new_text : info->orig_text;
 
-    for (; *str; str++)
-    {
-        if (*str == '\n')
-        {
-            WAD::Printf("\\n\"\n  \"");
-            continue;
-        }
-
-        if (*str == '"')
-        {
-            WAD::Printf("\\\"");
-            continue;
-        }
-
-        // XXX may need special handling for non-english chars
-        WAD::Printf("%c", *str);
-    }
-
-    WAD::Printf("\";\n");
+    // XXX may need special handling for non-english chars
+    WAD::StringField(info->ldf_name, str);
 }
 
 const char *TextStr::GetLDFForBex(const char *bex_name)
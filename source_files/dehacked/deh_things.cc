@@ -159,22 +159,22 @@ const attackextra_t attack_extra[] = {{MT_FIRE, "TRACKER", 0, 75, "FS"},
 void HandleSounds(const mobjinfo_t *info, int mt_num)
 {
     if (info->seesound != sfx_None)
-        WAD::Printf("LAUNCH_SOUND = \"%s\";\n", Sounds::GetSound(info->seesound));
+        WAD::StringField("LAUNCH_SOUND", Sounds::GetSound(info->seesound));
 
     if (info->deathsound != sfx_None)
-        WAD::Printf("DEATH_SOUND = \"%s\";\n", Sounds::GetSound(info->deathsound));
+        WAD::StringField("DEATH_SOUND", Sounds::GetSound(info->deathsound));
 
     if (info->rip_sound != sfx_None)
-        WAD::Printf("RIP_SOUND = \"%s\";\n", Sounds::GetSound(info->rip_sound));
+        WAD::StringField("RIP_SOUND", Sounds::GetSound(info->rip_sound));
 
     if (mt_num == MT_FIRE)
     {
-        WAD::Printf("ATTEMPT_SOUND = \"%s\";\n", Sounds::GetSound(sfx_vilatk));
-        WAD::Printf("ENGAGED_SOUND = \"%s\";\n", Sounds::GetSound(sfx_barexp));
+        WAD::StringField("ATTEMPT_SOUND", Sounds::GetSound(sfx_vilatk));
+        WAD::StringField("ENGAGED_SOUND", Sounds::GetSound(sfx_barexp));
     }
 
     if (mt_num == MT_FATSHOT)
-        WAD::Printf("ATTEMPT_SOUND = \"%s\";\n", Sounds::GetSound(sfx_manatk));
+        WAD::StringField("ATTEMPT_SOUND", Sounds::GetSound(sfx_manatk));
 }
 
 void HandleFrames(const mobjinfo_t *info, int mt_num)
@@ -247,12 +247,10 @@ void AddAtkSpecial(const char *name)
     if (!flag_got_one)
     {
         flag_got_one = true;
-        WAD::Printf("ATTACK_SPECIAL = ");
+        WAD::BeginField("ATTACK_SPECIAL");
     }
-    else
-        WAD::Printf(",");
 
-    WAD::Printf("%s", name);
+    WAD::AddValue("%s", name);
 }
 
 void HandleAtkSpecials(const mobjinfo_t *info, int mt_num, const attackextra_t *ext, bool plr_rocket)
@@ -272,7 +270,7 @@ void HandleAtkSpecials(const mobjinfo_t *info, int mt_num, const attackextra_t *
         AddAtkSpecial("SMOKING_TRACER");
 
     if (flag_got_one)
-        WAD::Printf(";\n");
+        WAD::EndField();
 }
 
 void CheckPainElemental(void)
@@ -306,22 +304,28 @@ void CheckPainElemental(void)
     else
         spawn_at = "IDLE:1";
 
-    WAD::Printf("[ELEMENTAL_SPAWNER]\n");
-    WAD::Printf("ATTACKTYPE = SPAWNER;\n");
-    WAD::Printf("ATTACK_HEIGHT = 8;\n");
-    WAD::Printf("ATTACK_SPECIAL = PRESTEP_SPAWN,FACE_TARGET;\n");
-    WAD::Printf("SPAWNED_OBJECT = LOST_SOUL;\n");
-    WAD::Printf("SPAWN_OBJECT_STATE = %s;\n", spawn_at);
+    WAD::Entry("ELEMENTAL_SPAWNER");
+    WAD::Field("ATTACKTYPE", "SPAWNER");
+    WAD::Field("ATTACK_HEIGHT", "8");
+    WAD::BeginField("ATTACK_SPECIAL");
+    WAD::AddValue("PRESTEP_SPAWN");
+    WAD::AddValue("FACE_TARGET");
+    WAD::EndField();
+    WAD::Field("SPAWNED_OBJECT", "LOST_SOUL");
+    WAD::Field("SPAWN_OBJECT_STATE", "%s", spawn_at);
 
-    WAD::Printf("SPAWN_LIMIT = 21;\n");
+    WAD::Field("SPAWN_LIMIT", "21");
 
     WAD::Printf("\n");
-    WAD::Printf("[ELEMENTAL_DEATHSPAWN]\n");
-    WAD::Printf("ATTACKTYPE = TRIPLE_SPAWNER;\n");
-    WAD::Printf("ATTACK_HEIGHT = 8;\n");
-    WAD::Printf("ATTACK_SPECIAL = PRESTEP_SPAWN,FACE_TARGET;\n");
-    WAD::Printf("SPAWNED_OBJECT = LOST_SOUL;\n");
-    WAD::Printf("SPAWN_OBJECT_STATE = %s;\n", spawn_at);
+    WAD::Entry("ELEMENTAL_DEATHSPAWN");
+    WAD::Field("ATTACKTYPE", "TRIPLE_SPAWNER");
+    WAD::Field("ATTACK_HEIGHT", "8");
+    WAD::BeginField("ATTACK_SPECIAL");
+    WAD::AddValue("PRESTEP_SPAWN");
+    WAD::AddValue("FACE_TARGET");
+    WAD::EndField();
+    WAD::Field("SPAWNED_OBJECT", "LOST_SOUL");
+    WAD::Field("SPAWN_OBJECT_STATE", "%s", spawn_at);
 }
 
 void ConvertAttack(const mobjinfo_t *info, int mt_num, bool plr_rocket);
@@ -358,17 +362,17 @@ void Attacks::ConvertScratch(const scratch_atk_c *atk)
         BeginLump();
     }
 
-    WAD::Printf("[%s]\n", atk->fullname.c_str());
+    WAD::Entry("%s", atk->fullname.c_str());
 
-    WAD::Printf("ATTACKTYPE=CLOSECOMBAT;\n");
-    WAD::Printf("DAMAGE.VAL=%d;\n", atk->damage);
-    WAD::Printf("DAMAGE.MAX=%d;\n", atk->damage);
-    WAD::Printf("ATTACKRANGE=80;\n");
-    WAD::Printf("ATTACK_SPECIAL=FACE_TARGET;\n");
+    WAD::Field("ATTACKTYPE", "CLOSECOMBAT");
+    WAD::Field("DAMAGE.VAL", "%d", atk->damage);
+    WAD::Field("DAMAGE.MAX", "%d", atk->damage);
+    WAD::Field("ATTACKRANGE", "80");
+    WAD::Field("ATTACK_SPECIAL", "FACE_TARGET");
 
     if (atk->sfx != "")
     {
-        WAD::Printf("ENGAGED_SOUND=%s;\n", atk->sfx.c_str());
+        WAD::Field("ENGAGED_SOUND", "%s", atk->sfx.c_str());
     }
 
     WAD::Printf("\n");
@@ -390,9 +394,9 @@ void Attacks::ConvertAttack(const mobjinfo_t *info, int mt_num, bool plr_rocket)
     }
 
     if (plr_rocket)
-        WAD::Printf("[%s]\n", "PLAYER_MISSILE");
+        WAD::Entry("%s", "PLAYER_MISSILE");
     else
-        WAD::Printf("[%s]\n", Things::GetMobjName(mt_num) + 1);
+        WAD::Entry("%s", Things::GetMobjName(mt_num) + 1);
 
     // find attack in the extra table...
     const attackextra_t *ext = NULL;
@@ -407,67 +411,67 @@ void Attacks::ConvertAttack(const mobjinfo_t *info, int mt_num, bool plr_rocket)
     if (!ext)
         I_Error("Dehacked: Error - Missing attack %s in extra table.\n", Things::GetMobjName(mt_num) + 1);
 
-    WAD::Printf("ATTACKTYPE = %s;\n", ext->atk_type);
+    WAD::Field("ATTACKTYPE", "%s", ext->atk_type);
 
-    WAD::Printf("RADIUS = %1.1f;\n", F_FIXED(info->radius));
-    WAD::Printf("HEIGHT = %1.1f;\n", F_FIXED(info->height));
+    WAD::Field("RADIUS", "%1.1f", F_FIXED(info->radius));
+    WAD::Field("HEIGHT", "%1.1f", F_FIXED(info->height));
 
     if (info->spawnhealth != 1000)
-        WAD::Printf("SPAWNHEALTH = %d;\n", info->spawnhealth);
+        WAD::Field("SPAWNHEALTH", "%d", info->spawnhealth);
 
     if (info->speed != 0)
-        WAD::Printf("SPEED = %s;\n", Things::GetSpeed(info->speed));
+        WAD::Field("SPEED", "%s", Things::GetSpeed(info->speed));
 
     if (info->mass != 100)
-        WAD::Printf("MASS = %d;\n", info->mass);
+        WAD::Field("MASS", "%d", info->mass);
 
     if (mt_num == MT_BRUISERSHOT)
-        WAD::Printf("FAST = 1.4;\n");
+        WAD::Field("FAST", "1.4");
     else if (mt_num == MT_TROOPSHOT || mt_num == MT_HEADSHOT)
-        WAD::Printf("FAST = 2.0;\n");
+        WAD::Field("FAST", "2.0");
 
     if (plr_rocket)
-        WAD::Printf("ATTACK_HEIGHT = 32;\n");
+        WAD::Field("ATTACK_HEIGHT", "32");
     else if (ext->atk_height != 0)
-        WAD::Printf("ATTACK_HEIGHT = %d;\n", ext->atk_height);
+        WAD::Field("ATTACK_HEIGHT", "%d", ext->atk_height);
 
     if (mt_num == MT_FIRE)
     {
-        WAD::Printf("DAMAGE.VAL = 20;\n");
-        WAD::Printf("EXPLODE_DAMAGE.VAL = 70;\n");
+        WAD::Field("DAMAGE.VAL", "20");
+        WAD::Field("EXPLODE_DAMAGE.VAL", "70");
     }
     else if (mt_num == MT_EXTRABFG)
     {
-        WAD::Printf("DAMAGE.VAL   = 65;\n");
-        WAD::Printf("DAMAGE.ERROR = 50;\n");
+        WAD::Field("DAMAGE.VAL", "65");
+        WAD::Field("DAMAGE.ERROR", "50");
     }
     else if (info->damage > 0)
     {
-        WAD::Printf("DAMAGE.VAL = %d;\n", info->damage);
-        WAD::Printf("DAMAGE.MAX = %d;\n", info->damage * 8);
+        WAD::Field("DAMAGE.VAL", "%d", info->damage);
+        WAD::Field("DAMAGE.MAX", "%d", info->damage * 8);
     }
 
     if (mt_num == MT_BFG)
-        WAD::Printf("SPARE_ATTACK = BFG9000_SPRAY;\n");
+        WAD::Field("SPARE_ATTACK", "BFG9000_SPRAY");
 
     if (ext->translucency != 100)
-        WAD::Printf("TRANSLUCENCY = %d%%;\n", ext->translucency);
+        WAD::Field("TRANSLUCENCY", "%d%%", ext->translucency);
 
     if (strchr(ext->flags, KF_PUFF_SMK))
-        WAD::Printf("PUFF = SMOKE;\n");
+        WAD::Field("PUFF", "SMOKE");
 
     if (strchr(ext->flags, KF_TOO_CLOSE))
-        WAD::Printf("TOO_CLOSE_RANGE = 196;\n");
+        WAD::Field("TOO_CLOSE_RANGE", "196");
 
     if (strchr(ext->flags, KF_NO_TRACE))
     {
-        WAD::Printf("NO_TRACE_CHANCE = 50%%;\n");
+        WAD::Field("NO_TRACE_CHANCE", "50%%");
 
-        WAD::Printf("TRACE_ANGLE = 9;\n");
+        WAD::Field("TRACE_ANGLE", "9");
     }
 
     if (strchr(ext->flags, KF_KEEP_FIRE))
-        WAD::Printf("KEEP_FIRING_CHANCE = 4%%;\n");
+        WAD::Field("KEEP_FIRING_CHANCE", "4%%");
 
     HandleAtkSpecials(info, mt_num, ext, plr_rocket);
     HandleSounds(info, mt_num);
@@ -484,9 +488,9 @@ void Attacks::ConvertAttack(const mobjinfo_t *info, int mt_num, bool plr_rocket)
     }
 
     if (Frames::act_flags & AF_EXPLODE)
-        WAD::Printf("EXPLODE_DAMAGE.VAL = 128;\n");
+        WAD::Field("EXPLODE_DAMAGE.VAL", "128");
     else if (Frames::act_flags & AF_DETONATE)
-        WAD::Printf("EXPLODE_DAMAGE.VAL = %d;\n", info->damage);
+        WAD::Field("EXPLODE_DAMAGE.VAL", "%d", info->damage);
 
     WAD::Printf("\n");
 }
@@ -942,14 +946,12 @@ void AddOneFlag(const mobjinfo_t *info, const char *name, bool &got_a_flag)
         got_a_flag = true;
 
         if (info->name[0] == '*')
-            WAD::Printf("PROJECTILE_SPECIAL = ");
+            WAD::BeginField("PROJECTILE_SPECIAL");
         else
-            WAD::Printf("SPECIAL = ");
+            WAD::BeginField("SPECIAL");
     }
-    else
-        WAD::Printf(",");
 
-    WAD::Printf("%s", name);
+    WAD::AddValue("%s", name);
 }
 
 void HandleFlags(const mobjinfo_t *info, int mt_num, int player)
@@ -1026,26 +1028,26 @@ void HandleFlags(const mobjinfo_t *info, int mt_num, int player)
     AddOneFlag(info, "DEHACKED_COMPAT", got_a_flag);
 
     if (got_a_flag)
-        WAD::Printf(";\n");
+        WAD::EndField();
 
     if (cur_f & MF_TRANSLATION)
     {
         if ((cur_f & MF_TRANSLATION) == 0x4000000)
-            WAD::Printf("PALETTE_REMAP = PLAYER_DK_GREY;\n");
+            WAD::Field("PALETTE_REMAP", "PLAYER_DK_GREY");
         else if ((cur_f & MF_TRANSLATION) == 0x8000000)
-            WAD::Printf("PALETTE_REMAP = PLAYER_BROWN;\n");
+            WAD::Field("PALETTE_REMAP", "PLAYER_BROWN");
         else
-            WAD::Printf("PALETTE_REMAP = PLAYER_DULL_RED;\n");
+            WAD::Field("PALETTE_REMAP", "PLAYER_DULL_RED");
     }
 
     if (cur_f & MF_TRANSLUCENT)
     {
-        WAD::Printf("TRANSLUCENCY = 50%%;\n");
+        WAD::Field("TRANSLUCENCY", "50%%");
     }
 
     if ((cur_f & MF_FRIEND) && !player)
     {
-        WAD::Printf("SIDE = 16777215;\n");
+        WAD::Field("SIDE", "16777215");
     }
 }
 
@@ -1176,31 +1178,31 @@ void HandleSounds(const mobjinfo_t *info, int mt_num)
     if (info->activesound != sfx_None)
     {
         if (info->flags & MF_PICKUP)
-            WAD::Printf("PICKUP_SOUND = \"%s\";\n", Sounds::GetSound(info->activesound));
+            WAD::StringField("PICKUP_SOUND", Sounds::GetSound(info->activesound));
         else
-            WAD::Printf("ACTIVE_SOUND = \"%s\";\n", Sounds::GetSound(info->activesound));
+            WAD::StringField("ACTIVE_SOUND", Sounds::GetSound(info->activesound));
     }
     else if (mt_num == MT_TELEPORTMAN)
-        WAD::Printf("ACTIVE_SOUND = \"%s\";\n", Sounds::GetSound(sfx_telept));
+        WAD::StringField("ACTIVE_SOUND", Sounds::GetSound(sfx_telept));
 
     if (info->seesound != sfx_None)
-        WAD::Printf("SIGHTING_SOUND = \"%s\";\n", Sounds::GetSound(info->seesound));
+        WAD::StringField("SIGHTING_SOUND", Sounds::GetSound(info->seesound));
     else if (mt_num == MT_BOSSSPIT)
-        WAD::Printf("SIGHTING_SOUND = \"%s\";\n", Sounds::GetSound(sfx_bossit));
+        WAD::StringField("SIGHTING_SOUND", Sounds::GetSound(sfx_bossit));
 
     if (info->attacksound != sfx_None && info->meleestate != S_NULL)
     {
-        WAD::Printf("STARTCOMBAT_SOUND = \"%s\";\n", Sounds::GetSound(info->attacksound));
+        WAD::StringField("STARTCOMBAT_SOUND", Sounds::GetSound(info->attacksound));
     }
 
     if (info->painsound != sfx_None)
-        WAD::Printf("PAIN_SOUND = \"%s\";\n", Sounds::GetSound(info->painsound));
+        WAD::StringField("PAIN_SOUND", Sounds::GetSound(info->painsound));
 
     if (info->deathsound != sfx_None)
-        WAD::Printf("DEATH_SOUND = \"%s\";\n", Sounds::GetSound(info->deathsound));
+        WAD::StringField("DEATH_SOUND", Sounds::GetSound(info->deathsound));
 
     if (info->rip_sound != sfx_None)
-        WAD::Printf("RIP_SOUND = \"%s\";\n", Sounds::GetSound(info->rip_sound));
+        WAD::StringField("RIP_SOUND", Sounds::GetSound(info->rip_sound));
 }
 
 void HandleFrames(const mobjinfo_t *info, int mt_num)
@@ -1211,9 +1213,9 @@ void HandleFrames(const mobjinfo_t *info, int mt_num)
 
     if (mt_num == MT_TELEPORTMAN)
     {
-        WAD::Printf("TRANSLUCENCY = 50%%;\n");
+        WAD::Field("TRANSLUCENCY", "50%%");
         WAD::Printf("\n");
-        WAD::Printf("STATES(IDLE) = %s:A:-1:NORMAL:TRANS_SET(0%%);\n", Sprites::GetSprite(SPR_TFOG));
+        WAD::Field("STATES(IDLE)", "%s:A:-1:NORMAL:TRANS_SET(0%%)", Sprites::GetSprite(SPR_TFOG));
 
         // EDGE doesn't use the TELEPORT_FOG object, instead it uses
         // the CHASE states of the TELEPORT_FLASH object (i.e. the one
@@ -1256,10 +1258,10 @@ void HandleFrames(const mobjinfo_t *info, int mt_num)
         if (mt_num != MT_BOSSTARGET)
             I_Debugf("Dehacked: Warning - Mobj [%s:%d] has no states.\n", GetMobjName(mt_num), info->doomednum);
 
-        WAD::Printf("TRANSLUCENCY = 0%%;\n");
+        WAD::Field("TRANSLUCENCY", "0%%");
 
         WAD::Printf("\n");
-        WAD::Printf("STATES(IDLE) = %s:A:-1:NORMAL:NOTHING;\n", Sprites::GetSprite(SPR_CAND));
+        WAD::Field("STATES(IDLE)", "%s:A:-1:NORMAL:NOTHING", Sprites::GetSprite(SPR_CAND));
 
         return;
     }
@@ -1309,30 +1311,31 @@ void HandlePlayer(const mobjinfo_t *info, int player)
 
     const playerinfo_t *pi = player_info + (player - 1);
 
-    WAD::Printf("PLAYER = %d;\n", player);
-    WAD::Printf("SIDE = %d;\n", 1 << (player - 1));
-    WAD::Printf("PALETTE_REMAP = %s;\n", pi->remap);
-
-    WAD::Printf("INITIAL_BENEFIT = \n");
-    WAD::Printf("    BULLETS.LIMIT(%d), ", Ammo::plr_max[am_bullet]);
-    WAD::Printf("SHELLS.LIMIT(%d), ", Ammo::plr_max[am_shell]);
-    WAD::Printf("ROCKETS.LIMIT(%d), ", Ammo::plr_max[am_rocket]);
-    WAD::Printf("CELLS.LIMIT(%d),\n", Ammo::plr_max[am_cell]);
-    WAD::Printf("    PELLETS.LIMIT(%d), ", 200);
-    WAD::Printf("NAILS.LIMIT(%d), ", 100);
-    WAD::Printf("GRENADES.LIMIT(%d), ", 50);
-    WAD::Printf("GAS.LIMIT(%d),\n", 300);
-
-    WAD::Printf("    AMMO9.LIMIT(%d), ", 100);
-    WAD::Printf("AMMO10.LIMIT(%d), ", 200);
-    WAD::Printf("AMMO11.LIMIT(%d), ", 50);
-    WAD::Printf("AMMO12.LIMIT(%d),\n", 300);
-    WAD::Printf("    AMMO13.LIMIT(%d), ", 100);
-    WAD::Printf("AMMO14.LIMIT(%d), ", 200);
-    WAD::Printf("AMMO15.LIMIT(%d), ", 50);
-    WAD::Printf("AMMO16.LIMIT(%d),\n", 300);
-
-    WAD::Printf("    BULLETS(%d);\n", Misc::init_ammo);
+    WAD::Field("PLAYER", "%d", player);
+    WAD::Field("SIDE", "%d", 1 << (player - 1));
+    WAD::Field("PALETTE_REMAP", "%s", pi->remap);
+
+    WAD::BeginField("INITIAL_BENEFIT");
+    WAD::AddValue("BULLETS.LIMIT(%d)", Ammo::plr_max[am_bullet]);
+    WAD::AddValue("SHELLS.LIMIT(%d)", Ammo::plr_max[am_shell]);
+    WAD::AddValue("ROCKETS.LIMIT(%d)", Ammo::plr_max[am_rocket]);
+    WAD::AddValue("CELLS.LIMIT(%d)", Ammo::plr_max[am_cell]);
+    WAD::AddValue("PELLETS.LIMIT(%d)", 200);
+    WAD::AddValue("NAILS.LIMIT(%d)", 100);
+    WAD::AddValue("GRENADES.LIMIT(%d)", 50);
+    WAD::AddValue("GAS.LIMIT(%d)", 300);
+
+    WAD::AddValue("AMMO9.LIMIT(%d)", 100);
+    WAD::AddValue("AMMO10.LIMIT(%d)", 200);
+    WAD::AddValue("AMMO11.LIMIT(%d)", 50);
+    WAD::AddValue("AMMO12.LIMIT(%d)", 300);
+    WAD::AddValue("AMMO13.LIMIT(%d)", 100);
+    WAD::AddValue("AMMO14.LIMIT(%d)", 200);
+    WAD::AddValue("AMMO15.LIMIT(%d)", 50);
+    WAD::AddValue("AMMO16.LIMIT(%d)", 300);
+
+    WAD::AddValue("BULLETS(%d)", Misc::init_ammo);
+    WAD::EndField();
 }
 
 typedef struct
@@ -1405,31 +1408,39 @@ void HandleItem(const mobjinfo_t *info, int mt_num)
 
     if (spr_num == SPR_PSTR) // Berserk
     {
-        WAD::Printf("PICKUP_BENEFIT = POWERUP_BERSERK(60:60),HEALTH(100:100);\n");
-        WAD::Printf("PICKUP_MESSAGE = GotBerserk;\n");
-        WAD::Printf("PICKUP_SOUND = %s;\n", Sounds::GetSound(sfx_getpow));
-        WAD::Printf("PICKUP_EFFECT = SWITCH_WEAPON(FIST);\n");
+        WAD::BeginField("PICKUP_BENEFIT");
+        WAD::AddValue("POWERUP_BERSERK(60:60)");
+        WAD::AddValue("HEALTH(100:100)");
+        WAD::EndField();
+        WAD::Field("PICKUP_MESSAGE", "GotBerserk");
+        WAD::Field("PICKUP_SOUND", "%s", Sounds::GetSound(sfx_getpow));
+        WAD::Field("PICKUP_EFFECT", "SWITCH_WEAPON(FIST)");
         return;
     }
     else if (spr_num == SPR_MEGA) // Megasphere
     {
-        WAD::Printf("PICKUP_BENEFIT = ");
-        WAD::Printf("HEALTH(%d:%d),", Misc::mega_health, Misc::mega_health);
-        WAD::Printf("BLUE_ARMOUR(%d:%d);\n", Misc::max_armour, Misc::max_armour);
-        WAD::Printf("PICKUP_MESSAGE = GotMega;\n");
-        WAD::Printf("PICKUP_SOUND = %s;\n", Sounds::GetSound(sfx_getpow));
+        WAD::BeginField("PICKUP_BENEFIT");
+        WAD::AddValue("HEALTH(%d:%d)", Misc::mega_health, Misc::mega_health);
+        WAD::AddValue("BLUE_ARMOUR(%d:%d)", Misc::max_armour, Misc::max_armour);
+        WAD::EndField();
+        WAD::Field("PICKUP_MESSAGE", "GotMega");
+        WAD::Field("PICKUP_SOUND", "%s", Sounds::GetSound(sfx_getpow));
         return;
     }
     else if (spr_num == SPR_BPAK) // Backpack full of AMMO
     {
-        WAD::Printf("PICKUP_BENEFIT = \n");
-        WAD::Printf("    BULLETS.LIMIT(%d), ", 2 * Ammo::plr_max[am_bullet]);
-        WAD::Printf("    SHELLS.LIMIT(%d),\n", 2 * Ammo::plr_max[am_shell]);
-        WAD::Printf("    ROCKETS.LIMIT(%d), ", 2 * Ammo::plr_max[am_rocket]);
-        WAD::Printf("    CELLS.LIMIT(%d),\n", 2 * Ammo::plr_max[am_cell]);
-        WAD::Printf("    BULLETS(10), SHELLS(4), ROCKETS(1), CELLS(20);\n");
-        WAD::Printf("PICKUP_MESSAGE = GotBackpack;\n");
-        WAD::Printf("PICKUP_SOUND = %s;\n", Sounds::GetSound(sfx_itemup));
+        WAD::BeginField("PICKUP_BENEFIT");
+        WAD::AddValue("BULLETS.LIMIT(%d)", 2 * Ammo::plr_max[am_bullet]);
+        WAD::AddValue("SHELLS.LIMIT(%d)", 2 * Ammo::plr_max[am_shell]);
+        WAD::AddValue("ROCKETS.LIMIT(%d)", 2 * Ammo::plr_max[am_rocket]);
+        WAD::AddValue("CELLS.LIMIT(%d)", 2 * Ammo::plr_max[am_cell]);
+        WAD::AddValue("BULLETS(10)");
+        WAD::AddValue("SHELLS(4)");
+        WAD::AddValue("ROCKETS(1)");
+        WAD::AddValue("CELLS(20)");
+        WAD::EndField();
+        WAD::Field("PICKUP_MESSAGE", "GotBackpack");
+        WAD::Field("PICKUP_SOUND", "%s", Sounds::GetSound(sfx_itemup));
         return;
     }
 
@@ -1515,18 +1526,30 @@ void HandleItem(const mobjinfo_t *info, int mt_num)
     if (pu->par_num == 2 && amount > limit)
         amount = limit;
 
-    WAD::Printf("PICKUP_BENEFIT = %s", pu->benefit);
+    WAD::BeginField("PICKUP_BENEFIT");
+
+    // weapons also give some ammo, the amount goes on the last one
+    const char *benefit = pu->benefit;
+    const char *comma;
+
+    while ((comma = strchr(benefit, ',')) != NULL)
+    {
+        WAD::AddValue("%.*s", (int)(comma - benefit), benefit);
+        benefit = comma + 1;
+    }
 
     if (pu->par_num == 1)
-        WAD::Printf("(%d)", amount);
+        WAD::AddValue("%s(%d)", benefit, amount);
     else if (pu->par_num == 2)
-        WAD::Printf("(%d:%d)", amount, limit);
+        WAD::AddValue("%s(%d:%d)", benefit, amount, limit);
+    else
+        WAD::AddValue("%s", benefit);
 
-    WAD::Printf(";\n");
-    WAD::Printf("PICKUP_MESSAGE = %s;\n", pu->ldf);
+    WAD::EndField();
+    WAD::Field("PICKUP_MESSAGE", "%s", pu->ldf);
 
     if (info->activesound == sfx_None)
-        WAD::Printf("PICKUP_SOUND = %s;\n", Sounds::GetSound(pu->sound));
+        WAD::Field("PICKUP_SOUND", "%s", Sounds::GetSound(pu->sound));
 }
 
 const char *cast_titles[17] = {
@@ -1557,8 +1580,8 @@ void HandleCastOrder(const mobjinfo_t *info, int mt_num, int player)
     if (pos >= CAST_MAX) // not found
         return;
 
-    WAD::Printf("CASTORDER = %d;\n", order);
-    WAD::Printf("CAST_TITLE = %s;\n", cast_titles[pos - 1]);
+    WAD::Field("CASTORDER", "%d", order);
+    WAD::Field("CAST_TITLE", "%s", cast_titles[pos - 1]);
 }
 
 void HandleDropItem(const mobjinfo_t *info, int mt_num);
@@ -1603,29 +1626,30 @@ void Things::HandleDropItem(const mobjinfo_t *info, int mt_num)
 
     assert(item);
 
-    WAD::Printf("DROPITEM = \"%s\";\n", item);
+    WAD::StringField("DROPITEM", item);
 }
 
 void Things::HandleAttacks(const mobjinfo_t *info, int mt_num)
 {
     if (Frames::attack_slot[Frames::RANGE])
     {
-        WAD::Printf("RANGE_ATTACK = %s;\n", Frames::attack_slot[Frames::RANGE]);
-        WAD::Printf("MINATTACK_CHANCE = 25%%;\n");
+        WAD::Field("RANGE_ATTACK", "%s", Frames::attack_slot[Frames::RANGE]);
+        WAD::Field("MINATTACK_CHANCE", "25%%");
     }
 
     if (Frames::attack_slot[Frames::COMBAT])
     {
-        WAD::Printf("CLOSE_ATTACK = %s;\n", Frames::attack_slot[Frames::COMBAT]);
+        WAD::Field("CLOSE_ATTACK", "%s", Frames::attack_slot[Frames::COMBAT]);
     }
     else if (info->meleestate && info->name[0] != '*')
     {
         I_Debugf("Dehacked: Warning - No close attack in melee states of [%s].\n", GetMobjName(mt_num));
-        WAD::Printf("CLOSE_ATTACK = DEMON_CLOSECOMBAT; // dummy attack\n");
+        WAD::Comment("dummy attack");
+        WAD::Field("CLOSE_ATTACK", "DEMON_CLOSECOMBAT");
     }
 
     if (Frames::attack_slot[Frames::SPARE])
-        WAD::Printf("SPARE_ATTACK = %s;\n", Frames::attack_slot[Frames::SPARE]);
+        WAD::Field("SPARE_ATTACK", "%s", Frames::attack_slot[Frames::SPARE]);
 }
 
 void Things::ConvertMobj(const mobjinfo_t *info, int mt_num, int player, bool brain_missile, bool &got_one)
@@ -1645,46 +1669,46 @@ void Things::ConvertMobj(const mobjinfo_t *info, int mt_num, int player, bool br
         ddf_name = info->name;
 
     if (player > 0)
-        WAD::Printf("[%s:%d]\n", player_info[player - 1].name, player_info[player - 1].num);
+        WAD::Entry("%s:%d", player_info[player - 1].name, player_info[player - 1].num);
     else if (info->doomednum < 0)
-        WAD::Printf("[%s]\n", ddf_name);
+        WAD::Entry("%s", ddf_name);
     else
-        WAD::Printf("[%s:%d]\n", ddf_name, info->doomednum);
+        WAD::Entry("%s:%d", ddf_name, info->doomednum);
 
     if (info->pickup_width != 0)
-        WAD::Printf("RADIUS = %1.1f;\n", F_FIXED(info->pickup_width));
+        WAD::Field("RADIUS", "%1.1f", F_FIXED(info->pickup_width));
     else
-        WAD::Printf("RADIUS = %1.1f;\n", F_FIXED(info->radius));
+        WAD::Field("RADIUS", "%1.1f", F_FIXED(info->radius));
 
     if (info->projectile_pass_height != 0)
-        WAD::Printf("HEIGHT = %1.1f;\n", F_FIXED(info->projectile_pass_height));
+        WAD::Field("HEIGHT", "%1.1f", F_FIXED(info->projectile_pass_height));
     else
-        WAD::Printf("HEIGHT = %1.1f;\n", F_FIXED(info->height));
+        WAD::Field("HEIGHT", "%1.1f", F_FIXED(info->height));
 
     if (info->spawnhealth != 1000)
-        WAD::Printf("SPAWNHEALTH = %d;\n", info->spawnhealth);
+        WAD::Field("SPAWNHEALTH", "%d", info->spawnhealth);
 
     if (player > 0)
-        WAD::Printf("SPEED = 1;\n");
+        WAD::Field("SPEED", "1");
     else if (info->speed != 0)
-        WAD::Printf("SPEED = %s;\n", GetSpeed(info->speed));
+        WAD::Field("SPEED", "%s", GetSpeed(info->speed));
 
     if (info->mass != 100 && info->mass > 0)
-        WAD::Printf("MASS = %d;\n", info->mass);
+        WAD::Field("MASS", "%d", info->mass);
 
     if (info->reactiontime != 0)
-        WAD::Printf("REACTION_TIME = %dT;\n", info->reactiontime);
+        WAD::Field("REACTION_TIME", "%dT", info->reactiontime);
 
     if (info->painchance >= 256)
-        WAD::Printf("PAINCHANCE = 100%%;\n");
+        WAD::Field("PAINCHANCE", "100%%");
     else if (info->painchance > 0)
-        WAD::Printf("PAINCHANCE = %1.1f%%;\n", (float)info->painchance * 100.0 / 256.0);
+        WAD::Field("PAINCHANCE", "%1.1f%%", (float)info->painchance * 100.0 / 256.0);
 
     if (info->gib_health != 0)
-        WAD::Printf("GIB_HEALTH = %d;\n", info->gib_health);
+        WAD::Field("GIB_HEALTH", "%d", info->gib_health);
 
     if (mt_num == MT_BOSSSPIT)
-        WAD::Printf("SPIT_SPOT = BRAIN_SPAWNSPOT;\n");
+        WAD::Field("SPIT_SPOT", "BRAIN_SPAWNSPOT");
 
     HandleCastOrder(info, mt_num, player);
     HandleDropItem(info, mt_num);
@@ -1699,9 +1723,9 @@ void Things::ConvertMobj(const mobjinfo_t *info, int mt_num, int player, bool br
     HandleAttacks(info, mt_num);
 
     if (Frames::act_flags & AF_EXPLODE)
-        WAD::Printf("EXPLODE_DAMAGE.VAL = 128;\n");
+        WAD::Field("EXPLODE_DAMAGE.VAL", "128");
     else if (Frames::act_flags & AF_DETONATE)
-        WAD::Printf("EXPLODE_DAMAGE.VAL = %d;\n", info->damage);
+        WAD::Field("EXPLODE_DAMAGE.VAL", "%d", info->damage);
 
     if ((Frames::act_flags & AF_KEENDIE))
         Rscript::MarkKeenDie(mt_num);
@@ -31,6 +31,9 @@
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
+#include <ctype.h>
+
+#include <string>
 
 #include "deh_i_defs.h"
 #include "deh_edge.h"
@@ -46,8 +49,16 @@ namespace WAD
 
 ddf_collection_c *dest_container = NULL;
 
+bool keep_text = false;
+
 ddf_file_c *cur_lump = NULL;
 
+// current command with a list of values (NULL when none)
+ddf_record_c *cur_field = NULL;
+
+// comment waiting for the end of the current line
+std::string pending_comment;
+
 char wad_msg_buf[1024];
 
 void NewLump(ddf_type_e type)
@@ -55,15 +66,26 @@ void NewLump(ddf_type_e type)
     if (dest_container == NULL)
         I_Error("Dehacked: Error - WAD_NewLump: no container!\n");
 
+    if (cur_field != NULL)
+        I_Error("Dehacked: Error - WAD_NewLump: unfinished command.\n");
+
     dest_container->files.push_back(ddf_file_c(type, ""));
 
     cur_lump = &dest_container->files.back();
 }
 
-void Printf(const char *str, ...)
+static bool WantText(void)
 {
     if (cur_lump == NULL)
-        I_Error("Dehacked: Error - WAD_Printf: not started.\n");
+        I_Error("Dehacked: Error - WAD output not started.\n");
+
+    return keep_text || cur_lump->type == DDF_RadScript;
+}
+
+void Printf(const char *str, ...)
+{
+    if (!WantText())
+        return;
 
     va_list args;
 
@@ -74,6 +96,262 @@ void Printf(const char *str, ...)
     cur_lump->data += (const char *)wad_msg_buf;
 }
 
+void Comment(const char *str, ...)
+{
+    if (!WantText())
+        return;
+
+    va_list args;
+
+    va_start(args, str);
+    vsprintf(wad_msg_buf, str, args);
+    va_end(args);
+
+    pending_comment += "  // ";
+    pending_comment += wad_msg_buf;
+
+    if (cur_field == NULL)
+    {
+        cur_lump->data += pending_comment;
+        cur_lump->data += "\n";
+
+        pending_comment.clear();
+    }
+}
+
+// line break in the text, with any pending comment before it
+static void LineBreak(void)
+{
+    cur_lump->data += pending_comment;
+    cur_lump->data += "\n";
+
+    pending_comment.clear();
+}
+
+//
+// The DDF reader upper-cases names and values and ignores whitespace
+// (except in quoted strings), and names only keep certain characters.
+// These do the same, so that the records match what reading the text
+// would have produced.
+//
+static std::string CookName(const char *name, bool entry)
+{
+    std::string out;
+
+    for (; *name; name++)
+    {
+        char ch = *name;
+
+        if (isalnum((unsigned char)ch) || ch == '_' || (entry && (ch == ':' || ch == '+')) ||
+            (!entry && (ch == '(' || ch == ')' || ch == '.')))
+        {
+            out += toupper((unsigned char)ch);
+        }
+    }
+
+    return out;
+}
+
+// a backslash escape inside a DDF string
+static char Unescape(char ch)
+{
+    return (ch == 'n') ? '\n' : ch;
+}
+
+static std::string CookValue(const char *value)
+{
+    std::string out;
+
+    bool in_string = false;
+
+    for (; *value; value++)
+    {
+        char ch = *value;
+
+        if (in_string)
+        {
+            if (ch == '\\' && value[1])
+                out += Unescape(*++value);
+            else if (ch == '"')
+                in_string = false;
+            else
+                out += ch;
+
+            continue;
+        }
+
+        if (ch == '"')
+            in_string = true;
+        else if (!isspace((unsigned char)ch))
+            out += toupper((unsigned char)ch);
+    }
+
+    return out;
+}
+
+static void AddRecord(bool entry, const std::string &name)
+{
+    if (cur_field != NULL)
+        I_Error("Dehacked: Error - WAD output: unfinished command.\n");
+
+    cur_lump->records.push_back(ddf_record_c(entry, name));
+}
+
+void Entry(const char *name, ...)
+{
+    bool want_text = WantText();
+
+    va_list args;
+
+    va_start(args, name);
+    vsprintf(wad_msg_buf, name, args);
+    va_end(args);
+
+    AddRecord(true, CookName(wad_msg_buf, true));
+
+    if (want_text)
+    {
+        cur_lump->data += "[";
+        cur_lump->data += wad_msg_buf;
+        cur_lump->data += "]";
+
+        LineBreak();
+    }
+}
+
+void Field(const char *cmd, const char *value, ...)
+{
+    bool want_text = WantText();
+
+    va_list args;
+
+    va_start(args, value);
+    vsprintf(wad_msg_buf, value, args);
+    va_end(args);
+
+    AddRecord(false, CookName(cmd, false));
+
+    cur_lump->records.back().values.push_back(CookValue(wad_msg_buf));
+
+    if (want_text)
+    {
+        cur_lump->data += cmd;
+        cur_lump->data += " = ";
+        cur_lump->data += wad_msg_buf;
+        cur_lump->data += ";";
+
+        LineBreak();
+    }
+}
+
+void StringField(const char *cmd, const char *str)
+{
+    bool want_text = WantText();
+
+    AddRecord(false, CookName(cmd, false));
+
+    std::string value;
+
+    for (const char *pos = str; *pos; pos++)
+    {
+        if (*pos == '\\' && pos[1])
+            value += Unescape(*++pos);
+        else
+            value += *pos;
+    }
+
+    cur_lump->records.back().values.push_back(value);
+
+    if (want_text)
+    {
+        cur_lump->data += cmd;
+        cur_lump->data += " = \"";
+
+        for (; *str; str++)
+        {
+            if (*str == '\n')
+                cur_lump->data += "\\n\"\n  \"";
+            else if (*str == '"')
+                cur_lump->data += "\\\"";
+            else
+                cur_lump->data += *str;
+        }
+
+        cur_lump->data += "\";";
+
+        LineBreak();
+    }
+}
+
+void BeginField(const char *cmd, ...)
+{
+    bool want_text = WantText();
+
+    va_list args;
+
+    va_start(args, cmd);
+    vsprintf(wad_msg_buf, cmd, args);
+    va_end(args);
+
+    AddRecord(false, CookName(wad_msg_buf, false));
+
+    cur_field = &cur_lump->records.back();
+
+    if (want_text)
+    {
+        cur_lump->data += wad_msg_buf;
+        cur_lump->data += " =";
+    }
+}
+
+void AddValue(const char *value, ...)
+{
+    bool want_text = WantText();
+
+    if (cur_field == NULL)
+        I_Error("Dehacked: Error - WAD_AddValue: no command.\n");
+
+    va_list args;
+
+    va_start(args, value);
+    vsprintf(wad_msg_buf, value, args);
+    va_end(args);
+
+    if (want_text)
+    {
+        if (!cur_field->values.empty())
+            cur_lump->data += ",";
+
+        LineBreak();
+
+        cur_lump->data += "    ";
+        cur_lump->data += wad_msg_buf;
+    }
+
+    cur_field->values.push_back(CookValue(wad_msg_buf));
+}
+
+void EndField(void)
+{
+    bool want_text = WantText();
+
+    if (cur_field == NULL)
+        I_Error("Dehacked: Error - WAD_EndField: no command.\n");
+
+    // same as an empty value in DDF text
+    if (cur_field->values.empty())
+        cur_field->values.push_back("");
+
+    cur_field = NULL;
+
+    if (want_text)
+    {
+        cur_lump->data += ";";
+
+        LineBreak();
+    }
+}
+
 } // namespace WAD
 
 } // namespace Deh_Edge
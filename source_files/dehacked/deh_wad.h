@@ -28,9 +28,33 @@ namespace WAD
 {
 extern ddf_collection_c *dest_container;
 
+// when true, the DDF text equivalent of the output is generated too
+// (only needed for dumping).  RTS scripts are always text.
+extern bool keep_text;
+
 void NewLump(ddf_type_e type);
 
+// raw text output: the whole of an RTS lump, otherwise things like
+// the <TAG> header and blank lines which only matter for keep_text.
 void Printf(const char *str, ...) GCCATTR((format(printf, 1, 2)));
+
+// a comment, placed at the end of the current line of text.
+void Comment(const char *str, ...) GCCATTR((format(printf, 1, 2)));
+
+// DDF output: these add ready-split commands to the current lump,
+// which the DDF code can read without going through any text.
+void Entry(const char *name, ...) GCCATTR((format(printf, 1, 2)));
+
+void Field(const char *cmd, const char *value, ...) GCCATTR((format(printf, 2, 3)));
+
+// the value is a quoted string, and escapes in it (like "\n") are
+// handled the same as in DDF text.
+void StringField(const char *cmd, const char *str);
+
+// a command with a comma separated list of values.
+void BeginField(const char *cmd, ...) GCCATTR((format(printf, 1, 2)));
+void AddValue(const char *value, ...) GCCATTR((format(printf, 1, 2)));
+void EndField(void);
 } // namespace WAD
 
 } // namespace Deh_Edge
@@ -150,19 +150,19 @@ void HandleFlags(const weaponinfo_t *info, int w_num)
         return;
 
     if (strchr(info->flags, WF_FREE))
-        WAD::Printf("FREE = TRUE;\n");
+        WAD::Field("FREE", "TRUE");
 
     if (strchr(info->flags, WF_REF_INACC))
-        WAD::Printf("REFIRE_INACCURATE = TRUE;\n");
+        WAD::Field("REFIRE_INACCURATE", "TRUE");
 
     if (strchr(info->flags, WF_DANGEROUS))
-        WAD::Printf("DANGEROUS = TRUE;\n");
+        WAD::Field("DANGEROUS", "TRUE");
 
     if (strchr(info->flags, WF_NO_THRUST))
-        WAD::Printf("NOTHRUST = TRUE;\n");
+        WAD::Field("NOTHRUST", "TRUE");
 
     if (strchr(info->flags, WF_FEEDBACK))
-        WAD::Printf("FEEDBACK = TRUE;\n");
+        WAD::Field("FEEDBACK", "TRUE");
 }
 
 void AddOneFlag(const weaponinfo_t *info, const char *name, bool &got_a_flag)
@@ -171,12 +171,10 @@ void AddOneFlag(const weaponinfo_t *info, const char *name, bool &got_a_flag)
     {
         got_a_flag = true;
 
-        WAD::Printf("SPECIAL = ");
+        WAD::BeginField("SPECIAL");
     }
-    else
-        WAD::Printf(",");
 
-    WAD::Printf("%s", name);
+    WAD::AddValue("%s", name);
 }
 
 void HandleMBF21Flags(const weaponinfo_t *info, int w_num)
@@ -196,7 +194,7 @@ void HandleMBF21Flags(const weaponinfo_t *info, int w_num)
     }
 
     if (got_a_flag)
-        WAD::Printf(";\n");
+        WAD::EndField();
 
     if (cur_f != 0)
         I_Debugf("Dehacked: Warning - Unconverted flags 0x%08x in weapontype %d\n", cur_f, w_num);
@@ -206,9 +204,9 @@ void HandleSounds(const weaponinfo_t *info, int w_num)
 {
     if (w_num == wp_chainsaw)
     {
-        WAD::Printf("START_SOUND = \"%s\";\n", Sounds::GetSound(sfx_sawup));
-        WAD::Printf("IDLE_SOUND = \"%s\";\n", Sounds::GetSound(sfx_sawidl));
-        WAD::Printf("ENGAGED_SOUND = \"%s\";\n", Sounds::GetSound(sfx_sawful));
+        WAD::StringField("START_SOUND", Sounds::GetSound(sfx_sawup));
+        WAD::StringField("IDLE_SOUND", Sounds::GetSound(sfx_sawidl));
+        WAD::StringField("ENGAGED_SOUND", Sounds::GetSound(sfx_sawful));
         return;
     }
 
@@ -272,12 +270,12 @@ void HandleAttacks(const weaponinfo_t *info, int w_num)
 
     assert(atk != NULL);
 
-    WAD::Printf("ATTACK = %s;\n", atk);
+    WAD::Field("ATTACK", "%s", atk);
 
     // 2023.11.17 - Added SAWFUL ENGAGE_SOUND for non-chainsaw attacks using the chainsaw attack
     // Fixes, for instance, the Harmony Compatible knife swing being silent
     if (StrCaseCmp(atk, "PLAYER_SAW") == 0 && w_num != wp_chainsaw)
-        WAD::Printf("ENGAGED_SOUND = \"%s\";\n", Sounds::GetSound(sfx_sawful));
+        WAD::StringField("ENGAGED_SOUND", Sounds::GetSound(sfx_sawful));
 
 }
 
@@ -291,20 +289,20 @@ void ConvertWeapon(int w_num)
 
     const weaponinfo_t *info = weapon_info + w_num;
 
-    WAD::Printf("[%s]\n", info->ddf_name);
+    WAD::Entry("%s", info->ddf_name);
 
-    WAD::Printf("AMMOTYPE = %s;\n", Ammo::GetAmmo(info->ammo));
+    WAD::Field("AMMOTYPE", "%s", Ammo::GetAmmo(info->ammo));
 
     if (w_num == wp_bfg)
-        WAD::Printf("AMMOPERSHOT = %d;\n", Misc::bfg_cells_per_shot);
+        WAD::Field("AMMOPERSHOT", "%d", Misc::bfg_cells_per_shot);
     else if (info->ammo_per_shot != 0)
-        WAD::Printf("AMMOPERSHOT = %d;\n", info->ammo_per_shot);
+        WAD::Field("AMMOPERSHOT", "%d", info->ammo_per_shot);
 
-    WAD::Printf("AUTOMATIC = TRUE;\n");
+    WAD::Field("AUTOMATIC", "TRUE");
 
-    WAD::Printf("BINDKEY = %d;\n", info->bind_key);
+    WAD::Field("BINDKEY", "%d", info->bind_key);
 
-    WAD::Printf("PRIORITY = %d;\n", info->priority);
+    WAD::Field("PRIORITY", "%d", info->priority);
 
     HandleFlags(info, w_num);
     HandleMBF21Flags(info, w_num);
@@ -178,8 +178,6 @@ bool rotatemap       = false;
 bool am_keydoorblink = false;
 DEF_CVAR(am_keydoortext, "0", CVAR_ARCHIVE)
 
-extern cvar_c r_doubleframes;
-
 extern style_c *automap_style; // FIXME: put in header
 
 // translates between frame-buffer and map distances
@@ -577,7 +575,7 @@ static void DrawMLineDoor(mline_t *ml, RGBAColor rgb)
     // Lobo 2023: Make keyed doors pulse
     if (am_keydoorblink)
     {
-        linewidth = gametic % (32 * (r_doubleframes.d ? 2 : 1));
+        linewidth = gametic % 32;
 
         if (linewidth >= 16)
             linewidth = 2.0 + (linewidth * 0.1f);
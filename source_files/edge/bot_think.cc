@@ -42,6 +42,7 @@
 #include "w_wad.h"
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 #define DEBUG 0
 
@@ -1537,6 +1538,8 @@ void P_BotCreate(player_t *p, bool recreate)
 
 void P_BotPlayerBuilder(const player_t *p, void *data, ticcmd_t *cmd)
 {
+    EDGE_ZoneScoped;
+
     memset(cmd, 0, sizeof(ticcmd_t));
 
     if (gamestate != GS_LEVEL)
@@ -96,7 +96,6 @@ static char input_line[MAX_CON_INPUT + 2];
 static int  input_pos = 0;
 
 int           con_cursor;
-extern cvar_c r_doubleframes;
 
 #define KEYREPEATDELAY ((250 * TICRATE) / 1000)
 #define KEYREPEATRATE  (TICRATE / 15)
@@ -567,6 +566,9 @@ static void CalcSizes()
 
 static void SolidBox(int x, int y, int w, int h, RGBAColor col, float alpha)
 {
+    // the console draws directly, after anything batched by the HUD code
+    HUD_FlushBatch();
+
     if (alpha < 0.99f)
         glEnable(GL_BLEND);
 
@@ -710,6 +712,8 @@ static void DrawEndoomChar(float x, float y, char ch, RGBAColor col, RGBAColor c
 // writes the text on coords (x,y) of the console
 static void DrawText(int x, int y, const char *s, RGBAColor col)
 {
+    HUD_FlushBatch();
+
     if (con_font->def->type == FNTYP_Image)
     {
         // Always whiten the font when used with console output
@@ -779,6 +783,8 @@ static void DrawText(int x, int y, const char *s, RGBAColor col)
 
 static void EndoomDrawText(int x, int y, console_line_c *endoom_line)
 {
+    HUD_FlushBatch();
+
     // Always whiten the font when used with console output
     GLuint tex_id = W_ImageCache(endoom_font->font_image, true, (const colourmap_c *)0, true);
 
@@ -1503,7 +1509,7 @@ bool CON_Responder(event_t *ev)
         case KEYD_SPACE:
         case KEYD_BACKSPACE:
         case KEYD_DELETE:
-            repeat_countdown = KEYREPEATDELAY * (r_doubleframes.d ? 2 : 1);
+            repeat_countdown = KEYREPEATDELAY;
             break;
         default:
             repeat_countdown = 0;
@@ -1520,11 +1526,7 @@ bool CON_Responder(event_t *ev)
 
 void CON_Ticker(void)
 {
-    int add = 1;
-    if (r_doubleframes.d && !(hudtic & 1))
-        add = 0;
-
-    con_cursor = (con_cursor + add) & 31;
+    con_cursor = (con_cursor + 1) & 31;
 
     if (con_visible != vs_notvisible)
     {
@@ -1548,7 +1550,7 @@ void CON_Ticker(void)
 
                 while (repeat_countdown <= 0)
                 {
-                    repeat_countdown += KEYREPEATRATE * (r_doubleframes.d ? 2 : 1);
+                    repeat_countdown += KEYREPEATRATE;
                     CON_HandleKey(repeat_key, KeysShifted, false);
                 }
             }
@@ -1650,7 +1652,7 @@ void CON_ShowFPS(void)
         y -= FNSZ;
 
     if (abs(debug_fps.d) >= 3)
-        y -= (FNSZ * 4);
+        y -= (FNSZ * 7);
 
     SolidBox(x, y, SCREENWIDTH, SCREENHEIGHT, SG_BLACK_RGBA32, 0.5);
 
@@ -1689,12 +1691,21 @@ void CON_ShowFPS(void)
         y -= FNSZ;        
         sprintf(textbuf, "%i runit", ecframe_stats.draw_runits);
         DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
+        y -= FNSZ;
+        sprintf(textbuf, "%i merged", ecframe_stats.draw_mergedunits);
+        DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
+        y -= FNSZ;
+        sprintf(textbuf, "%i us sort", ecframe_stats.draw_sortmicros);
+        DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
         y -= FNSZ;        
         sprintf(textbuf, "%i wall", ecframe_stats.draw_wallparts);
         DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
         y -= FNSZ;        
         sprintf(textbuf, "%i plane", ecframe_stats.draw_planes);
         DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
+        y -= FNSZ;
+        sprintf(textbuf, "%i cached", ecframe_stats.draw_geomcached);
+        DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
         y -= FNSZ;        
         sprintf(textbuf, "%i thing", ecframe_stats.draw_things);
         DrawText(x, y, textbuf, SG_WEB_GRAY_RGBA32);
@@ -29,9 +29,11 @@
 #include "con_var.h"
 #include "dm_state.h"
 #include "e_input.h"
+#include "e_pacer.h"
 #include "g_game.h"
 #include "m_menu.h"
 #include "m_misc.h"
+#include "s_cache.h"
 #include "s_sound.h"
 #include "w_files.h"
 #include "w_wad.h"
@@ -323,6 +325,24 @@ int CMD_OpenHome(char **argv, int argc)
     return 0;
 }
 
+int CMD_ShowSoundCache(char **argv, int argc)
+{
+    S_CacheShowStats();
+    return 0;
+}
+
+int CMD_ShowPacing(char **argv, int argc)
+{
+    if (argc >= 2 && epi::StringCaseCompareASCII(argv[1], "reset") == 0)
+    {
+        E_PacerResetStats();
+        return 0;
+    }
+
+    E_PacerShowStats();
+    return 0;
+}
+
 int CMD_ShowLumps(char **argv, int argc)
 {
     int for_file = -1; // all files
@@ -587,8 +607,10 @@ const con_cmd_t builtin_commands[] = {{"args", CMD_ArgList},
                                       {"showfiles", CMD_ShowFiles},
                                       {"showgamepads", CMD_ShowGamepads},
                                       {"showlumps", CMD_ShowLumps},
+                                      {"showsfxcache", CMD_ShowSoundCache},
                                       {"showcmds", CMD_ShowCmds},
                                       {"showmaps", CMD_ShowMaps},
+                                      {"showpacing", CMD_ShowPacing},
                                       {"showvars", CMD_ShowVars},
                                       {"screenshot", CMD_ScreenShot},
                                       {"type", CMD_Type},
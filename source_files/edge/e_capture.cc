@@ -0,0 +1,449 @@
+//----------------------------------------------------------------------------
+//  EDGE Frame Capture
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Writes every frame to a video stream for offline rendering, and the
+//  sound of every game tic to a WAV file.  The game runs one tic per
+//  frame (like -screenshot), so the result does not depend on how fast
+//  the machine is, and is played back at 35 frames per second.
+//
+//    -capture <file>      YUV4MPEG2 (.y4m) video, or raw RGB24
+//                         frames when the name ends in .rgb
+//    -capturewav <file>   16-bit PCM sound
+//
+//  A name starting with '|' is run as a command which is given the
+//  data on its standard input, e.g. -capture "|ffmpeg -i - out.mkv".
+//
+//  Frames are read with RGL_QueueReadScreen(), then converted and
+//  written by a worker thread.  The sound is mixed by the game itself
+//  (the audio device plays silence), with the music and sound streams
+//  also decoded on the game thread, so nothing depends on timing.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+
+#include <stdio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "endianess.h"
+#include "filesystem.h"
+#include "str_compare.h"
+#include "str_util.h"
+
+#include "image_data.h"
+
+#include "dm_state.h"
+#include "e_capture.h"
+#include "m_argv.h"
+#include "r_draw.h"
+#include "r_modes.h"
+#include "s_blit.h"
+#include "s_music.h"
+#include "s_stream.h"
+
+// "b" is only valid (and needed) for the Windows version of popen()
+#ifdef _WIN32
+#define popen  _popen
+#define pclose _pclose
+#define PIPE_WRITE_MODE "wb"
+#else
+#define PIPE_WRITE_MODE "w"
+#endif
+
+// how many frames can wait for the worker before the game waits too
+#define MAX_PENDING_FRAMES 4
+
+// FIXME: extern == hack
+extern int  dev_freq;
+extern int  dev_frag_pairs;
+extern bool dev_stereo;
+
+typedef struct
+{
+    FILE *fp;
+    bool  is_pipe;
+} capture_file_t;
+
+static capture_file_t video_out = {NULL, false};
+static capture_file_t sound_out = {NULL, false};
+
+static bool video_y4m;
+
+// size of the video, from the first frame
+static int video_w = 0;
+static int video_h = 0;
+
+static int video_frames = 0;
+
+static std::thread             video_thread;
+static bool                    video_quit = false;
+static std::mutex              video_lock;
+static std::condition_variable video_cond;
+
+static std::deque<image_data_c *> video_queue;
+
+// sound
+static int64_t sound_pairs    = 0;
+static int     sound_leftover = 0; // remainder of dev_freq / TICRATE
+
+static std::vector<int16_t> sound_buf;
+
+static bool OpenCaptureFile(capture_file_t *out, const std::string &name)
+{
+    if (name[0] == '|')
+    {
+        out->fp      = popen(name.c_str() + 1, PIPE_WRITE_MODE);
+        out->is_pipe = true;
+    }
+    else
+    {
+        out->fp      = epi::FileOpenRaw(name, epi::kFileAccessWrite | epi::kFileAccessBinary);
+        out->is_pipe = false;
+    }
+
+    return (out->fp != NULL);
+}
+
+static void CloseCaptureFile(capture_file_t *out)
+{
+    if (!out->fp)
+        return;
+
+    if (out->is_pipe)
+        pclose(out->fp);
+    else
+        fclose(out->fp);
+
+    out->fp = NULL;
+}
+
+//----------------------------------------------------------------------------
+//  VIDEO
+//----------------------------------------------------------------------------
+
+static void WriteVideoFrame(image_data_c *img)
+{
+    std::vector<uint8_t> frame;
+
+    int plane = video_w * video_h;
+
+    // three planes for Y4M, three bytes per pixel for RGB
+    frame.resize(plane * 3);
+
+    // the image is bottom-up, and may not be the size of the video
+    // (if the screen mode was changed), in which case it is cropped
+    // or padded with black.
+    for (int y = 0; y < video_h; y++)
+    {
+        int src_y = img->height - 1 - y;
+
+        for (int x = 0; x < video_w; x++)
+        {
+            int r = 0, g = 0, b = 0;
+
+            if (src_y >= 0 && x < img->width)
+            {
+                const uint8_t *src = img->PixelAt(x, src_y);
+
+                r = src[0];
+                g = src[1];
+                b = src[2];
+            }
+
+            int pos = y * video_w + x;
+
+            if (video_y4m)
+            {
+                // BT.601, limited range
+                frame[pos]             = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+                frame[plane + pos]     = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                frame[plane * 2 + pos] = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+            else
+            {
+                frame[pos * 3 + 0] = (uint8_t)r;
+                frame[pos * 3 + 1] = (uint8_t)g;
+                frame[pos * 3 + 2] = (uint8_t)b;
+            }
+        }
+    }
+
+    if (video_y4m)
+        fputs("FRAME\n", video_out.fp);
+
+    fwrite(frame.data(), 1, frame.size(), video_out.fp);
+}
+
+static void VideoThreadLoop(void)
+{
+    std::unique_lock<std::mutex> lock(video_lock);
+
+    for (;;)
+    {
+        video_cond.wait(lock, [] { return video_quit || !video_queue.empty(); });
+
+        if (video_queue.empty())
+            break;
+
+        image_data_c *img = video_queue.front();
+
+        lock.unlock();
+
+        WriteVideoFrame(img);
+
+        delete img;
+
+        lock.lock();
+
+        // only removed once written, so an empty queue means all done
+        video_queue.pop_front();
+
+        video_cond.notify_all();
+    }
+}
+
+static void CaptureRead(image_data_c *img, void *priv)
+{
+    (void)priv;
+
+    if (video_w == 0)
+    {
+        video_w = img->width;
+        video_h = img->height;
+
+        if (video_y4m)
+            fprintf(video_out.fp, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", video_w, video_h, TICRATE);
+
+        I_Printf("Capture: video is %dx%d at %d fps%s\n", video_w, video_h, TICRATE,
+                 video_y4m ? "" : " (raw rgb24)");
+
+        video_quit   = false;
+        video_thread = std::thread(VideoThreadLoop);
+    }
+
+    std::unique_lock<std::mutex> lock(video_lock);
+
+    // don't let the frames pile up when the worker can't keep up
+    video_cond.wait(lock, [] { return video_queue.size() < MAX_PENDING_FRAMES; });
+
+    video_queue.push_back(img);
+    video_frames++;
+
+    video_cond.notify_all();
+}
+
+//----------------------------------------------------------------------------
+//  SOUND
+//----------------------------------------------------------------------------
+
+static void WriteU16(FILE *fp, uint16_t value)
+{
+    fputc(value & 0xFF, fp);
+    fputc((value >> 8) & 0xFF, fp);
+}
+
+static void WriteU32(FILE *fp, uint32_t value)
+{
+    WriteU16(fp, value & 0xFFFF);
+    WriteU16(fp, value >> 16);
+}
+
+static void WriteWAVHeader(uint32_t data_bytes)
+{
+    FILE *fp = sound_out.fp;
+
+    int channels = dev_stereo ? 2 : 1;
+
+    fwrite("RIFF", 1, 4, fp);
+    WriteU32(fp, data_bytes == 0xFFFFFFFF ? data_bytes : data_bytes + 36);
+    fwrite("WAVE", 1, 4, fp);
+
+    fwrite("fmt ", 1, 4, fp);
+    WriteU32(fp, 16);
+    WriteU16(fp, 1); // PCM
+    WriteU16(fp, channels);
+    WriteU32(fp, dev_freq);
+    WriteU32(fp, dev_freq * channels * 2);
+    WriteU16(fp, channels * 2);
+    WriteU16(fp, 16);
+
+    fwrite("data", 1, 4, fp);
+    WriteU32(fp, data_bytes);
+}
+
+void E_CaptureTic(void)
+{
+    if (!sound_out.fp)
+        return;
+
+    // S_MusicTicker() has just decoded more music, the sound streams
+    // need topping up too
+    S_StreamUpdate();
+
+    sound_leftover += dev_freq;
+
+    int pairs = sound_leftover / TICRATE;
+
+    sound_leftover -= pairs * TICRATE;
+
+    int channels = dev_stereo ? 2 : 1;
+
+    sound_buf.resize(pairs * channels);
+
+    int16_t *dest = sound_buf.data();
+
+    for (int left = pairs; left > 0;)
+    {
+        int count = HMM_MIN(left, dev_frag_pairs);
+
+        memset(dest, 0, count * channels * sizeof(int16_t));
+
+        S_MixAllChannels(dest, count * channels * 2);
+
+        dest += count * channels;
+        left -= count;
+    }
+
+    for (int16_t &sample : sound_buf)
+        sample = AlignedLittleEndianS16(sample);
+
+    fwrite(sound_buf.data(), sizeof(int16_t), sound_buf.size(), sound_out.fp);
+
+    sound_pairs += pairs;
+}
+
+//----------------------------------------------------------------------------
+
+void E_CaptureInit(void)
+{
+    std::string video_name = argv::Value("capture");
+    std::string sound_name = argv::Value("capturewav");
+
+    if (!video_name.empty())
+    {
+        if (!OpenCaptureFile(&video_out, video_name))
+            I_Error("Capture: unable to create %s\n", video_name.c_str());
+
+        video_y4m = (epi::StringCaseCompareASCII(epi::GetExtension(video_name), ".rgb") != 0);
+
+        I_Printf("Capture: writing video to %s\n", video_name.c_str());
+    }
+
+    if (!sound_name.empty())
+    {
+        if (nosound)
+        {
+            I_Warning("Capture: no sound device, -capturewav ignored.\n");
+        }
+        else
+        {
+            if (!OpenCaptureFile(&sound_out, sound_name))
+                I_Error("Capture: unable to create %s\n", sound_name.c_str());
+
+            // the size is filled in when finished, which can't be done
+            // with a pipe, so use the maximum like other programs.
+            WriteWAVHeader(0xFFFFFFFF);
+
+            // the game mixes the sound from now on, with the music and
+            // streams decoded on the game thread, in step with the tics.
+            I_LockAudio();
+            mix_in_game = true;
+            I_UnlockAudio();
+
+            S_StopMusicThread();
+            S_StreamStopThread();
+
+            I_Printf("Capture: writing sound to %s (%d Hz %s)\n", sound_name.c_str(), dev_freq,
+                     dev_stereo ? "stereo" : "mono");
+        }
+    }
+
+    // one tic per frame
+    if (E_CaptureActive())
+        singletics = true;
+}
+
+bool E_CaptureActive(void)
+{
+    return video_out.fp || sound_out.fp;
+}
+
+void E_CaptureFrame(void)
+{
+    if (video_out.fp)
+        RGL_QueueReadScreen(CaptureRead, NULL);
+}
+
+void E_CaptureShutdown(void)
+{
+    // collect the frames still being read
+    if (video_out.fp)
+        RGL_UpdateReadScreens(true);
+
+    E_CaptureClose();
+}
+
+void E_CaptureClose(void)
+{
+    if (video_out.fp)
+    {
+        if (video_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(video_lock);
+                video_quit = true;
+            }
+
+            video_cond.notify_all();
+            video_thread.join();
+        }
+
+        I_Printf("Capture: wrote %d frames\n", video_frames);
+
+        CloseCaptureFile(&video_out);
+    }
+
+    if (sound_out.fp)
+    {
+        int channels = dev_stereo ? 2 : 1;
+
+        int64_t data_bytes = sound_pairs * channels * 2;
+
+        if (!sound_out.is_pipe && data_bytes < 0xFFFFFFFF - 36)
+        {
+            fseek(sound_out.fp, 0, SEEK_SET);
+            WriteWAVHeader((uint32_t)data_bytes);
+        }
+
+        I_Printf("Capture: wrote %1.1f seconds of sound\n", sound_pairs / (double)dev_freq);
+
+        CloseCaptureFile(&sound_out);
+
+        I_LockAudio();
+        mix_in_game = false;
+        I_UnlockAudio();
+    }
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------
+//  EDGE Frame Capture
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+
+#ifndef __E_CAPTURE_H__
+#define __E_CAPTURE_H__
+
+void E_CaptureInit(void);
+// check for -capture and -capturewav, and if given start capturing.
+// Must be called after the sound system is started.
+
+bool E_CaptureActive(void);
+
+void E_CaptureFrame(void);
+// capture the frame just drawn (before I_FinishFrame).
+
+void E_CaptureTic(void);
+// mix and write the sound of the game tic just run.
+
+void E_CaptureShutdown(void);
+// write any remaining frames and close the files.
+
+void E_CaptureClose(void);
+// like E_CaptureShutdown(), but without reading the frames which are
+// still being read from the screen, so it is safe after a fatal error.
+
+#endif /* __E_CAPTURE_H__ */
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -0,0 +1,865 @@
+//----------------------------------------------------------------------------
+//  EDGE DDF Reader Check
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Replaces i_main.cc in the edge-ddf-check program.  Each DDF file
+//  given on the command line (directories like edge_defs and edge_base
+//  are searched for them) is read by the old character at a time DDF
+//  reader, kept below exactly as it was, and by DDF_MainReadFile().
+//  Everything they pass to the parse routines, along with the line
+//  number and line contents used for error messages, must be the same.
+//  Then each reader is timed over -repeat <num> runs of every file.
+//
+//  Errors in the files are fatal, like they are in the engine.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+#include "epi_sdl.h" // needed for proper SDL main linkage
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "file.h"
+#include "filesystem.h"
+#include "str_compare.h"
+#include "str_util.h"
+
+#include "local.h"
+
+#include "e_event.h"
+#include "con_gui.h"
+
+#define DEFAULT_REPEAT 20
+
+std::string exe_path = ".";
+
+extern FILE *logfile;
+
+//----------------------------------------------------------------------------
+//  OLD READER
+//----------------------------------------------------------------------------
+
+// enum thats gives the parser's current status
+typedef enum
+{
+    readstatus_invalid = 0,
+    waiting_tag,
+    reading_tag,
+    waiting_newdef,
+    reading_newdef,
+    reading_command,
+    reading_data,
+    reading_remark,
+    reading_string
+} readstatus_e;
+
+// enum thats describes the return value from OldProcessChar
+typedef enum
+{
+    nothing,
+    command_read,
+    property_read,
+    def_start,
+    def_stop,
+    remark_start,
+    remark_stop,
+    separator,
+    string_start,
+    string_stop,
+    group_start,
+    group_stop,
+    tag_start,
+    tag_stop,
+    terminator,
+    ok_char
+} readchar_t;
+
+// the old reader kept its own copy of the current line
+static std::string old_linedata;
+
+static readchar_t OldProcessChar(char character, std::string &token, int status)
+{
+    // -ACB- 1998/08/11 Used for detecting formatting in a string
+    static bool formatchar = false;
+
+    // With the exception of reading_string, whitespace is ignored.
+    if (status != reading_string)
+    {
+        if (isspace(character))
+            return nothing;
+    }
+    else // check for formatting char in a string
+    {
+        if (!formatchar && character == '\\')
+        {
+            formatchar = true;
+            return nothing;
+        }
+    }
+
+    // -AJA- 1999/09/26: Handle unmatched '}' better.
+    if (status != reading_string && character == '{')
+        return remark_start;
+
+    if (status == reading_remark && character == '}')
+        return remark_stop;
+
+    if (status != reading_string && character == '}')
+        DDF_Error("DDF: Encountered '}' without previous '{'.\n");
+
+    switch (status)
+    {
+    case reading_remark:
+        return nothing;
+
+        // -ES- 2000/02/29 Added tag check.
+    case waiting_tag:
+        if (character == '<')
+            return tag_start;
+        else
+            DDF_Error("DDF: File must start with a tag!\n");
+        break;
+
+    case reading_tag:
+        if (character == '>')
+            return tag_stop;
+        else
+        {
+            token += (character);
+            return ok_char;
+        }
+
+    case waiting_newdef:
+        if (character == '[')
+            return def_start;
+        else
+            return nothing;
+
+    case reading_newdef:
+        if (character == ']')
+        {
+            return def_stop;
+        }
+        else if ((isalnum(character)) || (character == '_') || (character == ':') || (character == '+'))
+        {
+            token += toupper(character);
+            return ok_char;
+        }
+        return nothing;
+
+    case reading_command:
+        if (character == '=')
+        {
+            return command_read;
+        }
+        else if (character == ';')
+        {
+            return property_read;
+        }
+        else if (character == '[')
+        {
+            return def_start;
+        }
+        else if (isalnum(character) || character == '_' || character == '(' || character == ')' || character == '.')
+        {
+            token += toupper(character);
+            return ok_char;
+        }
+        return nothing;
+
+        // -ACB- 1998/08/10 Check for string start
+    case reading_data:
+        if (character == '\"')
+            return string_start;
+
+        if (character == ';')
+            return terminator;
+
+        if (character == ',')
+            return separator;
+
+        if (character == '(')
+        {
+            token += (character);
+            return group_start;
+        }
+
+        if (character == ')')
+        {
+            token += (character);
+            return group_stop;
+        }
+
+        // Sprite Data - more than a few exceptions....
+        if (isalnum(character) || character == '_' || character == '-' || character == ':' || character == '.' ||
+            character == '[' || character == ']' || character == '\\' || character == '!' || character == '#' ||
+            character == '%' || character == '+' || character == '@' || character == '?')
+        {
+            token += toupper(character);
+            return ok_char;
+        }
+        else if (isprint(character))
+            DDF_WarnError("DDF: Illegal character '%c' found.\n", character);
+
+        break;
+
+    case reading_string: // -ACB- 1998/08/10 New string handling
+        // -KM- 1999/01/29 Fixed nasty bug where \" would be recognised as
+        //  string end over quote mark.  One of the level text used this.
+        if (formatchar)
+        {
+            // -ACB- 1998/08/11 Formatting check: Carriage-return.
+            if (character == 'n')
+            {
+                token += ('\n');
+                formatchar = false;
+                return ok_char;
+            }
+            else if (character == '\"') // -KM- 1998/10/29 Also recognise quote
+            {
+                token += ('\"');
+                formatchar = false;
+                return ok_char;
+            }
+            else if (character == '\\') // -ACB- 1999/11/24 Double backslash means directory
+            {
+                token += ('\\');
+                formatchar = false;
+                return ok_char;
+            }
+            else // -ACB- 1999/11/24 Any other characters are treated in the norm
+            {
+                token += (character);
+                formatchar = false;
+                return ok_char;
+            }
+        }
+        else if (character == '\"')
+        {
+            return string_stop;
+        }
+        else if (character == '\n')
+        {
+            cur_ddf_line_num--;
+            DDF_WarnError("Unclosed string detected.\n");
+
+            cur_ddf_line_num++;
+            return nothing;
+        }
+        // -KM- 1998/10/29 Removed ascii check, allow foreign characters (?)
+        // -ES- HEY! Swedish is not foreign!
+        else
+        {
+            token += (character);
+            return ok_char;
+        }
+
+    default: // doh!
+        I_Error("OldProcessChar: INTERNAL ERROR: "
+                "Bad status value %d !\n",
+                status);
+        break;
+    }
+
+    return nothing;
+}
+
+static void OldReadFile(readinfo_t *readinfo, const std::string &data)
+{
+    std::string token;
+    std::string current_cmd;
+
+    char *name  = NULL;
+    char *value = NULL;
+
+    int current_index = 0;
+    int entry_count   = 0;
+
+    int status       = waiting_tag;
+    int formerstatus = nothing;
+
+    int  comment_level = 0;
+    int  bracket_level = 0;
+    bool firstgo       = true;
+
+    cur_ddf_line_num = 1;
+    cur_ddf_filename = std::string(readinfo->lumpname);
+    cur_ddf_entryname.clear();
+
+    // WISH: don't make this copy, parse directly from the string
+    char *memfile = new char[data.size() + 1];
+    data.copy(memfile, std::string::npos);
+    memfile[data.size()] = 0;
+
+    char *memfileptr = memfile;
+    int   memsize    = (int)data.size();
+
+    // -ACB- 1998/09/12 Copy file to memory: Read until end. Speed optimisation.
+    while (memfileptr < &memfile[memsize])
+    {
+        // -KM- 1998/12/16 Added #define command to ddf files.
+        if (epi::StringPrefixCaseCompareASCII(std::string_view(memfileptr, 7), "#DEFINE") == 0)
+        {
+            bool line = false;
+
+            memfileptr += 8;
+            name = memfileptr;
+
+            while (*memfileptr != ' ' && memfileptr < &memfile[memsize])
+                memfileptr++;
+
+            if (memfileptr < &memfile[memsize])
+            {
+                *memfileptr++ = 0;
+                value         = memfileptr;
+            }
+            else
+            {
+                DDF_Error("#DEFINE '%s' as what?!\n", name);
+            }
+
+            // FIXME handle comments, stop at "//"
+
+            while (memfileptr < &memfile[memsize])
+            {
+                if (*memfileptr == '\r')
+                    *memfileptr = ' ';
+                if (*memfileptr == '\\')
+                    line = true;
+                if (*memfileptr == '\n' && !line)
+                    break;
+                memfileptr++;
+            }
+
+            if (*memfileptr == '\n')
+                cur_ddf_line_num++;
+
+            *memfileptr++ = 0;
+
+            DDF_MainAddDefine(name, value);
+
+            token.clear();
+            continue;
+        }
+
+        // -AJA- 1999/10/27: Not the greatest place for it, but detect //
+        //       comments here and ignore them.  Ow the pain of long
+        //       identifier names...  Ow the pain of &memfile[size] :-)
+
+        if (comment_level == 0 && status != reading_string && memfileptr + 1 < &memfile[memsize] &&
+            memfileptr[0] == '/' && memfileptr[1] == '/')
+        {
+            while (memfileptr < &memfile[memsize] && *memfileptr != '\n')
+                memfileptr++;
+
+            if (memfileptr >= &memfile[memsize])
+                break;
+        }
+
+        char character = *memfileptr++;
+
+        if (character == '\n')
+        {
+            int l_len;
+
+            cur_ddf_line_num++;
+
+            // -AJA- 2000/03/21: determine linedata.  Ouch.
+            for (l_len = 0;
+                 &memfileptr[l_len] < &memfile[memsize] && memfileptr[l_len] != '\n' && memfileptr[l_len] != '\r';
+                 l_len++)
+            {
+            }
+
+            old_linedata     = std::string(memfileptr, l_len);
+            cur_ddf_linedata = old_linedata;
+
+            // -AJA- 2001/05/21: handle directives (lines beginning with #).
+            // This code is more hackitude -- to be fixed when the whole
+            // parsing code gets the overhaul it needs.
+
+            if (epi::StringPrefixCaseCompareASCII(std::string_view(memfileptr, 9), "#CLEARALL") == 0)
+            {
+                if (!firstgo)
+                    DDF_Error("#CLEARALL cannot be used inside an entry !\n");
+
+                (*readinfo->clear_all)();
+
+                memfileptr += l_len;
+                continue;
+            }
+
+            if (epi::StringPrefixCaseCompareASCII(std::string_view(memfileptr, 8), "#VERSION") == 0)
+            {
+                // just ignore it
+                memfileptr += l_len;
+                continue;
+            }
+        }
+
+        int response = OldProcessChar(character, token, status);
+
+        switch (response)
+        {
+        case remark_start:
+            if (comment_level == 0)
+            {
+                formerstatus = status;
+                status       = reading_remark;
+            }
+            comment_level++;
+            break;
+
+        case remark_stop:
+            comment_level--;
+            if (comment_level == 0)
+            {
+                status = formerstatus;
+            }
+            break;
+
+        case command_read:
+            if (!token.empty())
+                current_cmd = token.c_str();
+            else
+                current_cmd.clear();
+
+            SYS_ASSERT(current_index == 0);
+
+            token.clear();
+            status = reading_data;
+            break;
+
+        case tag_start:
+            status = reading_tag;
+            break;
+
+        case tag_stop:
+            if (epi::StringCaseCompareASCII(token, readinfo->tag) != 0)
+                DDF_Error("Start tag <%s> expected, found <%s>!\n", readinfo->tag, token.c_str());
+
+            status = waiting_newdef;
+            token.clear();
+            break;
+
+        case def_start:
+            if (bracket_level > 0)
+                DDF_Error("Unclosed () brackets detected.\n");
+
+            entry_count++;
+
+            if (firstgo)
+            {
+                firstgo = false;
+                status  = reading_newdef;
+            }
+            else
+            {
+                old_linedata.clear();
+                cur_ddf_linedata = old_linedata;
+
+                // finish off previous entry
+                (*readinfo->finish_entry)();
+
+                token.clear();
+
+                status = reading_newdef;
+
+                cur_ddf_entryname.clear();
+            }
+            break;
+
+        case def_stop:
+            cur_ddf_entryname = epi::StringFormat("[%s]", token.c_str());
+
+            // -AJA- 2009/07/27: extend an existing entry
+            if (token[0] == '+' && token[1] == '+')
+                (*readinfo->start_entry)(token.c_str() + 2, true);
+            else
+                (*readinfo->start_entry)(token.c_str(), false);
+
+            token.clear();
+            status = reading_command;
+            break;
+
+            // -AJA- 2000/10/02: support for () brackets
+        case group_start:
+            if (status == reading_data || status == reading_command)
+                bracket_level++;
+            break;
+
+        case group_stop:
+            if (status == reading_data || status == reading_command)
+            {
+                bracket_level--;
+                if (bracket_level < 0)
+                    DDF_Error("Unexpected `)' bracket.\n");
+            }
+            break;
+
+        case separator:
+            if (bracket_level > 0)
+            {
+                token += (',');
+                break;
+            }
+
+            if (current_cmd.empty())
+                DDF_Error("Unexpected comma `,'.\n");
+
+            if (firstgo)
+                DDF_WarnError("Command %s used outside of any entry\n", current_cmd.c_str());
+            else
+            {
+                (*readinfo->parse_field)(current_cmd.c_str(), DDF_MainGetDefine(token.c_str()), current_index, false);
+                current_index++;
+            }
+
+            token.clear();
+            break;
+
+            // -ACB- 1998/08/10 String Handling
+        case string_start:
+            status = reading_string;
+            break;
+
+            // -ACB- 1998/08/10 String Handling
+        case string_stop:
+            status = reading_data;
+            break;
+
+        case terminator:
+            if (current_cmd.empty())
+                DDF_Error("Unexpected semicolon `;'.\n");
+
+            if (bracket_level > 0)
+                DDF_Error("Missing ')' bracket in ddf command.\n");
+
+            (*readinfo->parse_field)(current_cmd.c_str(), DDF_MainGetDefine(token.c_str()), current_index, true);
+            current_index = 0;
+
+            token.clear();
+            status = reading_command;
+            break;
+
+        case property_read:
+            DDF_WarnError("Badly formed command: Unexpected semicolon `;'\n");
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    current_cmd.clear();
+    old_linedata.clear();
+    cur_ddf_linedata = old_linedata;
+
+    // -AJA- 1999/10/21: check for unclosed comments
+    if (comment_level > 0)
+        DDF_Error("Unclosed comments detected.\n");
+
+    if (bracket_level > 0)
+        DDF_Error("Unclosed () brackets detected.\n");
+
+    if (status == reading_tag)
+        DDF_Error("Unclosed <> brackets detected.\n");
+
+    if (status == reading_newdef)
+        DDF_Error("Unclosed [] brackets detected.\n");
+
+    if (status == reading_data || status == reading_string)
+        DDF_WarnError("Unfinished DDF command on last line.\n");
+
+    // if firstgo is true, nothing was defined
+    if (!firstgo)
+        (*readinfo->finish_entry)();
+
+    delete[] memfile;
+
+    cur_ddf_entryname.clear();
+    cur_ddf_filename.clear();
+
+    DDF_MainFreeDefines();
+}
+
+//----------------------------------------------------------------------------
+//  RECORDING
+//----------------------------------------------------------------------------
+
+typedef struct
+{
+    const char *filename;
+    const char *tag;
+} ddf_check_file_t;
+
+static const ddf_check_file_t check_files[] = {
+    {"language.ldf", "LANGUAGES"}, {"sounds.ddf", "SOUNDS"},    {"colmap.ddf", "COLOURMAPS"},
+    {"images.ddf", "IMAGES"},      {"fonts.ddf", "FONTS"},      {"styles.ddf", "STYLES"},
+    {"attacks.ddf", "ATTACKS"},    {"weapons.ddf", "WEAPONS"},  {"things.ddf", "THINGS"},
+    {"playlist.ddf", "PLAYLISTS"}, {"lines.ddf", "LINES"},      {"sectors.ddf", "SECTORS"},
+    {"switch.ddf", "SWITCHES"},    {"anims.ddf", "ANIMATIONS"}, {"games.ddf", "GAMES"},
+    {"levels.ddf", "LEVELS"},      {"flats.ddf", "FLATS"},      {"movies.ddf", "MOVIES"},
+    {"wadfixes.ddf", "FIXES"},     {NULL, NULL}};
+
+// everything the reader passed to the parse routines, one line each
+static std::string check_log;
+
+// counts the commands when timing
+static int check_commands;
+
+static void CheckLog(const char *what)
+{
+    check_log += epi::StringFormat("%s @%d %s [%.*s]\n", what, cur_ddf_line_num, cur_ddf_entryname.c_str(),
+                                   (int)cur_ddf_linedata.size(), cur_ddf_linedata.data());
+}
+
+static void CheckStartEntry(const char *name, bool extend)
+{
+    CheckLog(epi::StringFormat("start %s%s", name, extend ? " (extend)" : "").c_str());
+}
+
+static void CheckParseField(const char *field, const char *contents, int index, bool is_last)
+{
+    CheckLog(epi::StringFormat("field %s #%d%s = %s", field, index, is_last ? " (last)" : "", contents).c_str());
+}
+
+static void CheckFinishEntry(void)
+{
+    CheckLog("finish");
+}
+
+static void CheckClearAll(void)
+{
+    CheckLog("clearall");
+}
+
+static void TimeStartEntry(const char *name, bool extend)
+{
+}
+
+static void TimeParseField(const char *field, const char *contents, int index, bool is_last)
+{
+    check_commands++;
+}
+
+static void TimeFinishEntry(void)
+{
+}
+
+static void TimeClearAll(void)
+{
+}
+
+//----------------------------------------------------------------------------
+
+static const char *FindTag(const std::string &path)
+{
+    std::string filename = epi::GetFilename(path);
+
+    for (int i = 0; check_files[i].filename; i++)
+        if (epi::StringCaseCompareASCII(filename, check_files[i].filename) == 0)
+            return check_files[i].tag;
+
+    return NULL;
+}
+
+static void AddFiles(std::vector<std::string> &list, std::string path)
+{
+    // the directory functions need an absolute path
+    if (!epi::IsPathAbsolute(path))
+        path = epi::PathAppend(epi::CurrentDirectoryGet(), path);
+
+    if (!epi::IsDirectory(path))
+    {
+        if (!FindTag(path))
+            I_Error("edge-ddf-check: not a DDF file: %s\n", path.c_str());
+
+        list.push_back(path);
+        return;
+    }
+
+    std::vector<epi::DirectoryEntry> fsd;
+
+    if (!epi::WalkDirectory(fsd, path))
+        I_Error("edge-ddf-check: failed to read directory: %s\n", path.c_str());
+
+    std::sort(fsd.begin(), fsd.end(),
+              [](const epi::DirectoryEntry &A, const epi::DirectoryEntry &B) { return A.name < B.name; });
+
+    for (auto &entry : fsd)
+        if (!entry.is_dir && FindTag(entry.name))
+            list.push_back(entry.name);
+}
+
+static std::string LoadFile(const std::string &filename)
+{
+    epi::File *F = epi::FileOpen(filename, epi::kFileAccessRead | epi::kFileAccessBinary);
+    if (F == NULL)
+        I_Error("edge-ddf-check: couldn't open file: %s\n", filename.c_str());
+
+    char *raw_data = (char *)F->LoadIntoMemory();
+    if (raw_data == NULL)
+        I_Error("edge-ddf-check: couldn't read file: %s\n", filename.c_str());
+
+    std::string data(raw_data);
+
+    delete[] raw_data;
+    delete F;
+
+    return data;
+}
+
+// returns the time taken in microseconds
+static int64_t TimeReader(bool use_old, readinfo_t *readinfo, const std::string &data, int repeat)
+{
+    readinfo_t time_info = *readinfo;
+
+    time_info.start_entry  = TimeStartEntry;
+    time_info.parse_field  = TimeParseField;
+    time_info.finish_entry = TimeFinishEntry;
+    time_info.clear_all    = TimeClearAll;
+
+    int64_t start_time = I_GetTimeMicros();
+
+    for (int r = 0; r < repeat; r++)
+    {
+        if (use_old)
+            OldReadFile(&time_info, data);
+        else
+            DDF_MainReadFile(&time_info, data);
+    }
+
+    return I_GetTimeMicros() - start_time;
+}
+
+static void ShowUsage(void)
+{
+    I_Printf("Usage: edge-ddf-check [-repeat <num>] <file or directory> ...\n");
+    I_Printf("e.g.   edge-ddf-check edge_defs edge_base\n");
+}
+
+extern "C"
+{
+
+    int main(int argc, char *argv[])
+    {
+        // messages (and errors) go straight to the terminal
+        logfile = stdout;
+
+        CON_InitConsole();
+
+        int repeat = DEFAULT_REPEAT;
+
+        std::vector<std::string> files;
+
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "-repeat") == 0 && i + 1 < argc)
+            {
+                repeat = atoi(argv[++i]);
+
+                if (repeat < 1)
+                    repeat = 1;
+
+                continue;
+            }
+
+            AddFiles(files, argv[i]);
+        }
+
+        if (files.empty())
+        {
+            ShowUsage();
+            return EXIT_FAILURE;
+        }
+
+        int     different = 0;
+        int64_t old_total = 0;
+        int64_t new_total = 0;
+
+        for (const std::string &filename : files)
+        {
+            std::string data = LoadFile(filename);
+
+            readinfo_t readinfo;
+
+            readinfo.lumpname     = filename.c_str();
+            readinfo.tag          = FindTag(filename);
+            readinfo.start_entry  = CheckStartEntry;
+            readinfo.parse_field  = CheckParseField;
+            readinfo.finish_entry = CheckFinishEntry;
+            readinfo.clear_all    = CheckClearAll;
+
+            check_log.clear();
+            OldReadFile(&readinfo, data);
+
+            std::string old_log;
+            old_log.swap(check_log);
+
+            DDF_MainReadFile(&readinfo, data);
+
+            if (old_log != check_log)
+            {
+                // show the first line which differs
+                size_t pos = 0;
+
+                while (pos < old_log.size() && pos < check_log.size() && old_log[pos] == check_log[pos])
+                    pos++;
+
+                pos = old_log.rfind('\n', pos);
+                pos = (pos == std::string::npos) ? 0 : pos + 1;
+
+                I_Printf("%s: DIFFERENT\n", filename.c_str());
+                I_Printf("  old: %s\n", old_log.substr(pos, old_log.find('\n', pos) - pos).c_str());
+                I_Printf("  new: %s\n", check_log.substr(pos, check_log.find('\n', pos) - pos).c_str());
+
+                different++;
+                continue;
+            }
+
+            check_commands = 0;
+
+            int64_t old_time = TimeReader(true, &readinfo, data, repeat);
+            int64_t new_time = TimeReader(false, &readinfo, data, repeat);
+
+            I_Printf("%s: same, %d KB, %d commands, old %1.3f ms, new %1.3f ms\n", filename.c_str(),
+                     (int)(data.size() / 1024), check_commands / (repeat * 2), old_time / 1000.0 / repeat,
+                     new_time / 1000.0 / repeat);
+
+            old_total += old_time;
+            new_total += new_time;
+        }
+
+        I_Printf("\n%d files, %d different\n", (int)files.size(), different);
+
+        if (new_total > 0)
+            I_Printf("Total: old reader %1.2f ms, new reader %1.2f ms (%1.1fx)\n", old_total / 1000.0 / repeat,
+                     new_total / 1000.0 / repeat, (double)old_total / new_total);
+
+        return (different > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+} // extern "C"
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
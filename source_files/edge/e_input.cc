@@ -47,8 +47,6 @@ extern bool G_Responder(event_t *ev);
 
 extern int I_JoyGetAxis(int n);
 
-extern cvar_c r_doubleframes;
-
 //
 // EVENT HANDLING
 //
@@ -340,7 +338,7 @@ void E_BuildTiccmd(ticcmd_t *cmd)
     // Turning
     if (!strafe)
     {
-        float turn = angleturn[t_speed] / (r_doubleframes.d ? 2 : 1) * joy_forces[AXIS_TURN];
+        float turn = angleturn[t_speed] * joy_forces[AXIS_TURN];
 
         turn *= turnspeed.f;
 
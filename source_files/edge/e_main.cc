@@ -34,6 +34,7 @@
 #include "i_defs.h"
 #include "epi_sdl.h"
 #include "e_main.h"
+#include "e_pacer.h"
 #include "i_defs_gl.h"
 #include "i_movie.h"
 
@@ -54,9 +55,11 @@
 #include "dm_defs.h"
 #include "dm_state.h"
 #include "dstrings.h"
+#include "e_capture.h"
 #include "e_input.h"
 #include "f_finale.h"
 #include "f_interm.h"
+#include "g_demo.h"
 #include "g_game.h"
 #include "hu_draw.h"
 #include "hu_stuff.h"
@@ -81,6 +84,7 @@
 #include "r_draw.h"
 #include "r_modes.h"
 #include "r_image.h"
+#include "r_interp.h"
 #include "w_files.h"
 #include "w_model.h"
 #include "w_sprite.h"
@@ -257,18 +261,22 @@ class startup_progress_c
         if (v_gamma.f < 0)
         {
             int col = (1.0f + v_gamma.f) * 255;
+            HUD_FlushBatch();
             glEnable(GL_BLEND);
             glBlendFunc(GL_ZERO, GL_SRC_COLOR);
             HUD_SolidBox(hud_x_left, 0, hud_x_right, 200, epi::MakeRGBA(col, col, col));
+            HUD_FlushBatch();
             glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             glDisable(GL_BLEND);
         }
         else if (v_gamma.f > 0)
         {
             int col = v_gamma.f * 255;
+            HUD_FlushBatch();
             glEnable(GL_BLEND);
             glBlendFunc(GL_DST_COLOR, GL_ONE);
             HUD_SolidBox(hud_x_left, 0, hud_x_right, 200, epi::MakeRGBA(col, col, col));
+            HUD_FlushBatch();
             glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             glDisable(GL_BLEND);
         }
@@ -301,6 +309,11 @@ static void SetGlobalVars(void)
     else if (argv::Find("windowed") > 0)
         DISPLAYMODE = 0;
 
+#ifdef EDGE_SIM_BENCH
+    // the playsim benchmark never opens a window
+    DISPLAYMODE = 0;
+#endif
+
     s = argv::Value("width");
     if (!s.empty())
     {
@@ -380,6 +393,10 @@ static void SetGlobalVars(void)
     argv::CheckBooleanParm("rotatemap", &rotatemap, false);
     argv::CheckBooleanParm("sound", &nosound, true);
     argv::CheckBooleanParm("music", &nomusic, true);
+#ifdef EDGE_SIM_BENCH
+    nosound = true;
+    nomusic = true;
+#endif
     argv::CheckBooleanParm("itemrespawn", &global_flags.itemrespawn, false);
     argv::CheckBooleanParm("mlook", &global_flags.mlook, false);
     argv::CheckBooleanParm("monsters", &global_flags.nomonsters, true);
@@ -582,8 +599,14 @@ void E_Display(void)
     // Start the frame - should we need to.
     I_StartFrame();
 
+    // collect screen reads from the last frame
+    RGL_UpdateReadScreens(false);
+    M_UpdateScreenShots(false);
+
     HUD_FrameSetup();
 
+    R_UpdateFractionalTic();
+
     switch (gamestate)
     {
     case GS_LEVEL:
@@ -663,18 +686,22 @@ void E_Display(void)
     if (v_gamma.f < 0)
     {
         int col = (1.0f + v_gamma.f) * 255;
+        HUD_FlushBatch();
         glEnable(GL_BLEND);
         glBlendFunc(GL_ZERO, GL_SRC_COLOR);
         HUD_SolidBox(hud_x_left, 0, hud_x_right, 200, epi::MakeRGBA(col, col, col));
+        HUD_FlushBatch();
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glDisable(GL_BLEND);
     }
     else if (v_gamma.f > 0)
     {
         int col = v_gamma.f * 255;
+        HUD_FlushBatch();
         glEnable(GL_BLEND);
         glBlendFunc(GL_DST_COLOR, GL_ONE);
         HUD_SolidBox(hud_x_left, 0, hud_x_right, 200, epi::MakeRGBA(col, col, col));
+        HUD_FlushBatch();
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glDisable(GL_BLEND);
     }
@@ -692,6 +719,8 @@ void E_Display(void)
             M_ScreenShot(false);
     }
 
+    E_CaptureFrame();
+
     I_FinishFrame(); // page flip or blit buffer
 }
 
@@ -934,14 +963,14 @@ void E_AdvanceTitle(void)
         if (title_pic == 0 && g->titlemusic > 0)
             S_ChangeMusic(g->titlemusic, false);
 
-        title_countdown = g->titletics * (r_doubleframes.d ? 2 : 1);
+        title_countdown = g->titletics;
         return;
     }
 
     // not found
 
     title_image     = NULL;
-    title_countdown = TICRATE * (r_doubleframes.d ? 2 : 1);
+    title_countdown = TICRATE;
 }
 
 void E_StartTitle(void)
@@ -1879,6 +1908,32 @@ static void InitDDF(void)
     DDF_Init();
 }
 
+// key of the current DDF snapshot (depends on all the loaded files)
+static uint32_t ddf_snapshot_key;
+
+static std::string DDFSnapshotFilename(void)
+{
+    return epi::PathAppend(cache_dir, "ddf_snapshot.dat");
+}
+
+static void LoadDDFSnapshot(void)
+{
+    // only used with -ddfcache, since the DDF modules still have to
+    // process every command and a plain parse is usually just as fast
+    if (argv::Find("ddfcache") <= 0)
+        return;
+
+    ddf_snapshot_key = W_LoadOrderKey();
+
+    DDF_LoadSnapshot(DDFSnapshotFilename(), ddf_snapshot_key);
+}
+
+static void SaveDDFSnapshot(void)
+{
+    // this does nothing unless LoadDDFSnapshot() could not use one
+    DDF_SaveSnapshot(DDFSnapshotFilename(), ddf_snapshot_key);
+}
+
 void E_EngineShutdown(void)
 {
     S_StopMusic();
@@ -1892,6 +1947,10 @@ void E_EngineShutdown(void)
 
     P_Shutdown();
 
+    E_CaptureShutdown();
+    M_ShutdownScreenShots();
+    RGL_FreeReadScreens();
+
     S_Shutdown();
     R_Shutdown();
     N_Shutdown();
@@ -1938,8 +1997,10 @@ static void E_Startup(void)
     CheckTurbo();
 
     RAD_Init();
+    LoadDDFSnapshot();
     W_ProcessMultipleFiles();
     DDF_ParseEverything();
+    SaveDDFSnapshot();
     // Must be done after WAD and DDF loading to check for potential
     // overrides of lump-specific image/sound/DDF defines
     W_DoPackSubstitutions();
@@ -1965,7 +2026,6 @@ static void E_Startup(void)
     ShowNotice();
 
     SV_MainInit();
-    S_PrecacheSounds();
     W_InitSprites();
     W_ProcessTX_HI();
     W_InitModels();
@@ -1977,6 +2037,8 @@ static void E_Startup(void)
     P_InitSwitchList();
     W_InitPicAnims();
     S_Init();
+    S_PrecacheSounds();
+    E_CaptureInit();
     N_InitNetwork();
     M_CheatInit();
     if (LUA_UseLuaHud())
@@ -1994,6 +2056,15 @@ static void E_Startup(void)
 static void E_Shutdown(void)
 {
     /* TODO: E_Shutdown */
+
+    G_StopDemo();
+
+    // finish writing these when the window is closed
+    E_CaptureShutdown();
+    M_ShutdownScreenShots();
+
+    // the sound threads must be stopped before the program exits
+    S_Shutdown();
 }
 
 static void E_InitialState(void)
@@ -2002,12 +2073,21 @@ static void E_InitialState(void)
 
     std::string ps;
 
-    // do loadgames first, as they contain all of the
-    // necessary state already (in the savegame).
+    // do demos and loadgames first, as they contain all of the
+    // necessary state already.
+
+    ps = argv::Value("timedemo");
+    if (!ps.empty())
+    {
+        G_DeferredPlayDemo(ps, true);
+        return;
+    }
 
-    if (argv::Find("playdemo") > 0 || argv::Find("timedemo") > 0 || argv::Find("record") > 0)
+    ps = argv::Value("playdemo");
+    if (!ps.empty())
     {
-        I_Error("Demos are no longer supported\n");
+        G_DeferredPlayDemo(ps, false);
+        return;
     }
 
     ps = argv::Value("loadgame");
@@ -2026,6 +2106,11 @@ static void E_InitialState(void)
 
     int bots = 0;
 
+    // recording a demo starts a new game, like -warp
+    std::string record_name = argv::Value("record");
+    if (!record_name.empty())
+        warp = true;
+
     ps = argv::Value("bots");
     if (!ps.empty())
         bots = atoi(ps.c_str());
@@ -2092,6 +2177,12 @@ static void E_InitialState(void)
 
     params.SinglePlayer(bots);
 
+    if (!record_name.empty())
+    {
+        G_DeferredRecordDemo(record_name, params);
+        return;
+    }
+
     G_DeferredNewGame(params);
 }
 
@@ -2121,6 +2212,10 @@ void E_Main(int argc, const char **argv)
 
     E_InitialState();
 
+#ifdef EDGE_SIM_BENCH
+    E_SimBench(); // never returns
+#endif
+
     CON_MessageColor(SG_YELLOW_RGBA32);
     I_Printf("%s v%s initialisation complete.\n", appname.c_str(), edgeversion.c_str());
 
@@ -2164,36 +2259,50 @@ void E_Idle(void)
 void E_Tick(void)
 {
     EDGE_ZoneScoped;
-    
+
+    G_TimeDemoFrame();
+
     G_BigStuff();
+    G_TimeDemoMark(TD_Other);
 
     // Update display, next frame, with current state.
     E_Display();
+    G_TimeDemoMark(TD_Render);
 
-    // this also runs the responder chain via E_ProcessEvents
-    int counts = N_TryRunTics();
-
-    // ignore this assertion if in a menu; switching between 35/70FPS
-    // in Video Options can occasionally produce a 'valid'
-    // zero count for N_TryRunTics()
+    E_PacerFrameDone();
 
-    if (!menuactive)
-        SYS_ASSERT(counts > 0);
+    // this also runs the responder chain via E_ProcessEvents.
+    // the count is zero when another frame is drawn before the next tic.
+    int counts = N_TryRunTics();
+    G_TimeDemoMark(TD_Other);
 
     // run the tics
     for (; counts > 0; counts--)
     {
         // run a step in the physics (etc)
         G_Ticker();
+        G_TimeDemoMark(TD_Game);
 
         // user interface stuff (skull anim, etc)
         CON_Ticker();
         M_Ticker();
+        G_TimeDemoMark(TD_Other);
+
         S_SoundTicker();
         S_MusicTicker();
+        E_CaptureTic();
+        G_TimeDemoMark(TD_Sound);
 
         // process mouse and keyboard events
         N_NetUpdate();
+
+        G_TimeDemoMark(TD_Other);
+
+        // if the level was completed (etc), deal with it before running
+        // any more tics, so the same tics are run whatever the frame rate
+        // (which demos rely on).
+        if (gameaction != ga_nothing)
+            break;
     }
 }
 
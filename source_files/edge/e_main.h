@@ -40,6 +40,9 @@ void E_EngineShutdown(void);
 void E_ForceWipe(void);
 void E_Display(void);
 
+void E_SimBench(void);
+// main loop of the headless playsim benchmark (edge-sim-bench only).
+
 // startup progress stuff
 
 void E_ProgressMessage(const char *message);
@@ -0,0 +1,247 @@
+//----------------------------------------------------------------------------
+//  EDGE Frame Pacing
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Decides when frames are started and waits for them (or the next
+//  tic) without spinning a core.  The OS usually wakes a sleeping
+//  thread a little late, so we keep track of how late and sleep for
+//  that much less, spinning for the remainder.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+
+#include <thread>
+
+#include "e_pacer.h"
+
+extern cvar_c r_doubleframes;
+extern cvar_c v_sync;
+extern cvar_c n_busywait;
+
+// frame interval for the 70 FPS setting, in microseconds
+#define FRAME_INTERVAL (1000000 / 70)
+
+// with vsync on, the buffer swap already waits for the display, so we
+// only limit frames ourselves when the display is faster than this.
+#define VSYNC_LIMIT_HZ 80
+
+// frames starting later than this after they were due are missed
+#define LATE_THRESHOLD 2000
+
+// limits for the expected wake-up lateness, in microseconds.  Coarse
+// system timers (about 15 ms) end up near the top.
+#define MIN_SLACK 100
+#define MAX_SLACK 16000
+
+// don't bother sleeping for less than this
+#define MIN_SLEEP 200
+
+// frame time histogram, bucket limits in milliseconds
+#define NUM_BUCKETS 10
+
+static const int bucket_limits[NUM_BUCKETS] = {5, 10, 15, 20, 25, 30, 40, 50, 100, 0};
+
+static int64_t sleep_slack = 1000;
+
+static int64_t frame_start = 0; // when the current frame started
+static int64_t frame_due   = 0; // when it should have started
+
+typedef struct
+{
+    int64_t since;
+
+    int frames;
+    int missed_frames;
+    int late_tics;
+
+    int64_t total_cost;
+    int64_t max_cost;
+    int64_t asleep;
+
+    int buckets[NUM_BUCKETS];
+} pacer_stats_t;
+
+static pacer_stats_t stats;
+
+void E_PacerWaitUntil(int64_t when)
+{
+    for (;;)
+    {
+        int64_t now    = I_GetTimeMicros();
+        int64_t remain = when - now;
+
+        if (remain <= 0)
+            return;
+
+        int64_t sleep_time = remain - sleep_slack;
+
+        if (n_busywait.d || sleep_time < MIN_SLEEP)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        I_SleepMicros((int)sleep_time);
+
+        int64_t woke = I_GetTimeMicros();
+        int64_t late = woke - (now + sleep_time);
+
+        stats.asleep += woke - now;
+
+        // jump up to a larger lateness straight away, come down slowly
+        if (late > sleep_slack)
+            sleep_slack = late;
+        else
+            sleep_slack = (sleep_slack * 15 + late) / 16;
+
+        sleep_slack = HMM_MAX(MIN_SLACK, HMM_MIN(sleep_slack, MAX_SLACK));
+    }
+}
+
+static int64_t FrameInterval(void)
+{
+    // only the 70 FPS setting limits frames between tics
+    if (r_doubleframes.d != 1)
+        return 0;
+
+    if (v_sync.d)
+    {
+        int hz = I_GetRefreshRate();
+
+        if (hz > 0 && hz <= VSYNC_LIMIT_HZ)
+            return 0;
+    }
+
+    return FRAME_INTERVAL;
+}
+
+static int64_t FrameDueTime(int64_t now, int64_t interval)
+{
+    if (interval == 0 || frame_due == 0)
+        return now;
+
+    int64_t next = frame_due + interval;
+
+    // more than a whole frame behind, start counting again from now
+    if (next < now - interval)
+        return now;
+
+    return next;
+}
+
+int64_t E_PacerNextFrame(int64_t next_tic)
+{
+    int64_t now      = I_GetTimeMicros();
+    int64_t interval = FrameInterval();
+    int64_t next     = FrameDueTime(now, interval);
+
+    // the tic comes first, or so soon after that the frame would be
+    // wasted (it gets drawn along with the tic instead).
+    if (next + interval / 2 >= next_tic)
+        return 0;
+
+    return next;
+}
+
+void E_PacerFrameStart(void)
+{
+    int64_t now = I_GetTimeMicros();
+
+    if (frame_start > 0)
+    {
+        int ms = (int)((now - frame_start) / 1000);
+
+        int b = 0;
+        while (b < NUM_BUCKETS - 1 && ms >= bucket_limits[b])
+            b++;
+
+        stats.buckets[b]++;
+        stats.frames++;
+    }
+
+    int64_t interval = FrameInterval();
+    int64_t due      = FrameDueTime(now, interval);
+
+    if (interval > 0 && now - due > LATE_THRESHOLD)
+        stats.missed_frames++;
+
+    frame_start = now;
+    frame_due   = (now - due > LATE_THRESHOLD) ? now : HMM_MIN(due, now);
+}
+
+void E_PacerFrameDone(void)
+{
+    if (frame_start == 0)
+        return;
+
+    int64_t cost = I_GetTimeMicros() - frame_start;
+
+    stats.total_cost += cost;
+    stats.max_cost = HMM_MAX(stats.max_cost, cost);
+}
+
+void E_PacerLateTics(int count)
+{
+    stats.late_tics += count;
+}
+
+void E_PacerResetStats(void)
+{
+    stats       = pacer_stats_t();
+    stats.since = I_GetTimeMicros();
+}
+
+void E_PacerShowStats(void)
+{
+    int64_t elapsed = I_GetTimeMicros() - stats.since;
+
+    if (stats.frames == 0 || elapsed <= 0)
+    {
+        I_Printf("Frame pacing: no frames yet\n");
+        return;
+    }
+
+    double seconds = elapsed / 1000000.0;
+
+    I_Printf("Frame pacing: %d frames in %1.1f seconds (%1.1f FPS)\n", stats.frames, seconds,
+             stats.frames / seconds);
+    I_Printf("Frame cost: average %1.2f ms, maximum %1.2f ms\n", stats.total_cost / 1000.0 / stats.frames,
+             stats.max_cost / 1000.0);
+    I_Printf("Missed deadlines: %d frames, %d tics\n", stats.missed_frames, stats.late_tics);
+    I_Printf("Asleep %1.0f%% of the time, wake-up slack %1.2f ms\n", stats.asleep * 100.0 / elapsed,
+             sleep_slack / 1000.0);
+
+    I_Printf("Frame times:\n");
+
+    int low = 0;
+
+    for (int b = 0; b < NUM_BUCKETS; b++)
+    {
+        int count = stats.buckets[b];
+
+        if (bucket_limits[b] > 0)
+            I_Printf("  %3d-%3d ms : %6d (%3d%%)\n", low, bucket_limits[b], count, count * 100 / stats.frames);
+        else
+            I_Printf("  %3d+    ms : %6d (%3d%%)\n", low, count, count * 100 / stats.frames);
+
+        low = bucket_limits[b];
+    }
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------
+//  EDGE Frame Pacing
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+
+#ifndef __E_PACER_H__
+#define __E_PACER_H__
+
+// all times here are from I_GetTimeMicros()
+
+void E_PacerWaitUntil(int64_t when);
+// sleep until the given time.  Most of the wait is spent asleep, only
+// the last part (how late the OS tends to wake us) is spun.
+
+int64_t E_PacerNextFrame(int64_t next_tic);
+// when the next frame in between tics should be started (the current
+// time if frames are not limited, i.e. uncapped or left to vsync), or
+// zero when the tic starting at 'next_tic' should be waited for.
+
+void E_PacerFrameStart(void);
+// a frame (and any tics before it) is about to run.
+
+void E_PacerFrameDone(void);
+// the frame has been drawn and shown.
+
+void E_PacerLateTics(int count);
+// the game is running 'count' tics behind.
+
+void E_PacerShowStats(void);
+void E_PacerResetStats(void);
+
+#endif /* __E_PACER_H__ */
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
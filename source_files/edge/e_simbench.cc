@@ -0,0 +1,340 @@
+//----------------------------------------------------------------------------
+//  EDGE Headless Playsim Benchmark
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Replaces i_main.cc in the edge-sim-bench program.  The engine starts
+//  up as usual (with the null GL backend and no sound), loads the level
+//  given by -warp (adding -bots <num> robots) or the one in a demo given
+//  by -playdemo, then runs -tics <num> game tics as fast as possible and
+//  prints how long they took, how many allocations were made and the
+//  time spent in each profiling zone (EDGE_ZoneScoped).
+//
+//  With -hitscans <num>, that many traces (like bullets, stopping at the
+//  first solid wall or shootable thing) are fired in a fixed pattern
+//  over the whole map before the tics are run.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+#include "epi_sdl.h" // needed for proper SDL main linkage
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#include "filesystem.h"
+
+#include "dm_state.h"
+#include "e_main.h"
+#include "g_game.h"
+#include "m_argv.h"
+#include "n_network.h"
+#include "p_local.h"
+
+#include "edge_profiling.h"
+
+#define DEFAULT_TICS (TICRATE * 60)
+
+// how many zones to show
+#define MAX_SHOWN_ZONES 40
+
+// hitscan pattern: directions fired from each point of a grid over the map
+#define HITSCAN_GRID   32
+#define HITSCAN_ANGLES 16
+
+std::string exe_path = ".";
+
+//----------------------------------------------------------------------------
+//  ALLOCATION COUNTING
+//----------------------------------------------------------------------------
+
+static std::atomic<int64_t> alloc_count(0);
+static std::atomic<int64_t> alloc_bytes(0);
+
+static void *CountedAlloc(size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add((int64_t)size, std::memory_order_relaxed);
+
+    void *p = malloc(size > 0 ? size : 1);
+
+    if (!p)
+        abort();
+
+    return p;
+}
+
+void *operator new(size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    free(p);
+}
+
+//----------------------------------------------------------------------------
+//  ZONE TIMINGS
+//----------------------------------------------------------------------------
+
+ECBenchZoneInfo *ecbench_zones = NULL;
+
+ECBenchZoneInfo::ECBenchZoneInfo(const char *_name) : name(_name), calls(0), nanosecs(0), depth(0)
+{
+    next          = ecbench_zones;
+    ecbench_zones = this;
+}
+
+static void ResetZones(void)
+{
+    for (ECBenchZoneInfo *zone = ecbench_zones; zone; zone = zone->next)
+    {
+        zone->calls    = 0;
+        zone->nanosecs = 0;
+    }
+}
+
+static bool ZoneTimeCmp(const ECBenchZoneInfo *A, const ECBenchZoneInfo *B)
+{
+    return A->nanosecs > B->nanosecs;
+}
+
+static void ShowZones(int64_t total_micros)
+{
+    std::vector<ECBenchZoneInfo *> list;
+
+    for (ECBenchZoneInfo *zone = ecbench_zones; zone; zone = zone->next)
+        if (zone->calls > 0)
+            list.push_back(zone);
+
+    std::sort(list.begin(), list.end(), ZoneTimeCmp);
+
+    if (list.size() > MAX_SHOWN_ZONES)
+        list.resize(MAX_SHOWN_ZONES);
+
+    I_Printf("\n%-28s %10s %10s %10s %6s\n", "Zone", "Calls", "Total ms", "Avg us", "Time");
+
+    for (const ECBenchZoneInfo *zone : list)
+    {
+        double micros = zone->nanosecs / 1000.0;
+
+        I_Printf("%-28s %10lld %10.2f %10.3f %5.1f%%\n", zone->name, (long long)zone->calls, micros / 1000.0,
+                 micros / zone->calls, micros * 100.0 / HMM_MAX(total_micros, (int64_t)1));
+    }
+}
+
+//----------------------------------------------------------------------------
+//  HITSCANS
+//----------------------------------------------------------------------------
+
+static bool PTR_BenchHitscan(intercept_t *in, void *dataptr)
+{
+    int *hits = (int *)dataptr;
+
+    if (in->line)
+    {
+        // one-sided walls stop the shot, others are passed through
+        if (in->line->backsector)
+            return true;
+    }
+    else if (!(in->thing->flags & MF_SHOOTABLE))
+    {
+        return true;
+    }
+
+    (*hits)++;
+    return false;
+}
+
+static int64_t RunHitscans(int total)
+{
+    float width  = (float)(bmap_width * BLOCKMAP_UNIT);
+    float height = (float)(bmap_height * BLOCKMAP_UNIT);
+
+    int hits = 0;
+
+    int64_t start_count = alloc_count.load(std::memory_order_relaxed);
+    int64_t start_time  = I_GetTimeMicros();
+
+    for (int i = 0; i < total; i++)
+    {
+        int point = (i / HITSCAN_ANGLES) % (HITSCAN_GRID * HITSCAN_GRID);
+
+        float x = bmap_orgx + width * ((point % HITSCAN_GRID) + 0.5f) / HITSCAN_GRID;
+        float y = bmap_orgy + height * ((point / HITSCAN_GRID) + 0.5f) / HITSCAN_GRID;
+
+        float angle = (i % HITSCAN_ANGLES + 0.25f) * 2.0f * HMM_PI32 / HITSCAN_ANGLES;
+
+        P_PathTraverse(x, y, x + cosf(angle) * MISSILERANGE, y + sinf(angle) * MISSILERANGE,
+                       PT_ADDLINES | PT_ADDTHINGS, PTR_BenchHitscan, &hits);
+    }
+
+    int64_t elapsed = HMM_MAX(I_GetTimeMicros() - start_time, (int64_t)1);
+    int64_t count   = alloc_count.load(std::memory_order_relaxed) - start_count;
+
+    I_Printf("Hitscans: %d in %1.3f seconds (%1.0f per second, %1.3f us each), %d hit something, %lld allocations\n",
+             total, elapsed / 1000000.0, total * 1000000.0 / elapsed, (double)elapsed / total, hits, (long long)count);
+
+    return elapsed;
+}
+
+//----------------------------------------------------------------------------
+//  BENCHMARK
+//----------------------------------------------------------------------------
+
+void E_SimBench(void)
+{
+    if (gameaction == ga_nothing)
+        I_Error("edge-sim-bench: nothing to run.\n\n"
+                "Use -warp <map> (optionally with -bots <num>, -skill <num> etc)\n"
+                "or -playdemo <demo>, and -tics <num> for how many tics to run\n"
+                "(-hitscans <num> also fires that many traces first).\n");
+
+    int total_tics = DEFAULT_TICS;
+    int hitscans   = 0;
+
+    std::string s = argv::Value("tics");
+    if (!s.empty())
+        total_tics = HMM_MAX(0, atoi(s.c_str()));
+
+    s = argv::Value("hitscans");
+    if (!s.empty())
+        hitscans = HMM_MAX(0, atoi(s.c_str()));
+
+    // tics are run one at a time, as fast as possible
+    singletics = true;
+
+    // load the level
+    G_BigStuff();
+
+    if (gamestate != GS_LEVEL)
+        I_Error("edge-sim-bench: failed to start the level.\n");
+
+    ResetZones();
+
+    if (hitscans > 0)
+    {
+        ShowZones(RunHitscans(hitscans));
+        ResetZones();
+    }
+
+    if (total_tics == 0)
+    {
+        I_SystemShutdown();
+        I_CloseProgram(EXIT_SUCCESS);
+    }
+
+    I_Printf("edge-sim-bench: running %d tics on %s\n", total_tics, currmap->name.c_str());
+
+    int64_t start_count = alloc_count.load(std::memory_order_relaxed);
+    int64_t start_bytes = alloc_bytes.load(std::memory_order_relaxed);
+    int64_t start_time  = I_GetTimeMicros();
+
+    int tics = 0;
+
+    while (tics < total_tics)
+    {
+        N_TryRunTics();
+        G_Ticker();
+
+        tics++;
+
+        // level finished, player died in a demo, demo ended, etc
+        if (gameaction != ga_nothing || gamestate != GS_LEVEL)
+            break;
+    }
+
+    int64_t elapsed = I_GetTimeMicros() - start_time;
+    int64_t count   = alloc_count.load(std::memory_order_relaxed) - start_count;
+    int64_t bytes   = alloc_bytes.load(std::memory_order_relaxed) - start_bytes;
+
+    double seconds = HMM_MAX(elapsed, (int64_t)1) / 1000000.0;
+
+    if (tics < total_tics)
+        I_Printf("edge-sim-bench: stopped early, the level or demo ended\n");
+
+    I_Printf("edge-sim-bench: %d tics in %1.3f seconds (%1.1f tics per second, %1.3f ms per tic)\n", tics, seconds,
+             tics / seconds, seconds * 1000.0 / tics);
+    I_Printf("Allocations: %lld (%1.1f per tic), %1.1f KB (%1.0f bytes per tic)\n", (long long)count,
+             (double)count / tics, bytes / 1024.0, (double)bytes / tics);
+
+    ShowZones(elapsed);
+
+    I_SystemShutdown();
+    I_CloseProgram(EXIT_SUCCESS);
+}
+
+extern "C"
+{
+
+    int main(int argc, char *argv[])
+    {
+        if (SDL_Init(0) < 0)
+            I_Error("Couldn't init SDL!!\n%s\n", SDL_GetError());
+
+        exe_path = SDL_GetBasePath();
+
+#ifdef _WIN32
+        // -AJA- change current dir to match executable
+        if (!epi::CurrentDirectorySet(exe_path))
+            I_Error("Couldn't set program directory to %s!!\n", exe_path.c_str());
+#endif
+
+        // Start up and run the benchmark, it never returns
+        E_Main(argc, (const char **)argv);
+
+        return 0;
+    }
+
+} // extern "C"
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -783,6 +783,8 @@ static void CastDrawer(void)
         if (!skin_img)
             skin_img = W_ImageForDummySkin();
 
+        HUD_FlushBatch();
+
         glClear(GL_DEPTH_BUFFER_BIT);
         glEnable(GL_DEPTH_TEST);
 
@@ -0,0 +1,670 @@
+//----------------------------------------------------------------------------
+//  EDGE Demo Recording and Playback
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  A demo is the stream of ticcmds used by the game simulation, along
+//  with what is needed to start the same game again: the map, skill,
+//  players, random seed, game flags, gameplay cvars and the data files
+//  (which are only checked, not loaded, on playback).
+//
+//  The ticcmds are captured when they are used (once per game tic, see
+//  G_DemoTiccmds) rather than when they are built, so tics which the
+//  game never ran, like those dropped when a new level is loaded, are
+//  not stored.
+//
+//  Things which do not go through ticcmds are not recorded, such as
+//  cheat codes and answers to RTS menus.
+//
+//  All values are stored little-endian.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "filesystem.h"
+#include "str_compare.h"
+
+#include "dm_state.h"
+#include "e_player.h"
+#include "g_demo.h"
+#include "g_game.h"
+#include "m_menu.h"
+#include "m_random.h"
+#include "version.h"
+#include "w_files.h"
+
+extern cvar_c v_sync;
+
+#define DEMO_MAGIC   "EDGEDEMO"
+#define DEMO_VERSION 1
+
+#define DEMO_EXTENSION ".edm"
+
+// markers in the tic stream
+#define DEMO_TIC 0x01
+#define DEMO_END 0x80
+
+bool demorecording = false;
+bool demoplayback  = false;
+bool timingdemo    = false;
+
+// cvars which change how the game plays, by prefix
+static const char *gameplay_cvars[] = {"g_", "bot_", "player_", NULL};
+
+static std::string demo_name;
+
+static epi::File *demo_file = NULL;
+
+// bytes waiting to be written when recording, the whole demo when
+// playing back.
+static std::vector<uint8_t> demo_buffer;
+
+static size_t demo_pos     = 0;
+static bool   demo_overrun = false;
+
+static int demo_tics = 0;
+
+// cvars changed for playback, and their values beforehand
+typedef struct
+{
+    cvar_c     *var;
+    std::string old_value;
+} saved_cvar_t;
+
+static std::vector<saved_cvar_t> saved_cvars;
+
+// -timedemo statistics
+static bool    td_running     = false;
+static int64_t td_start_time  = 0;
+static int64_t td_last_mark   = 0;
+static int64_t td_frame_start = 0;
+
+static int64_t td_parts[TD_NUMPARTS];
+
+static std::vector<int> td_frame_times; // in microseconds
+
+//----------------------------------------------------------------------------
+//  READING AND WRITING
+//----------------------------------------------------------------------------
+
+static void PutByte(int value)
+{
+    demo_buffer.push_back((uint8_t)value);
+}
+
+static void PutShort(int value)
+{
+    PutByte(value & 0xFF);
+    PutByte((value >> 8) & 0xFF);
+}
+
+static void PutLong(uint32_t value)
+{
+    PutShort(value & 0xFFFF);
+    PutShort(value >> 16);
+}
+
+static void PutString(const std::string &str)
+{
+    PutShort((int)str.size());
+
+    for (char ch : str)
+        PutByte(ch);
+}
+
+static void FlushDemo(void)
+{
+    if (demo_file && !demo_buffer.empty())
+        demo_file->Write(demo_buffer.data(), (unsigned int)demo_buffer.size());
+
+    demo_buffer.clear();
+}
+
+static int GetByte(void)
+{
+    if (demo_pos >= demo_buffer.size())
+    {
+        demo_overrun = true;
+        return 0;
+    }
+
+    return demo_buffer[demo_pos++];
+}
+
+static int GetShort(void)
+{
+    int lo = GetByte();
+    int hi = GetByte();
+
+    return lo | (hi << 8);
+}
+
+static uint32_t GetLong(void)
+{
+    uint32_t lo = GetShort();
+    uint32_t hi = GetShort();
+
+    return lo | (hi << 16);
+}
+
+static std::string GetString(void)
+{
+    std::string str;
+
+    int len = GetShort();
+
+    for (; len > 0 && !demo_overrun; len--)
+        str.push_back((char)GetByte());
+
+    return str;
+}
+
+static void PutTiccmd(const ticcmd_t *cmd)
+{
+    PutShort(cmd->angleturn);
+    PutShort(cmd->mlookturn);
+    PutShort(cmd->player_idx);
+    PutByte(cmd->forwardmove);
+    PutByte(cmd->sidemove);
+    PutByte(cmd->upwardmove);
+    PutByte(cmd->buttons);
+    PutShort(cmd->extbuttons);
+    PutByte(cmd->chatchar);
+}
+
+static void GetTiccmd(ticcmd_t *cmd)
+{
+    memset(cmd, 0, sizeof(ticcmd_t));
+
+    cmd->angleturn   = (int16_t)GetShort();
+    cmd->mlookturn   = (int16_t)GetShort();
+    cmd->player_idx  = (int16_t)GetShort();
+    cmd->forwardmove = (int8_t)GetByte();
+    cmd->sidemove    = (int8_t)GetByte();
+    cmd->upwardmove  = (int8_t)GetByte();
+    cmd->buttons     = (uint8_t)GetByte();
+    cmd->extbuttons  = (uint16_t)GetShort();
+    cmd->chatchar    = (uint8_t)GetByte();
+}
+
+static void PutFlags(const gameflags_t *F)
+{
+    PutByte(F->nomonsters);
+    PutByte(F->fastparm);
+    PutByte(F->respawn);
+    PutByte(F->res_respawn);
+    PutByte(F->itemrespawn);
+    PutByte(F->true3dgameplay);
+    PutLong((uint32_t)F->menu_grav);
+    PutByte(F->more_blood);
+    PutByte(F->jump);
+    PutByte(F->crouch);
+    PutByte(F->mlook);
+    PutByte(F->autoaim);
+    PutByte(F->cheats);
+    PutByte(F->have_extra);
+    PutByte(F->limit_zoom);
+    PutByte(F->kicking);
+    PutByte(F->weapon_switch);
+    PutByte(F->pass_missile);
+    PutByte(F->team_damage);
+}
+
+static void GetFlags(gameflags_t *F)
+{
+    F->nomonsters     = GetByte() != 0;
+    F->fastparm       = GetByte() != 0;
+    F->respawn        = GetByte() != 0;
+    F->res_respawn    = GetByte() != 0;
+    F->itemrespawn    = GetByte() != 0;
+    F->true3dgameplay = GetByte() != 0;
+    F->menu_grav      = (int)GetLong();
+    F->more_blood     = GetByte() != 0;
+    F->jump           = GetByte() != 0;
+    F->crouch         = GetByte() != 0;
+    F->mlook          = GetByte() != 0;
+    F->autoaim        = (autoaim_t)GetByte();
+    F->cheats         = GetByte() != 0;
+    F->have_extra     = GetByte() != 0;
+    F->limit_zoom     = GetByte() != 0;
+    F->kicking        = GetByte() != 0;
+    F->weapon_switch  = GetByte() != 0;
+    F->pass_missile   = GetByte() != 0;
+    F->team_damage    = GetByte() != 0;
+}
+
+//----------------------------------------------------------------------------
+//  HEADER
+//----------------------------------------------------------------------------
+
+static void WriteHeader(const newgame_params_c &params)
+{
+    for (const char *s = DEMO_MAGIC; *s; s++)
+        PutByte(*s);
+
+    PutByte(DEMO_VERSION);
+    PutString(edgeversion.s);
+
+    PutString(params.map->name);
+    PutByte(params.skill);
+    PutByte(params.deathmatch);
+    PutLong((uint32_t)params.random_seed);
+
+    PutByte(params.total_players);
+    for (int pnum = 0; pnum < params.total_players; pnum++)
+        PutByte(params.players[pnum]);
+
+    PutFlags(params.flags);
+
+    std::vector<const char *> names;
+
+    for (int i = 0; gameplay_cvars[i]; i++)
+    {
+        std::vector<const char *> list;
+        CON_MatchAllVars(list, gameplay_cvars[i]);
+
+        names.insert(names.end(), list.begin(), list.end());
+    }
+
+    PutShort((int)names.size());
+
+    for (const char *name : names)
+    {
+        PutString(name);
+        PutString(CON_FindVar(name)->s);
+    }
+
+    PutShort((int)data_files.size());
+
+    for (data_file_c *df : data_files)
+    {
+        PutString(epi::GetFilename(df->name));
+        PutLong(W_FileContentHash(df));
+    }
+}
+
+// sets a cvar for the duration of the demo
+static void SetDemoCvar(cvar_c *var, const char *value)
+{
+    if (var->s == value)
+        return;
+
+    saved_cvars.push_back({var, var->s});
+
+    *var = value;
+}
+
+static void ReadHeader(newgame_params_c &params)
+{
+    for (const char *s = DEMO_MAGIC; *s; s++)
+        if (GetByte() != *s)
+            I_Error("Not an EDGE demo: %s\n", demo_name.c_str());
+
+    int version = GetByte();
+
+    if (version != DEMO_VERSION)
+        I_Error("Demo %s has unsupported version %d\n", demo_name.c_str(), version);
+
+    std::string recorded_with = GetString();
+
+    I_Printf("Playing demo: %s (recorded with version %s)\n", demo_name.c_str(), recorded_with.c_str());
+
+    std::string map_name = GetString();
+
+    params.skill       = (skill_t)GetByte();
+    params.deathmatch  = GetByte();
+    params.random_seed = (int)GetLong();
+
+    params.total_players = GetByte();
+
+    if (params.total_players < 1 || params.total_players > MAXPLAYERS)
+        I_Error("Demo %s is corrupt (bad player count)\n", demo_name.c_str());
+
+    for (int pnum = 0; pnum < params.total_players; pnum++)
+    {
+        params.players[pnum] = (playerflag_e)GetByte();
+        params.nodes[pnum]   = NULL;
+    }
+
+    gameflags_t flags;
+    GetFlags(&flags);
+
+    params.CopyFlags(&flags);
+    params.level_skip = true;
+
+    params.map = G_LookupMap(map_name.c_str());
+
+    if (!params.map || !G_MapExists(params.map))
+        I_Error("Demo %s: no such level '%s'\n", demo_name.c_str(), map_name.c_str());
+
+    // gameplay cvars
+    int num_cvars = GetShort();
+
+    for (; num_cvars > 0 && !demo_overrun; num_cvars--)
+    {
+        std::string name  = GetString();
+        std::string value = GetString();
+
+        cvar_c *var = CON_FindVar(name.c_str());
+
+        if (!var)
+        {
+            I_Warning("Demo uses unknown cvar: %s\n", name.c_str());
+            continue;
+        }
+
+        SetDemoCvar(var, value.c_str());
+    }
+
+    // data files, these are only checked
+    int num_files = GetShort();
+
+    if (num_files != (int)data_files.size())
+        I_Warning("Demo was recorded with %d data files, %d are loaded\n", num_files, (int)data_files.size());
+
+    for (int i = 0; i < num_files && !demo_overrun; i++)
+    {
+        std::string name = GetString();
+        uint32_t    hash = GetLong();
+
+        if (i >= (int)data_files.size())
+        {
+            I_Warning("Demo needs data file: %s\n", name.c_str());
+            continue;
+        }
+
+        data_file_c *df = data_files[i];
+
+        if (epi::StringCaseCompareASCII(name, epi::GetFilename(df->name)) != 0)
+            I_Warning("Demo data file %d is %s, loaded file is %s\n", i + 1, name.c_str(),
+                      epi::GetFilename(df->name).c_str());
+        else if (hash != W_FileContentHash(df))
+            I_Warning("Demo data file %s does not match the loaded one\n", name.c_str());
+    }
+
+    if (demo_overrun)
+        I_Error("Demo %s is corrupt (header is truncated)\n", demo_name.c_str());
+}
+
+//----------------------------------------------------------------------------
+
+void G_DeferredRecordDemo(std::string filename, newgame_params_c &params)
+{
+    G_StopDemo();
+
+    demo_name = filename;
+
+    if (epi::GetExtension(demo_name).empty())
+        epi::ReplaceExtension(demo_name, DEMO_EXTENSION);
+
+    demo_file = epi::FileOpen(demo_name, epi::kFileAccessWrite | epi::kFileAccessBinary);
+
+    if (!demo_file)
+        I_Error("Unable to create demo file: %s\n", demo_name.c_str());
+
+    if (!params.flags)
+        params.CopyFlags(&global_flags);
+
+    G_DeferredNewGame(params);
+
+    WriteHeader(params);
+    FlushDemo();
+
+    demorecording = true;
+    demo_tics     = 0;
+
+    I_Printf("Recording demo: %s\n", demo_name.c_str());
+}
+
+void G_DeferredPlayDemo(std::string filename, bool timing)
+{
+    G_StopDemo();
+
+    demo_name = filename;
+
+    if (!epi::FileExists(demo_name) && epi::GetExtension(demo_name).empty())
+        epi::ReplaceExtension(demo_name, DEMO_EXTENSION);
+
+    epi::File *F = epi::FileOpen(demo_name, epi::kFileAccessRead | epi::kFileAccessBinary);
+
+    if (!F)
+        I_Error("Unable to open demo file: %s\n", demo_name.c_str());
+
+    int      length = F->GetLength();
+    uint8_t *data   = F->LoadIntoMemory();
+
+    delete F;
+
+    if (!data)
+        I_Error("Unable to read demo file: %s\n", demo_name.c_str());
+
+    demo_buffer.assign(data, data + length);
+    delete[] data;
+
+    demo_pos     = 0;
+    demo_overrun = false;
+
+    newgame_params_c params;
+
+    ReadHeader(params);
+
+    if (timing)
+    {
+        // run as fast as possible
+        singletics = true;
+
+        SetDemoCvar(&v_sync, "0");
+    }
+
+    G_DeferredNewGame(params);
+
+    demoplayback = true;
+    timingdemo   = timing;
+    demo_tics    = 0;
+}
+
+static void RecordTic(void)
+{
+    int count = 0;
+
+    for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
+        if (players[pnum])
+            count++;
+
+    PutByte(DEMO_TIC);
+    PutByte(count);
+
+    for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
+    {
+        player_t *p = players[pnum];
+        if (!p)
+            continue;
+
+        PutByte(pnum);
+        PutTiccmd(&p->cmd);
+    }
+
+    FlushDemo();
+
+    demo_tics++;
+}
+
+static void ShowTimeDemoStats(void)
+{
+    int64_t elapsed = td_last_mark - td_start_time;
+
+    if (elapsed <= 0 || td_frame_times.empty())
+        return;
+
+    double seconds = elapsed / 1000000.0;
+
+    I_Printf("Timedemo: %d tics in %1.2f seconds (%1.1f tics per second)\n", demo_tics, seconds,
+             demo_tics / seconds);
+
+    std::vector<int> sorted(td_frame_times);
+    std::sort(sorted.begin(), sorted.end());
+
+    int64_t total = 0;
+    for (int t : sorted)
+        total += t;
+
+    int    count = (int)sorted.size();
+    size_t p99   = HMM_MIN(sorted.size() - 1, sorted.size() * 99 / 100);
+
+    I_Printf("Frame times: %d frames, average %1.3f ms, min %1.3f ms, max %1.3f ms, 99%% %1.3f ms\n", count,
+             total / 1000.0 / count, sorted.front() / 1000.0, sorted.back() / 1000.0, sorted[p99] / 1000.0);
+
+    static const char *part_names[TD_NUMPARTS] = {"game", "render", "sound", "other"};
+
+    for (int part = 0; part < TD_NUMPARTS; part++)
+        I_Printf("  %-6s : %8.1f ms (%2d%%)\n", part_names[part], td_parts[part] / 1000.0,
+                 (int)(td_parts[part] * 100 / elapsed));
+}
+
+static void FinishPlayback(int marker)
+{
+    if (marker == DEMO_END)
+    {
+        uint32_t rnd_state = GetLong();
+
+        if (!demo_overrun && rnd_state != (uint32_t)P_ReadRandomState())
+            I_Warning("Demo went out of sync\n");
+    }
+    else
+        I_Warning("Demo %s is corrupt (tic %d)\n", demo_name.c_str(), demo_tics);
+
+    if (timingdemo)
+    {
+        ShowTimeDemoStats();
+
+        G_StopDemo();
+        M_ImmediateQuit();
+        return;
+    }
+
+    I_Printf("Demo finished: %s (%d tics)\n", demo_name.c_str(), demo_tics);
+
+    G_StopDemo();
+    G_DeferredEndGame();
+}
+
+static void PlayTic(void)
+{
+    int marker = GetByte();
+
+    if (marker != DEMO_TIC)
+    {
+        FinishPlayback(marker);
+        return;
+    }
+
+    int count = GetByte();
+
+    for (; count > 0; count--)
+    {
+        int pnum = GetByte();
+
+        ticcmd_t cmd;
+        GetTiccmd(&cmd);
+
+        if (pnum < MAXPLAYERS && players[pnum])
+            memcpy(&players[pnum]->cmd, &cmd, sizeof(ticcmd_t));
+    }
+
+    if (demo_overrun)
+    {
+        FinishPlayback(0);
+        return;
+    }
+
+    if (timingdemo && !td_running)
+    {
+        td_running     = true;
+        td_start_time  = I_GetTimeMicros();
+        td_last_mark   = td_start_time;
+        td_frame_start = 0;
+
+        memset(td_parts, 0, sizeof(td_parts));
+        td_frame_times.clear();
+    }
+
+    demo_tics++;
+}
+
+void G_DemoTiccmds(void)
+{
+    if (demorecording)
+        RecordTic();
+    else if (demoplayback)
+        PlayTic();
+}
+
+void G_StopDemo(void)
+{
+    if (demorecording)
+    {
+        PutByte(DEMO_END);
+        PutLong((uint32_t)P_ReadRandomState());
+        FlushDemo();
+
+        delete demo_file;
+        demo_file = NULL;
+
+        I_Printf("Demo recorded: %s (%d tics)\n", demo_name.c_str(), demo_tics);
+    }
+
+    for (auto it = saved_cvars.rbegin(); it != saved_cvars.rend(); it++)
+        *it->var = it->old_value;
+
+    saved_cvars.clear();
+    demo_buffer.clear();
+
+    demorecording = false;
+    demoplayback  = false;
+    timingdemo    = false;
+    td_running    = false;
+}
+
+void G_TimeDemoFrame(void)
+{
+    if (!td_running)
+        return;
+
+    G_TimeDemoMark(TD_Other);
+
+    if (td_frame_start > 0)
+        td_frame_times.push_back((int)(td_last_mark - td_frame_start));
+
+    td_frame_start = td_last_mark;
+}
+
+void G_TimeDemoMark(timedemo_part_e part)
+{
+    if (!td_running)
+        return;
+
+    int64_t now = I_GetTimeMicros();
+
+    td_parts[part] += now - td_last_mark;
+    td_last_mark = now;
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -0,0 +1,64 @@
+//----------------------------------------------------------------------------
+//  EDGE Demo Recording and Playback
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+
+#ifndef __G_DEMO_H__
+#define __G_DEMO_H__
+
+#include <string>
+
+class newgame_params_c;
+
+extern bool demorecording;
+extern bool demoplayback;
+extern bool timingdemo;
+
+void G_DeferredRecordDemo(std::string filename, newgame_params_c &params);
+// start the new game described by 'params' and record a demo of it.
+
+void G_DeferredPlayDemo(std::string filename, bool timing);
+// start a new game from the demo's header and play it back.
+// When timing, the game runs as fast as possible (singletics) and
+// the timings are printed when the demo ends, then we quit.
+
+void G_DemoTiccmds(void);
+// called once per game tic after the ticcmds have been grabbed:
+// records them, or replaces them with the ones from the demo.
+
+void G_StopDemo(void);
+// finish recording or playing back, e.g. before quitting.
+
+typedef enum
+{
+    TD_Game = 0, // G_Ticker
+    TD_Render,   // E_Display
+    TD_Sound,    // sound and music tickers
+    TD_Other,    // everything else (input, menus, level loads)
+
+    TD_NUMPARTS
+} timedemo_part_e;
+
+void G_TimeDemoFrame(void);
+// a new frame is starting (-timedemo only).
+
+void G_TimeDemoMark(timedemo_part_e part);
+// the time since the previous mark was spent in 'part'.
+
+#endif /* __G_DEMO_H__ */
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
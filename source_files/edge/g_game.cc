@@ -37,9 +37,11 @@
 #include "e_input.h"
 #include "e_main.h"
 #include "f_finale.h"
+#include "g_demo.h"
 #include "g_game.h"
 #include "m_cheat.h"
 #include "m_menu.h"
+#include "m_misc.h"
 #include "m_random.h"
 #include "n_network.h"
 #include "bot_think.h"
@@ -47,6 +49,7 @@
 #include "p_tick.h"
 #include "rad_trig.h"
 #include "am_map.h"
+#include "r_interp.h"
 #include "r_sky.h"
 #include "r_modes.h"
 #include "s_sound.h"
@@ -60,8 +63,6 @@
 #include "vm_coal.h"
 #include "script/compat/lua_compat.h"
 
-extern cvar_c r_doubleframes;
-
 gamestate_e gamestate = GS_NOTHING;
 
 gameaction_e gameaction = ga_nothing;
@@ -469,33 +470,6 @@ void G_BigStuff(void)
 
 void G_Ticker(void)
 {
-
-    bool extra_tic = (gametic & 1) == 1;
-
-    if (extra_tic && r_doubleframes.d)
-    {
-        switch (gamestate)
-        {
-        case GS_LEVEL:
-            // get commands
-            N_GrabTiccmds();
-
-            //!!!  P_Ticker();
-            P_Ticker(true);
-            break;
-
-        case GS_INTERMISSION:
-        case GS_FINALE:
-            N_GrabTiccmds();
-            break;
-        default:
-            break;
-        }
-        // ANIMATE FLATS AND TEXTURES GLOBALLY
-        W_UpdateImageAnims();
-        return;
-    }
-
     // ANIMATE FLATS AND TEXTURES GLOBALLY
     W_UpdateImageAnims();
 
@@ -510,7 +484,7 @@ void G_Ticker(void)
         // get commands
         N_GrabTiccmds();
 
-        P_Ticker(false);
+        P_Ticker();
         AM_Ticker();
         HU_Ticker();
         RAD_Ticker();
@@ -521,11 +495,13 @@ void G_Ticker(void)
 
     case GS_INTERMISSION:
         N_GrabTiccmds();
+        G_DemoTiccmds();
         WI_Ticker();
         break;
 
     case GS_FINALE:
         N_GrabTiccmds();
+        G_DemoTiccmds();
         F_Ticker();
         break;
 
@@ -847,6 +823,9 @@ static bool G_LoadGameFromFile(std::string filename, bool is_hub)
     SV_FinishLoad();
     SV_CloseReadFile();
 
+    R_ClearInterpolation();
+    R_ClearGeometryCache();
+
     return true; // OK
 }
 
@@ -858,11 +837,17 @@ static bool G_LoadGameFromFile(std::string filename, bool is_hub)
 //
 static void G_DoLoadGame(void)
 {
+    // a demo cannot continue from a savegame
+    G_StopDemo();
+
     E_ForceWipe();
 
     const char *dir_name = SV_SlotName(defer_load_slot);
     I_Debugf("G_DoLoadGame : %s\n", dir_name);
 
+    // the save screenshot may still be being written to "current"
+    M_UpdateScreenShots(true);
+
     SV_ClearSlot("current");
     SV_CopySlot(dir_name, "current");
 
@@ -979,6 +964,9 @@ static void G_DoSaveGame(void)
     else
         VM_SaveGame();
 
+    // the save screenshot must be written before copying the slot
+    M_UpdateScreenShots(true);
+
     std::string fn(SV_FileName("current", "head"));
 
     if (G_SaveGameToFile(fn, defer_save_desc))
@@ -1078,6 +1066,10 @@ void G_DeferredNewGame(newgame_params_c &params)
 {
     SYS_ASSERT(params.map);
 
+    // e.g. a new game started from the menu
+    if (demorecording || demoplayback)
+        G_StopDemo();
+
     defer_params = new newgame_params_c(params);
 
     if (params.level_skip)
@@ -1217,6 +1209,8 @@ void G_DeferredEndGame(void)
 //
 static void G_DoEndGame(void)
 {
+    G_StopDemo();
+
     E_ForceWipe();
 
     P_DestroyAllPlayers();
@@ -36,6 +36,10 @@
 
 #include "str_compare.h"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #define DUMMY_WIDTH(font) (4)
 #define DUMMY_CLAMP       789
 
@@ -49,7 +53,6 @@ extern console_line_c *quit_lines[ENDOOM_LINES];
 extern int             con_cursor;
 extern font_c         *endoom_font;
 extern cvar_c          r_overlay;
-extern cvar_c          r_doubleframes;
 
 static font_c *default_font;
 
@@ -257,6 +260,9 @@ void HUD_PushScissor(float x1, float y1, float x2, float y2, bool expand)
     int sx2 = I_ROUND(x2);
     int sy2 = I_ROUND(y2);
 
+    // everything drawn so far is outside this scissor
+    HUD_FlushBatch();
+
     if (sci_stack_top == 0)
     {
         glEnable(GL_SCISSOR_TEST);
@@ -299,6 +305,8 @@ void HUD_PopScissor()
 {
     SYS_ASSERT(sci_stack_top > 0);
 
+    HUD_FlushBatch();
+
     sci_stack_top--;
 
     if (sci_stack_top == 0)
@@ -319,7 +327,7 @@ void HUD_CalcScrollTexCoords(float x_scroll, float y_scroll, float *tx1, float *
 {
     float timeScale, adjustedScrollS, adjustedScrollT;
 
-    timeScale = gametic / (r_doubleframes.d ? 200.0f : 100.0f);
+    timeScale = gametic / 100.0f;
 
     adjustedScrollS = x_scroll * timeScale;
     adjustedScrollT = y_scroll * timeScale;
@@ -392,6 +400,149 @@ void HUD_CalcTurbulentTexCoords(float *tx, float *ty, float x, float y)
     }
 }
 
+//----------------------------------------------------------------------------
+//  BATCHING
+//----------------------------------------------------------------------------
+//
+// Quads are not drawn straight away, but gathered into one vertex
+// array while the texture, blending and alpha test stay the same.
+// The GL state is then set once and the whole lot is drawn with a
+// single call.
+//
+// Anything else drawing to the screen must call HUD_FlushBatch()
+// first, so that it ends up on top of the HUD stuff drawn before it.
+//
+
+typedef struct
+{
+    float x, y;
+    float s, t;
+    float rgba[4];
+} hud_vert_t;
+
+typedef struct
+{
+    GLuint tex_id; // zero for solid colours
+    bool   blend;
+    bool   alpha_test;
+    float  alpha_ref;
+} hud_batch_state_t;
+
+static std::vector<hud_vert_t> hud_batch;
+static hud_batch_state_t       hud_batch_state;
+
+void HUD_FlushBatch(void)
+{
+    if (hud_batch.empty())
+        return;
+
+    const hud_batch_state_t &st = hud_batch_state;
+
+    if (st.tex_id != 0)
+    {
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, st.tex_id);
+    }
+
+    if (st.alpha_test)
+    {
+        glEnable(GL_ALPHA_TEST);
+        glAlphaFunc(GL_GREATER, st.alpha_ref);
+    }
+
+    if (st.blend)
+        glEnable(GL_BLEND);
+
+    // models leave their buffer and arrays enabled
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(hud_vert_t), &hud_batch[0].x);
+
+    glEnableClientState(GL_COLOR_ARRAY);
+    glColorPointer(4, GL_FLOAT, sizeof(hud_vert_t), hud_batch[0].rgba);
+
+    glClientActiveTexture(GL_TEXTURE0);
+
+    if (st.tex_id != 0)
+    {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(hud_vert_t), &hud_batch[0].s);
+    }
+    else
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glDrawArrays(GL_QUADS, 0, (GLsizei)hud_batch.size());
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_ALPHA_TEST);
+    glDisable(GL_BLEND);
+
+    glAlphaFunc(GL_GREATER, 0);
+
+    hud_batch.clear();
+}
+
+static void HUD_BatchState(GLuint tex_id, bool blend, bool alpha_test = false, float alpha_ref = 0)
+{
+    if (!alpha_test)
+        alpha_ref = 0;
+
+    if (!hud_batch.empty())
+    {
+        const hud_batch_state_t &st = hud_batch_state;
+
+        if (st.tex_id == tex_id && st.blend == blend && st.alpha_test == alpha_test && st.alpha_ref == alpha_ref)
+            return;
+
+        HUD_FlushBatch();
+    }
+
+    hud_batch_state.tex_id     = tex_id;
+    hud_batch_state.blend      = blend;
+    hud_batch_state.alpha_test = alpha_test;
+    hud_batch_state.alpha_ref  = alpha_ref;
+}
+
+static inline void HUD_BatchVertex(float x, float y, float s, float t, const sg_color &col, float alpha)
+{
+    hud_vert_t v;
+
+    v.x       = x;
+    v.y       = y;
+    v.s       = s;
+    v.t       = t;
+    v.rgba[0] = col.r;
+    v.rgba[1] = col.g;
+    v.rgba[2] = col.b;
+    v.rgba[3] = alpha;
+
+    hud_batch.push_back(v);
+}
+
+// adds a textured quad, (x1,y1) gets (tx1,ty1) and so on
+static void HUD_BatchQuad(float x1, float y1, float x2, float y2, float tx1, float ty1, float tx2, float ty2,
+                          const sg_color &col, float alpha)
+{
+    HUD_BatchVertex(x1, y1, tx1, ty1, col, alpha);
+    HUD_BatchVertex(x2, y1, tx2, ty1, col, alpha);
+    HUD_BatchVertex(x2, y2, tx2, ty2, col, alpha);
+    HUD_BatchVertex(x1, y2, tx1, ty2, col, alpha);
+}
+
+static void HUD_BatchSolidQuad(float x1, float y1, float x2, float y2, const sg_color &col, float alpha)
+{
+    HUD_BatchVertex(x1, y1, 0, 0, col, alpha);
+    HUD_BatchVertex(x1, y2, 0, 0, col, alpha);
+    HUD_BatchVertex(x2, y2, 0, 0, col, alpha);
+    HUD_BatchVertex(x2, y1, 0, 0, col, alpha);
+}
+
 //----------------------------------------------------------------------------
 
 void HUD_RawImage(float hx1, float hy1, float hx2, float hy2, const image_c *image, float tx1, float ty1, float tx2,
@@ -421,76 +572,73 @@ void HUD_RawImage(float hx1, float hy1, float hx2, float hy2, const image_c *ima
 
     if (epi::StringCaseCompareASCII(image->name, "FONT_DUMMY_IMAGE") == 0)
     {
+        bool smoothed = (var_smoothing && cur_font->def->ttf_smoothing == cur_font->def->TTF_SMOOTH_ON_DEMAND) ||
+                        cur_font->def->ttf_smoothing == cur_font->def->TTF_SMOOTH_ALWAYS;
+
         if (cur_font->def->type == FNTYP_TrueType)
         {
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glEnable(GL_TEXTURE_2D);
-            if ((var_smoothing && cur_font->def->ttf_smoothing == cur_font->def->TTF_SMOOTH_ON_DEMAND) ||
-                cur_font->def->ttf_smoothing == cur_font->def->TTF_SMOOTH_ALWAYS)
-                glBindTexture(GL_TEXTURE_2D, cur_font->ttf_smoothed_tex_id[current_font_size]);
+            if (smoothed)
+                HUD_BatchState(cur_font->ttf_smoothed_tex_id[current_font_size], true);
             else
-                glBindTexture(GL_TEXTURE_2D, cur_font->ttf_tex_id[current_font_size]);
+                HUD_BatchState(cur_font->ttf_tex_id[current_font_size], true);
         }
         else // patch font
         {
-            glEnable(GL_ALPHA_TEST);
-            glEnable(GL_BLEND);
-            glEnable(GL_TEXTURE_2D);
-            if ((var_smoothing && cur_font->def->ttf_smoothing == cur_font->def->TTF_SMOOTH_ON_DEMAND) ||
-                cur_font->def->ttf_smoothing == cur_font->def->TTF_SMOOTH_ALWAYS)
-            {
-                if (do_whiten)
-                    glBindTexture(GL_TEXTURE_2D, cur_font->p_cache.atlas_whitened_smoothed_texid);
-                else
-                    glBindTexture(GL_TEXTURE_2D, cur_font->p_cache.atlas_smoothed_texid);
-            }
+            GLuint atlas;
+
+            if (smoothed)
+                atlas = do_whiten ? cur_font->p_cache.atlas_whitened_smoothed_texid
+                                  : cur_font->p_cache.atlas_smoothed_texid;
             else
-            {
-                if (do_whiten)
-                    glBindTexture(GL_TEXTURE_2D, cur_font->p_cache.atlas_whitened_texid);
-                else
-                    glBindTexture(GL_TEXTURE_2D, cur_font->p_cache.atlas_texid);
-            }
+                atlas = do_whiten ? cur_font->p_cache.atlas_whitened_texid : cur_font->p_cache.atlas_texid;
+
+            HUD_BatchState(atlas, true, true);
         }
-        glColor4f(sgcol.r, sgcol.g, sgcol.b, alpha);
-        glBegin(GL_QUADS);
-        glTexCoord2f(tx1, ty2);
-        glVertex2f(hx1, hy1);
-        glTexCoord2f(tx2, ty2);
-        glVertex2f(hx2, hy1);
-        glTexCoord2f(tx2, ty1);
-        glVertex2f(hx2, hy2);
-        glTexCoord2f(tx1, ty1);
-        glVertex2f(hx1, hy2);
-        glEnd();
-        glDisable(GL_TEXTURE_2D);
+
+        HUD_BatchQuad(hx1, hy1, hx2, hy2, tx1, ty2, tx2, ty1, sgcol, alpha);
         return;
     }
 
     // GLuint tex_id = W_ImageCache(image, true, palremap, do_whiten);
     GLuint tex_id = W_ImageCache(image, true, nullptr, do_whiten);
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, tex_id);
+    bool blend      = (image->opacity == OPAC_Complex || alpha < 0.99f);
+    bool alpha_test = !(alpha >= 0.99f && image->opacity == OPAC_Solid);
+    float alpha_ref = (alpha < 0.11f || image->opacity == OPAC_Complex) ? 0 : alpha * 0.66f;
 
-    if (alpha >= 0.99f && image->opacity == OPAC_Solid)
-        glDisable(GL_ALPHA_TEST);
-    else
+    bool scrolling = (sx != 0.0 || sy != 0.0);
+    bool overlay   = (epi::StringCaseCompareASCII(image->name, hud_overlays.at(r_overlay.d)) == 0);
+
+    bool hud_swirl = false;
+
+    if (image->liquid_type > LIQ_None && swirling_flats > SWIRL_SMMU)
     {
-        glEnable(GL_ALPHA_TEST);
+        hud_swirl_pass = 1;
+        hud_swirl      = true;
+    }
+
+    if (image->liquid_type == LIQ_Thick)
+        hud_thick_liquid = true;
 
-        if (!(alpha < 0.11f || image->opacity == OPAC_Complex))
-            glAlphaFunc(GL_GREATER, alpha * 0.66f);
+    // the common case: just add it to the batch
+    if (!scrolling && !overlay && !hud_swirl)
+    {
+        HUD_BatchState(tex_id, blend, alpha_test, alpha_ref);
+        HUD_BatchQuad(x1, y1, x2, y2, tx1, ty1, tx2, ty2, sgcol, alpha);
+
+        hud_thick_liquid = false;
+        return;
     }
 
-    if (image->opacity == OPAC_Complex || alpha < 0.99f)
-        glEnable(GL_BLEND);
+    // these need the texture wrapping changed, so are drawn on their own
+    HUD_FlushBatch();
+
+    glBindTexture(GL_TEXTURE_2D, tex_id);
 
     GLint old_s_clamp = DUMMY_CLAMP;
     GLint old_t_clamp = DUMMY_CLAMP;
 
-    if (sx != 0.0 || sy != 0.0)
+    if (scrolling)
     {
         glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &old_s_clamp);
         glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &old_t_clamp);
@@ -501,46 +649,20 @@ void HUD_RawImage(float hx1, float hy1, float hx2, float hy2, const image_c *ima
         HUD_CalcScrollTexCoords(sx, sy, &tx1, &ty1, &tx2, &ty2);
     }
 
-    if (epi::StringCaseCompareASCII(image->name, hud_overlays.at(r_overlay.d)) == 0)
+    if (overlay)
     {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     }
 
-    bool hud_swirl = false;
-
-    if (image->liquid_type > LIQ_None && swirling_flats > SWIRL_SMMU)
-    {
-        hud_swirl_pass = 1;
-        hud_swirl      = true;
-    }
-
-    if (image->liquid_type == LIQ_Thick)
-        hud_thick_liquid = true;
-
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, alpha);
-
-    glBegin(GL_QUADS);
-
     if (hud_swirl)
     {
         HUD_CalcTurbulentTexCoords(&tx1, &ty1, x1, y1);
         HUD_CalcTurbulentTexCoords(&tx2, &ty2, x2, y2);
     }
 
-    glTexCoord2f(tx1, ty1);
-    glVertex2i(x1, y1);
-
-    glTexCoord2f(tx2, ty1);
-    glVertex2i(x2, y1);
-
-    glTexCoord2f(tx2, ty2);
-    glVertex2i(x2, y2);
-
-    glTexCoord2f(tx1, ty2);
-    glVertex2i(x1, y2);
-
-    glEnd();
+    HUD_BatchState(tex_id, blend, alpha_test, alpha_ref);
+    HUD_BatchQuad(x1, y1, x2, y2, tx1, ty1, tx2, ty2, sgcol, alpha);
 
     if (hud_swirl && swirling_flats == SWIRL_PARALLAX)
     {
@@ -552,40 +674,24 @@ void HUD_RawImage(float hx1, float hy1, float hx2, float hy2, const image_c *ima
         HUD_CalcTurbulentTexCoords(&tx1, &ty1, x1, y1);
         HUD_CalcTurbulentTexCoords(&tx2, &ty2, x2, y2);
         alpha /= 2;
-        glEnable(GL_ALPHA_TEST);
 
-        glColor4f(sgcol.r, sgcol.g, sgcol.b, alpha);
-
-        glEnable(GL_BLEND);
-        glBegin(GL_QUADS);
-        glTexCoord2f(tx1, ty1);
-        glVertex2i(x1, y1);
-
-        glTexCoord2f(tx2, ty1);
-        glVertex2i(x2, y1);
-
-        glTexCoord2f(tx2, ty2);
-        glVertex2i(x2, y2);
-
-        glTexCoord2f(tx1, ty2);
-        glVertex2i(x1, y2);
-        glEnd();
+        // the second layer is drawn blended and alpha tested
+        HUD_BatchState(tex_id, true, true, alpha_test ? alpha_ref : 0);
+        HUD_BatchQuad(x1, y1, x2, y2, tx1, ty1, tx2, ty2, sgcol, alpha);
     }
 
+    HUD_FlushBatch();
+
     hud_swirl_pass   = 0;
     hud_thick_liquid = false;
 
+    glBindTexture(GL_TEXTURE_2D, tex_id);
+
     if (old_s_clamp != DUMMY_CLAMP)
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, old_s_clamp);
 
     if (old_t_clamp != DUMMY_CLAMP)
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, old_t_clamp);
-
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_ALPHA_TEST);
-    glDisable(GL_BLEND);
-
-    glAlphaFunc(GL_GREATER, 0);
 }
 
 void HUD_RawFromTexID(float hx1, float hy1, float hx2, float hy2, unsigned int tex_id, image_opacity_e opacity,
@@ -602,45 +708,12 @@ void HUD_RawFromTexID(float hx1, float hy1, float hx2, float hy2, unsigned int t
     if (x2 < 0 || x1 > SCREENWIDTH || y2 < 0 || y1 > SCREENHEIGHT)
         return;
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, tex_id);
-
-    if (alpha >= 0.99f && opacity == OPAC_Solid)
-        glDisable(GL_ALPHA_TEST);
-    else
-    {
-        glEnable(GL_ALPHA_TEST);
-
-        if (!(alpha < 0.11f || opacity == OPAC_Complex))
-            glAlphaFunc(GL_GREATER, alpha * 0.66f);
-    }
-
-    if (opacity == OPAC_Complex || alpha < 0.99f)
-        glEnable(GL_BLEND);
-
-    glColor4f(1.0f, 1.0f, 1.0f, alpha);
-
-    glBegin(GL_QUADS);
-
-    glTexCoord2f(tx1, ty1);
-    glVertex2i(x1, y1);
-
-    glTexCoord2f(tx2, ty1);
-    glVertex2i(x2, y1);
-
-    glTexCoord2f(tx2, ty2);
-    glVertex2i(x2, y2);
-
-    glTexCoord2f(tx1, ty2);
-    glVertex2i(x1, y2);
-
-    glEnd();
+    bool  blend      = (opacity == OPAC_Complex || alpha < 0.99f);
+    bool  alpha_test = !(alpha >= 0.99f && opacity == OPAC_Solid);
+    float alpha_ref  = (alpha < 0.11f || opacity == OPAC_Complex) ? 0 : alpha * 0.66f;
 
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_ALPHA_TEST);
-    glDisable(GL_BLEND);
-
-    glAlphaFunc(GL_GREATER, 0);
+    HUD_BatchState(tex_id, blend, alpha_test, alpha_ref);
+    HUD_BatchQuad(x1, y1, x2, y2, tx1, ty1, tx2, ty2, sg_white, alpha);
 }
 
 void HUD_StretchFromImageData(float x, float y, float w, float h, const image_data_c *img, unsigned int tex_id,
@@ -826,23 +899,10 @@ void HUD_SolidBox(float x1, float y1, float x2, float y2, RGBAColor col)
         y2 = COORD_Y(y2);
     }
 
-    if (cur_alpha < 0.99f)
-        glEnable(GL_BLEND);
-
     sg_color sgcol = sg_make_color_1i(col);
 
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, cur_alpha);
-
-    glBegin(GL_QUADS);
-
-    glVertex2f(x1, y1);
-    glVertex2f(x1, y2);
-    glVertex2f(x2, y2);
-    glVertex2f(x2, y1);
-
-    glEnd();
-
-    glDisable(GL_BLEND);
+    HUD_BatchState(0, cur_alpha < 0.99f);
+    HUD_BatchSolidQuad(x1, y1, x2, y2, sgcol, cur_alpha);
 }
 
 void HUD_SolidLine(float x1, float y1, float x2, float y2, RGBAColor col, float thickness, bool smooth, float dx,
@@ -856,6 +916,8 @@ void HUD_SolidLine(float x1, float y1, float x2, float y2, RGBAColor col, float
     dx = COORD_X(dx) - COORD_X(0);
     dy = COORD_Y(0) - COORD_Y(dy);
 
+    HUD_FlushBatch();
+
     glLineWidth(thickness);
 
     if (smooth)
@@ -889,42 +951,14 @@ void HUD_ThinBox(float x1, float y1, float x2, float y2, RGBAColor col, float th
     x2 = COORD_X(x2);
     y2 = COORD_Y(y2);
 
-    if (cur_alpha < 0.99f)
-        glEnable(GL_BLEND);
-
     sg_color sgcol = sg_make_color_1i(col);
 
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, cur_alpha);
-
-    glBegin(GL_QUADS);
-    glVertex2f(x1, y1);
-    glVertex2f(x1, y2);
-    glVertex2f(x1 + 2 + thickness, y2);
-    glVertex2f(x1 + 2 + thickness, y1);
-    glEnd();
-
-    glBegin(GL_QUADS);
-    glVertex2f(x2 - 2 - thickness, y1);
-    glVertex2f(x2 - 2 - thickness, y2);
-    glVertex2f(x2, y2);
-    glVertex2f(x2, y1);
-    glEnd();
-
-    glBegin(GL_QUADS);
-    glVertex2f(x1 + 2 + thickness, y1);
-    glVertex2f(x1 + 2 + thickness, y1 + 2 + thickness);
-    glVertex2f(x2 - 2 - thickness, y1 + 2 + thickness);
-    glVertex2f(x2 - 2 - thickness, y1);
-    glEnd();
-
-    glBegin(GL_QUADS);
-    glVertex2f(x1 + 2 + thickness, y2 - 2 - thickness);
-    glVertex2f(x1 + 2 + thickness, y2);
-    glVertex2f(x2 - 2 - thickness, y2);
-    glVertex2f(x2 - 2 - thickness, y2 - 2 - thickness);
-    glEnd();
+    HUD_BatchState(0, cur_alpha < 0.99f);
 
-    glDisable(GL_BLEND);
+    HUD_BatchSolidQuad(x1, y1, x1 + 2 + thickness, y2, sgcol, cur_alpha);
+    HUD_BatchSolidQuad(x2 - 2 - thickness, y1, x2, y2, sgcol, cur_alpha);
+    HUD_BatchSolidQuad(x1 + 2 + thickness, y1, x2 - 2 - thickness, y1 + 2 + thickness, sgcol, cur_alpha);
+    HUD_BatchSolidQuad(x1 + 2 + thickness, y2 - 2 - thickness, x2 - 2 - thickness, y2, sgcol, cur_alpha);
 }
 
 void HUD_GradientBox(float x1, float y1, float x2, float y2, RGBAColor *cols)
@@ -936,30 +970,12 @@ void HUD_GradientBox(float x1, float y1, float x2, float y2, RGBAColor *cols)
     x2 = COORD_X(x2);
     y2 = COORD_Y(y2);
 
-    if (cur_alpha < 0.99f)
-        glEnable(GL_BLEND);
-
-    glBegin(GL_QUADS);
-
-    sg_color sgcol = sg_make_color_1i(cols[1]);
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, cur_alpha);
-    glVertex2f(x1, y1);
-
-    sgcol = sg_make_color_1i(cols[0]);
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, cur_alpha);
-    glVertex2f(x1, y2);
-
-    sgcol = sg_make_color_1i(cols[2]);
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, cur_alpha);
-    glVertex2f(x2, y2);
-
-    sgcol = sg_make_color_1i(cols[3]);
-    glColor4f(sgcol.r, sgcol.g, sgcol.b, cur_alpha);
-    glVertex2f(x2, y1);
-
-    glEnd();
+    HUD_BatchState(0, cur_alpha < 0.99f);
 
-    glDisable(GL_BLEND);
+    HUD_BatchVertex(x1, y1, 0, 0, sg_make_color_1i(cols[1]), cur_alpha);
+    HUD_BatchVertex(x1, y2, 0, 0, sg_make_color_1i(cols[0]), cur_alpha);
+    HUD_BatchVertex(x2, y2, 0, 0, sg_make_color_1i(cols[2]), cur_alpha);
+    HUD_BatchVertex(x2, y1, 0, 0, sg_make_color_1i(cols[3]), cur_alpha);
 }
 
 float HUD_FontWidth(void)
@@ -1072,6 +1088,8 @@ void HUD_DrawEndoomChar(float left_x, float top_y, float FNX, const image_c *img
     w = FNX;
     h = FNX * 2;
 
+    HUD_FlushBatch();
+
     sg_color sgcol = sg_make_color_1i(color2);
 
     glDisable(GL_TEXTURE_2D);
@@ -1134,6 +1152,85 @@ void HUD_DrawEndoomChar(float left_x, float top_y, float FNX, const image_c *img
     glAlphaFunc(GL_GREATER, 0);
 }
 
+//
+// Text layout cache
+//
+// Laying out a line of TrueType text needs a kerning lookup for each
+// pair of characters, and the HUD draws the same strings over and
+// over, so the advance of each character is remembered per font,
+// size and string.  These do not include the current scale.
+//
+
+#define MAX_CACHED_TEXT_RUNS 1024
+
+typedef struct
+{
+    font_c     *font;
+    float       size;
+    int         font_size;
+    std::string text;
+} text_run_key_t;
+
+struct text_run_key_hash_t
+{
+    size_t operator()(const text_run_key_t &K) const
+    {
+        size_t h = std::hash<std::string>()(K.text);
+
+        h ^= std::hash<const void *>()(K.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<float>()(K.size) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<int>()(K.font_size) + 0x9e3779b9 + (h << 6) + (h >> 2);
+
+        return h;
+    }
+};
+
+struct text_run_key_equal_t
+{
+    bool operator()(const text_run_key_t &A, const text_run_key_t &B) const
+    {
+        return A.font == B.font && A.size == B.size && A.font_size == B.font_size && A.text == B.text;
+    }
+};
+
+static std::unordered_map<text_run_key_t, std::vector<float>, text_run_key_hash_t, text_run_key_equal_t>
+    text_run_cache;
+
+static const std::vector<float> &HUD_TextRunAdvances(const char *str, float size)
+{
+    text_run_key_t key = {cur_font, size, current_font_size, str};
+
+    auto it = text_run_cache.find(key);
+
+    if (it != text_run_cache.end())
+        return it->second;
+
+    if (text_run_cache.size() >= MAX_CACHED_TEXT_RUNS)
+        text_run_cache.clear();
+
+    std::vector<float> &adv = text_run_cache[key];
+
+    float factor = size > 0 ? (size / cur_font->def->default_size) : 1;
+
+    adv.resize(key.text.size());
+
+    // like the old per-character code, kerning is also applied against
+    // a following newline
+    for (size_t i = 0; i < adv.size(); i++)
+    {
+        adv[i] = cur_font->CharWidth(str[i]) * factor;
+
+        if (str[i + 1])
+        {
+            adv[i] += stbtt_GetGlyphKernAdvance(cur_font->ttf_info, cur_font->GetGlyphIndex(str[i]),
+                                                cur_font->GetGlyphIndex(str[i + 1])) *
+                      cur_font->ttf_kern_scale[current_font_size] * factor;
+        }
+    }
+
+    return adv;
+}
+
 //
 // Write a string using the current font
 //
@@ -1158,6 +1255,11 @@ void HUD_DrawText(float x, float y, const char *str, float size)
     if (!str)
         return;
 
+    const float *ttf_adv = nullptr;
+
+    if (cur_font->def->type == FNTYP_TrueType)
+        ttf_adv = HUD_TextRunAdvances(str, size).data();
+
     while (*str)
     {
         // get the length of the line
@@ -1171,16 +1273,7 @@ void HUD_DrawText(float x, float y, const char *str, float size)
         for (int i = 0; i < len; i++)
         {
             if (cur_font->def->type == FNTYP_TrueType)
-            {
-                float factor = size > 0 ? (size / cur_font->def->default_size) : 1;
-                total_w += cur_font->CharWidth(str[i]) * factor * cur_scale;
-                if (str[i + 1])
-                {
-                    total_w += stbtt_GetGlyphKernAdvance(cur_font->ttf_info, cur_font->GetGlyphIndex(str[i]),
-                                                         cur_font->GetGlyphIndex(str[i + 1])) *
-                               cur_font->ttf_kern_scale[current_font_size] * factor * cur_scale;
-                }
-            }
+                total_w += ttf_adv[i] * cur_scale;
             else if (cur_font->def->type == FNTYP_Image)
                 total_w +=
                     (size > 0 ? size * cur_font->CharRatio(str[i]) + cur_font->spacing : cur_font->CharWidth(str[i])) *
@@ -1209,16 +1302,7 @@ void HUD_DrawText(float x, float y, const char *str, float size)
                 HUD_DrawChar(cx, cy, img, ch, size);
 
             if (cur_font->def->type == FNTYP_TrueType)
-            {
-                float factor = size > 0 ? (size / cur_font->def->default_size) : 1;
-                cx += cur_font->CharWidth(ch) * factor * cur_scale;
-                if (str[k + 1])
-                {
-                    cx += stbtt_GetGlyphKernAdvance(cur_font->ttf_info, cur_font->GetGlyphIndex(str[k]),
-                                                    cur_font->GetGlyphIndex(str[k + 1])) *
-                          cur_font->ttf_kern_scale[current_font_size] * factor * cur_scale;
-                }
-            }
+                cx += ttf_adv[k] * cur_scale;
             else if (cur_font->def->type == FNTYP_Image)
                 cx += (size > 0 ? size * cur_font->CharRatio(ch) + cur_font->spacing : cur_font->CharWidth(ch)) *
                       cur_scale;
@@ -1231,6 +1315,10 @@ void HUD_DrawText(float x, float y, const char *str, float size)
             break;
 
         str += (len + 1);
+
+        if (ttf_adv)
+            ttf_adv += (len + 1);
+
         cy += (size > 0 ? size : HUD_FontHeight()) + VERT_SPACING;
     }
 }
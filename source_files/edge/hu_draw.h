@@ -100,6 +100,11 @@ void HUD_StretchImageNoOffset(float x, float y, float w, float h, const image_c
 void HUD_TileImage(float x, float y, float w, float h, const image_c *image, float offset_x = 0.0f,
                    float offset_y = 0.0f);
 
+// draw any quads gathered by the functions above and below.  Must be
+// called before drawing anything with GL directly, changing the GL
+// state they use, or reading the screen.  I_FinishFrame() calls it.
+void HUD_FlushBatch(void);
+
 // Functions for when we want to draw without having an image_c
 void HUD_StretchFromImageData(float x, float y, float w, float h, const image_data_c *img, unsigned int tex_id,
                               image_opacity_e opacity);
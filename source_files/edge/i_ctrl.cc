@@ -34,8 +34,6 @@
 
 // FIXME: Combine all these SDL bool vars into an int/enum'd flags structure
 
-extern cvar_c r_doubleframes;
-
 // Work around for alt-tabbing
 bool alt_is_down;
 bool eat_mouse_motion = true;
@@ -850,19 +848,33 @@ void I_ShutdownControl(void)
     }
 }
 
+int64_t I_GetTimeMicros(void)
+{
+    static Uint64 base = SDL_GetPerformanceCounter();
+    static Uint64 freq = SDL_GetPerformanceFrequency();
+
+    Uint64 t = SDL_GetPerformanceCounter() - base;
+
+    // split up to avoid overflowing with high frequency counters
+    return (int64_t)((t / freq) * 1000000 + (t % freq) * 1000000 / freq);
+}
+
 int I_GetTime(void)
 {
-    Uint32 t = SDL_GetTicks();
+    return (int)(I_GetTimeMicros() * 35 / 1000000);
+}
 
-    int factor = (r_doubleframes.d ? 70 : 35);
+float I_GetTimeFrac(void)
+{
+    int64_t t = I_GetTimeMicros();
 
-    // more complex than "t*70/1000" to give more accuracy
-    return (t / 1000) * factor + (t % 1000) * factor / 1000;
+    // how far we are between the tic I_GetTime() returns and the next one
+    return (float)(t * 35 % 1000000) / 1000000.0f;
 }
 
 int I_GetMillies(void)
 {
-    return SDL_GetTicks();
+    return (int)(I_GetTimeMicros() / 1000);
 }
 
 //--- editor settings ---
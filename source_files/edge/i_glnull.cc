@@ -0,0 +1,439 @@
+//----------------------------------------------------------------------------
+//  EDGE Null OpenGL Backend
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Used by the headless playsim benchmark (edge-sim-bench): instead of
+//  loading a GL driver, every GL function the engine calls is pointed
+//  at a stub which does nothing, so the normal startup and level setup
+//  code runs unchanged without a window or GPU.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+#include "i_defs_gl.h"
+
+static GLuint null_next_name = 1;
+
+static void GLAD_API_PTR Null_glGenTextures(GLsizei n, GLuint *textures)
+{
+    for (GLsizei i = 0; i < n; i++)
+        textures[i] = null_next_name++;
+}
+
+static void GLAD_API_PTR Null_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+    for (GLsizei i = 0; i < n; i++)
+        buffers[i] = null_next_name++;
+}
+
+static const GLubyte *GLAD_API_PTR Null_glGetString(GLenum name)
+{
+    return (const GLubyte *)"null";
+}
+
+static void GLAD_API_PTR Null_glGetIntegerv(GLenum pname, GLint *data)
+{
+    switch (pname)
+    {
+    case GL_MAX_LIGHTS:
+    case GL_MAX_CLIP_PLANES:
+        *data = 8;
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *data = 4096;
+        break;
+    case GL_MAX_TEXTURE_UNITS:
+        *data = 4;
+        break;
+    default:
+        *data = 0;
+        break;
+    }
+}
+
+static void GLAD_API_PTR Null_glGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+    *params = 0;
+}
+
+static void GLAD_API_PTR Null_glActiveTexture(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glAlphaFunc(GLenum, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glBegin(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glBindBuffer(GLenum, GLuint)
+{
+}
+
+static void GLAD_API_PTR Null_glBindTexture(GLenum, GLuint)
+{
+}
+
+static void GLAD_API_PTR Null_glBlendFunc(GLenum, GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glBufferData(GLenum, GLsizeiptr, const void*, GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glClear(GLbitfield)
+{
+}
+
+static void GLAD_API_PTR Null_glClearColor(GLfloat, GLfloat, GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glClientActiveTexture(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glClipPlane(GLenum, const GLdouble*)
+{
+}
+
+static void GLAD_API_PTR Null_glColor3f(GLfloat, GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glColor4f(GLfloat, GLfloat, GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glColor4fv(const GLfloat*)
+{
+}
+
+static void GLAD_API_PTR Null_glColorMask(GLboolean, GLboolean, GLboolean, GLboolean)
+{
+}
+
+static void GLAD_API_PTR Null_glColorMaterial(GLenum, GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glColorPointer(GLint, GLenum, GLsizei, const void*)
+{
+}
+
+static void GLAD_API_PTR Null_glCullFace(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glDeleteBuffers(GLsizei, const GLuint*)
+{
+}
+
+static void GLAD_API_PTR Null_glDeleteTextures(GLsizei, const GLuint*)
+{
+}
+
+static void GLAD_API_PTR Null_glDepthFunc(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glDepthMask(GLboolean)
+{
+}
+
+static void GLAD_API_PTR Null_glDisable(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glDisableClientState(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glDrawArrays(GLenum, GLint, GLsizei)
+{
+}
+
+static void GLAD_API_PTR Null_glEnable(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glEnableClientState(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glEnd(void)
+{
+}
+
+static void GLAD_API_PTR Null_glFlush(void)
+{
+}
+
+static void GLAD_API_PTR Null_glFogf(GLenum, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glFogfv(GLenum, const GLfloat*)
+{
+}
+
+static void GLAD_API_PTR Null_glFogi(GLenum, GLint)
+{
+}
+
+static void GLAD_API_PTR Null_glFrontFace(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glFrustum(GLdouble, GLdouble, GLdouble, GLdouble, GLdouble, GLdouble)
+{
+}
+
+static void GLAD_API_PTR Null_glHint(GLenum, GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glLightModelfv(GLenum, const GLfloat*)
+{
+}
+
+static void GLAD_API_PTR Null_glLineWidth(GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glLoadIdentity(void)
+{
+}
+
+static void GLAD_API_PTR Null_glMaterialfv(GLenum, GLenum, const GLfloat*)
+{
+}
+
+static void *GLAD_API_PTR Null_glMapBuffer(GLenum, GLenum)
+{
+    return NULL;
+}
+
+static void GLAD_API_PTR Null_glMatrixMode(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glMultiTexCoord2fv(GLenum, const GLfloat*)
+{
+}
+
+static void GLAD_API_PTR Null_glNormal3f(GLfloat, GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glNormal3fv(const GLfloat*)
+{
+}
+
+static void GLAD_API_PTR Null_glNormal3i(GLint, GLint, GLint)
+{
+}
+
+static void GLAD_API_PTR Null_glNormalPointer(GLenum, GLsizei, const void*)
+{
+}
+
+static void GLAD_API_PTR Null_glOrtho(GLdouble, GLdouble, GLdouble, GLdouble, GLdouble, GLdouble)
+{
+}
+
+static void GLAD_API_PTR Null_glPixelStorei(GLenum, GLint)
+{
+}
+
+static void GLAD_API_PTR Null_glPixelZoom(GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glPolygonOffset(GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glPopMatrix(void)
+{
+}
+
+static void GLAD_API_PTR Null_glPushMatrix(void)
+{
+}
+
+static void GLAD_API_PTR Null_glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*)
+{
+}
+
+static void GLAD_API_PTR Null_glRotatef(GLfloat, GLfloat, GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glScissor(GLint, GLint, GLsizei, GLsizei)
+{
+}
+
+static void GLAD_API_PTR Null_glShadeModel(GLenum)
+{
+}
+
+static void GLAD_API_PTR Null_glTexCoord2f(GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glTexCoordPointer(GLint, GLenum, GLsizei, const void*)
+{
+}
+
+static void GLAD_API_PTR Null_glTexEnvi(GLenum, GLenum, GLint)
+{
+}
+
+static void GLAD_API_PTR Null_glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*)
+{
+}
+
+static void GLAD_API_PTR Null_glTexParameteri(GLenum, GLenum, GLint)
+{
+}
+
+static void GLAD_API_PTR Null_glTranslatef(GLfloat, GLfloat, GLfloat)
+{
+}
+
+static GLboolean GLAD_API_PTR Null_glUnmapBuffer(GLenum)
+{
+    return GL_TRUE;
+}
+
+static void GLAD_API_PTR Null_glVertex2f(GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glVertex2i(GLint, GLint)
+{
+}
+
+static void GLAD_API_PTR Null_glVertex3f(GLfloat, GLfloat, GLfloat)
+{
+}
+
+static void GLAD_API_PTR Null_glVertex3fv(const GLfloat*)
+{
+}
+
+static void GLAD_API_PTR Null_glVertexPointer(GLint, GLenum, GLsizei, const void*)
+{
+}
+
+static void GLAD_API_PTR Null_glViewport(GLint, GLint, GLsizei, GLsizei)
+{
+}
+
+void I_NullGLStartup(void)
+{
+    I_Printf("OpenGL: using the null backend\n");
+
+    GLAD_GL_VERSION_1_0 = 1;
+    GLAD_GL_VERSION_1_1 = 1;
+    GLAD_GL_VERSION_1_2 = 1;
+    GLAD_GL_VERSION_1_3 = 1;
+    GLAD_GL_VERSION_1_4 = 1;
+    GLAD_GL_VERSION_1_5 = 1;
+
+    glad_glActiveTexture       = Null_glActiveTexture;
+    glad_glAlphaFunc           = Null_glAlphaFunc;
+    glad_glBegin               = Null_glBegin;
+    glad_glBindBuffer          = Null_glBindBuffer;
+    glad_glBindTexture         = Null_glBindTexture;
+    glad_glBlendFunc           = Null_glBlendFunc;
+    glad_glBufferData          = Null_glBufferData;
+    glad_glClear               = Null_glClear;
+    glad_glClearColor          = Null_glClearColor;
+    glad_glClientActiveTexture = Null_glClientActiveTexture;
+    glad_glClipPlane           = Null_glClipPlane;
+    glad_glColor3f             = Null_glColor3f;
+    glad_glColor4f             = Null_glColor4f;
+    glad_glColor4fv            = Null_glColor4fv;
+    glad_glColorMask           = Null_glColorMask;
+    glad_glColorMaterial       = Null_glColorMaterial;
+    glad_glColorPointer        = Null_glColorPointer;
+    glad_glCullFace            = Null_glCullFace;
+    glad_glDeleteBuffers       = Null_glDeleteBuffers;
+    glad_glDeleteTextures      = Null_glDeleteTextures;
+    glad_glDepthFunc           = Null_glDepthFunc;
+    glad_glDepthMask           = Null_glDepthMask;
+    glad_glDisable             = Null_glDisable;
+    glad_glDisableClientState  = Null_glDisableClientState;
+    glad_glDrawArrays          = Null_glDrawArrays;
+    glad_glEnable              = Null_glEnable;
+    glad_glEnableClientState   = Null_glEnableClientState;
+    glad_glEnd                 = Null_glEnd;
+    glad_glFlush               = Null_glFlush;
+    glad_glFogf                = Null_glFogf;
+    glad_glFogfv               = Null_glFogfv;
+    glad_glFogi                = Null_glFogi;
+    glad_glFrontFace           = Null_glFrontFace;
+    glad_glFrustum             = Null_glFrustum;
+    glad_glGenBuffers          = Null_glGenBuffers;
+    glad_glGenTextures         = Null_glGenTextures;
+    glad_glGetIntegerv         = Null_glGetIntegerv;
+    glad_glGetString           = Null_glGetString;
+    glad_glGetTexParameteriv   = Null_glGetTexParameteriv;
+    glad_glHint                = Null_glHint;
+    glad_glLightModelfv        = Null_glLightModelfv;
+    glad_glLineWidth           = Null_glLineWidth;
+    glad_glLoadIdentity        = Null_glLoadIdentity;
+    glad_glMaterialfv          = Null_glMaterialfv;
+    glad_glMapBuffer           = Null_glMapBuffer;
+    glad_glMatrixMode          = Null_glMatrixMode;
+    glad_glMultiTexCoord2fv    = Null_glMultiTexCoord2fv;
+    glad_glNormal3f            = Null_glNormal3f;
+    glad_glNormal3fv           = Null_glNormal3fv;
+    glad_glNormal3i            = Null_glNormal3i;
+    glad_glNormalPointer       = Null_glNormalPointer;
+    glad_glOrtho               = Null_glOrtho;
+    glad_glPixelStorei         = Null_glPixelStorei;
+    glad_glPixelZoom           = Null_glPixelZoom;
+    glad_glPolygonOffset       = Null_glPolygonOffset;
+    glad_glPopMatrix           = Null_glPopMatrix;
+    glad_glPushMatrix          = Null_glPushMatrix;
+    glad_glReadPixels          = Null_glReadPixels;
+    glad_glRotatef             = Null_glRotatef;
+    glad_glScissor             = Null_glScissor;
+    glad_glShadeModel          = Null_glShadeModel;
+    glad_glTexCoord2f          = Null_glTexCoord2f;
+    glad_glTexCoordPointer     = Null_glTexCoordPointer;
+    glad_glTexEnvi             = Null_glTexEnvi;
+    glad_glTexImage2D          = Null_glTexImage2D;
+    glad_glTexParameteri       = Null_glTexParameteri;
+    glad_glTranslatef          = Null_glTranslatef;
+    glad_glUnmapBuffer         = Null_glUnmapBuffer;
+    glad_glVertex2f            = Null_glVertex2f;
+    glad_glVertex2i            = Null_glVertex2i;
+    glad_glVertex3f            = Null_glVertex3f;
+    glad_glVertex3fv           = Null_glVertex3fv;
+    glad_glVertexPointer       = Null_glVertexPointer;
+    glad_glViewport            = Null_glViewport;
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
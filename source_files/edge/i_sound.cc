@@ -66,7 +66,9 @@ void SoundFill_Callback(void *udata, Uint8 *stream, int len)
 {
     (void)udata;
     SDL_memset(stream, 0, len);
-    S_MixAllChannels(stream, len);
+
+    if (!mix_in_game)
+        S_MixAllChannels(stream, len);
 }
 
 static bool I_TryOpenSound(int want_freq, bool want_stereo)
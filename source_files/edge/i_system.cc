@@ -25,6 +25,7 @@
 
 #include "con_main.h"
 #include "dm_defs.h"
+#include "e_capture.h"
 #include "e_main.h"
 #include "g_game.h"
 #include "m_argv.h"
@@ -160,11 +161,33 @@ void I_Sleep(int millisecs)
     SDL_Delay(millisecs);
 }
 
+void I_SleepMicros(int microsecs)
+{
+#if !defined(__MINGW32__) && (defined(WIN32) || defined(_WIN32) || defined(_WIN64))
+    if (windows_timer != NULL)
+    {
+        LARGE_INTEGER due_time;
+        due_time.QuadPart = -((LONGLONG)microsecs * 10);
+        if (SetWaitableTimerEx(windows_timer, &due_time, 0, NULL, NULL, NULL, 0))
+        {
+            WaitForSingleObject(windows_timer, INFINITE);
+        }
+        return;
+    }
+#endif
+
+    std::this_thread::sleep_for(std::chrono::microseconds(microsecs));
+}
+
 void I_SystemShutdown(void)
 {
     // make sure audio is unlocked (e.g. I_Error occurred)
     I_UnlockAudio();
 
+    // the workers must be stopped before exiting (e.g. I_Error occurred)
+    M_StopScreenShotThread();
+    E_CaptureClose();
+
     I_ShutdownSound();
     I_ShutdownControl();
     I_ShutdownGraphics();
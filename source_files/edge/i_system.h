@@ -75,6 +75,10 @@ void I_CloseProgram(int exitnum) GCCATTR((noreturn));
 // -AJA- 2005/01/21: sleep for the given number of milliseconds.
 void I_Sleep(int millisecs);
 
+// sleep for the given number of microseconds.  The operating system
+// may wake us up later than asked (see e_pacer.cc).
+void I_SleepMicros(int microsecs);
+
 // -AJA- 2007/04/13: display a system message box with the
 // given message (typically a serious error message).
 void I_MessageBox(const char *message, const char *title);
@@ -108,11 +112,22 @@ void I_ShutdownControl(void);
 // predictable.
 int I_PureRandom(void);
 
+// Returns a value that increases by 1000000 every second, from close
+// to zero when first called.  Unlike I_GetMicros() it never goes
+// backwards or wraps around.  I_GetTime() and I_GetMillies() are based
+// on this timer.
+int64_t I_GetTimeMicros(void);
+
 // Returns a value that increases monotonically over time.  The value
 // should increase by TICRATE every second (TICRATE is currently 35).
 // The starting value should be close to zero.
 int I_GetTime(void);
 
+// Returns how far the current time is between the value I_GetTime()
+// returns and the next one, in the range 0.0 to 1.0 (exclusive).  Used
+// to interpolate the rendered frames between game tics.
+float I_GetTimeFrac(void);
+
 // Returns a value that increases by 1000 every second (i.e. each unit is
 // a single millisecond).  This timer begins at zero when the application
 // is first begun, hence it won't normally overflow (unless the engine
@@ -190,6 +205,10 @@ void I_StartupGraphics(void);
 // I_SystemStartup(), the main code never calls this function.
 void I_ShutdownGraphics(void);
 
+// Points all the GL functions at stubs which do nothing.  Only used
+// by the headless playsim benchmark, instead of creating a window.
+void I_NullGLStartup(void);
+
 // Called to prepare the screen for rendering (if necessary).
 void I_StartFrame(void);
 
@@ -198,6 +217,10 @@ void I_StartFrame(void);
 // may also handle double/triple buffering here.
 void I_FinishFrame(void);
 
+// Returns the refresh rate (in Hz) of the display the window is on,
+// or zero if it is not known.
+int I_GetRefreshRate(void);
+
 // Tries to set the video card to the given mode (or open a window).
 // If there already was a valid mode (or open window), this call
 // should replace it.  The previous contents (including the palette)
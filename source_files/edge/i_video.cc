@@ -23,6 +23,7 @@
 
 #include <signal.h>
 
+#include "hu_draw.h"
 #include "m_argv.h"
 #include "m_misc.h"
 #include "r_modes.h"
@@ -123,6 +124,20 @@ void I_DeterminePixelAspect()
 
 void I_StartupGraphics(void)
 {
+#ifdef EDGE_SIM_BENCH
+    // headless: no window or video modes, just the null GL backend
+    v_desktop_width  = SCREENWIDTH;
+    v_desktop_height = SCREENHEIGHT;
+
+    borderless_mode.display_mode = scrmode_c::SCR_BORDERLESS;
+    borderless_mode.width        = SCREENWIDTH;
+    borderless_mode.height       = SCREENHEIGHT;
+    borderless_mode.depth        = SCREENBITS;
+
+    I_NullGLStartup();
+    return;
+#endif
+
     std::string driver = argv::Value("videodriver");
 
     if (driver.empty())
@@ -325,6 +340,11 @@ bool I_SetScreenSize(scrmode_c *mode)
                  ? "borderless"
                  : (mode->display_mode == scrmode_c::SCR_FULLSCREEN ? "fullscreen" : "windowed"));
 
+#ifdef EDGE_SIM_BENCH
+    // headless: every mode "works", as nothing is ever shown
+    return true;
+#endif
+
     if (my_vis == NULL)
     {
         if (!I_CreateWindow(mode))
@@ -393,11 +413,16 @@ void I_StartFrame(void)
 
 void I_FinishFrame(void)
 {
+    HUD_FlushBatch();
+
     SDL_GL_SwapWindow(my_vis);
     
     EDGE_TracyPlot("draw_runits", (int64_t) ecframe_stats.draw_runits);
+    EDGE_TracyPlot("draw_mergedunits", (int64_t) ecframe_stats.draw_mergedunits);
+    EDGE_TracyPlot("draw_sortmicros", (int64_t) ecframe_stats.draw_sortmicros);
     EDGE_TracyPlot("draw_wallparts", (int64_t) ecframe_stats.draw_wallparts);
     EDGE_TracyPlot("draw_planes", (int64_t) ecframe_stats.draw_planes);
+    EDGE_TracyPlot("draw_geomcached", (int64_t) ecframe_stats.draw_geomcached);
     EDGE_TracyPlot("draw_things", (int64_t) ecframe_stats.draw_things);
     EDGE_TracyPlot("draw_lightiterator", (int64_t) ecframe_stats.draw_lightiterator);
     EDGE_TracyPlot("draw_sectorglowiterator", (int64_t) ecframe_stats.draw_sectorglowiterator);
@@ -426,6 +451,19 @@ void I_FinishFrame(void)
         I_DeterminePixelAspect();
 }
 
+int I_GetRefreshRate(void)
+{
+    if (!my_vis || graphics_shutdown)
+        return 0;
+
+    SDL_DisplayMode mode;
+
+    if (SDL_GetWindowDisplayMode(my_vis, &mode) != 0)
+        return 0;
+
+    return mode.refresh_rate;
+}
+
 void I_ShutdownGraphics(void)
 {
     if (graphics_shutdown)
@@ -77,6 +77,10 @@ static const dehconvfuncs_t edge_dehconv_funcs = {
 
 void DEH_Convert(const uint8_t *data, int length, const std::string &source)
 {
+    // the converted entries are already in the DDF snapshot
+    if (DDF_SnapshotLoaded())
+        return;
+
     DehEdgeStartup(&edge_dehconv_funcs);
 
     dehret_e ret = DehEdgeAddLump((const char *)data, length);
@@ -91,6 +95,9 @@ void DEH_Convert(const uint8_t *data, int length, const std::string &source)
         I_Error("Failed to convert DeHackEd file: %s\n", source.c_str());
     }
 
+    // the text form is only needed for dumping
+    DehEdgeSetKeepText(debug_dehacked.d > 0);
+
     ddf_collection_c col;
 
     ret = DehEdgeRunConversion(&col);
@@ -42,6 +42,7 @@
 #include "dm_state.h"
 #include "dstrings.h"
 #include "e_main.h"
+#include "g_demo.h"
 #include "g_game.h"
 #include "f_interm.h"
 #include "hu_draw.h"
@@ -1597,6 +1598,8 @@ static void QuitResponse(int ch)
         }
     }
 
+    G_StopDemo();
+
     // -ACB- 1999/09/20 New exit code order
     // Write the default config file first
     I_Printf("Saving system defaults...\n");
@@ -1673,6 +1676,8 @@ void M_ImmediateQuit()
     return;
 #endif
 
+    G_StopDemo();
+
     I_Printf("Saving system defaults...\n");
     M_SaveDefaults();
 
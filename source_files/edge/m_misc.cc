@@ -30,6 +30,11 @@
 
 #include "i_defs.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "endianess.h"
 #include "file.h"
 #include "filesystem.h"
@@ -432,91 +437,239 @@ void M_InitMiscConVars(void)
 #define PIXEL_GRN(pix) (playpal_data[0][pix][1])
 #define PIXEL_BLU(pix) (playpal_data[0][pix][2])
 
-void M_ScreenShot(bool show_msg)
+//----------------------------------------------------------------------------
+//  SCREENSHOTS
+//----------------------------------------------------------------------------
+//
+// The screen is read with RGL_QueueReadScreen(), which hands the image
+// over a frame later, then a worker thread flips it and encodes it to
+// a JPEG or PNG file.  Results are printed by M_UpdateScreenShots(),
+// since the console is not thread safe.
+//
+
+// how many images can wait for the worker before the game waits too
+#define MAX_PENDING_SHOTS 8
+
+typedef struct
 {
-    const char *extension;
+    image_data_c *img;
+    std::string   filename;
 
-    if (png_scrshots)
-        extension = "png";
+    bool png;
+    bool show_msg;
+    bool save_game; // touch the .replace file afterwards
+
+    bool result;
+} shot_job_t;
+
+static std::thread             shot_thread;
+static bool                    shot_quit = false;
+static std::mutex              shot_lock;
+static std::condition_variable shot_cond;
+
+static std::deque<shot_job_t *> shot_queue;
+static std::deque<shot_job_t *> shot_done;
+
+// jobs not finished yet, including those waiting for their image
+static int shot_pending = 0;
+
+// last number used for a shotXX file name
+static int last_shot_num = 0;
+
+static void EncodeScreenShot(shot_job_t *job)
+{
+    // the screen is read bottom-up, need to invert it
+    job->img->Invert();
+
+    if (job->png)
+        job->result = PNG_Save(job->filename, job->img);
     else
-        extension = "jpg";
+        job->result = JPEG_Save(job->filename, job->img);
 
-    std::string fn;
+    delete job->img;
+    job->img = NULL;
 
-    // find a file name to save it to
-    for (int i = 1; i <= 9999; i++)
+    if (job->save_game)
     {
-        std::string base(epi::StringFormat("shot%02d.%s", i, extension));
+        std::string replace(job->filename);
 
-        fn = epi::PathAppend(shot_dir, base);
+        epi::ReplaceExtension(replace, ".replace");
 
-        if (!epi::TestFileAccess(fn))
-        {
-            break; // file doesn't exist
-        }
+        epi::File *replace_touch = epi::FileOpen(replace, epi::kFileAccessWrite);
+
+        delete replace_touch;
     }
+}
 
-    image_data_c *img = new image_data_c(SCREENWIDTH, SCREENHEIGHT, 3);
+static void ShotThreadLoop(void)
+{
+    std::unique_lock<std::mutex> lock(shot_lock);
 
-    RGL_ReadScreen(0, 0, SCREENWIDTH, SCREENHEIGHT, img->PixelAt(0, 0));
+    for (;;)
+    {
+        shot_cond.wait(lock, [] { return shot_quit || !shot_queue.empty(); });
 
-    // ReadScreen produces a bottom-up image, need to invert it
-    img->Invert();
+        if (shot_queue.empty())
+            break;
 
-    bool result;
+        shot_job_t *job = shot_queue.front();
+        shot_queue.pop_front();
 
-    if (png_scrshots)
-    {
-        result = PNG_Save(fn, img);
+        lock.unlock();
+
+        EncodeScreenShot(job);
+
+        lock.lock();
+
+        shot_done.push_back(job);
+
+        shot_cond.notify_all();
     }
-    else
+}
+
+static void ScreenShotRead(image_data_c *img, void *priv)
+{
+    shot_job_t *job = (shot_job_t *)priv;
+
+    job->img = img;
+
+    if (!shot_thread.joinable())
     {
-        result = JPEG_Save(fn, img);
+        shot_quit   = false;
+        shot_thread = std::thread(ShotThreadLoop);
     }
 
-    if (show_msg)
+    std::unique_lock<std::mutex> lock(shot_lock);
+
+    // don't let the images pile up when the worker can't keep up
+    shot_cond.wait(lock, [] { return shot_queue.size() < MAX_PENDING_SHOTS; });
+
+    shot_queue.push_back(job);
+
+    shot_cond.notify_all();
+}
+
+static void QueueScreenShot(const std::string &filename, bool png, bool show_msg, bool save_game)
+{
+    shot_job_t *job = new shot_job_t;
+
+    job->img       = NULL;
+    job->filename  = filename;
+    job->png       = png;
+    job->show_msg  = show_msg;
+    job->save_game = save_game;
+    job->result    = false;
+
+    shot_pending++;
+
+    RGL_QueueReadScreen(ScreenShotRead, job);
+}
+
+void M_UpdateScreenShots(bool wait_all)
+{
+    if (shot_pending == 0)
+        return;
+
+    if (wait_all)
+        RGL_UpdateReadScreens(true);
+
+    std::deque<shot_job_t *> finished;
+
     {
-        if (result)
-            I_Printf("Captured to file: %s\n", fn.c_str());
-        else
-            I_Printf("Error saving file: %s\n", fn.c_str());
+        std::unique_lock<std::mutex> lock(shot_lock);
+
+        if (wait_all)
+            shot_cond.wait(lock, [] { return (int)shot_done.size() == shot_pending; });
+
+        finished.swap(shot_done);
     }
 
-    delete img;
+    for (shot_job_t *job : finished)
+    {
+        if (job->show_msg)
+        {
+            if (job->result)
+                I_Printf("Captured to file: %s\n", job->filename.c_str());
+            else
+                I_Printf("Error saving file: %s\n", job->filename.c_str());
+        }
+
+        shot_pending--;
+
+        delete job;
+    }
 }
 
-void M_MakeSaveScreenShot(void)
+void M_StopScreenShotThread(void)
 {
+    if (!shot_thread.joinable())
+        return;
 
-    const char *extension = "jpg";
+    {
+        std::lock_guard<std::mutex> lock(shot_lock);
+        shot_quit = true;
+    }
 
-    std::string           temp(epi::StringFormat("%s/%s.%s", "current", "head", extension));
-    std::string filename = epi::PathAppend(save_dir, temp);
+    shot_cond.notify_all();
 
-    epi::FileDelete(filename);
+    // can happen when a fatal error occurs while encoding
+    if (std::this_thread::get_id() == shot_thread.get_id())
+    {
+        shot_thread.detach();
+        return;
+    }
 
-    image_data_c *img = new image_data_c(SCREENWIDTH, SCREENHEIGHT, 3);
+    shot_thread.join();
+}
 
-    RGL_ReadScreen(0, 0, SCREENWIDTH, SCREENHEIGHT, img->PixelAt(0, 0));
+void M_ShutdownScreenShots(void)
+{
+    M_UpdateScreenShots(true);
 
-    // ReadScreen produces a bottom-up image, need to invert it
-    img->Invert();
+    M_StopScreenShotThread();
+}
 
-    bool result;
-    result = JPEG_Save(filename, img);
+void M_ScreenShot(bool show_msg)
+{
+    const char *extension;
 
-    if (result)
-        I_Printf("Captured to file: %s\n", filename.c_str());
+    if (png_scrshots)
+        extension = "png";
     else
-        I_Printf("Error saving file: %s\n", filename.c_str());
+        extension = "jpg";
+
+    std::string fn;
+
+    // find a file name to save it to.  Earlier shots may still be
+    // waiting to be written, so continue after the last one used.
+    for (int i = HMM_MIN(last_shot_num + 1, 9999); i <= 9999; i++)
+    {
+        std::string base(epi::StringFormat("shot%02d.%s", i, extension));
+
+        fn = epi::PathAppend(shot_dir, base);
+
+        last_shot_num = i;
+
+        if (!epi::TestFileAccess(fn))
+        {
+            break; // file doesn't exist
+        }
+    }
+
+    QueueScreenShot(fn, png_scrshots, show_msg, false);
+}
 
-    delete img;
+void M_MakeSaveScreenShot(void)
+{
 
-    epi::ReplaceExtension(filename, ".replace");
+    const char *extension = "jpg";
 
-    epi::File *replace_touch = epi::FileOpen(filename, epi::kFileAccessWrite);
+    std::string           temp(epi::StringFormat("%s/%s.%s", "current", "head", extension));
+    std::string filename = epi::PathAppend(save_dir, temp);
+
+    epi::FileDelete(filename);
 
-    delete replace_touch;
+    QueueScreenShot(filename, false, true, true);
 }
 
 //
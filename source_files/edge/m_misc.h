@@ -60,6 +60,15 @@ void M_InitMiscConVars(void);
 void M_ScreenShot(bool show_msg);
 void M_MakeSaveScreenShot(void);
 
+// prints the results of screenshots written since the last call.  When
+// `wait_all' is true, first waits until every one has been written.
+void M_UpdateScreenShots(bool wait_all);
+void M_ShutdownScreenShots(void);
+
+// stops the encoding worker (after the images it already has) without
+// reading the screen, so it is safe after a fatal error.
+void M_StopScreenShotThread(void);
+
 std::string M_ComposeFileName(std::string dir, std::string file);
 epi::File          *M_OpenComposedEPIFile(std::string dir, std::string file);
 void                  M_WarnError(const char *error, ...) GCCATTR((format(printf, 1, 2)));
@@ -392,7 +392,7 @@ static optmenuitem_t vidoptions[] = {
     {OPT_Switch, "Sector Brightness", SecBrights, 11, &v_secbright.d, M_UpdateCVARFromInt, NULL, &v_secbright},
     {OPT_Boolean, "Lighting Mode", "Indexed/Flat", 2, &r_forceflatlighting.d, M_UpdateCVARFromInt, NULL,
      &r_forceflatlighting},
-    {OPT_Switch, "Framerate Target", "35 FPS/70 FPS", 2, &r_doubleframes.d, M_UpdateCVARFromInt, NULL, &r_doubleframes},
+    {OPT_Switch, "Framerate Target", "35 FPS/70 FPS/Uncapped", 3, &r_doubleframes.d, M_UpdateCVARFromInt, NULL, &r_doubleframes},
     {OPT_Switch, "Smoothing", YesNo, 2, &var_smoothing, M_ChangeMipMap, NULL},
     {OPT_Switch, "Upscale Textures", Hq2xMode, 4, &hq2x_scaling, M_ChangeMipMap,
      "Only affects paletted (Doom format) textures"},
@@ -29,6 +29,7 @@
 #include "dm_state.h"
 #include "e_input.h"
 #include "e_main.h"
+#include "e_pacer.h"
 #include "g_game.h"
 #include "e_player.h"
 #include "m_argv.h"
@@ -43,17 +44,17 @@
 
 #include "epi_windows.h"
 
-extern coal::vm_c *ui_vm;
-extern void        VM_SetFloat(coal::vm_c *vm, const char *mod_name, const char *var_name, double value);
-
 // #define DEBUG_TICS 1
 
 // only true if packets are exchanged with a server
 bool netgame = false;
 
-// 70Hz
+// frame rate: 0 = 35 FPS, 1 = 70 FPS, 2 = uncapped.  The game itself
+// always runs at 35 tics per second, frames drawn in between tics are
+// interpolated (see r_interp.cc).
 DEF_CVAR(r_doubleframes, "1", CVAR_ARCHIVE)
-DEF_CVAR(n_busywait, "1", CVAR_ROM)
+// spin instead of sleeping while waiting for the next tic or frame
+DEF_CVAR(n_busywait, "0", CVAR_ARCHIVE)
 
 #if !defined(__MINGW32__) && (defined(WIN32) || defined(_WIN32) || defined(_WIN64))
 HANDLE windows_timer = NULL;
@@ -86,10 +87,6 @@ void N_InitNetwork(void)
 
 #if !defined(__MINGW32__) && (defined(WIN32) || defined(_WIN32) || defined(_WIN64))
     windows_timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
-    if (windows_timer != NULL)
-    {
-        n_busywait = 0;
-    }
 #endif
 }
 
@@ -174,9 +171,9 @@ void N_GrabTiccmds(void)
         memcpy(&p->cmd, p->in_cmds + buf, sizeof(ticcmd_t));
     }
     if (LUA_UseLuaHud())
-        LUA_SetFloat(LUA_GetGlobalVM(), "sys", "gametic", gametic / (r_doubleframes.d ? 2 : 1));
+        LUA_SetFloat(LUA_GetGlobalVM(), "sys", "gametic", gametic);
     else
-        VM_SetFloat(ui_vm, "sys", "gametic", gametic / (r_doubleframes.d ? 2 : 1));
+        VM_SetGameTic(gametic);
 
     gametic++;
 }
@@ -219,6 +216,12 @@ int N_NetUpdate()
     return nowtime;
 }
 
+// when the given tic starts, in I_GetTimeMicros() units
+static int64_t TicStartTime(int tic)
+{
+    return ((int64_t)tic * 1000000 + TICRATE - 1) / TICRATE;
+}
+
 int N_TryRunTics()
 {
     EDGE_ZoneScoped;
@@ -244,23 +247,38 @@ int N_TryRunTics()
     {
         while (realtics <= 0)
         {
+            E_PacerWaitUntil(TicStartTime(last_tryrun_tic + 1));
+
             nowtime         = N_NetUpdate();
             realtics        = nowtime - last_tryrun_tic;
             last_tryrun_tic = nowtime;
-
-            if (!n_busywait.d && realtics <= 0)
-            {
-                I_Sleep(5);
-            }
         }
 
         // this limit is rather arbitrary
         if (realtics > TICRATE / 3)
             realtics = TICRATE / 3;
 
+        E_PacerFrameStart();
         return realtics;
     }
 
+    if (realtics > 1)
+        E_PacerLateTics(realtics - 1);
+
+    // no tic is due yet: if a frame is due before it, let it be drawn
+    // (the caller runs zero tics).
+    if (realtics <= 0 && r_doubleframes.d > 0)
+    {
+        int64_t frame_time = E_PacerNextFrame(TicStartTime(last_tryrun_tic + 1));
+
+        if (frame_time > 0)
+        {
+            E_PacerWaitUntil(frame_time);
+            E_PacerFrameStart();
+            return 0;
+        }
+    }
+
     SYS_ASSERT(gametic <= maketic);
 
     // decide how many tics to run...
@@ -281,14 +299,15 @@ int N_TryRunTics()
     // wait for new tics if needed
     while (maketic < gametic + tics)
     {
-        N_NetUpdate();
+        E_PacerWaitUntil(TicStartTime(last_update_tic + 1));
 
-        if (!n_busywait.d && (maketic < gametic + tics))
-        {
-            I_Sleep(5);
-        }
+        N_NetUpdate();
     }
 
+    // the time we waited for has been used up
+    last_tryrun_tic = HMM_MAX(last_tryrun_tic, last_update_tic);
+
+    E_PacerFrameStart();
     return tics;
 }
 
@@ -57,6 +57,7 @@
 #include "f_interm.h" // wi_stats
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 extern flatdef_c *P_IsThingOnLiquidFloor(mobj_t *thing);
 
@@ -438,7 +439,7 @@ void P_ActMakeIntoCorpse(mobj_t *mo)
     // object is on ground, it can be walked over
     mo->flags &= ~MF_SOLID;
 
-    mo->tag = 0;
+    P_SetMobjTag(mo, 0);
 
     P_HitLiquidFloor(mo);
 }
@@ -460,7 +461,8 @@ void P_BringCorpseToLife(mobj_t *corpse)
     // UDMF check
     if (!AlmostEquals(corpse->alpha, 1.0f))
         corpse->vis_target = corpse->alpha;
-    corpse->tag           = corpse->spawnpoint.tag;
+
+    P_SetMobjTag(corpse, corpse->spawnpoint.tag);
 
     corpse->flags &= ~MF_COUNTKILL; // Lobo 2023: don't add to killcount
 
@@ -3089,6 +3091,8 @@ static bool CreateAggression(mobj_t *mo)
 //
 void P_ActStandardLook(mobj_t *object)
 {
+    EDGE_ZoneScoped;
+
     int     targ_pnum;
     mobj_t *targ = NULL;
 
@@ -3259,6 +3263,8 @@ void P_ActPlayerSupportMeander(mobj_t *object)
 //
 void P_ActStandardChase(mobj_t *object)
 {
+    EDGE_ZoneScoped;
+
     int    delta;
     sfx_t *sound;
 
@@ -68,9 +68,16 @@ int bmap_height = 0; // size in mapblocks
 float bmap_orgx;
 float bmap_orgy;
 
-typedef std::list<line_t *> linedef_set_t;
+// lines in each mapblock, stored contiguously: the lines in block N
+// are bmap_lines[bmap_line_start[N] .. bmap_line_start[N+1]-1].
+static int *bmap_line_start = NULL;
+static int *bmap_lines      = NULL;
 
-static linedef_set_t **bmap_lines = NULL;
+// copies of the line bounding boxes (four per line, indexed with
+// BOXTOP etc) and validcount marks, so that lines which are not
+// touched can be skipped without reading the line_t itself.
+static float *bmap_line_boxes = NULL;
+static int   *bmap_line_valid = NULL;
 
 // for thing chains
 mobj_t **bmap_things = NULL;
@@ -105,19 +112,14 @@ void P_CreateThingBlockMap(void)
 
 void P_DestroyBlockMap(void)
 {
-    if (bmap_lines)
-    {
-        for (int i = 0; i < bmap_width * bmap_height; i++)
-        {
-            if (bmap_lines[i])
-            {
-                delete bmap_lines[i];
-            }
-        }
-    }
-
+    delete[] bmap_line_start;
+    bmap_line_start = NULL;
     delete[] bmap_lines;
     bmap_lines = NULL;
+    delete[] bmap_line_boxes;
+    bmap_line_boxes = NULL;
+    delete[] bmap_line_valid;
+    bmap_line_valid = NULL;
     delete[] bmap_things;
     bmap_things = NULL;
 
@@ -750,6 +752,8 @@ void P_FreeSectorTouchNodes(sector_t *sec)
 //
 bool P_BlockLinesIterator(float x1, float y1, float x2, float y2, bool (*func)(line_t *, void *), void *data)
 {
+    EDGE_ZoneScoped;
+
     validcount++;
 
     int lx = BLOCKMAP_GET_X(x1);
@@ -765,30 +769,30 @@ bool P_BlockLinesIterator(float x1, float y1, float x2, float y2, bool (*func)(l
     for (int by = ly; by <= hy; by++)
         for (int bx = lx; bx <= hx; bx++)
         {
-            linedef_set_t *lset = bmap_lines[by * bmap_width + bx];
+            int bnum = by * bmap_width + bx;
 
-            if (!lset)
-                continue;
+            const int *list = bmap_lines + bmap_line_start[bnum];
+            const int *end  = bmap_lines + bmap_line_start[bnum + 1];
 
-            linedef_set_t::iterator LI;
-            for (LI = lset->begin(); LI != lset->end(); LI++)
+            for (; list < end; list++)
             {
-                line_t *ld = *LI;
+                int ln = *list;
 
                 // has line already been checked ?
-                if (ld->validcount == validcount)
+                if (bmap_line_valid[ln] == validcount)
                     continue;
 
-                ld->validcount = validcount;
+                bmap_line_valid[ln] = validcount;
 
                 // check whether line touches the given bbox
-                if (ld->bbox[BOXRIGHT] <= x1 || ld->bbox[BOXLEFT] >= x2 || ld->bbox[BOXTOP] <= y1 ||
-                    ld->bbox[BOXBOTTOM] >= y2)
+                const float *lbox = bmap_line_boxes + ln * 4;
+
+                if (lbox[BOXRIGHT] <= x1 || lbox[BOXLEFT] >= x2 || lbox[BOXTOP] <= y1 || lbox[BOXBOTTOM] >= y2)
                 {
                     continue;
                 }
 
-                if (!func(ld, data))
+                if (!func(lines + ln, data))
                     return false;
             }
         }
@@ -799,6 +803,8 @@ bool P_BlockLinesIterator(float x1, float y1, float x2, float y2, bool (*func)(l
 
 bool P_BlockThingsIterator(float x1, float y1, float x2, float y2, bool (*func)(mobj_t *, void *), void *data)
 {
+    EDGE_ZoneScoped;
+
     // need to expand the source by one block because large
     // things (radius limited to BLOCKMAP_UNIT) can overlap
     // into adjacent blocks.
@@ -963,6 +969,9 @@ void P_SectorGlowIterator(sector_t *sec, float x1, float y1, float z1, float x2,
 // INTERCEPT ROUTINES
 //
 
+// intercepts of the current trace are kept as a heap, nearest first.
+// The storage is reused between traces and never shrinks.  A traverser
+// may start a trace of its own: it uses the part above the outer one.
 static std::vector<intercept_t> intercepts;
 
 divline_t trace;
@@ -982,7 +991,7 @@ float P_InterceptVector(divline_t *v2, divline_t *v1)
     return num / den;
 }
 
-static inline void PIT_AddLineIntercept(line_t *ld)
+static inline void PIT_AddLineIntercept(int line_num)
 {
     // Looks for lines in the given block
     // that intercept the given trace
@@ -993,10 +1002,12 @@ static inline void PIT_AddLineIntercept(line_t *ld)
     // Returns true if earlyout and a solid line hit.
 
     // has line already been checked ?
-    if (ld->validcount == validcount)
+    if (bmap_line_valid[line_num] == validcount)
         return;
 
-    ld->validcount = validcount;
+    bmap_line_valid[line_num] = validcount;
+
+    line_t *ld = lines + line_num;
 
     int       s1;
     int       s2;
@@ -1110,9 +1121,10 @@ static inline void PIT_AddThingIntercept(mobj_t *thing)
 
 struct Compare_Intercept_pred
 {
+    // puts the nearest intercept at the top of the heap
     inline bool operator()(const intercept_t &A, const intercept_t &B) const
     {
-        return A.frac < B.frac;
+        return A.frac > B.frac;
     }
 };
 
@@ -1126,9 +1138,11 @@ struct Compare_Intercept_pred
 //
 bool P_PathTraverse(float x1, float y1, float x2, float y2, int flags, bool (*func)(intercept_t *, void *), void *data)
 {
+    EDGE_ZoneScoped;
+
     validcount++;
 
-    intercepts.clear();
+    size_t base = intercepts.size();
 
     // don't side exactly on a line
     if (AlmostEquals(fmod(x1 - bmap_orgx, BLOCKMAP_UNIT), 0.0))
@@ -1220,15 +1234,11 @@ bool P_PathTraverse(float x1, float y1, float x2, float y2, int flags, bool (*fu
         {
             if (flags & PT_ADDLINES)
             {
-                linedef_set_t *lset = bmap_lines[by * bmap_width + bx];
+                int bnum = by * bmap_width + bx;
 
-                if (lset)
+                for (int i = bmap_line_start[bnum]; i < bmap_line_start[bnum + 1]; i++)
                 {
-                    linedef_set_t::iterator LI;
-                    for (LI = lset->begin(); LI != lset->end(); LI++)
-                    {
-                        PIT_AddLineIntercept(*LI);
-                    }
+                    PIT_AddLineIntercept(bmap_lines[i]);
                 }
             }
 
@@ -1256,26 +1266,35 @@ bool P_PathTraverse(float x1, float y1, float x2, float y2, int flags, bool (*fu
         }
     }
 
-    // go through the sorted list
+    // go through the intercepts, nearest first.  Most traversers stop
+    // at the first thing or wall which blocks them, so only the ones
+    // which get visited are put in order.
 
-    if (intercepts.size() == 0)
+    if (intercepts.size() == base)
         return true;
 
-    std::sort(intercepts.begin(), intercepts.end(), Compare_Intercept_pred());
+    std::make_heap(intercepts.begin() + base, intercepts.end(), Compare_Intercept_pred());
 
-    std::vector<intercept_t>::iterator I;
+    bool result = true;
 
-    for (I = intercepts.begin(); I != intercepts.end(); I++)
+    while (intercepts.size() > base)
     {
-        if (!func(&*I, data))
+        std::pop_heap(intercepts.begin() + base, intercepts.end(), Compare_Intercept_pred());
+
+        intercept_t in = intercepts.back();
+        intercepts.pop_back();
+
+        if (!func(&in, data))
         {
             // don't bother going further
-            return false;
+            result = false;
+            break;
         }
     }
 
-    // everything was traversed
-    return true;
+    intercepts.resize(base);
+
+    return result;
 }
 
 //--------------------------------------------------------------------------
@@ -1283,14 +1302,12 @@ bool P_PathTraverse(float x1, float y1, float x2, float y2, int flags, bool (*fu
 //  BLOCKMAP GENERATION
 //
 
-static void BlockAdd(int bnum, line_t *ld)
-{
-    if (!bmap_lines[bnum])
-        bmap_lines[bnum] = new linedef_set_t;
-
-    bmap_lines[bnum]->push_back(ld);
+// (block, line) pairs, gathered before building the final arrays
+static std::vector<std::pair<int, int>> blk_pairs;
 
-    // blk_total_lines++;
+static void BlockAdd(int bnum, int line_num)
+{
+    blk_pairs.push_back(std::make_pair(bnum, line_num));
 }
 
 static void BlockAddLine(int line_num)
@@ -1345,7 +1362,7 @@ static void BlockAddLine(int line_num)
     if (y_dist == 0)
     {
         for (i = 0; i <= x_dist; i++, blocknum++)
-            BlockAdd(blocknum, ld);
+            BlockAdd(blocknum, line_num);
 
         return;
     }
@@ -1353,7 +1370,7 @@ static void BlockAddLine(int line_num)
     if (x_dist == 0)
     {
         for (i = 0; i <= y_dist; i++, blocknum += y_sign * bmap_width)
-            BlockAdd(blocknum, ld);
+            BlockAdd(blocknum, line_num);
 
         return;
     }
@@ -1382,7 +1399,7 @@ static void BlockAddLine(int line_num)
         {
             blocknum = (sy / 128 + j * y_sign) * bmap_width + (sx / 128);
 
-            BlockAdd(blocknum, ld);
+            BlockAdd(blocknum, line_num);
         }
     }
 }
@@ -1399,18 +1416,47 @@ void P_GenerateBlockMap(int min_x, int min_y, int max_x, int max_y)
     L_WriteDebug("GenerateBlockmap: MAP (%d,%d) -> (%d,%d)\n", min_x, min_y, max_x, max_y);
     L_WriteDebug("GenerateBlockmap: BLOCKS %d x %d  TOTAL %d\n", bmap_width, bmap_height, btotal);
 
-    // setup blk_cur_lines array.  Initially all pointers are NULL, when
-    // any lines get added then the dynamic array is created.
-
-    bmap_lines = new linedef_set_t *[btotal];
-
-    Z_Clear(bmap_lines, linedef_set_t *, btotal);
+    blk_pairs.clear();
 
     // process each linedef of the map
     for (int i = 0; i < numlines; i++)
         BlockAddLine(i);
 
-    // L_WriteDebug("GenerateBlockmap: TOTAL DATA=%d\n", blk_total_lines);
+    int total_lines = (int)blk_pairs.size();
+
+    L_WriteDebug("GenerateBlockmap: TOTAL DATA=%d\n", total_lines);
+
+    // count the lines in each block, then place them.  Within a block
+    // the lines stay in linedef order.
+    bmap_line_start = new int[btotal + 1];
+    bmap_lines      = new int[HMM_MAX(1, total_lines)];
+
+    Z_Clear(bmap_line_start, int, btotal + 1);
+
+    for (int i = 0; i < total_lines; i++)
+        bmap_line_start[blk_pairs[i].first + 1]++;
+
+    for (int b = 0; b < btotal; b++)
+        bmap_line_start[b + 1] += bmap_line_start[b];
+
+    std::vector<int> fill(bmap_line_start, bmap_line_start + btotal);
+
+    for (int i = 0; i < total_lines; i++)
+        bmap_lines[fill[blk_pairs[i].first]++] = blk_pairs[i].second;
+
+    blk_pairs.clear();
+    blk_pairs.shrink_to_fit();
+
+    bmap_line_boxes = new float[HMM_MAX(1, numlines) * 4];
+    bmap_line_valid = new int[HMM_MAX(1, numlines)];
+
+    for (int i = 0; i < numlines; i++)
+    {
+        for (int k = 0; k < 4; k++)
+            bmap_line_boxes[i * 4 + k] = lines[i].bbox[k];
+
+        bmap_line_valid[i] = 0;
+    }
 }
 
 //--- editor settings ---
@@ -43,6 +43,7 @@
 #include <float.h>
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 dirtype_e opposite[] = {DI_WEST,      DI_SOUTHWEST, DI_SOUTH,     DI_SOUTHEAST, DI_EAST,
                         DI_NORTHEAST, DI_NORTH,     DI_NORTHWEST, DI_NODIR};
@@ -185,6 +186,8 @@ void P_ActNoiseAlert(mobj_t *actor)
 //
 bool P_Move(mobj_t *actor, bool path)
 {
+    EDGE_ZoneScoped;
+
     HMM_Vec3 orig_pos{{actor->x, actor->y, actor->z}};
 
     float tryx;
@@ -299,6 +302,8 @@ static bool TryWalk(mobj_t *actor)
 // -ACB- 1998/09/06 actor is now an object; different movement choices.
 void P_NewChaseDir(mobj_t *object)
 {
+    EDGE_ZoneScoped;
+
     float     deltax;
     float     deltay;
     dirtype_e tdir;
@@ -455,6 +460,8 @@ void P_NewChaseDir(mobj_t *object)
 //
 bool P_LookForPlayers(mobj_t *actor, BAMAngle range)
 {
+    EDGE_ZoneScoped;
+
     int       c;
     int       stop;
     player_t *player;
@@ -43,11 +43,10 @@
 #include "m_random.h"
 #include "p_local.h"
 #include "r_state.h"
+#include "edge_profiling.h"
 
 #define PUSH_FACTOR 64.0f // should be 128 ??
 
-extern cvar_c r_doubleframes;
-
 std::vector<force_t *> active_forces;
 
 static force_t *tm_force; // for PIT_PushThing
@@ -212,11 +211,9 @@ void P_AddSectorForce(sector_t *sec, bool is_wind, float x_mag, float y_mag)
 //
 // Executes all force effects for the current tic.
 //
-void P_RunForces(bool extra_tic)
+void P_RunForces(void)
 {
-    // TODO: review what needs updating here for 70 Hz
-    if (extra_tic && r_doubleframes.d)
-        return;
+    EDGE_ZoneScoped;
 
     std::vector<force_t *>::iterator FI;
 
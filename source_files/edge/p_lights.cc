@@ -193,49 +193,44 @@ void EV_LightTurnOn(int tag, int bright)
 {
     /* TURN LINE'S TAG LIGHTS ON */
 
-    for (int i = 0; i < numsectors; i++)
+    for (sector_t *sector = P_FindSectorFromTag(tag); sector; sector = sector->tag_next)
     {
-        sector_t *sector = sectors + i;
-
-        if (sector->tag == tag)
+        // bright == 0 means to search for highest light level
+        // surrounding sector
+        if (!bright)
         {
-            // bright == 0 means to search for highest light level
-            // surrounding sector
-            if (!bright)
+            for (int j = 0; j < sector->linecount; j++)
             {
-                for (int j = 0; j < sector->linecount; j++)
-                {
-                    line_t *templine = sector->lines[j];
+                line_t *templine = sector->lines[j];
 
-                    sector_t *temp = P_GetNextSector(templine, sector);
+                sector_t *temp = P_GetNextSector(templine, sector);
 
-                    if (!temp)
-                        continue;
+                if (!temp)
+                    continue;
 
-                    if (temp->props.lightlevel > bright)
-                        bright = temp->props.lightlevel;
-                }
+                if (temp->props.lightlevel > bright)
+                    bright = temp->props.lightlevel;
             }
-            // bright == 1 means to search for lowest light level
-            // surrounding sector
-            if (bright == 1)
+        }
+        // bright == 1 means to search for lowest light level
+        // surrounding sector
+        if (bright == 1)
+        {
+            bright = 255;
+            for (int j = 0; j < sector->linecount; j++)
             {
-                bright = 255;
-                for (int j = 0; j < sector->linecount; j++)
-                {
-                    line_t *templine = sector->lines[j];
+                line_t *templine = sector->lines[j];
 
-                    sector_t *temp = P_GetNextSector(templine, sector);
+                sector_t *temp = P_GetNextSector(templine, sector);
 
-                    if (!temp)
-                        continue;
+                if (!temp)
+                    continue;
 
-                    if (temp->props.lightlevel < bright)
-                        bright = temp->props.lightlevel;
-                }
+                if (temp->props.lightlevel < bright)
+                    bright = temp->props.lightlevel;
             }
-            sector->props.lightlevel = bright;
         }
+        sector->props.lightlevel = bright;
     }
 }
 
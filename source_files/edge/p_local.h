@@ -119,7 +119,7 @@ void P_CreatePlayer(int pnum, bool is_bot);
 void P_DestroyAllPlayers(void);
 void P_GiveInitialBenefits(player_t *player, const mobjtype_c *info);
 
-bool P_PlayerThink(player_t *player, bool extra_tic);
+bool P_PlayerThink(player_t *player);
 void P_UpdateAvailWeapons(player_t *p);
 void P_UpdateTotalArmour(player_t *p);
 
@@ -145,7 +145,7 @@ statenum_t P_MobjFindLabel(mobj_t *mobj, const char *label);
 bool       P_SetMobjState(mobj_t *mobj, statenum_t state);
 bool       P_SetMobjStateDeferred(mobj_t *mobj, statenum_t state, int tic_skip);
 void       P_SetMobjDirAndSpeed(mobj_t *mobj, BAMAngle angle, float slope, float speed);
-void       P_RunMobjThinkers(bool extra_tic);
+void       P_RunMobjThinkers(void);
 void       P_SpawnDebris(float x, float y, float z, BAMAngle angle, const mobjtype_c *debris);
 void       P_SpawnPuff(float x, float y, float z, const mobjtype_c *puff, BAMAngle angle);
 void       P_SpawnBlood(float x, float y, float z, float damage, BAMAngle angle, const mobjtype_c *blood);
@@ -265,6 +265,7 @@ bool    P_CheckAbsPosition(mobj_t *thing, float x, float y, float z);
 bool    P_CheckSight(mobj_t *src, mobj_t *dest);
 bool    P_CheckSightToPoint(mobj_t *src, float x, float y, float z);
 bool    P_CheckSightApproxVert(mobj_t *src, mobj_t *dest);
+bool    P_CheckReject(const sector_t *src, const sector_t *dest);
 void    P_RadiusAttack(mobj_t *spot, mobj_t *source, float radius, float damage, const damage_c *damtype,
                        bool thrust_only);
 
@@ -288,6 +289,10 @@ bool ReplaceMidTexFromPart(line_t *TheLine, scroll_part_e parts);
 // -AJA- 2000/07/31: line data changed back to shorts.
 //
 
+// sector visibility table from the XWA file, NULL when there is none.
+// same layout as a REJECT lump.
+extern uint8_t *rejectmatrix;
+
 //
 // P_INTER
 //
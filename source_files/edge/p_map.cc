@@ -50,6 +50,7 @@
 #include "s_sound.h"
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 #define RAISE_RADIUS 32
 
@@ -245,6 +246,9 @@ bool P_TeleportMove(mobj_t *thing, float x, float y, float z)
 
     P_ChangeThingPosition(thing, x, y, z);
 
+    // don't draw it sliding across the map
+    thing->interp_skip = true;
+
     return true;
 }
 
@@ -399,6 +403,8 @@ static bool PIT_CheckAbsThing(mobj_t *thing, void *data)
 //
 bool P_CheckAbsPosition(mobj_t *thing, float x, float y, float z)
 {
+    EDGE_ZoneScoped;
+
     // can go anywhere
     if (thing->flags & MF_NOCLIP)
         return true;
@@ -1039,6 +1045,8 @@ static bool P_CheckRelPosition(mobj_t *thing, float x, float y)
 //
 bool P_TryMove(mobj_t *thing, float x, float y)
 {
+    EDGE_ZoneScoped;
+
     float   oldx;
     float   oldy;
     line_t *ld;
@@ -1326,6 +1334,8 @@ static bool PTR_SlideTraverse(intercept_t *in, void *dataptr)
 //
 void P_SlideMove(mobj_t *mo, float x, float y)
 {
+    EDGE_ZoneScoped;
+
     slidemo = mo;
 
     float dx = x - mo->x;
@@ -2235,6 +2245,8 @@ static bool PTR_ShootTraverse(intercept_t *in, void *dataptr)
 
 mobj_t *P_AimLineAttack(mobj_t *t1, BAMAngle angle, float distance, float *slope)
 {
+    EDGE_ZoneScoped;
+
     float x2 = t1->x + distance * epi::BAMCos(angle);
     float y2 = t1->y + distance * epi::BAMSin(angle);
 
@@ -2275,6 +2287,8 @@ mobj_t *P_AimLineAttack(mobj_t *t1, BAMAngle angle, float distance, float *slope
 void P_LineAttack(mobj_t *t1, BAMAngle angle, float distance, float slope, float damage, const damage_c *damtype,
                   const mobjtype_c *puff)
 {
+    EDGE_ZoneScoped;
+
     // Note: Damtype can be NULL.
 
     float x2 = t1->x + distance * epi::BAMCos(angle);
@@ -2548,6 +2562,8 @@ static bool PTR_UseTraverse(intercept_t *in, void *dataptr)
 //
 void P_UseLines(player_t *player)
 {
+    EDGE_ZoneScoped;
+
     int   angle;
     float x1;
     float y1;
@@ -2677,6 +2693,8 @@ static bool PIT_RadiusAttack(mobj_t *thing, void *data)
 //
 void P_RadiusAttack(mobj_t *spot, mobj_t *source, float radius, float damage, const damage_c *damtype, bool thrust_only)
 {
+    EDGE_ZoneScoped;
+
     bomb_I.range   = radius;
     bomb_I.spot    = spot;
     bomb_I.source  = source;
@@ -2956,6 +2974,7 @@ bool P_SolidSectorMove(sector_t *sec, bool is_ceiling, float dh, int crush, bool
 
     P_RecomputeGapsAroundSector(sec);
     P_FloodExtraFloors(sec);
+    R_DirtySectorGeometry(sec);
 
     if (!nocarething)
     {
@@ -66,6 +66,7 @@
 #include "s_sound.h"
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 #include <list>
 
@@ -73,8 +74,6 @@
 
 #define DEBUG_MOBJ 0
 
-extern cvar_c r_doubleframes;
-
 DEF_CVAR(g_cullthinkers, "0", CVAR_ARCHIVE)
 
 DEF_CVAR(g_gravity, "1.0", CVAR_ARCHIVE)
@@ -370,7 +369,8 @@ static void TeleportRespawn(mobj_t *mobj)
     new_mo->spawnpoint = mobj->spawnpoint;
     new_mo->angle      = mobj->spawnpoint.angle;
     new_mo->vertangle  = mobj->spawnpoint.vertangle;
-    new_mo->tag        = mobj->spawnpoint.tag;
+
+    P_SetMobjTag(new_mo, mobj->spawnpoint.tag);
 
     if (mobj->spawnpoint.flags & MF_AMBUSH)
         new_mo->flags |= MF_AMBUSH;
@@ -455,7 +455,7 @@ static void ResurrectRespawn(mobj_t *mobj)
     mobj->SetSource(NULL);
     mobj->SetTarget(NULL);
 
-    mobj->tag = mobj->spawnpoint.tag;
+    P_SetMobjTag(mobj, mobj->spawnpoint.tag);
 
     if (mobj->spawnpoint.flags & MF_AMBUSH)
         mobj->flags |= MF_AMBUSH;
@@ -781,14 +781,8 @@ void P_CalcFullProperties(const mobj_t *mo, region_properties_t *new_p)
 //
 // P_XYMovement
 //
-static void P_XYMovement(mobj_t *mo, const region_properties_t *props, bool extra_tic)
+static void P_XYMovement(mobj_t *mo, const region_properties_t *props)
 {
-    bool do_extra = mo->player != nullptr; // 70 Hz
-
-    // missiles should run every tic too
-    if (mo->flags & MF_MISSILE)
-        do_extra = true;
-
     float orig_x = mo->x;
     float orig_y = mo->y;
 
@@ -816,12 +810,6 @@ static void P_XYMovement(mobj_t *mo, const region_properties_t *props, bool extr
     float xmove = mo->mom.X;
     float ymove = mo->mom.Y;
 
-    if (do_extra && r_doubleframes.d) // 70Hz
-    {
-        xmove *= 0.52;
-        ymove *= 0.52;
-    }
-
     // -AJA- 1999/07/31: Ride that rawhide :->
     if (mo->above_mo && !(mo->above_mo->flags & MF_FLOAT) && mo->above_mo->floorz < (mo->z + mo->height + 1))
     {
@@ -1043,12 +1031,6 @@ static void P_XYMovement(mobj_t *mo, const region_properties_t *props, bool extr
         friction = props->drag;
     }
 
-    // 70hz : adjust friction to account for extra tic
-    if (do_extra && r_doubleframes.d)
-    {
-        friction = sqrt(friction);
-    }
-
     // when we are confident that a mikoportal is being used, do not apply friction or drag
     // to the voodoo doll
     if (!mo->is_voodoo || !AlmostEquals(mo->floorz, -32768.0f) || AlmostEquals(mo->mom.Z, 0.0f))
@@ -1079,13 +1061,8 @@ static void P_XYMovement(mobj_t *mo, const region_properties_t *props, bool extr
 //
 // P_ZMovement
 //
-static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra_tic)
+static void P_ZMovement(mobj_t *mo, const region_properties_t *props)
 {
-    bool do_extra = mo->player != nullptr; // 70 Hz
-
-    if (mo->flags & MF_MISSILE)
-        do_extra = true;
-
     float dist;
     float delta;
     float zmove;
@@ -1106,9 +1083,6 @@ static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra
 
     zmove = mo->mom.Z * (1.0f - props->viscosity);
 
-    if (do_extra && r_doubleframes.d) // 70 Hz
-        zmove *= 0.52;
-
     if (mo->on_slope && mo->z > mo->floorz && std::abs(mo->z - mo->floorz) < 6.0f) // 1/4 of default step size
         zmove_vs = mo->floorz - mo->z;
 
@@ -1153,11 +1127,11 @@ static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra
             bool  fly_or_swim =
                 mo->player && (mo->player->swimming || mo->player->powers[PW_Jetpack] > 0 || mo->on_ladder >= 0);
 
-            if (mo->player && gravity > 0 && -zmove > (OOF_SPEED / (r_doubleframes.d ? 2 : 1)) && !fly_or_swim)
+            if (mo->player && gravity > 0 && -zmove > OOF_SPEED && !fly_or_swim)
             {
                 // Squat down. Decrease viewheight for a moment after hitting the
                 // ground (hard), and utter appropriate sound.
-                mo->player->deltaviewheight = zmove / 8.0f * (r_doubleframes.d ? 2.0 : 1.0); // 70Hz
+                mo->player->deltaviewheight = zmove / 8.0f;
                 if (mo->info->maxfall > 0 && -mo->mom.Z > hurt_momz)
                 {
                     if (!(mo->player->cheats & CF_GODMODE) && mo->player->powers[PW_Invulnerable] < 1)
@@ -1234,9 +1208,7 @@ static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra
 
         if (!(mo->flags & MF_NOGRAVITY) && !(mo->player && mo->player->powers[PW_Jetpack] > 0) && !(mo->on_ladder >= 0))
         {
-            // 70 Hz: apply gravity only on real tics
-            if (!extra_tic || !r_doubleframes.d)
-                mo->mom.Z -= gravity / (mo->mbf21flags & MBF21_LOGRAV ? 8 : 1);
+            mo->mom.Z -= gravity / (mo->mbf21flags & MBF21_LOGRAV ? 8 : 1);
         }
     }
 
@@ -1256,7 +1228,7 @@ static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra
             bool  fly_or_swim =
                 mo->player && (mo->player->swimming || mo->player->powers[PW_Jetpack] > 0 || mo->on_ladder >= 0);
 
-            if (mo->player && gravity < 0 && zmove > (OOF_SPEED / (r_doubleframes.d ? 2 : 1)) && !fly_or_swim)
+            if (mo->player && gravity < 0 && zmove > OOF_SPEED && !fly_or_swim)
             {
                 mo->player->deltaviewheight = zmove / 8.0f;
                 S_StartFX(mo->info->oof_sound, P_MobjGetSfxCategory(mo), mo);
@@ -1315,9 +1287,7 @@ static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra
 
         if (!(mo->flags & MF_NOGRAVITY) && !(mo->player && mo->player->powers[PW_Jetpack] > 0) && !(mo->on_ladder >= 0))
         {
-            // 70 Hz: apply gravity only on real tics
-            if (!extra_tic || !r_doubleframes.d)
-                mo->mom.Z += -gravity / (mo->mbf21flags & MBF21_LOGRAV ? 8 : 1);
+            mo->mom.Z += -gravity / (mo->mbf21flags & MBF21_LOGRAV ? 8 : 1);
         }
     }
 
@@ -1350,8 +1320,10 @@ static void P_ZMovement(mobj_t *mo, const region_properties_t *props, bool extra
 //
 #define MAX_THINK_LOOP 8
 
-static void P_MobjThinker(mobj_t *mobj, bool extra_tic)
+static void P_MobjThinker(mobj_t *mobj)
 {
+    EDGE_ZoneScoped;
+
     if (mobj->next == (mobj_t *)-1)
         I_Error("P_MobjThinker INTERNAL ERROR: mobj has been freed");
 
@@ -1367,37 +1339,34 @@ static void P_MobjThinker(mobj_t *mobj, bool extra_tic)
 
     mobj->ClearStaleRefs();
 
-    if (!extra_tic || !r_doubleframes.d)
-    {
-        SYS_ASSERT(mobj->state);
-        SYS_ASSERT(mobj->refcount >= 0);
+    SYS_ASSERT(mobj->state);
+    SYS_ASSERT(mobj->refcount >= 0);
 
-        mobj->visibility = (15 * mobj->visibility + mobj->vis_target) / 16;
-        mobj->dlight.r   = (15 * mobj->dlight.r + mobj->dlight.target) / 16;
+    mobj->visibility = (15 * mobj->visibility + mobj->vis_target) / 16;
+    mobj->dlight.r   = (15 * mobj->dlight.r + mobj->dlight.target) / 16;
 
-        // position interpolation
-        if (mobj->lerp_num > 1)
-        {
-            mobj->lerp_pos++;
+    // position interpolation
+    if (mobj->lerp_num > 1)
+    {
+        mobj->lerp_pos++;
 
-            if (mobj->lerp_pos >= mobj->lerp_num)
-            {
-                mobj->lerp_pos = mobj->lerp_num = 0;
-            }
+        if (mobj->lerp_pos >= mobj->lerp_num)
+        {
+            mobj->lerp_pos = mobj->lerp_num = 0;
         }
+    }
 
-        // handle SKULLFLY attacks
-        if ((mobj->flags & MF_SKULLFLY) && AlmostEquals(mobj->mom.X, 0.0f) && AlmostEquals(mobj->mom.Y, 0.0f))
-        {
-            // the skull slammed into something
-            mobj->flags &= ~MF_SKULLFLY;
-            mobj->mom.X = mobj->mom.Y = mobj->mom.Z = 0;
+    // handle SKULLFLY attacks
+    if ((mobj->flags & MF_SKULLFLY) && AlmostEquals(mobj->mom.X, 0.0f) && AlmostEquals(mobj->mom.Y, 0.0f))
+    {
+        // the skull slammed into something
+        mobj->flags &= ~MF_SKULLFLY;
+        mobj->mom.X = mobj->mom.Y = mobj->mom.Z = 0;
 
-            P_SetMobjState(mobj, mobj->info->idle_state);
+        P_SetMobjState(mobj, mobj->info->idle_state);
 
-            if (mobj->isRemoved())
-                return;
-        }
+        if (mobj->isRemoved())
+            return;
     }
 
     // determine properties, & handle push sectors
@@ -1408,12 +1377,9 @@ static void P_MobjThinker(mobj_t *mobj, bool extra_tic)
     {
         P_CalcFullProperties(mobj, &player_props);
 
-        if (!extra_tic || !r_doubleframes.d)
-        {
-            mobj->mom.X += player_props.push.X;
-            mobj->mom.Y += player_props.push.Y;
-            mobj->mom.Z += player_props.push.Z;
-        }
+        mobj->mom.X += player_props.push.X;
+        mobj->mom.Y += player_props.push.Y;
+        mobj->mom.Z += player_props.push.Z;
 
         props = &player_props;
     }
@@ -1432,18 +1398,15 @@ static void P_MobjThinker(mobj_t *mobj, bool extra_tic)
                     if (!((mobj->flags & MF_NOGRAVITY) || (flags & SECSP_PushAll)) &&
                         (mobj->z <= mobj->floorz + 1.0f || (flags & SECSP_WholeRegion)))
                     {
-                        if (!extra_tic || !r_doubleframes.d)
-                        {
-                            float push_mul = 1.0f;
+                        float push_mul = 1.0f;
 
-                            SYS_ASSERT(mobj->info->mass > 0);
-                            if (!(flags & SECSP_PushConstant))
-                                push_mul = 100.0f / mobj->info->mass;
+                        SYS_ASSERT(mobj->info->mass > 0);
+                        if (!(flags & SECSP_PushConstant))
+                            push_mul = 100.0f / mobj->info->mass;
 
-                            mobj->mom.X += push_mul * tn_props.push.X;
-                            mobj->mom.Y += push_mul * tn_props.push.Y;
-                            mobj->mom.Z += push_mul * tn_props.push.Z;
-                        }
+                        mobj->mom.X += push_mul * tn_props.push.X;
+                        mobj->mom.Y += push_mul * tn_props.push.Y;
+                        mobj->mom.Z += push_mul * tn_props.push.Z;
                     }
                 }
             }
@@ -1460,39 +1423,28 @@ static void P_MobjThinker(mobj_t *mobj, bool extra_tic)
 
     // momentum movement
 
-    bool do_extra = mobj->player != nullptr; // 70 Hz
-    if (mobj->flags & MF_MISSILE)
-        do_extra = true;
-
-    if (!r_doubleframes.d || !extra_tic || do_extra)
+    if ((mobj->player || (mobj->flags & MF_MISSILE)) && mobj->subsector->sector->floor_vertex_slope)
     {
-        if (do_extra && mobj->subsector->sector->floor_vertex_slope)
-        {
-            if (AlmostEquals(mobj->old_z, mobj->old_floorz))
-                mobj->on_slope = true;
-        }
+        if (AlmostEquals(mobj->old_z, mobj->old_floorz))
+            mobj->on_slope = true;
+    }
 
-        if (!AlmostEquals(mobj->mom.X, 0.0f) || !AlmostEquals(mobj->mom.Y, 0.0f) || mobj->player)
-        {
-            P_XYMovement(mobj, props, extra_tic);
+    if (!AlmostEquals(mobj->mom.X, 0.0f) || !AlmostEquals(mobj->mom.Y, 0.0f) || mobj->player)
+    {
+        P_XYMovement(mobj, props);
 
-            if (mobj->isRemoved())
-                return;
-        }
+        if (mobj->isRemoved())
+            return;
+    }
 
-        if ((!AlmostEquals(mobj->z, mobj->floorz)) || !AlmostEquals(mobj->mom.Z, 0.0f)) //  || mobj->ride_em)
-        {
-            P_ZMovement(mobj, props, extra_tic);
+    if ((!AlmostEquals(mobj->z, mobj->floorz)) || !AlmostEquals(mobj->mom.Z, 0.0f)) //  || mobj->ride_em)
+    {
+        P_ZMovement(mobj, props);
 
-            if (mobj->isRemoved())
-                return;
-        }
+        if (mobj->isRemoved())
+            return;
     }
 
-    // FIXME factor out the player-related code from the rest
-    if (extra_tic && r_doubleframes.d)
-        return;
-
     if (mobj->fuse >= 0)
     {
         if (!--mobj->fuse)
@@ -1782,6 +1734,9 @@ void P_RemoveMobj(mobj_t *mo)
     // unlink from sector and block lists
     P_UnsetThingFinally(mo);
 
+    // unlink from the tag index
+    P_SetMobjTag(mo, 0);
+
     // mark as REMOVED
     mo->state      = NULL;
     mo->next_state = NULL;
@@ -1790,7 +1745,6 @@ void P_RemoveMobj(mobj_t *mo)
     mo->extendedflags = 0;
     mo->hyperflags    = 0;
     mo->health        = 0;
-    mo->tag           = 0;
     mo->tics          = -1;
     mo->wud_tags.clear();
 
@@ -1828,6 +1782,8 @@ void P_RemoveAllMobjs(bool loading)
         mo->refcount = 0;
         DeleteMobj(mo);
     }
+
+    P_RebuildMobjTagIndex();
 }
 
 void P_RemoveItemsInQue(void)
@@ -1847,8 +1803,10 @@ void P_RemoveItemsInQue(void)
 // Cycle through all mobjs and let them think.
 // Also handles removed objects which have no more references.
 //
-void P_RunMobjThinkers(bool extra_tic)
+void P_RunMobjThinkers(void)
 {
+    EDGE_ZoneScoped;
+
     mobj_t *mo;
     mobj_t *next;
 
@@ -1883,40 +1841,18 @@ void P_RunMobjThinkers(bool extra_tic)
         }
 
         if (mo->player)
-            P_MobjThinker(mo, extra_tic);
+            P_MobjThinker(mo);
         else
         {
             if (time_stop_active)
                 continue;
-            if (!r_doubleframes.d)
-            {
-                if (!g_cullthinkers.d || (gametic / 2 %
-                                              I_ROUND(1 + R_PointToDist(players[consoleplayer]->mo->x,
-                                                                        players[consoleplayer]->mo->y, mo->x, mo->y) /
-                                                              1500) ==
-                                          0))
-                    P_MobjThinker(mo, extra_tic);
-            }
-            else
-            {
-                if (extra_tic)
-                {
-                    if (!(mo->flags & MF_MISSILE))
-                        continue;
-                    else if (!g_cullthinkers.d ||
-                             ((gametic / 4) % I_ROUND(1 + R_PointToDist(players[consoleplayer]->mo->x,
-                                                                        players[consoleplayer]->mo->y, mo->x, mo->y) /
-                                                              1500) ==
-                              0))
-                        P_MobjThinker(mo, extra_tic);
-                }
-                else if (!g_cullthinkers.d ||
-                         ((gametic / 4) % I_ROUND(1 + R_PointToDist(players[consoleplayer]->mo->x,
+
+            if (!g_cullthinkers.d || (gametic / 2 %
+                                          I_ROUND(1 + R_PointToDist(players[consoleplayer]->mo->x,
                                                                     players[consoleplayer]->mo->y, mo->x, mo->y) /
                                                           1500) ==
-                          0))
-                    P_MobjThinker(mo, extra_tic);
-            }
+                                      0))
+                P_MobjThinker(mo);
         }
     }
 }
@@ -254,9 +254,14 @@ struct mobj_s : public position_c
     float model_aspect   = 1.0f;
 
     // tag ID (for special operations)
+    // NOTE: only change it via P_SetMobjTag()
     int         tag      = 0;
     std::string wud_tags = "";
 
+    // things with the same (non-zero) tag, see P_FindMobjFromTag()
+    struct mobj_s *tag_next = nullptr;
+    struct mobj_s *tag_prev = nullptr;
+
     // Movement direction, movement generation (zig-zagging).
     dirtype_e movedir = DI_EAST; // 0-7
 
@@ -350,6 +355,14 @@ struct mobj_s : public position_c
 
     HMM_Vec3 lerp_from = {{0, 0, 0}};
 
+    // where the thing was at the start of the last tic, for drawing
+    // frames in between tics (see r_interp.cc).  interp_skip is set for
+    // new and teleported things, which are drawn where they are.
+    HMM_Vec3 interp_from      = {{0, 0, 0}};
+    BAMAngle interp_angle     = 0;
+    BAMAngle interp_vertangle = 0;
+    bool     interp_skip      = true;
+
     // touch list: sectors this thing is in or touches
     struct touch_node_s *touch_sectors = nullptr;
 
@@ -34,6 +34,7 @@
 #include "s_sound.h"
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 #include <algorithm>
 
@@ -54,8 +55,6 @@ extern std::vector<lineanim_t> lineanims;
 linetype_c donut[2];
 static int donut_setup = 0;
 
-extern cvar_c r_doubleframes;
-
 static bool P_ActivateInStasis(int tag);
 static bool P_StasifySector(int tag);
 
@@ -239,9 +238,6 @@ static move_result_e AttemptMovePlane(sector_t *sector, float speed, float dest,
     bool past = false;
     bool nofit;
 
-    if (r_doubleframes.d)
-        speed *= 0.5f;
-
     //
     // check whether we have gone past the destination height
     //
@@ -407,7 +403,7 @@ static bool MovePlane(plane_move_t *plane)
         break;
 
     case DIRECTION_WAIT:
-        plane->waited -= (!r_doubleframes.d || !(gametic & 1)) ? 1 : 0;
+        plane->waited--;
         if (plane->waited <= 0)
         {
             int   dir;
@@ -1215,13 +1211,11 @@ static bool MoveSlider(slider_move_t *smov)
 
     sector_t *sec = smov->line->frontsector;
 
-    float factor = r_doubleframes.d ? 0.5f : 1.0f;
-
     switch (smov->direction)
     {
     // WAITING
     case 0:
-        smov->waited -= (!r_doubleframes.d || !(gametic & 1)) ? 1 : 0;
+        smov->waited--;
         if (smov->waited <= 0)
         {
             if (SliderCanClose(smov->line))
@@ -1243,7 +1237,7 @@ static bool MoveSlider(slider_move_t *smov)
     case 1:
         MakeMovingSound(&smov->sfxstarted, smov->info->sfx_open, &sec->sfx_origin);
 
-        smov->opening += (smov->info->speed * factor);
+        smov->opening += smov->info->speed;
 
         // mark line as non-blocking (at some point)
         P_ComputeGaps(smov->line);
@@ -1280,7 +1274,7 @@ static bool MoveSlider(slider_move_t *smov)
         {
             MakeMovingSound(&smov->sfxstarted, smov->info->sfx_close, &sec->sfx_origin);
 
-            smov->opening -= (smov->info->speed * factor);
+            smov->opening -= smov->info->speed;
 
             // mark line as blocking (at some point)
             P_ComputeGaps(smov->line);
@@ -1296,7 +1290,7 @@ static bool MoveSlider(slider_move_t *smov)
         {
             MakeMovingSound(&smov->sfxstarted, smov->info->sfx_open, &sec->sfx_origin);
 
-            smov->opening += (smov->info->speed * factor);
+            smov->opening += smov->info->speed;
 
             // mark line as non-blocking (at some point)
             P_ComputeGaps(smov->line);
@@ -1403,6 +1397,8 @@ bool EV_DoSlider(line_t *door, line_t *act_line, mobj_t *thing, const linetype_c
 //
 void P_RunActivePlanes(void)
 {
+    EDGE_ZoneScoped;
+
     if (time_stop_active)
         return;
 
@@ -1439,11 +1435,6 @@ void P_RunActivePlanes(void)
                                    ((sec_ref->f_h + sec_ref->c_h) - heightref);
                         float sx = line_ref->length / 32.0f * line_ref->dx / line_ref->length *
                                    ((sec_ref->f_h + sec_ref->c_h) - heightref);
-                        if (r_doubleframes.d && special_ref->scroll_type & ScrollType_Displace)
-                        {
-                            sy *= 2;
-                            sx *= 2;
-                        }
                         if (special_ref->sector_effect & SECTFX_PushThings)
                         {
                             sec->props.old_push.Y += BOOM_CARRY_FACTOR * sy;
@@ -1489,11 +1480,6 @@ void P_RunActivePlanes(void)
                                                                                              : sec_ref->orig_height;
                             float sy        = tdy * ((sec_ref->f_h + sec_ref->c_h) - heightref);
                             float sx        = tdx * ((sec_ref->f_h + sec_ref->c_h) - heightref);
-                            if (r_doubleframes.d && special_ref->scroll_type & ScrollType_Displace)
-                            {
-                                sy *= 2;
-                                sx *= 2;
-                            }
                             if (ld->side[0])
                             {
                                 if (ld->side[0]->top.image)
@@ -1551,11 +1537,6 @@ void P_RunActivePlanes(void)
                                                                                              : sec_ref->orig_height;
                             float sy        = x_speed * ((sec_ref->f_h + sec_ref->c_h) - heightref);
                             float sx        = y_speed * ((sec_ref->f_h + sec_ref->c_h) - heightref);
-                            if (r_doubleframes.d && special_ref->scroll_type & ScrollType_Displace)
-                            {
-                                sy *= 2;
-                                sx *= 2;
-                            }
                             if (ld->side[0])
                             {
                                 if (ld->side[0]->top.image)
@@ -27,11 +27,13 @@
 
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "endianess.h"
 #include "math_crc.h"
 #include "str_lexer.h"
 #include "str_util.h"
+#include "udmf_parser.h"
 
 #include "main.h"
 #include "colormap.h"
@@ -46,19 +48,23 @@
 #include "m_math.h"
 #include "m_misc.h"
 #include "m_random.h"
+#include "p_action.h"
 #include "p_local.h"
 #include "p_setup.h"
 #include "am_map.h"
 #include "r_gldefs.h"
 #include "r_sky.h"
 #include "s_sound.h"
+#include "s_cache.h"
 #include "s_music.h"
 #include "sv_main.h"
 #include "r_image.h"
+#include "r_interp.h"
 #include "w_texture.h"
 #include "w_files.h"
 #include "w_wad.h"
 #include "rad_trig.h" // MUSINFO changers
+#include "rad_act.h"
 
 #include "miniz.h" // ZGL3 nodes
 
@@ -114,6 +120,8 @@ vgap_t *vertgaps;
 
 vertex_seclist_t *v_seclists;
 
+uint8_t *rejectmatrix = nullptr;
+
 static line_t **linebuffer = NULL;
 
 // bbox used
@@ -127,9 +135,9 @@ int mapthing_NUM;
 
 static bool hexen_level;
 
-static bool        udmf_level;
-static int         udmf_lumpnum;
-static std::string udmf_lump;
+static bool         udmf_level;
+static int          udmf_lumpnum;
+static epi::UDMFMap udmf_map;
 
 // a place to store sidedef numbers of the loaded linedefs.
 // There is two values for every line: side0 and side1.
@@ -357,34 +365,6 @@ static void SegCommonStuff(seg_t *seg, int linedef_in)
     }
 }
 
-//
-// GroupSectorTags
-//
-// Called during P_LoadSectors to set the tag_next & tag_prev fields of
-// each sector_t, which keep all sectors with the same tag in a linked
-// list for faster handling.
-//
-// -AJA- 1999/07/29: written.
-//
-static void GroupSectorTags(sector_t *dest, sector_t *seclist, int numsecs)
-{
-    // NOTE: `numsecs' does not include the current sector.
-
-    dest->tag_next = dest->tag_prev = NULL;
-
-    for (; numsecs > 0; numsecs--)
-    {
-        sector_t *src = &seclist[numsecs - 1];
-
-        if (src->tag == dest->tag)
-        {
-            src->tag_next  = dest;
-            dest->tag_prev = src;
-            return;
-        }
-    }
-}
-
 static void LoadSectors(int lump)
 {
     const uint8_t      *data;
@@ -499,9 +479,6 @@ static void LoadSectors(int lump)
         ss->p = &ss->props;
 
         ss->sound_player = -1;
-
-        // -AJA- 1999/07/29: Keep sectors with same tag in a list.
-        GroupSectorTags(ss, sectors, i);
     }
 
     delete[] data;
@@ -672,7 +649,7 @@ static mobj_t *SpawnMapThing(const mobjtype_c *info, float x, float y, float z,
     }
     // Lobo 2022: added tagged mobj support ;)
     if (tag > 0)
-        mo->tag = tag;
+        P_SetMobjTag(mo, tag);
 
     return mo;
 }
@@ -1000,21 +977,6 @@ static void LoadLineDefs(int lump)
         int side1 = AlignedLittleEndianU16(mld->side_L);
 
         ComputeLinedefData(ld, side0, side1);
-
-        // check for possible extrafloors, updating the exfloor_max count
-        // for the sectors in question.
-
-        if (ld->tag && ld->special && ld->special->ef.type)
-        {
-            for (int j = 0; j < numsectors; j++)
-            {
-                if (sectors[j].tag != ld->tag)
-                    continue;
-
-                sectors[j].exfloor_max++;
-                numextrafloors++;
-            }
-        }
     }
 
     delete[] data;
@@ -1449,542 +1411,330 @@ static void LoadXGL3Nodes(int lumpnum)
     zgldata.clear();
 }
 
-static void LoadUDMFVertexes()
+static inline void ClearRejectBit(int src, int dest)
 {
-    epi::Lexer lex(udmf_lump);
+    int bit = src * numsectors + dest;
 
-    I_Debugf("LoadUDMFVertexes: parsing TEXTMAP\n");
-    int cur_vertex = 0;
+    rejectmatrix[bit >> 3] &= ~(1 << (bit & 7));
+}
 
-    for (;;)
+static inline bool TestRejectBit(int src, int dest)
+{
+    int bit = src * numsectors + dest;
+
+    return (rejectmatrix[bit >> 3] & (1 << (bit & 7))) != 0;
+}
+
+//
+// LoadXReject
+//
+// Loads the sector visibility table which the node builder stores
+// after the XGL3 nodes (see ajbsp/bsp_reject.cc).  It is optional,
+// older XWA files do not have one.  Must be called after the nodes
+// have been loaded.
+//
+static void LoadXReject(int lumpnum)
+{
+    rejectmatrix = nullptr;
+
+    if (lumpnum < 0 || !W_VerifyLump(lumpnum) || !W_VerifyLumpName(lumpnum, "XREJECT"))
     {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
+        I_Debugf("LoadXReject: no visibility table\n");
+        return;
+    }
 
-        if (tok == epi::kTokenEOF)
-            break;
+    int      length = 0;
+    uint8_t *data   = W_LoadLump(lumpnum, &length);
 
-        if (tok != epi::kTokenIdentifier)
-            I_Error("Malformed TEXTMAP lump.\n");
+    int matrix_size = (int)(((int64_t)numsectors * numsectors + 7) / 8);
 
-        // check namespace
-        if (lex.Match("="))
-        {
-            lex.Next(section);
-            if (!lex.Match(";"))
-                I_Error("Malformed TEXTMAP lump: missing ';'\n");
-            continue;
-        }
+    if (length < 12 || memcmp(data, "XRJ1", 4) != 0 ||
+        epi::UnalignedLittleEndianS32(data + 4) != numsectors ||
+        epi::UnalignedLittleEndianS32(data + 8) != numsubsectors ||
+        length != 12 + numsubsectors * 4 + matrix_size)
+    {
+        I_Warning("Ignoring bad XREJECT lump, the XWA file may be out of date.\n");
+        delete[] data;
+        return;
+    }
 
-        if (!lex.Match("{"))
-            I_Error("Malformed TEXTMAP lump: missing '{'\n");
+    rejectmatrix = new uint8_t[matrix_size];
+    memcpy(rejectmatrix, data + 12 + numsubsectors * 4, matrix_size);
 
-        if (section == "vertex")
-        {
-            float x = 0.0f, y = 0.0f;
-            float zf = -40000.0f, zc = 40000.0f;
-            for (;;)
-            {
-                if (lex.Match("}"))
-                    break;
+    // the node builder does not know every trick the engine uses when
+    // giving subsectors a sector (see DetermineSubsectorSector), so
+    // make each mismatched sector see whatever the table's one did.
+    // that only ever makes the table more permissive.
+    const uint8_t *ss_sectors = data + 12;
+
+    for (int i = 0; i < numsubsectors; i++)
+    {
+        int real = subsectors[i].sector - sectors;
+        int used = epi::UnalignedLittleEndianS32(ss_sectors + i * 4);
 
-                std::string       key;
-                std::string       value;
-                epi::TokenKind block_tok = lex.Next(key);
+        if (real == used)
+            continue;
 
-                if (block_tok == epi::kTokenEOF)
-                    I_Error("Malformed TEXTMAP lump: unclosed block\n");
+        for (int k = 0; k < numsectors; k++)
+        {
+            if (used >= 0 && used < numsectors && TestRejectBit(used, k))
+                continue;
 
-                if (block_tok != epi::kTokenIdentifier)
-                    I_Error("Malformed TEXTMAP lump: missing key\n");
+            ClearRejectBit(real, k);
+            ClearRejectBit(k, real);
+        }
+    }
 
-                if (!lex.Match("="))
-                    I_Error("Malformed TEXTMAP lump: missing '='\n");
+    delete[] data;
 
-                block_tok = lex.Next(value);
+    I_Debugf("LoadXReject: loaded visibility table\n");
+}
 
-                if (block_tok == epi::kTokenEOF || block_tok == epi::kTokenError || value == "}")
-                    I_Error("Malformed TEXTMAP lump: missing value\n");
+static void LoadUDMFVertexes()
+{
+    I_Debugf("LoadUDMFVertexes: processing %d vertices\n", numvertexes);
 
-                if (!lex.Match(";"))
-                    I_Error("Malformed TEXTMAP lump: missing ';'\n");
+    for (int i = 0; i < numvertexes; i++)
+    {
+        const epi::UDMFVertex &V = udmf_map.vertices[i];
 
-                if (key == "x")
-                    x = epi::LexDouble(value);
-                else if (key == "y")
-                    y = epi::LexDouble(value);
-                else if (key == "zfloor")
-                    zf = epi::LexDouble(value);
-                else if (key == "zceiling")
-                    zc = epi::LexDouble(value);
-            }
-            vertexes[cur_vertex] = {{{{{x, y, zf}}}, zc}};
-            cur_vertex++;
-        }
-        else // consume other blocks
-        {
-            for (;;)
-            {
-                tok = lex.Next(section);
-                if (lex.Match("}") || tok == epi::kTokenEOF)
-                    break;
-            }
-        }
+        vertexes[i] = {{{{{(float)V.x, (float)V.y, (float)V.zfloor}}}, (float)V.zceiling}};
     }
-    SYS_ASSERT(cur_vertex == numvertexes);
 
-    I_Debugf("LoadUDMFVertexes: finished parsing TEXTMAP\n");
+    I_Debugf("LoadUDMFVertexes: finished\n");
 }
 
 static void LoadUDMFSectors()
 {
-    epi::Lexer lex(udmf_lump);
+    I_Debugf("LoadUDMFSectors: processing %d sectors\n", numsectors);
 
-    I_Debugf("LoadUDMFSectors: parsing TEXTMAP\n");
-    int cur_sector = 0;
-
-    for (;;)
+    for (int cur_sector = 0; cur_sector < numsectors; cur_sector++)
     {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
+        const epi::UDMFSector &S = udmf_map.sectors[cur_sector];
 
-        if (tok == epi::kTokenEOF)
-            break;
+        int fz = S.heightfloor;
+        int cz = S.heightceiling;
 
-        if (tok != epi::kTokenIdentifier)
-            I_Error("Malformed TEXTMAP lump.\n");
+        float fx = S.xpanningfloor, fy = S.ypanningfloor;
+        float cx = S.xpanningceiling, cy = S.ypanningceiling;
+        float rf = S.rotationfloor, rc = S.rotationceiling;
 
-        // check namespace
-        if (lex.Match("="))
-        {
-            lex.Next(section);
-            if (!lex.Match(";"))
-                I_Error("Malformed TEXTMAP lump: missing ';'\n");
-            continue;
-        }
+        RGBAColor light_color = ((uint32_t)S.lightcolor << 8 | 0xFF);
+        RGBAColor fog_color   = ((uint32_t)S.fadecolor << 8 | 0xFF);
+        int       fog_density = HMM_Clamp(0, S.fogdensity, 1020);
 
-        if (!lex.Match("{"))
-            I_Error("Malformed TEXTMAP lump: missing '{'\n");
+        sector_t *ss = sectors + cur_sector;
+        ss->f_h      = fz;
+        ss->c_h      = cz;
 
-        if (section == "sector")
+        // return to wolfenstein?
+        if (m_goobers.d)
         {
-            int      cz = 0, fz = 0;
-            float    fx = 0.0f, fy = 0.0f, cx = 0.0f, cy = 0.0f;
-            float    fx_sc = 1.0f, fy_sc = 1.0f, cx_sc = 1.0f, cy_sc = 1.0f;
-            float    rf = 0.0f, rc = 0.0f;
-            float    gravfactor = 1.0f;
-            int      light = 160, type = 0, tag = 0;
-            RGBAColor fog_color   = SG_BLACK_RGBA32;
-            RGBAColor light_color = SG_WHITE_RGBA32;
-            int      fog_density = 0;
-            char     floor_tex[10];
-            char     ceil_tex[10];
-            strcpy(floor_tex, "-");
-            strcpy(ceil_tex, "-");
-            for (;;)
-            {
-                if (lex.Match("}"))
-                    break;
-
-                std::string       key;
-                std::string       value;
-                epi::TokenKind block_tok = lex.Next(key);
-
-                if (block_tok == epi::kTokenEOF)
-                    I_Error("Malformed TEXTMAP lump: unclosed block\n");
-
-                if (block_tok != epi::kTokenIdentifier)
-                    I_Error("Malformed TEXTMAP lump: missing key\n");
-
-                if (!lex.Match("="))
-                    I_Error("Malformed TEXTMAP lump: missing '='\n");
-
-                block_tok = lex.Next(value);
-
-                if (block_tok == epi::kTokenEOF || block_tok == epi::kTokenError || value == "}")
-                    I_Error("Malformed TEXTMAP lump: missing value\n");
-
-                if (!lex.Match(";"))
-                    I_Error("Malformed TEXTMAP lump: missing ';'\n");
-
-                if (key == "heightfloor")
-                    fz = epi::LexInteger(value);
-                else if (key == "heightceiling")
-                    cz = epi::LexInteger(value);
-                else if (key == "texturefloor")
-                    Z_StrNCpy(floor_tex, value.c_str(), 8);
-                else if (key == "textureceiling")
-                    Z_StrNCpy(ceil_tex, value.c_str(), 8);
-                else if (key == "lightlevel")
-                    light = epi::LexInteger(value);
-                else if (key == "special")
-                    type = epi::LexInteger(value);
-                else if (key == "id")
-                    tag = epi::LexInteger(value);
-                else if (key == "lightcolor")
-                    light_color = ((uint32_t)epi::LexInteger(value) << 8 | 0xFF);
-                else if (key == "fadecolor")
-                    fog_color = ((uint32_t)epi::LexInteger(value) << 8 | 0xFF);
-                else if (key == "fogdensity")
-                    fog_density = HMM_Clamp(0, epi::LexInteger(value), 1020);
-                else if (key == "xpanningfloor")
-                    fx = epi::LexDouble(value);
-                else if (key == "ypanningfloor")
-                    fy = epi::LexDouble(value);
-                else if (key == "xpanningceiling")
-                    cx = epi::LexDouble(value);
-                else if (key == "ypanningceiling")
-                    cy = epi::LexDouble(value);
-                else if (key == "xscalefloor")
-                    fx_sc = epi::LexDouble(value);
-                else if (key == "yscalefloor")
-                    fy_sc = epi::LexDouble(value);
-                else if (key == "xscaleceiling")
-                    cx_sc = epi::LexDouble(value);
-                else if (key == "yscaleceiling")
-                    cy_sc = epi::LexDouble(value);
-                else if (key == "rotationfloor")
-                    rf = epi::LexDouble(value);
-                else if (key == "rotationceiling")
-                    rc = epi::LexDouble(value);
-                else if (key == "gravity")
-                    gravfactor = epi::LexDouble(value);
-            }
-            sector_t *ss = sectors + cur_sector;
-            ss->f_h      = fz;
-            ss->c_h      = cz;
-
-            // return to wolfenstein?
-            if (m_goobers.d)
-            {
-                ss->f_h = 0;
-                ss->c_h = (AlmostEquals(fz, cz)) ? 0 : 128.0f;
-            }
+            ss->f_h = 0;
+            ss->c_h = (AlmostEquals(fz, cz)) ? 0 : 128.0f;
+        }
 
-            ss->orig_height = (ss->f_h + ss->c_h);
+        ss->orig_height = (ss->f_h + ss->c_h);
 
-            ss->floor.translucency = VISIBLE;
-            ss->floor.x_mat.X      = 1;
-            ss->floor.x_mat.Y      = 0;
-            ss->floor.y_mat.X      = 0;
-            ss->floor.y_mat.Y      = 1;
+        ss->floor.translucency = VISIBLE;
+        ss->floor.x_mat.X      = 1;
+        ss->floor.x_mat.Y      = 0;
+        ss->floor.y_mat.X      = 0;
+        ss->floor.y_mat.Y      = 1;
 
-            ss->ceil = ss->floor;
+        ss->ceil = ss->floor;
 
-            // granular offsets
-            ss->floor.offset.X += fx;
-            ss->floor.offset.Y += fy;
-            ss->ceil.offset.X += cx;
-            ss->ceil.offset.Y += cy;
+        // granular offsets
+        ss->floor.offset.X += fx;
+        ss->floor.offset.Y += fy;
+        ss->ceil.offset.X += cx;
+        ss->ceil.offset.Y += cy;
 
-            // rotations
-            if (!AlmostEquals(rf, 0.0f))
-                ss->floor.rotation = epi::BAMFromDegrees(rf);
+        // rotations
+        if (!AlmostEquals(rf, 0.0f))
+            ss->floor.rotation = epi::BAMFromDegrees(rf);
 
-            if (!AlmostEquals(rc, 0.0f))
-                ss->ceil.rotation = epi::BAMFromDegrees(rc);
+        if (!AlmostEquals(rc, 0.0f))
+            ss->ceil.rotation = epi::BAMFromDegrees(rc);
 
-            // granular scaling
-            ss->floor.x_mat.X = fx_sc;
-            ss->floor.y_mat.Y = fy_sc;
-            ss->ceil.x_mat.X  = cx_sc;
-            ss->ceil.y_mat.Y  = cy_sc;
+        // granular scaling
+        ss->floor.x_mat.X = S.xscalefloor;
+        ss->floor.y_mat.Y = S.yscalefloor;
+        ss->ceil.x_mat.X  = S.xscaleceiling;
+        ss->ceil.y_mat.Y  = S.yscaleceiling;
 
-            ss->floor.image = W_ImageLookup(floor_tex, INS_Flat);
+        ss->floor.image = W_ImageLookup(S.texturefloor, INS_Flat);
 
-            if (ss->floor.image)
+        if (ss->floor.image)
+        {
+            flatdef_c *current_flatdef = flatdefs.Find(ss->floor.image->name.c_str());
+            if (current_flatdef)
             {
-                flatdef_c *current_flatdef = flatdefs.Find(ss->floor.image->name.c_str());
-                if (current_flatdef)
-                {
-                    ss->bob_depth  = current_flatdef->bob_depth;
-                    ss->sink_depth = current_flatdef->sink_depth;
-                }
+                ss->bob_depth  = current_flatdef->bob_depth;
+                ss->sink_depth = current_flatdef->sink_depth;
             }
+        }
 
-            ss->ceil.image = W_ImageLookup(ceil_tex, INS_Flat);
+        ss->ceil.image = W_ImageLookup(S.textureceiling, INS_Flat);
 
-            if (!ss->floor.image)
-            {
-                I_Warning("Bad Level: sector #%d has missing floor texture.\n", cur_sector);
-                ss->floor.image = W_ImageLookup("FLAT1", INS_Flat);
-            }
-            if (!ss->ceil.image)
-            {
-                I_Warning("Bad Level: sector #%d has missing ceiling texture.\n", cur_sector);
-                ss->ceil.image = ss->floor.image;
-            }
+        if (!ss->floor.image)
+        {
+            I_Warning("Bad Level: sector #%d has missing floor texture.\n", cur_sector);
+            ss->floor.image = W_ImageLookup("FLAT1", INS_Flat);
+        }
+        if (!ss->ceil.image)
+        {
+            I_Warning("Bad Level: sector #%d has missing ceiling texture.\n", cur_sector);
+            ss->ceil.image = ss->floor.image;
+        }
 
-            // convert negative tags to zero
-            ss->tag = HMM_MAX(0, tag);
+        // convert negative tags to zero
+        ss->tag = HMM_MAX(0, S.id);
 
-            ss->props.lightlevel = light;
+        ss->props.lightlevel = S.lightlevel;
 
-            // convert negative types to zero
-            ss->props.type    = HMM_MAX(0, type);
-            ss->props.special = P_LookupSectorType(ss->props.type);
+        // convert negative types to zero
+        ss->props.type    = HMM_MAX(0, S.special);
+        ss->props.special = P_LookupSectorType(ss->props.type);
 
-            ss->exfloor_max = 0;
+        ss->exfloor_max = 0;
 
-            ss->props.colourmap = NULL;
+        ss->props.colourmap = NULL;
 
-            ss->props.gravity   = GRAVITY * gravfactor;
-            ss->props.friction  = FRICTION;
-            ss->props.viscosity = VISCOSITY;
-            ss->props.drag      = DRAG;
+        ss->props.gravity   = GRAVITY * (float)S.gravity;
+        ss->props.friction  = FRICTION;
+        ss->props.viscosity = VISCOSITY;
+        ss->props.drag      = DRAG;
 
-            // Allow UDMF sector light/fog information to override DDFSECT types
-            if (fog_color != SG_BLACK_RGBA32) // All black is the established UDMF "no fog" color
-            {
-                // Prevent UDMF-specified fog color from having our internal 'no value'...uh...value
-                if (fog_color == kRGBANoValue)
-                    fog_color ^= 0x00010100;
-                ss->props.fog_color = fog_color;
-                // Best-effort match for GZDoom's fogdensity values so that UDB, etc
-                // give predictable results
-                if (fog_density < 2)
-                    ss->props.fog_density = 0.002f;
-                else
-                    ss->props.fog_density = 0.01f * ((float)fog_density / 1020.0f);
-            }
-            else if (ss->props.special && ss->props.special->fog_color != kRGBANoValue)
-            {
-                ss->props.fog_color   = ss->props.special->fog_color;
-                ss->props.fog_density = 0.01f * ss->props.special->fog_density;
-            }
+        // Allow UDMF sector light/fog information to override DDFSECT types
+        if (fog_color != SG_BLACK_RGBA32) // All black is the established UDMF "no fog" color
+        {
+            // Prevent UDMF-specified fog color from having our internal 'no value'...uh...value
+            if (fog_color == kRGBANoValue)
+                fog_color ^= 0x00010100;
+            ss->props.fog_color = fog_color;
+            // Best-effort match for GZDoom's fogdensity values so that UDB, etc
+            // give predictable results
+            if (fog_density < 2)
+                ss->props.fog_density = 0.002f;
             else
-            {
-                ss->props.fog_color   = kRGBANoValue;
-                ss->props.fog_density = 0;
-            }
-            if (light_color != SG_WHITE_RGBA32)
-            {
+                ss->props.fog_density = 0.01f * ((float)fog_density / 1020.0f);
+        }
+        else if (ss->props.special && ss->props.special->fog_color != kRGBANoValue)
+        {
+            ss->props.fog_color   = ss->props.special->fog_color;
+            ss->props.fog_density = 0.01f * ss->props.special->fog_density;
+        }
+        else
+        {
+            ss->props.fog_color   = kRGBANoValue;
+            ss->props.fog_density = 0;
+        }
+        if (light_color != SG_WHITE_RGBA32)
+        {
 
-                if (light_color == kRGBANoValue)
-                    light_color ^= 0x00010100;
-                // Make colourmap if necessary
-                for (auto cmap : colourmaps)
-                {
-                    if (cmap->gl_colour != kRGBANoValue && cmap->gl_colour == light_color)
-                    {
-                        ss->props.colourmap = cmap;
-                        break;
-                    }
-                }
-                if (!ss->props.colourmap || ss->props.colourmap->gl_colour != light_color)
+            if (light_color == kRGBANoValue)
+                light_color ^= 0x00010100;
+            // Make colourmap if necessary
+            for (auto cmap : colourmaps)
+            {
+                if (cmap->gl_colour != kRGBANoValue && cmap->gl_colour == light_color)
                 {
-                    colourmap_c *ad_hoc = new colourmap_c;
-                    ad_hoc->name        = epi::StringFormat("UDMF_%d", light_color); // Internal
-                    ad_hoc->gl_colour   = light_color;
-                    ss->props.colourmap = ad_hoc;
-                    colourmaps.push_back(ad_hoc);
+                    ss->props.colourmap = cmap;
+                    break;
                 }
             }
-
-            ss->p = &ss->props;
-
-            ss->sound_player = -1;
-
-            // -AJA- 1999/07/29: Keep sectors with same tag in a list.
-            GroupSectorTags(ss, sectors, cur_sector);
-            cur_sector++;
-        }
-        else // consume other blocks
-        {
-            for (;;)
+            if (!ss->props.colourmap || ss->props.colourmap->gl_colour != light_color)
             {
-                tok = lex.Next(section);
-                if (lex.Match("}") || tok == epi::kTokenEOF)
-                    break;
+                colourmap_c *ad_hoc = new colourmap_c;
+                ad_hoc->name        = epi::StringFormat("UDMF_%d", light_color); // Internal
+                ad_hoc->gl_colour   = light_color;
+                ss->props.colourmap = ad_hoc;
+                colourmaps.push_back(ad_hoc);
             }
         }
+
+        ss->p = &ss->props;
+
+        ss->sound_player = -1;
     }
-    SYS_ASSERT(cur_sector == numsectors);
 
-    I_Debugf("LoadUDMFSectors: finished parsing TEXTMAP\n");
+    I_Debugf("LoadUDMFSectors: finished\n");
 }
 
 static void LoadUDMFSideDefs()
 {
-    epi::Lexer lex(udmf_lump);
+    int nummapsides = (int)udmf_map.sidedefs.size();
 
-    I_Debugf("LoadUDMFSectors: parsing TEXTMAP\n");
+    I_Debugf("LoadUDMFSideDefs: processing %d sidedefs\n", nummapsides);
 
     sides = new side_t[numsides];
     Z_Clear(sides, side_t, numsides);
 
-    int nummapsides = 0;
+    SYS_ASSERT(nummapsides <= numsides); // sanity check
 
-    for (;;)
+    for (int i = 0; i < nummapsides; i++)
     {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
+        const epi::UDMFSidedef &SD = udmf_map.sidedefs[i];
 
-        if (tok == epi::kTokenEOF)
-            break;
+        side_t *sd = sides + i;
 
-        if (tok != epi::kTokenIdentifier)
-            I_Error("Malformed TEXTMAP lump.\n");
+        sd->top.translucency = VISIBLE;
+        sd->top.offset.X     = SD.offsetx;
+        sd->top.offset.Y     = SD.offsety;
+        sd->top.x_mat.X      = 1;
+        sd->top.x_mat.Y      = 0;
+        sd->top.y_mat.X      = 0;
+        sd->top.y_mat.Y      = 1;
 
-        // check namespace
-        if (lex.Match("="))
-        {
-            lex.Next(section);
-            if (!lex.Match(";"))
-                I_Error("Malformed TEXTMAP lump: missing ';'\n");
-            continue;
-        }
+        sd->middle = sd->top;
+        sd->bottom = sd->top;
 
-        if (!lex.Match("{"))
-            I_Error("Malformed TEXTMAP lump: missing '{'\n");
+        // a missing sector field means sector #0
+        sd->sector = &sectors[HMM_MAX(0, SD.sector)];
 
-        if (section == "sidedef")
-        {
-            nummapsides++;
-            int   x = 0, y = 0;
-            float lowx = 0.0f, midx = 0.0f, highx = 0.0f;
-            float lowy = 0.0f, midy = 0.0f, highy = 0.0f;
-            float low_scx = 1.0f, mid_scx = 1.0f, high_scx = 1.0f;
-            float low_scy = 1.0f, mid_scy = 1.0f, high_scy = 1.0f;
-            int   sec_num = 0;
-            char  top_tex[10];
-            char  bottom_tex[10];
-            char  middle_tex[10];
-            strcpy(top_tex, "-");
-            strcpy(bottom_tex, "-");
-            strcpy(middle_tex, "-");
-            for (;;)
-            {
-                if (lex.Match("}"))
-                    break;
+        sd->top.image = W_ImageLookup(SD.texturetop, INS_Texture, ILF_Null);
 
-                std::string       key;
-                std::string       value;
-                epi::TokenKind block_tok = lex.Next(key);
-
-                if (block_tok == epi::kTokenEOF)
-                    I_Error("Malformed TEXTMAP lump: unclosed block\n");
-
-                if (block_tok != epi::kTokenIdentifier)
-                    I_Error("Malformed TEXTMAP lump: missing key\n");
-
-                if (!lex.Match("="))
-                    I_Error("Malformed TEXTMAP lump: missing '='\n");
-
-                block_tok = lex.Next(value);
-
-                if (block_tok == epi::kTokenEOF || block_tok == epi::kTokenError || value == "}")
-                    I_Error("Malformed TEXTMAP lump: missing value\n");
-
-                if (!lex.Match(";"))
-                    I_Error("Malformed TEXTMAP lump: missing ';'\n");
-
-                if (key == "offsetx")
-                    x = epi::LexInteger(value);
-                else if (key == "offsety")
-                    y = epi::LexInteger(value);
-                else if (key == "offsetx_bottom")
-                    lowx = epi::LexDouble(value);
-                else if (key == "offsetx_mid")
-                    midx = epi::LexDouble(value);
-                else if (key == "offsetx_top")
-                    highx = epi::LexDouble(value);
-                else if (key == "offsety_bottom")
-                    lowy = epi::LexDouble(value);
-                else if (key == "offsety_mid")
-                    midy = epi::LexDouble(value);
-                else if (key == "offsety_top")
-                    highy = epi::LexDouble(value);
-                else if (key == "scalex_bottom")
-                    low_scx = epi::LexDouble(value);
-                else if (key == "scalex_mid")
-                    mid_scx = epi::LexDouble(value);
-                else if (key == "scalex_top")
-                    high_scx = epi::LexDouble(value);
-                else if (key == "scaley_bottom")
-                    low_scy = epi::LexDouble(value);
-                else if (key == "scaley_mid")
-                    mid_scy = epi::LexDouble(value);
-                else if (key == "scaley_top")
-                    high_scy = epi::LexDouble(value);
-                else if (key == "texturetop")
-                    Z_StrNCpy(top_tex, value.c_str(), 8);
-                else if (key == "texturebottom")
-                    Z_StrNCpy(bottom_tex, value.c_str(), 8);
-                else if (key == "texturemiddle")
-                    Z_StrNCpy(middle_tex, value.c_str(), 8);
-                else if (key == "sector")
-                    sec_num = epi::LexInteger(value);
-            }
-            SYS_ASSERT(nummapsides <= numsides); // sanity check
+        if (sd->top.image == NULL)
+        {
+            if (m_goobers.d)
+                sd->top.image = W_ImageLookup(SD.texturebottom, INS_Texture);
+            else
+                sd->top.image = W_ImageLookup(SD.texturetop, INS_Texture);
+        }
 
-            side_t *sd = sides + nummapsides - 1;
+        sd->middle.image = W_ImageLookup(SD.texturemiddle, INS_Texture);
+        sd->bottom.image = W_ImageLookup(SD.texturebottom, INS_Texture);
 
-            sd->top.translucency = VISIBLE;
-            sd->top.offset.X     = x;
-            sd->top.offset.Y     = y;
-            sd->top.x_mat.X      = 1;
-            sd->top.x_mat.Y      = 0;
-            sd->top.y_mat.X      = 0;
-            sd->top.y_mat.Y      = 1;
+        // granular offsets
+        sd->bottom.offset.X += (float)SD.offsetx_bottom;
+        sd->middle.offset.X += (float)SD.offsetx_mid;
+        sd->top.offset.X += (float)SD.offsetx_top;
+        sd->bottom.offset.Y += (float)SD.offsety_bottom;
+        sd->middle.offset.Y += (float)SD.offsety_mid;
+        sd->top.offset.Y += (float)SD.offsety_top;
 
-            sd->middle = sd->top;
-            sd->bottom = sd->top;
+        // granular scaling
+        sd->bottom.x_mat.X = SD.scalex_bottom;
+        sd->middle.x_mat.X = SD.scalex_mid;
+        sd->top.x_mat.X    = SD.scalex_top;
+        sd->bottom.y_mat.Y = SD.scaley_bottom;
+        sd->middle.y_mat.Y = SD.scaley_mid;
+        sd->top.y_mat.Y    = SD.scaley_top;
 
-            sd->sector = &sectors[sec_num];
+        // handle BOOM colourmaps with [242] linetype
+        sd->top.boom_colmap    = colourmaps.Lookup(SD.texturetop);
+        sd->middle.boom_colmap = colourmaps.Lookup(SD.texturemiddle);
+        sd->bottom.boom_colmap = colourmaps.Lookup(SD.texturebottom);
 
-            sd->top.image = W_ImageLookup(top_tex, INS_Texture, ILF_Null);
+        if (sd->top.image && fabs(sd->top.offset.Y) > IM_HEIGHT(sd->top.image))
+            sd->top.offset.Y = fmodf(sd->top.offset.Y, IM_HEIGHT(sd->top.image));
 
-            if (sd->top.image == NULL)
-            {
-                if (m_goobers.d)
-                    sd->top.image = W_ImageLookup(bottom_tex, INS_Texture);
-                else
-                    sd->top.image = W_ImageLookup(top_tex, INS_Texture);
-            }
+        if (sd->middle.image && fabs(sd->middle.offset.Y) > IM_HEIGHT(sd->middle.image))
+            sd->middle.offset.Y = fmodf(sd->middle.offset.Y, IM_HEIGHT(sd->middle.image));
 
-            sd->middle.image = W_ImageLookup(middle_tex, INS_Texture);
-            sd->bottom.image = W_ImageLookup(bottom_tex, INS_Texture);
-
-            // granular offsets
-            sd->bottom.offset.X += lowx;
-            sd->middle.offset.X += midx;
-            sd->top.offset.X += highx;
-            sd->bottom.offset.Y += lowy;
-            sd->middle.offset.Y += midy;
-            sd->top.offset.Y += highy;
-
-            // granular scaling
-            sd->bottom.x_mat.X = low_scx;
-            sd->middle.x_mat.X = mid_scx;
-            sd->top.x_mat.X    = high_scx;
-            sd->bottom.y_mat.Y = low_scy;
-            sd->middle.y_mat.Y = mid_scy;
-            sd->top.y_mat.Y    = high_scy;
-
-            // handle BOOM colourmaps with [242] linetype
-            sd->top.boom_colmap    = colourmaps.Lookup(top_tex);
-            sd->middle.boom_colmap = colourmaps.Lookup(middle_tex);
-            sd->bottom.boom_colmap = colourmaps.Lookup(bottom_tex);
-
-            if (sd->top.image && fabs(sd->top.offset.Y) > IM_HEIGHT(sd->top.image))
-                sd->top.offset.Y = fmodf(sd->top.offset.Y, IM_HEIGHT(sd->top.image));
-
-            if (sd->middle.image && fabs(sd->middle.offset.Y) > IM_HEIGHT(sd->middle.image))
-                sd->middle.offset.Y = fmodf(sd->middle.offset.Y, IM_HEIGHT(sd->middle.image));
-
-            if (sd->bottom.image && fabs(sd->bottom.offset.Y) > IM_HEIGHT(sd->bottom.image))
-                sd->bottom.offset.Y = fmodf(sd->bottom.offset.Y, IM_HEIGHT(sd->bottom.image));
-        }
-        else // consume other blocks
-        {
-            for (;;)
-            {
-                tok = lex.Next(section);
-                if (lex.Match("}") || tok == epi::kTokenEOF)
-                    break;
-            }
-        }
+        if (sd->bottom.image && fabs(sd->bottom.offset.Y) > IM_HEIGHT(sd->bottom.image))
+            sd->bottom.offset.Y = fmodf(sd->bottom.offset.Y, IM_HEIGHT(sd->bottom.image));
     }
 
     I_Debugf("LoadUDMFSideDefs: post-processing linedefs & sidedefs\n");
@@ -2042,437 +1792,227 @@ static void LoadUDMFSideDefs()
 
     SYS_ASSERT(sd == sides + numsides);
 
-    I_Debugf("LoadUDMFSideDefs: finished parsing TEXTMAP\n");
+    I_Debugf("LoadUDMFSideDefs: finished\n");
 }
 
+// maps the epi::UDMFLineFlag bits onto MLF_xxx flags
+static const int udmf_line_flags[][2] = {
+    {epi::kUDMFLineBlocking, MLF_Blocking},
+    {epi::kUDMFLineBlockMonsters, MLF_BlockMonsters},
+    {epi::kUDMFLineTwoSided, MLF_TwoSided},
+    {epi::kUDMFLineDontPegTop, MLF_UpperUnpegged},
+    {epi::kUDMFLineDontPegBottom, MLF_LowerUnpegged},
+    {epi::kUDMFLineSecret, MLF_Secret},
+    {epi::kUDMFLineBlockSound, MLF_SoundBlock},
+    {epi::kUDMFLineDontDraw, MLF_DontDraw},
+    {epi::kUDMFLineMapped, MLF_Mapped},
+    {epi::kUDMFLinePassUse, MLF_PassThru},
+    {epi::kUDMFLineBlockPlayers, MLF_BlockPlayers},
+    {epi::kUDMFLineBlockSight, MLF_SightBlock},
+};
+
 static void LoadUDMFLineDefs()
 {
-    epi::Lexer lex(udmf_lump);
+    I_Debugf("LoadUDMFLineDefs: processing %d linedefs\n", numlines);
 
-    I_Debugf("LoadUDMFLineDefs: parsing TEXTMAP\n");
-
-    int cur_line = 0;
-
-    for (;;)
+    for (int cur_line = 0; cur_line < numlines; cur_line++)
     {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
-
-        if (tok == epi::kTokenEOF)
-            break;
+        const epi::UDMFLinedef &L = udmf_map.linedefs[cur_line];
 
-        if (tok != epi::kTokenIdentifier)
-            I_Error("Malformed TEXTMAP lump.\n");
+        int flags = 0;
 
-        // check namespace
-        if (lex.Match("="))
-        {
-            lex.Next(section);
-            if (!lex.Match(";"))
-                I_Error("Malformed TEXTMAP lump: missing ';'\n");
-            continue;
-        }
+        for (auto &F : udmf_line_flags)
+            if (L.flags & F[0])
+                flags |= F[1];
 
-        if (!lex.Match("{"))
-            I_Error("Malformed TEXTMAP lump: missing '{'\n");
+        line_t *ld = lines + cur_line;
 
-        if (section == "linedef")
-        {
-            int flags = 0, v1 = 0, v2 = 0;
-            int side0 = -1, side1 = -1, tag = -1;
-            int special = 0;
-            for (;;)
-            {
-                if (lex.Match("}"))
-                    break;
+        ld->flags = flags;
+        ld->tag   = HMM_MAX(0, L.id);
 
-                std::string       key;
-                std::string       value;
-                epi::TokenKind block_tok = lex.Next(key);
-
-                if (block_tok == epi::kTokenEOF)
-                    I_Error("Malformed TEXTMAP lump: unclosed block\n");
-
-                if (block_tok != epi::kTokenIdentifier)
-                    I_Error("Malformed TEXTMAP lump: missing key\n");
-
-                if (!lex.Match("="))
-                    I_Error("Malformed TEXTMAP lump: missing '='\n");
-
-                block_tok = lex.Next(value);
-
-                if (block_tok == epi::kTokenEOF || block_tok == epi::kTokenError || value == "}")
-                    I_Error("Malformed TEXTMAP lump: missing value\n");
-
-                if (!lex.Match(";"))
-                    I_Error("Malformed TEXTMAP lump: missing ';'\n");
-
-                if (key == "id")
-                    tag = epi::LexInteger(value);
-                else if (key == "v1")
-                    v1 = epi::LexInteger(value);
-                else if (key == "v2")
-                    v2 = epi::LexInteger(value);
-                else if (key == "special")
-                    special = epi::LexInteger(value);
-                else if (key == "sidefront")
-                    side0 = epi::LexInteger(value);
-                else if (key == "sideback")
-                    side1 = epi::LexInteger(value);
-                else if (key == "blocking")
-                    flags |= (epi::LexBoolean(value) ? MLF_Blocking : 0);
-                else if (key == "blockmonsters")
-                    flags |= (epi::LexBoolean(value) ? MLF_BlockMonsters : 0);
-                else if (key == "twosided")
-                    flags |= (epi::LexBoolean(value) ? MLF_TwoSided : 0);
-                else if (key == "dontpegtop")
-                    flags |= (epi::LexBoolean(value) ? MLF_UpperUnpegged : 0);
-                else if (key == "dontpegbottom")
-                    flags |= (epi::LexBoolean(value) ? MLF_LowerUnpegged : 0);
-                else if (key == "secret")
-                    flags |= (epi::LexBoolean(value) ? MLF_Secret : 0);
-                else if (key == "blocksound")
-                    flags |= (epi::LexBoolean(value) ? MLF_SoundBlock : 0);
-                else if (key == "dontdraw")
-                    flags |= (epi::LexBoolean(value) ? MLF_DontDraw : 0);
-                else if (key == "mapped")
-                    flags |= (epi::LexBoolean(value) ? MLF_Mapped : 0);
-                else if (key == "passuse")
-                    flags |= (epi::LexBoolean(value) ? MLF_PassThru : 0);
-                else if (key == "blockplayers")
-                    flags |= (epi::LexBoolean(value) ? MLF_BlockPlayers : 0);
-                else if (key == "blocksight")
-                    flags |= (epi::LexBoolean(value) ? MLF_SightBlock : 0);
-            }
-            line_t *ld = lines + cur_line;
+        // a missing vertex field means vertex #0
+        ld->v1 = &vertexes[HMM_MAX(0, L.v1)];
+        ld->v2 = &vertexes[HMM_MAX(0, L.v2)];
 
-            ld->flags = flags;
-            ld->tag   = HMM_MAX(0, tag);
-            ld->v1    = &vertexes[v1];
-            ld->v2    = &vertexes[v2];
+        ld->special = P_LookupLineType(HMM_MAX(0, L.special));
 
-            ld->special = P_LookupLineType(HMM_MAX(0, special));
-
-            if (ld->special && ld->special->type == line_walkable)
-                ld->flags |= MLF_PassThru;
-
-            if (ld->special && ld->special->type == line_none &&
-                (ld->special->s_xspeed || ld->special->s_yspeed || ld->special->scroll_type > ScrollType_None ||
-                 ld->special->line_effect == LINEFX_VectorScroll || ld->special->line_effect == LINEFX_OffsetScroll ||
-                 ld->special->line_effect == LINEFX_TaggedOffsetScroll))
-                ld->flags |= MLF_PassThru;
-
-            if (ld->special && ld->special->slope_type & SLP_DetailFloor)
-                ld->flags |= MLF_PassThru;
+        if (ld->special && ld->special->type == line_walkable)
+            ld->flags |= MLF_PassThru;
 
-            if (ld->special && ld->special->slope_type & SLP_DetailCeiling)
-                ld->flags |= MLF_PassThru;
+        if (ld->special && ld->special->type == line_none &&
+            (ld->special->s_xspeed || ld->special->s_yspeed || ld->special->scroll_type > ScrollType_None ||
+             ld->special->line_effect == LINEFX_VectorScroll || ld->special->line_effect == LINEFX_OffsetScroll ||
+             ld->special->line_effect == LINEFX_TaggedOffsetScroll))
+            ld->flags |= MLF_PassThru;
 
-            if (ld->special && ld->special == linetypes.Lookup(0)) // Add passthru to unknown/templated
-                ld->flags |= MLF_PassThru;
+        if (ld->special && ld->special->slope_type & SLP_DetailFloor)
+            ld->flags |= MLF_PassThru;
 
-            ComputeLinedefData(ld, side0, side1);
+        if (ld->special && ld->special->slope_type & SLP_DetailCeiling)
+            ld->flags |= MLF_PassThru;
 
-            if (ld->tag && ld->special && ld->special->ef.type)
-            {
-                for (int j = 0; j < numsectors; j++)
-                {
-                    if (sectors[j].tag != ld->tag)
-                        continue;
+        if (ld->special && ld->special == linetypes.Lookup(0)) // Add passthru to unknown/templated
+            ld->flags |= MLF_PassThru;
 
-                    sectors[j].exfloor_max++;
-                    numextrafloors++;
-                }
-            }
-            cur_line++;
-        }
-        else // consume other blocks
-        {
-            for (;;)
-            {
-                tok = lex.Next(section);
-                if (lex.Match("}") || tok == epi::kTokenEOF)
-                    break;
-            }
-        }
+        ComputeLinedefData(ld, L.sidefront, L.sideback);
     }
-    SYS_ASSERT(cur_line == numlines);
 
-    I_Debugf("LoadUDMFLineDefs: finished parsing TEXTMAP\n");
+    I_Debugf("LoadUDMFLineDefs: finished\n");
 }
 
 static void LoadUDMFThings()
 {
-    epi::Lexer lex(udmf_lump);
+    I_Debugf("LoadUDMFThings: processing %d things\n", (int)udmf_map.things.size());
+
+    for (const epi::UDMFThing &T : udmf_map.things)
+    {
+        float    x         = T.x;
+        float    y         = T.y;
+        float    z         = T.height;
+        BAMAngle angle     = epi::BAMFromDegrees(T.angle);
+        int      options   = MTF_NOT_SINGLE | MTF_NOT_DM | MTF_NOT_COOP;
+        int      typenum   = T.type;
+        int      tag       = T.id;
+        float    healthfac = T.health;
+        float    alpha     = T.alpha;
+        float    scale     = T.scale;
+        float    scalex    = T.scalex;
+        float    scaley    = T.scaley;
+
+        if (T.flags & (epi::kUDMFThingSkill1 | epi::kUDMFThingSkill2))
+            options |= MTF_EASY;
+        if (T.flags & epi::kUDMFThingSkill3)
+            options |= MTF_NORMAL;
+        if (T.flags & (epi::kUDMFThingSkill4 | epi::kUDMFThingSkill5))
+            options |= MTF_HARD;
+        if (T.flags & epi::kUDMFThingAmbush)
+            options |= MTF_AMBUSH;
+        if (T.flags & epi::kUDMFThingFriend)
+            options |= MTF_FRIEND;
+
+        if (T.flags & epi::kUDMFThingSingle)
+            options &= ~MTF_NOT_SINGLE;
+        if (T.flags & epi::kUDMFThingDM)
+            options &= ~MTF_NOT_DM;
+        if (T.flags & epi::kUDMFThingCoop)
+            options &= ~MTF_NOT_COOP;
+
+        const mobjtype_c *objtype = mobjtypes.Lookup(typenum);
 
-    I_Debugf("LoadUDMFThings: parsing TEXTMAP\n");
-    for (;;)
-    {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
-
-        if (tok == epi::kTokenEOF)
-            break;
-
-        if (tok != epi::kTokenIdentifier)
-            I_Error("Malformed TEXTMAP lump.\n");
-
-        // check namespace
-        if (lex.Match("="))
+        // MOBJTYPE not found, don't crash out: JDS Compliance.
+        // -ACB- 1998/07/21
+        if (objtype == NULL)
         {
-            lex.Next(section);
-            if (!lex.Match(";"))
-                I_Error("Malformed TEXTMAP lump: missing ';'\n");
+            UnknownThingWarning(typenum, x, y);
             continue;
         }
 
-        if (!lex.Match("{"))
-            I_Error("Malformed TEXTMAP lump: missing '{'\n");
+        sector_t *sec = R_PointInSubsector(x, y)->sector;
 
-        if (section == "thing")
+        if ((objtype->hyperflags & HF_MUSIC_CHANGER) && !musinfo_tracks[currmap->name].processed)
         {
-            float             x = 0.0f, y = 0.0f, z = 0.0f;
-            BAMAngle           angle     = kBAMAngle0;
-            int               options   = MTF_NOT_SINGLE | MTF_NOT_DM | MTF_NOT_COOP;
-            int               typenum   = -1;
-            int               tag       = 0;
-            float             healthfac = 1.0f;
-            float             alpha     = 1.0f;
-            float             scale = 0.0f, scalex = 0.0f, scaley = 0.0f;
-            const mobjtype_c *objtype;
-            for (;;)
-            {
-                if (lex.Match("}"))
-                    break;
-
-                std::string       key;
-                std::string       value;
-                epi::TokenKind block_tok = lex.Next(key);
-
-                if (block_tok == epi::kTokenEOF)
-                    I_Error("Malformed TEXTMAP lump: unclosed block\n");
-
-                if (block_tok != epi::kTokenIdentifier)
-                    I_Error("Malformed TEXTMAP lump: missing key\n");
-
-                if (!lex.Match("="))
-                    I_Error("Malformed TEXTMAP lump: missing '='\n");
-
-                block_tok = lex.Next(value);
-
-                if (block_tok == epi::kTokenEOF || block_tok == epi::kTokenError || value == "}")
-                    I_Error("Malformed TEXTMAP lump: missing value\n");
-
-                if (!lex.Match(";"))
-                    I_Error("Malformed TEXTMAP lump: missing ';'\n");
-
-                if (key == "id")
-                    tag = epi::LexInteger(value);
-                else if (key == "x")
-                    x = epi::LexDouble(value);
-                else if (key == "y")
-                    y = epi::LexDouble(value);
-                else if (key == "height")
-                    z = epi::LexDouble(value);
-                else if (key == "angle")
-                    angle = epi::BAMFromDegrees(epi::LexInteger(value));
-                else if (key == "type")
-                    typenum = epi::LexInteger(value);
-                else if (key == "skill1")
-                    options |= (epi::LexBoolean(value) ? MTF_EASY : 0);
-                else if (key == "skill2")
-                    options |= (epi::LexBoolean(value) ? MTF_EASY : 0);
-                else if (key == "skill3")
-                    options |= (epi::LexBoolean(value) ? MTF_NORMAL : 0);
-                else if (key == "skill4")
-                    options |= (epi::LexBoolean(value) ? MTF_HARD : 0);
-                else if (key == "skill5")
-                    options |= (epi::LexBoolean(value) ? MTF_HARD : 0);
-                else if (key == "ambush")
-                    options |= (epi::LexBoolean(value) ? MTF_AMBUSH : 0);
-                else if (key == "single")
-                    options &= (epi::LexBoolean(value) ? ~MTF_NOT_SINGLE : options);
-                else if (key == "dm")
-                    options &= (epi::LexBoolean(value) ? ~MTF_NOT_DM : options);
-                else if (key == "coop")
-                    options &= (epi::LexBoolean(value) ? ~MTF_NOT_COOP : options);
-                else if (key == "friend")
-                    options |= (epi::LexBoolean(value) ? MTF_FRIEND : 0);
-                else if (key == "health")
-                    healthfac = epi::LexDouble(value);
-                else if (key == "alpha")
-                    alpha = epi::LexDouble(value);
-                else if (key == "scale")
-                    scale     = epi::LexDouble(value);
-                else if (key == "scalex")
-                    scalex    = epi::LexDouble(value);
-                else if (key == "scaley")
-                    scaley    = epi::LexDouble(value);
-            }
-            objtype = mobjtypes.Lookup(typenum);
-
-            // MOBJTYPE not found, don't crash out: JDS Compliance.
-            // -ACB- 1998/07/21
-            if (objtype == NULL)
+            // This really should only be used with the original DoomEd number range
+            if (objtype->number >= 14100 && objtype->number < 14165)
             {
-                UnknownThingWarning(typenum, x, y);
-                continue;
-            }
-
-            sector_t *sec = R_PointInSubsector(x, y)->sector;
+                int mus_number = -1;
 
-            if ((objtype->hyperflags & HF_MUSIC_CHANGER) && !musinfo_tracks[currmap->name].processed)
-            {
-                // This really should only be used with the original DoomEd number range
-                if (objtype->number >= 14100 && objtype->number < 14165)
+                if (objtype->number == 14100) // Default for level
+                    mus_number = currmap->music;
+                else if (musinfo_tracks[currmap->name].mappings.count(objtype->number - 14100))
                 {
-                    int mus_number = -1;
-
-                    if (objtype->number == 14100) // Default for level
-                        mus_number = currmap->music;
-                    else if (musinfo_tracks[currmap->name].mappings.count(objtype->number - 14100))
-                    {
-                        mus_number = musinfo_tracks[currmap->name].mappings[objtype->number - 14100];
-                    }
-                    // Track found; make ad-hoc RTS script for music changing
-                    if (mus_number != -1)
-                    {
-                        std::string mus_rts = "// MUSINFO SCRIPTS\n\n";
-                        mus_rts.append(epi::StringFormat("START_MAP %s\n", currmap->name.c_str()));
-                        mus_rts.append(epi::StringFormat("  SECTOR_TRIGGER_INDEX %d\n", sec - sectors));
-                        mus_rts.append("    TAGGED_INDEPENDENT\n");
-                        mus_rts.append("    TAGGED_REPEATABLE\n");
-                        mus_rts.append("    WAIT 30T\n");
-                        mus_rts.append(epi::StringFormat("    CHANGE_MUSIC %d\n", mus_number));
-                        mus_rts.append("    RETRIGGER\n");
-                        mus_rts.append("  END_SECTOR_TRIGGER\n");
-                        mus_rts.append("END_MAP\n\n");
-                        RAD_ReadScript(mus_rts, "MUSINFO");
-                    }
+                    mus_number = musinfo_tracks[currmap->name].mappings[objtype->number - 14100];
+                }
+                // Track found; make ad-hoc RTS script for music changing
+                if (mus_number != -1)
+                {
+                    std::string mus_rts = "// MUSINFO SCRIPTS\n\n";
+                    mus_rts.append(epi::StringFormat("START_MAP %s\n", currmap->name.c_str()));
+                    mus_rts.append(epi::StringFormat("  SECTOR_TRIGGER_INDEX %d\n", sec - sectors));
+                    mus_rts.append("    TAGGED_INDEPENDENT\n");
+                    mus_rts.append("    TAGGED_REPEATABLE\n");
+                    mus_rts.append("    WAIT 30T\n");
+                    mus_rts.append(epi::StringFormat("    CHANGE_MUSIC %d\n", mus_number));
+                    mus_rts.append("    RETRIGGER\n");
+                    mus_rts.append("  END_SECTOR_TRIGGER\n");
+                    mus_rts.append("END_MAP\n\n");
+                    RAD_ReadScript(mus_rts, "MUSINFO");
                 }
             }
+        }
 
-            if (objtype->flags & MF_SPAWNCEILING)
-                z += sec->c_h - objtype->height;
-            else
-                z += sec->f_h;
+        if (objtype->flags & MF_SPAWNCEILING)
+            z += sec->c_h - objtype->height;
+        else
+            z += sec->f_h;
 
-            mobj_t *udmf_thing = SpawnMapThing(objtype, x, y, z, sec, angle, options, tag);
+        mobj_t *udmf_thing = SpawnMapThing(objtype, x, y, z, sec, angle, options, tag);
 
-            // check for UDMF-specific thing stuff
-            if (udmf_thing)
+        // check for UDMF-specific thing stuff
+        if (udmf_thing)
+        {
+            udmf_thing->vis_target = alpha;
+            udmf_thing->alpha = alpha;
+            if (!AlmostEquals(healthfac, 1.0f))
             {
-                udmf_thing->vis_target = alpha;
-                udmf_thing->alpha = alpha;
-                if (!AlmostEquals(healthfac, 1.0f))
+                if (healthfac < 0)
                 {
-                    if (healthfac < 0)
-                    {
-                        udmf_thing->spawnhealth = fabs(healthfac);
-                        udmf_thing->health      = fabs(healthfac);
-                    }
-                    else
-                    {
-                        udmf_thing->spawnhealth *= healthfac;
-                        udmf_thing->health *= healthfac;
-                    }
-                }
-                // Treat 'scale' and 'scalex/scaley' as one or the other; don't try to juggle both
-                if (!AlmostEquals(scale, 0.0f))
-                {
-                    udmf_thing->scale = udmf_thing->model_scale = scale;
-                    udmf_thing->height *= scale;
-                    udmf_thing->radius *= scale;
+                    udmf_thing->spawnhealth = fabs(healthfac);
+                    udmf_thing->health      = fabs(healthfac);
                 }
-                else if (!AlmostEquals(scalex, 0.0f) || !AlmostEquals(scaley, 0.0f))
+                else
                 {
-                    float sx          = AlmostEquals(scalex, 0.0f) ? 1.0f : scalex;
-                    float sy          = AlmostEquals(scaley, 0.0f) ? 1.0f : scaley;
-                    udmf_thing->scale = udmf_thing->model_scale = sy;
-                    udmf_thing->aspect = udmf_thing->model_aspect = (sx / sy);
-                    udmf_thing->height *= sy;
-                    udmf_thing->radius *= sx;
+                    udmf_thing->spawnhealth *= healthfac;
+                    udmf_thing->health *= healthfac;
                 }
             }
-
-            mapthing_NUM++;
-        }
-        else // consume other blocks
-        {
-            for (;;)
+            // Treat 'scale' and 'scalex/scaley' as one or the other; don't try to juggle both
+            if (!AlmostEquals(scale, 0.0f))
             {
-                tok = lex.Next(section);
-                if (lex.Match("}") || tok == epi::kTokenEOF)
-                    break;
+                udmf_thing->scale = udmf_thing->model_scale = scale;
+                udmf_thing->height *= scale;
+                udmf_thing->radius *= scale;
+            }
+            else if (!AlmostEquals(scalex, 0.0f) || !AlmostEquals(scaley, 0.0f))
+            {
+                float sx          = AlmostEquals(scalex, 0.0f) ? 1.0f : scalex;
+                float sy          = AlmostEquals(scaley, 0.0f) ? 1.0f : scaley;
+                udmf_thing->scale = udmf_thing->model_scale = sy;
+                udmf_thing->aspect = udmf_thing->model_aspect = (sx / sy);
+                udmf_thing->height *= sy;
+                udmf_thing->radius *= sx;
             }
         }
+
+        mapthing_NUM++;
     }
 
     // Mark MUSINFO for this level as done processing, even if it was empty,
     // so we can avoid re-checks
     musinfo_tracks[currmap->name].processed = true;
 
-    I_Debugf("LoadUDMFThings: finished parsing TEXTMAP\n");
+    I_Debugf("LoadUDMFThings: finished\n");
 }
 
 static void LoadUDMFCounts()
 {
-    epi::Lexer lex(udmf_lump);
-
-    for (;;)
+    if (udmf_strict.d)
     {
-        std::string       section;
-        epi::TokenKind tok = lex.Next(section);
-
-        if (tok == epi::kTokenEOF)
-            break;
-
-        if (tok != epi::kTokenIdentifier)
-            I_Error("Malformed TEXTMAP lump.\n");
+        const std::string &ns = udmf_map.name_space;
 
-        // check namespace
-        if (lex.Match("="))
+        if (ns != "doom" && ns != "heretic" && ns != "edge-classic" && ns != "zdoomtranslated")
         {
-            lex.Next(section);
-
-            if (udmf_strict.d)
-            {
-                if (section != "doom" && section != "heretic" && section != "edge-classic" &&
-                    section != "zdoomtranslated")
-                {
-                    I_Warning("UDMF: %s uses unsupported namespace \"%s\"!\nSupported namespaces are \"doom\", "
-                              "\"heretic\", \"edge-classic\", or \"zdoomtranslated\"!\n",
-                              currmap->lump.c_str(), section.c_str());
-                }
-            }
-
-            if (!lex.Match(";"))
-                I_Error("Malformed TEXTMAP lump: missing ';'\n");
-            continue;
-        }
-
-        if (!lex.Match("{"))
-            I_Error("Malformed TEXTMAP lump: missing '{'\n");
-
-        // side counts are computed during linedef loading
-        if (section == "thing")
-            mapthing_NUM++;
-        else if (section == "vertex")
-            numvertexes++;
-        else if (section == "sector")
-            numsectors++;
-        else if (section == "linedef")
-            numlines++;
-
-        // ignore block contents
-        for (;;)
-        {
-            tok = lex.Next(section);
-            if (lex.Match("}") || tok == epi::kTokenEOF)
-                break;
+            I_Warning("UDMF: %s uses unsupported namespace \"%s\"!\nSupported namespaces are \"doom\", "
+                      "\"heretic\", \"edge-classic\", or \"zdoomtranslated\"!\n",
+                      currmap->lump.c_str(), ns.c_str());
         }
     }
 
+    // side counts are computed during linedef loading
+    numvertexes = (int)udmf_map.vertices.size();
+    numsectors  = (int)udmf_map.sectors.size();
+    numlines    = (int)udmf_map.linedefs.size();
+    mapthing_NUM = (int)udmf_map.things.size();
+
     // initialize arrays
     vertexes = new vertex_t[numvertexes];
     sectors  = new sector_t[numsectors];
@@ -2637,9 +2177,9 @@ static void LoadSideDefs(int lump)
 // SetupExtrafloors
 //
 // This is done after loading sectors (which sets exfloor_max to 0)
-// and after loading linedefs (which increases it for each new
-// extrafloor).  So now we know the maximum number of extrafloors
-// that can ever be needed.
+// and linedefs, and after building the tag index.  Each extrafloor
+// linedef increases exfloor_max of the sectors it refers to, so then
+// we know the maximum number of extrafloors that can ever be needed.
 //
 // Note: this routine doesn't create any extrafloors (this is done
 // later when their linetypes are activated).
@@ -2649,6 +2189,20 @@ static void SetupExtrafloors(void)
     int       i, ef_index = 0;
     sector_t *ss;
 
+    for (i = 0; i < numlines; i++)
+    {
+        line_t *ld = lines + i;
+
+        if (ld->tag && ld->special && ld->special->ef.type)
+        {
+            for (sector_t *sec = P_FindSectorFromTag(ld->tag); sec; sec = sec->tag_next)
+            {
+                sec->exfloor_max++;
+                numextrafloors++;
+            }
+        }
+    }
+
     if (numextrafloors == 0)
         return;
 
@@ -2681,11 +2235,9 @@ static void SetupSlidingDoors(void)
             ld->slide_door = ld->special;
         else
         {
-            for (int k = 0; k < numlines; k++)
+            for (line_t *other = P_FindLineFromTag(ld->tag); other; other = other->tag_next)
             {
-                line_t *other = lines + k;
-
-                if (other->tag != ld->tag || other == ld)
+                if (other == ld)
                     continue;
 
                 other->slide_door = ld->special;
@@ -3446,10 +2998,242 @@ void ShutdownLevel(void)
     linebuffer = NULL;
     delete[] v_seclists;
     v_seclists = NULL;
+    delete[] rejectmatrix;
+    rejectmatrix = nullptr;
 
     P_DestroyBlockMap();
 
     P_RemoveAllMobjs(false);
+
+    P_ClearTagIndex();
+}
+
+//
+// Sound warmup: gather the sounds the level can make, most important
+// first (the players and their weapons), so the sound cache can decode
+// them in the background.  Sounds missed here are loaded when first
+// played.
+//
+static std::vector<sfxdef_c *>                level_sounds;
+static std::unordered_set<const mobjtype_c *>  level_sound_things;
+static std::unordered_set<const weapondef_c *> level_sound_weapons;
+static std::unordered_set<const atkdef_c *>    level_sound_attacks;
+
+// weapons which things on the level give when picked up
+static std::vector<const weapondef_c *> level_sound_pickups;
+
+static void GatherStateSounds(const state_group_t &group)
+{
+    for (const state_range_t &range : group)
+    {
+        for (int i = range.first; i <= range.last; i++)
+        {
+            const state_t *st = &states[i];
+
+            if (st->action == P_ActPlaySound || st->action == P_ActPlaySoundBoss || st->action == A_WeaponPlaySound)
+                S_CacheAddEffect(level_sounds, (const sfx_t *)st->action_par);
+        }
+    }
+}
+
+static void GatherThingSounds(const mobjtype_c *info);
+
+static void GatherAttackSounds(const atkdef_c *atk)
+{
+    if (!atk || level_sound_attacks.count(atk) > 0)
+        return;
+
+    level_sound_attacks.insert(atk);
+
+    S_CacheAddEffect(level_sounds, atk->initsound);
+    S_CacheAddEffect(level_sounds, atk->sound);
+
+    GatherThingSounds(atk->atk_mobj);
+    GatherThingSounds(atk->spawnedobj);
+    GatherThingSounds(atk->puff);
+
+    GatherAttackSounds(atk->dualattack1);
+    GatherAttackSounds(atk->dualattack2);
+}
+
+static void GatherWeaponSounds(const weapondef_c *weap)
+{
+    if (!weap || level_sound_weapons.count(weap) > 0)
+        return;
+
+    level_sound_weapons.insert(weap);
+
+    S_CacheAddEffect(level_sounds, weap->start);
+    S_CacheAddEffect(level_sounds, weap->engaged);
+    S_CacheAddEffect(level_sounds, weap->hit);
+    S_CacheAddEffect(level_sounds, weap->idle);
+    S_CacheAddEffect(level_sounds, weap->sound1);
+    S_CacheAddEffect(level_sounds, weap->sound2);
+    S_CacheAddEffect(level_sounds, weap->sound3);
+
+    GatherStateSounds(weap->state_grp);
+
+    for (int ATK = 0; ATK < 4; ATK++)
+        GatherAttackSounds(weap->attack[ATK]);
+
+    GatherAttackSounds(weap->eject_attack);
+}
+
+static void GatherThingSounds(const mobjtype_c *info)
+{
+    if (!info || level_sound_things.count(info) > 0)
+        return;
+
+    level_sound_things.insert(info);
+
+    S_CacheAddEffect(level_sounds, info->seesound);
+    S_CacheAddEffect(level_sounds, info->attacksound);
+    S_CacheAddEffect(level_sounds, info->painsound);
+    S_CacheAddEffect(level_sounds, info->deathsound);
+    S_CacheAddEffect(level_sounds, info->overkill_sound);
+    S_CacheAddEffect(level_sounds, info->activesound);
+    S_CacheAddEffect(level_sounds, info->walksound);
+    S_CacheAddEffect(level_sounds, info->jump_sound);
+    S_CacheAddEffect(level_sounds, info->noway_sound);
+    S_CacheAddEffect(level_sounds, info->oof_sound);
+    S_CacheAddEffect(level_sounds, info->fallpain_sound);
+    S_CacheAddEffect(level_sounds, info->gasp_sound);
+    S_CacheAddEffect(level_sounds, info->secretsound);
+    S_CacheAddEffect(level_sounds, info->falling_sound);
+    S_CacheAddEffect(level_sounds, info->rip_sound);
+
+    GatherStateSounds(info->state_grp);
+
+    GatherAttackSounds(info->closecombat);
+    GatherAttackSounds(info->rangeattack);
+    GatherAttackSounds(info->spareattack);
+
+    GatherThingSounds(info->dropitem);
+    GatherThingSounds(info->blood);
+    GatherThingSounds(info->respawneffect);
+
+    // weapons which can be picked up come after everything else
+    for (benefit_t *be = info->pickup_benefits; be; be = be->next)
+    {
+        if (be->type == BENEFIT_Weapon)
+            level_sound_pickups.push_back(be->sub.weap);
+    }
+}
+
+static void GatherPlaneSounds(const movplanedef_c *plane)
+{
+    S_CacheAddEffect(level_sounds, plane->sfxstart);
+    S_CacheAddEffect(level_sounds, plane->sfxup);
+    S_CacheAddEffect(level_sounds, plane->sfxdown);
+    S_CacheAddEffect(level_sounds, plane->sfxstop);
+}
+
+static void GatherLineSounds(const linetype_c *special)
+{
+    GatherPlaneSounds(&special->f);
+    GatherPlaneSounds(&special->c);
+
+    S_CacheAddEffect(level_sounds, special->d.d_sfxin);
+    S_CacheAddEffect(level_sounds, special->d.d_sfxinstop);
+    S_CacheAddEffect(level_sounds, special->d.d_sfxout);
+    S_CacheAddEffect(level_sounds, special->d.d_sfxoutstop);
+
+    S_CacheAddEffect(level_sounds, special->s.sfx_start);
+    S_CacheAddEffect(level_sounds, special->s.sfx_open);
+    S_CacheAddEffect(level_sounds, special->s.sfx_close);
+    S_CacheAddEffect(level_sounds, special->s.sfx_stop);
+
+    S_CacheAddEffect(level_sounds, special->failed_sfx);
+    S_CacheAddEffect(level_sounds, special->ambient_sfx);
+    S_CacheAddEffect(level_sounds, special->activate_sfx);
+
+    GatherThingSounds(special->t.inspawnobj);
+    GatherThingSounds(special->t.outspawnobj);
+    GatherThingSounds(special->effectobject);
+}
+
+static void GatherScriptSounds(void)
+{
+    for (rad_script_t *scr = r_scripts; scr; scr = scr->next)
+    {
+        if (strcmp(currmap->name.c_str(), scr->mapid) != 0 && strcmp(scr->mapid, "ALL") != 0)
+            continue;
+
+        for (rts_state_t *st = scr->first_state; st; st = st->next)
+        {
+            if (st->action == RAD_ActPlaySound)
+            {
+                S_CacheAddEffect(level_sounds, ((s_sound_t *)st->param)->sfx);
+            }
+            else if (st->action == RAD_ActSpawnThing)
+            {
+                const s_thing_t *t = (const s_thing_t *)st->param;
+
+                if (t->thing_name)
+                    GatherThingSounds(mobjtypes.Lookup(t->thing_name));
+                else
+                    GatherThingSounds(mobjtypes.Lookup(t->thing_type));
+            }
+        }
+    }
+}
+
+static void PrecacheLevelSounds(void)
+{
+    if (!var_cache_sfx)
+        return;
+
+    level_sounds.clear();
+    level_sound_things.clear();
+    level_sound_weapons.clear();
+    level_sound_attacks.clear();
+    level_sound_pickups.clear();
+
+    for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
+    {
+        player_t *p = players[pnum];
+        if (!p)
+            continue;
+
+        if (p->mo)
+            GatherThingSounds(p->mo->info);
+
+        for (int w = 0; w < MAXWEAPONS; w++)
+        {
+            if (p->weapons[w].owned)
+                GatherWeaponSounds(p->weapons[w].info);
+        }
+    }
+
+    for (mobj_t *mo = mobjlisthead; mo; mo = mo->next)
+        GatherThingSounds(mo->info);
+
+    // (the list grows when a weapon's attacks spawn more things)
+    for (size_t i = 0; i < level_sound_pickups.size(); i++)
+        GatherWeaponSounds(level_sound_pickups[i]);
+
+    for (int i = 0; i < numlines; i++)
+    {
+        if (lines[i].special)
+            GatherLineSounds(lines[i].special);
+    }
+
+    for (int i = 0; i < numsectors; i++)
+    {
+        const sectortype_c *special = sectors[i].props.special;
+        if (!special)
+            continue;
+
+        GatherPlaneSounds(&special->f);
+        GatherPlaneSounds(&special->c);
+
+        S_CacheAddEffect(level_sounds, special->ambient_sfx);
+        S_CacheAddEffect(level_sounds, special->splash_sfx);
+    }
+
+    GatherScriptSounds();
+
+    S_CacheWarmup(level_sounds, true);
 }
 
 void P_SetupLevel(void)
@@ -3462,6 +3246,9 @@ void P_SetupLevel(void)
     if (level_active)
         ShutdownLevel();
 
+    R_ClearInterpolation();
+    R_ClearGeometryCache();
+
     // -ACB- 1998/08/27 NULL the head pointers for the linked lists....
     itemquehead  = NULL;
     mobjlisthead = NULL;
@@ -3489,13 +3276,16 @@ void P_SetupLevel(void)
     {
         udmf_level          = true;
         udmf_lumpnum        = lumpnum + 1;
-        int   raw_length    = 0;
+        int      raw_length = 0;
         uint8_t *raw_udmf   = W_LoadLump(udmf_lumpnum, &raw_length);
-        udmf_lump.clear();
-        udmf_lump.resize(raw_length);
-        memcpy(udmf_lump.data(), raw_udmf, raw_length);
-        if (udmf_lump.empty())
+        if (raw_length == 0)
             I_Error("Internal error: can't load UDMF lump.\n");
+
+        // parse the whole TEXTMAP once, straight from the lump memory
+        uint32_t start_time = I_GetMicros();
+        epi::ParseUDMF((const char *)raw_udmf, raw_length, udmf_map);
+        I_Debugf("UDMF: parsed TEXTMAP in %u us\n", I_GetMicros() - start_time);
+
         delete[] raw_udmf;
     }
     else
@@ -3553,6 +3343,9 @@ void P_SetupLevel(void)
         LoadUDMFSideDefs();
     }
 
+    // -AJA- 1999/07/29: Keep sectors (and lines) with same tag in a list.
+    P_BuildTagIndex();
+
     SetupExtrafloors();
     SetupSlidingDoors();
     SetupVertGaps();
@@ -3561,7 +3354,10 @@ void P_SetupLevel(void)
 
     LoadXGL3Nodes(xgl_lump);
 
-    // REJECT is ignored, and we generate our own BLOCKMAP
+    // the map's REJECT is ignored, the node builder makes our own
+    // (which is stored right after the nodes).  we also generate our
+    // own BLOCKMAP.
+    LoadXReject(xgl_lump + 1);
 
     DoBlockMap();
 
@@ -3597,7 +3393,10 @@ void P_SetupLevel(void)
             LoadThings(lumpnum + ML_THINGS);
     }
     else
+    {
         LoadUDMFThings();
+        udmf_map.Clear();
+    }
 
         // OK, CRC values have now been computed
 #ifdef DEVELOPERS
@@ -3619,7 +3418,7 @@ void P_SetupLevel(void)
     // setup categories based on game mode (SP/COOP/DM)
     S_ChangeChannelNum();
 
-    // FIXME: cache sounds (esp. for player)
+    PrecacheLevelSounds();
 
     S_ChangeMusic(currmap->music, true); // start level music
 
@@ -49,6 +49,7 @@
 #include "r_state.h"
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 #define DEBUG_SIGHT 0
 
@@ -422,8 +423,27 @@ static bool CheckSightSameSubsector(mobj_t *src, mobj_t *dest)
     return false;
 }
 
+//
+// P_CheckReject
+//
+// Returns true when nothing in the source sector can ever see the
+// destination sector, according to the visibility table built with
+// the nodes.  Returns false when there is no table.
+//
+bool P_CheckReject(const sector_t *src, const sector_t *dest)
+{
+    if (!rejectmatrix)
+        return false;
+
+    int bit = (src - sectors) * numsectors + (dest - sectors);
+
+    return (rejectmatrix[bit >> 3] & (1 << (bit & 7))) != 0;
+}
+
 bool P_CheckSight(mobj_t *src, mobj_t *dest)
 {
+    EDGE_ZoneScoped;
+
     // -ACB- 1998/07/20 t2 is Invisible, t1 cannot possibly see it.
     if (dest->visibility == INVISIBLE)
         return false;
@@ -438,6 +458,18 @@ bool P_CheckSight(mobj_t *src, mobj_t *dest)
     SYS_ASSERT(src->subsector);
     SYS_ASSERT(dest->subsector);
 
+    if (P_CheckReject(src->subsector->sector, dest->subsector->sector))
+    {
+#ifdef DEVELOPERS
+        sight_rej_hit++;
+#endif
+        return false;
+    }
+
+#ifdef DEVELOPERS
+    sight_rej_miss++;
+#endif
+
     // An unobstructed LOS is possible.
     // Now look from eyes of t1 to any part of t2.
 
@@ -575,11 +607,16 @@ bool P_CheckSight(mobj_t *src, mobj_t *dest)
 
 bool P_CheckSightToPoint(mobj_t *src, float x, float y, float z)
 {
+    EDGE_ZoneScoped;
+
     subsector_t *dest_sub = R_PointInSubsector(x, y);
 
     if (dest_sub == src->subsector)
         return true;
 
+    if (P_CheckReject(src->subsector->sector, dest_sub->sector))
+        return false;
+
     validcount++;
 
     sight_I.src.x   = src->x;
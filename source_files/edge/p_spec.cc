@@ -51,8 +51,7 @@
 #include "r_sky.h" //Lobo 2022: added for our Sky Transfer special
 
 #include "AlmostEquals.h"
-
-extern cvar_c r_doubleframes;
+#include "edge_profiling.h"
 
 // Level exit timer
 bool levelTimer;
@@ -239,25 +238,6 @@ float P_FindRaiseToTexture(sector_t *sec)
     return sec->f_h + minsize;
 }
 
-//
-// Returns the FIRST sector that tag refers to.
-//
-// -KM- 1998/09/27 Doesn't need a line.
-// -AJA- 1999/09/29: Now returns a sector_t, and has no start.
-//
-sector_t *P_FindSectorFromTag(int tag)
-{
-    int i;
-
-    for (i = 0; i < numsectors; i++)
-    {
-        if (sectors[i].tag == tag)
-            return sectors + i;
-    }
-
-    return NULL;
-}
-
 //
 // Find minimum light from an adjacent sector
 //
@@ -648,13 +628,10 @@ static void P_LineEffect(line_t *target, line_t *source, const linetype_c *speci
                 anim.scroll_line_ref    = source;
                 anim.side0_xoffspeed    = -source->side[0]->middle.offset.X / 8.0;
                 anim.side0_yoffspeed    = source->side[0]->middle.offset.Y / 8.0;
-                for (int i = 0; i < numlines; i++)
+                for (line_t *ld = P_FindLineFromTag(source->frontsector->tag); ld; ld = ld->tag_next)
                 {
-                    if (lines[i].tag == source->frontsector->tag)
-                    {
-                        if (!lines[i].special || lines[i].special->count == 1)
-                            anim.permanent = true;
-                    }
+                    if (!ld->special || ld->special->count == 1)
+                        anim.permanent = true;
                 }
                 anim.last_height = anim.scroll_sec_ref->orig_height;
             }
@@ -715,13 +692,10 @@ static void P_LineEffect(line_t *target, line_t *source, const linetype_c *speci
                     anim.scroll_line_ref    = source;
                     anim.dynamic_dx += x;
                     anim.dynamic_dy += y;
-                    for (int i = 0; i < numlines; i++)
+                    for (line_t *ld = P_FindLineFromTag(source->frontsector->tag); ld; ld = ld->tag_next)
                     {
-                        if (lines[i].tag == source->frontsector->tag)
-                        {
-                            if (!lines[i].special || lines[i].special->count == 1)
-                                anim.permanent = true;
-                        }
+                        if (!ld->special || ld->special->count == 1)
+                            anim.permanent = true;
                     }
                     anim.last_height = anim.scroll_sec_ref->orig_height;
                 }
@@ -853,13 +827,10 @@ static void P_SectorEffect(sector_t *target, line_t *source, const linetype_c *s
                 anim.scroll_sec_ref     = source->frontsector;
                 anim.scroll_special_ref = special;
                 anim.scroll_line_ref    = source;
-                for (int i = 0; i < numlines; i++)
+                for (line_t *ld = P_FindLineFromTag(source->frontsector->tag); ld; ld = ld->tag_next)
                 {
-                    if (lines[i].tag == source->frontsector->tag)
-                    {
-                        if (!lines[i].special || lines[i].special->count == 1)
-                            anim.permanent = true;
-                    }
+                    if (!ld->special || ld->special->count == 1)
+                        anim.permanent = true;
                 }
                 anim.last_height = anim.scroll_sec_ref->orig_height;
             }
@@ -1020,16 +991,11 @@ static void P_PortalEffect(line_t *ld)
 
     bool is_camera = (ld->special->portal_effect & PORTFX_Camera) ? true : false;
 
-    for (int i = 0; i < numlines; i++)
+    for (line_t *other = P_FindLineFromTag(ld->tag); other; other = other->tag_next)
     {
-        line_t *other = lines + i;
-
         if (other == ld)
             continue;
 
-        if (other->tag != ld->tag)
-            continue;
-
         float h1 = ld->frontsector->c_h - ld->frontsector->f_h;
         float h2 = other->frontsector->c_h - other->frontsector->f_h;
 
@@ -1258,8 +1224,6 @@ static bool P_ActivateSpecialLine(line_t *line, const linetype_c *special, int t
     sfx_t    *sfx[4];
     sector_t *tsec;
 
-    int i;
-
 #ifdef DEVELOPERS
     if (!special)
     {
@@ -1413,12 +1377,9 @@ static bool P_ActivateSpecialLine(line_t *line, const linetype_c *special, int t
         }
         else
         {
-            for (i = 0; i < numlines; i++)
+            for (line_t *other = P_FindLineFromTag(tag); other; other = other->tag_next)
             {
-                if (lines[i].tag == tag)
-                {
-                    P_SpawnLineEffectDebris(lines + i, special);
-                }
+                P_SpawnLineEffectDebris(other, special);
             }
         }
     }
@@ -1525,11 +1486,9 @@ static bool P_ActivateSpecialLine(line_t *line, const linetype_c *special, int t
         }
         else if (tag)
         {
-            for (i = 0; i < numlines; i++)
+            for (line_t *other = P_FindLineFromTag(tag); other; other = other->tag_next)
             {
-                line_t *other = lines + i;
-
-                if (other->tag == tag && other != line)
+                if (other != line)
                     if (EV_DoSlider(other, line, thing, special))
                         texSwitch = true;
             }
@@ -1591,11 +1550,11 @@ static bool P_ActivateSpecialLine(line_t *line, const linetype_c *special, int t
         }
         else
         {
-            for (i = 0; i < numlines; i++)
+            for (line_t *other = P_FindLineFromTag(tag); other; other = other->tag_next)
             {
-                if (lines[i].tag == tag && &lines[i] != line)
+                if (other != line)
                 {
-                    P_LineEffect(lines + i, line, special);
+                    P_LineEffect(other, line, special);
                     texSwitch = true;
                 }
             }
@@ -1740,8 +1699,6 @@ static inline void PlayerInProperties(player_t *player, float bz, float tz, floa
     const sectortype_c *special = props->special;
     float               damage, factor;
 
-    bool extra_tic = ((gametic & 1) == 1);
-
     if (!special || c_h < f_h)
         return;
 
@@ -1756,7 +1713,7 @@ static inline void PlayerInProperties(player_t *player, float bz, float tz, floa
     if ((special->special_flags & SECSP_AirLess) && mouth_z >= f_h && mouth_z <= c_h && player->powers[PW_Scuba] <= 0)
     {
         int subtract = 1;
-        if ((r_doubleframes.d && extra_tic) || !should_choke)
+        if (!should_choke)
             subtract = 0;
         player->air_in_lungs -= subtract;
         player->underwater = true;
@@ -1844,9 +1801,6 @@ static inline void PlayerInProperties(player_t *player, float bz, float tz, floa
     else if (player->powers[PW_AcidSuit] && !special->damage.bypass_all)
         factor = 0;
 
-    if (r_doubleframes.d && extra_tic)
-        factor = 0;
-
     if (factor > 0 && (leveltime % (1 + special->damage.delay)) == 0)
     {
         DAMAGE_COMPUTE(damage, &special->damage);
@@ -1998,15 +1952,14 @@ static inline void ApplyScroll(HMM_Vec2 &offset, const HMM_Vec2 &delta, unsigned
 //
 // Animate planes, scroll walls, etc.
 //
-void P_UpdateSpecials(bool extra_tic)
+void P_UpdateSpecials(void)
 {
-    // For anim stuff
-    float factor = r_doubleframes.d ? 0.5f : 1.0f;
+    EDGE_ZoneScoped;
 
     // LEVEL TIMER
     if (levelTimer == true)
     {
-        levelTimeCount -= (r_doubleframes.d && extra_tic) ? 0 : 1;
+        levelTimeCount--;
 
         if (!levelTimeCount)
             G_ExitLevel(1);
@@ -2096,11 +2049,6 @@ void P_UpdateSpecials(bool extra_tic)
                     special_ref->scroll_type & ScrollType_Displace ? lineanims[i].last_height : sec_ref->orig_height;
                 float sy = tdy * ((sec_ref->f_h + sec_ref->c_h) - heightref);
                 float sx = tdx * ((sec_ref->f_h + sec_ref->c_h) - heightref);
-                if (r_doubleframes.d && special_ref->scroll_type & ScrollType_Displace)
-                {
-                    sy *= 2;
-                    sx *= 2;
-                }
                 if (ld->side[0])
                 {
                     if (ld->side[0]->top.image)
@@ -2146,11 +2094,6 @@ void P_UpdateSpecials(bool extra_tic)
                     special_ref->scroll_type & ScrollType_Displace ? lineanims[i].last_height : sec_ref->orig_height;
                 float sy = x_speed * ((sec_ref->f_h + sec_ref->c_h) - heightref);
                 float sx = y_speed * ((sec_ref->f_h + sec_ref->c_h) - heightref);
-                if (r_doubleframes.d && special_ref->scroll_type & ScrollType_Displace)
-                {
-                    sy *= 2;
-                    sx *= 2;
-                }
                 if (ld->side[0])
                 {
                     if (ld->side[0]->top.image)
@@ -2269,10 +2212,10 @@ void P_UpdateSpecials(bool extra_tic)
             if (ld->side[0]->top.image)
             {
                 ld->side[0]->top.offset.X = fmod(
-                    ld->side[0]->top.offset.X + (ld->side[0]->top.scroll.X + ld->side[0]->top.net_scroll.X) * factor,
+                    ld->side[0]->top.offset.X + (ld->side[0]->top.scroll.X + ld->side[0]->top.net_scroll.X),
                     ld->side[0]->top.image->actual_w);
                 ld->side[0]->top.offset.Y = fmod(
-                    ld->side[0]->top.offset.Y + (ld->side[0]->top.scroll.Y + ld->side[0]->top.net_scroll.Y) * factor,
+                    ld->side[0]->top.offset.Y + (ld->side[0]->top.scroll.Y + ld->side[0]->top.net_scroll.Y),
                     ld->side[0]->top.image->actual_h);
                 ld->side[0]->top.net_scroll = {{0, 0}};
             }
@@ -2280,11 +2223,11 @@ void P_UpdateSpecials(bool extra_tic)
             {
                 ld->side[0]->middle.offset.X =
                     fmod(ld->side[0]->middle.offset.X +
-                             (ld->side[0]->middle.scroll.X + ld->side[0]->middle.net_scroll.X) * factor,
+                             (ld->side[0]->middle.scroll.X + ld->side[0]->middle.net_scroll.X),
                          ld->side[0]->middle.image->actual_w);
                 ld->side[0]->middle.offset.Y =
                     fmod(ld->side[0]->middle.offset.Y +
-                             (ld->side[0]->middle.scroll.Y + ld->side[0]->middle.net_scroll.Y) * factor,
+                             (ld->side[0]->middle.scroll.Y + ld->side[0]->middle.net_scroll.Y),
                          ld->side[0]->middle.image->actual_h);
                 ld->side[0]->middle.net_scroll = {{0, 0}};
             }
@@ -2292,11 +2235,11 @@ void P_UpdateSpecials(bool extra_tic)
             {
                 ld->side[0]->bottom.offset.X =
                     fmod(ld->side[0]->bottom.offset.X +
-                             (ld->side[0]->bottom.scroll.X + ld->side[0]->bottom.net_scroll.X) * factor,
+                             (ld->side[0]->bottom.scroll.X + ld->side[0]->bottom.net_scroll.X),
                          ld->side[0]->bottom.image->actual_w);
                 ld->side[0]->bottom.offset.Y =
                     fmod(ld->side[0]->bottom.offset.Y +
-                             (ld->side[0]->bottom.scroll.Y + ld->side[0]->bottom.net_scroll.Y) * factor,
+                             (ld->side[0]->bottom.scroll.Y + ld->side[0]->bottom.net_scroll.Y),
                          ld->side[0]->bottom.image->actual_h);
                 ld->side[0]->bottom.net_scroll = {{0, 0}};
             }
@@ -2307,10 +2250,10 @@ void P_UpdateSpecials(bool extra_tic)
             if (ld->side[1]->top.image)
             {
                 ld->side[1]->top.offset.X = fmod(
-                    ld->side[1]->top.offset.X + (ld->side[1]->top.scroll.X + ld->side[1]->top.net_scroll.X) * factor,
+                    ld->side[1]->top.offset.X + (ld->side[1]->top.scroll.X + ld->side[1]->top.net_scroll.X),
                     ld->side[1]->top.image->actual_w);
                 ld->side[1]->top.offset.Y = fmod(
-                    ld->side[1]->top.offset.Y + (ld->side[1]->top.scroll.Y + ld->side[1]->top.net_scroll.Y) * factor,
+                    ld->side[1]->top.offset.Y + (ld->side[1]->top.scroll.Y + ld->side[1]->top.net_scroll.Y),
                     ld->side[1]->top.image->actual_h);
                 ld->side[1]->top.net_scroll = {{0, 0}};
             }
@@ -2318,11 +2261,11 @@ void P_UpdateSpecials(bool extra_tic)
             {
                 ld->side[1]->middle.offset.X =
                     fmod(ld->side[1]->middle.offset.X +
-                             (ld->side[1]->middle.scroll.X + ld->side[1]->middle.net_scroll.X) * factor,
+                             (ld->side[1]->middle.scroll.X + ld->side[1]->middle.net_scroll.X),
                          ld->side[1]->middle.image->actual_w);
                 ld->side[1]->middle.offset.Y =
                     fmod(ld->side[1]->middle.offset.Y +
-                             (ld->side[1]->middle.scroll.Y + ld->side[1]->middle.net_scroll.Y) * factor,
+                             (ld->side[1]->middle.scroll.Y + ld->side[1]->middle.net_scroll.Y),
                          ld->side[1]->middle.image->actual_h);
                 ld->side[1]->middle.net_scroll = {{0, 0}};
             }
@@ -2330,11 +2273,11 @@ void P_UpdateSpecials(bool extra_tic)
             {
                 ld->side[1]->bottom.offset.X =
                     fmod(ld->side[1]->bottom.offset.X +
-                             (ld->side[1]->bottom.scroll.X + ld->side[1]->bottom.net_scroll.X) * factor,
+                             (ld->side[1]->bottom.scroll.X + ld->side[1]->bottom.net_scroll.X),
                          ld->side[1]->bottom.image->actual_w);
                 ld->side[1]->bottom.offset.Y =
                     fmod(ld->side[1]->bottom.offset.Y +
-                             (ld->side[1]->bottom.scroll.Y + ld->side[1]->bottom.net_scroll.Y) * factor,
+                             (ld->side[1]->bottom.scroll.Y + ld->side[1]->bottom.net_scroll.Y),
                          ld->side[1]->bottom.image->actual_h);
                 ld->side[1]->bottom.net_scroll = {{0, 0}};
             }
@@ -2373,11 +2316,6 @@ void P_UpdateSpecials(bool extra_tic)
                        ((sec_ref->f_h + sec_ref->c_h) - heightref);
             float sx = line_ref->length / 32.0f * line_ref->dx / line_ref->length *
                        ((sec_ref->f_h + sec_ref->c_h) - heightref);
-            if (r_doubleframes.d && special_ref->scroll_type & ScrollType_Displace)
-            {
-                sy *= 2;
-                sx *= 2;
-            }
             if (special_ref->sector_effect & SECTFX_PushThings)
             {
                 sec->props.net_push.Y += BOOM_CARRY_FACTOR * sy;
@@ -2426,13 +2364,13 @@ void P_UpdateSpecials(bool extra_tic)
             sec->props.push.Z   = sec->props.old_push.Z;
         }
 
-        sec->floor.offset.X = fmod(sec->floor.offset.X + (sec->floor.scroll.X + sec->floor.net_scroll.X) * factor,
+        sec->floor.offset.X = fmod(sec->floor.offset.X + (sec->floor.scroll.X + sec->floor.net_scroll.X),
                                    sec->floor.image->actual_w);
-        sec->floor.offset.Y = fmod(sec->floor.offset.Y + (sec->floor.scroll.Y + sec->floor.net_scroll.Y) * factor,
+        sec->floor.offset.Y = fmod(sec->floor.offset.Y + (sec->floor.scroll.Y + sec->floor.net_scroll.Y),
                                    sec->floor.image->actual_h);
-        sec->ceil.offset.X  = fmod(sec->ceil.offset.X + (sec->ceil.scroll.X + sec->ceil.net_scroll.X) * factor,
+        sec->ceil.offset.X  = fmod(sec->ceil.offset.X + (sec->ceil.scroll.X + sec->ceil.net_scroll.X),
                                    sec->ceil.image->actual_w);
-        sec->ceil.offset.Y  = fmod(sec->ceil.offset.Y + (sec->ceil.scroll.Y + sec->ceil.net_scroll.Y) * factor,
+        sec->ceil.offset.Y  = fmod(sec->ceil.offset.Y + (sec->ceil.scroll.Y + sec->ceil.net_scroll.Y),
                                    sec->ceil.image->actual_h);
         sec->props.push.X   = sec->props.push.X + sec->props.net_push.X;
         sec->props.push.Y   = sec->props.push.Y + sec->props.net_push.Y;
@@ -2444,8 +2382,7 @@ void P_UpdateSpecials(bool extra_tic)
     }
 
     // DO BUTTONS
-    if (!r_doubleframes.d || !extra_tic)
-        P_UpdateButtons();
+    P_UpdateButtons();
 }
 
 //
@@ -2630,7 +2567,7 @@ void P_SpawnSpecials2(int autotag)
 
             sector->props.push.X += epi::BAMCos(secSpecial->push_angle) * mul;
             sector->props.push.Y += epi::BAMSin(secSpecial->push_angle) * mul;
-            sector->props.push.Z += secSpecial->push_zspeed / (r_doubleframes.d ? 89.2f : 100.0f);
+            sector->props.push.Z += secSpecial->push_zspeed / 100.0f;
         }
 
         // Scrollers
@@ -165,7 +165,7 @@ void P_SpawnSpecials2(int autotag);
 void P_StopAmbientSectorSfx(void);
 
 // every tic
-void P_UpdateSpecials(bool extra_tic);
+void P_UpdateSpecials(void);
 
 // when needed
 bool P_UseSpecialLine(mobj_t *thing, line_t *line, int side, float open_bottom, float open_top);
@@ -183,9 +183,17 @@ sector_t *P_GetNextSector(const line_t *line, const sector_t *sec, bool ignore_s
 // Info Needs....
 float     P_FindSurroundingHeight(const heightref_e ref, const sector_t *sec);
 float     P_FindRaiseToTexture(sector_t *sec); // -KM- 1998/09/01 New func, old inline
-sector_t *P_FindSectorFromTag(int tag);
 int       P_FindMinSurroundingLight(sector_t *sector, int max);
 
+// Tag index (p_tags.cc)
+void      P_BuildTagIndex(void);
+void      P_ClearTagIndex(void);
+sector_t *P_FindSectorFromTag(int tag);
+line_t   *P_FindLineFromTag(int tag);
+mobj_t   *P_FindMobjFromTag(int tag);
+void      P_SetMobjTag(mobj_t *mo, int tag);
+void      P_RebuildMobjTagIndex(void);
+
 // start an action...
 bool EV_Lights(sector_t *sec, const lightdef_c *type);
 
@@ -217,7 +225,7 @@ bool EV_DoPlane(sector_t *sec, const movplanedef_c *type, sector_t *model);
 bool EV_DoSlider(line_t *door, line_t *act_line, mobj_t *thing, const linetype_c *special);
 bool P_SectorIsLowering(sector_t *sec);
 
-void P_RunForces(bool extra_tic);
+void P_RunForces(void);
 void P_DestroyAllForces(void);
 void P_AddPointForce(sector_t *sec, float length);
 void P_AddSectorForce(sector_t *sec, bool is_wind, float x_mag, float y_mag);
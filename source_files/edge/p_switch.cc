@@ -99,20 +99,24 @@ static void StartButton(switchdef_c *sw, line_t *line, bwhere_e w, const image_c
 
 void P_ChangeSwitchTexture(line_t *line, bool useAgain, line_special_e specials, bool noSound)
 {
-    for (int j = 0; j < numlines; j++)
+    // either just this line, or every line with the same tag (which
+    // includes this one).
+    bool    all_tagged = (line->tag != 0 && !(specials & LINSP_SwitchSeparate));
+    line_t *first      = all_tagged ? P_FindLineFromTag(line->tag) : line;
+
+    for (line_t *ld = first; ld; ld = all_tagged ? ld->tag_next : NULL)
     {
-        if (line != &lines[j])
+        if (line != ld)
         {
-            if (line->tag == 0 || line->tag != lines[j].tag || (specials & LINSP_SwitchSeparate) ||
-                (useAgain && line->special && line->special != lines[j].special))
+            if (useAgain && line->special && line->special != ld->special)
             {
                 continue;
             }
         }
 
-        side_t *side = lines[j].side[0];
+        side_t *side = ld->side[0];
 
-        position_c *sfx_origin = &lines[j].frontsector->sfx_origin;
+        position_c *sfx_origin = &ld->frontsector->sfx_origin;
 
         bwhere_e pos = BWH_None;
 
@@ -160,12 +164,12 @@ void P_ChangeSwitchTexture(line_t *line, bool useAgain, line_special_e specials,
                 }
 
                 if (useAgain)
-                    StartButton(sw, &lines[j], pos, OLD_SW);
+                    StartButton(sw, ld, pos, OLD_SW);
 
                 break;
             }
         } // it.IsValid() - switchdefs
-    }     // j < numlines
+    }     // ld
 }
 
 #undef CHECK_SW
@@ -0,0 +1,243 @@
+//----------------------------------------------------------------------------
+//  EDGE Tag Index
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Maps a tag number to the sectors, lines and things which use it.
+//  Each tag has the head of three intrusive lists: sectors and lines
+//  are chained via tag_next in index order (built once when the level
+//  is loaded, their tags never change), things are chained via
+//  tag_next/tag_prev in mobj list order and are kept up to date by
+//  P_SetMobjTag().
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+
+#include <unordered_map>
+
+#include "dm_defs.h"
+#include "dm_state.h"
+#include "p_local.h"
+#include "r_state.h"
+
+struct tag_list_t
+{
+    sector_t *sectors = nullptr;
+    line_t   *lines   = nullptr;
+    mobj_t   *things  = nullptr;
+};
+
+static std::unordered_map<int, tag_list_t> tag_index;
+
+static const tag_list_t *LookupTag(int tag)
+{
+    auto find = tag_index.find(tag);
+
+    if (find == tag_index.end())
+        return nullptr;
+
+    return &find->second;
+}
+
+//
+// P_BuildTagIndex
+//
+// Called once the sectors and linedefs of a level have been loaded.
+// The lists are built backwards so that each one ends up in ascending
+// index order, i.e. the order a linear scan would visit them.
+//
+void P_BuildTagIndex(void)
+{
+    tag_index.clear();
+
+    for (int i = numsectors - 1; i >= 0; i--)
+    {
+        sector_t   *sec = sectors + i;
+        tag_list_t &T   = tag_index[sec->tag];
+
+        sec->tag_prev = nullptr;
+        sec->tag_next = T.sectors;
+
+        if (T.sectors)
+            T.sectors->tag_prev = sec;
+
+        T.sectors = sec;
+    }
+
+    for (int i = numlines - 1; i >= 0; i--)
+    {
+        line_t     *ld = lines + i;
+        tag_list_t &T  = tag_index[ld->tag];
+
+        ld->tag_next = T.lines;
+        T.lines      = ld;
+    }
+}
+
+void P_ClearTagIndex(void)
+{
+    tag_index.clear();
+}
+
+//
+// Returns the FIRST sector that tag refers to, the rest can be
+// visited via sector->tag_next.
+//
+// -KM- 1998/09/27 Doesn't need a line.
+// -AJA- 1999/09/29: Now returns a sector_t, and has no start.
+//
+sector_t *P_FindSectorFromTag(int tag)
+{
+    const tag_list_t *T = LookupTag(tag);
+
+    return T ? T->sectors : nullptr;
+}
+
+//
+// Returns the FIRST line with the given tag, the rest can be
+// visited via line->tag_next.
+//
+line_t *P_FindLineFromTag(int tag)
+{
+    const tag_list_t *T = LookupTag(tag);
+
+    return T ? T->lines : nullptr;
+}
+
+//
+// Returns the first thing (in mobj list order) with the given tag,
+// the rest can be visited via mobj->tag_next in the same order.
+// Things with a zero tag are not indexed.
+//
+mobj_t *P_FindMobjFromTag(int tag)
+{
+    if (tag == 0)
+        return nullptr;
+
+    const tag_list_t *T = LookupTag(tag);
+
+    return T ? T->things : nullptr;
+}
+
+static void PushMobjTag(tag_list_t &T, mobj_t *mo)
+{
+    mo->tag_prev = nullptr;
+    mo->tag_next = T.things;
+
+    if (T.things)
+        T.things->tag_prev = mo;
+
+    T.things = mo;
+}
+
+//
+// Keeps each thing list in mobj list order, which is the order the old
+// scans of the whole mobj list visited them: the thing goes right after
+// the nearest thing before it in the mobj list with the same tag.  New
+// things are at the head of the mobj list, so this only has to walk
+// when an existing thing gets (re)tagged.
+//
+static void LinkMobjTag(mobj_t *mo)
+{
+    tag_list_t &T = tag_index[mo->tag];
+
+    mobj_t *other = mo->prev;
+
+    while (other && other->tag != mo->tag)
+        other = other->prev;
+
+    if (!other)
+    {
+        PushMobjTag(T, mo);
+        return;
+    }
+
+    mo->tag_prev = other;
+    mo->tag_next = other->tag_next;
+
+    if (other->tag_next)
+        other->tag_next->tag_prev = mo;
+
+    other->tag_next = mo;
+}
+
+static void UnlinkMobjTag(mobj_t *mo)
+{
+    if (mo->tag_next)
+        mo->tag_next->tag_prev = mo->tag_prev;
+
+    if (mo->tag_prev)
+        mo->tag_prev->tag_next = mo->tag_next;
+    else
+    {
+        auto find = tag_index.find(mo->tag);
+
+        if (find != tag_index.end() && find->second.things == mo)
+            find->second.things = mo->tag_next;
+    }
+
+    mo->tag_next = mo->tag_prev = nullptr;
+}
+
+//
+// P_SetMobjTag
+//
+// All changes to mobj_t::tag (apart from savegame loading) must go
+// through here, so the thing lists stay valid.
+//
+void P_SetMobjTag(mobj_t *mo, int tag)
+{
+    if (mo->tag == tag)
+        return;
+
+    if (mo->tag != 0)
+        UnlinkMobjTag(mo);
+
+    mo->tag = tag;
+
+    if (mo->tag != 0)
+        LinkMobjTag(mo);
+}
+
+//
+// P_RebuildMobjTagIndex
+//
+// Relinks every thing from scratch, used after the mobj list has been
+// replaced (loading a savegame, or removing everything).  Going from
+// the tail of the mobj list keeps each thing list in mobj list order.
+//
+void P_RebuildMobjTagIndex(void)
+{
+    for (auto &entry : tag_index)
+        entry.second.things = nullptr;
+
+    mobj_t *tail = mobjlisthead;
+
+    while (tail && tail->next)
+        tail = tail->next;
+
+    for (mobj_t *mo = tail; mo; mo = mo->prev)
+    {
+        mo->tag_next = mo->tag_prev = nullptr;
+
+        if (mo->tag != 0)
+            PushMobjTag(tag_index[mo->tag], mo);
+    }
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -38,12 +38,9 @@
 
 mobj_t *P_FindTeleportMan(int tag, const mobjtype_c *info)
 {
-    for (int i = 0; i < numsectors; i++)
+    for (sector_t *sec = P_FindSectorFromTag(tag); sec; sec = sec->tag_next)
     {
-        if (sectors[i].tag != tag)
-            continue;
-
-        for (subsector_t *sub = sectors[i].subsectors; sub; sub = sub->sec_next)
+        for (subsector_t *sub = sec->subsectors; sub; sub = sub->sec_next)
         {
             for (mobj_t *mo = sub->thinglist; mo; mo = mo->snext)
                 if (mo->info == info && !(mo->extendedflags & EF_NEVERTARGET))
@@ -56,15 +53,12 @@ mobj_t *P_FindTeleportMan(int tag, const mobjtype_c *info)
 
 line_t *P_FindTeleportLine(int tag, line_t *original)
 {
-    for (int i = 0; i < numlines; i++)
+    for (line_t *ld = P_FindLineFromTag(tag); ld; ld = ld->tag_next)
     {
-        if (lines[i].tag != tag)
-            continue;
-
-        if (lines + i == original)
+        if (ld == original)
             continue;
 
-        return lines + i;
+        return ld;
     }
 
     return NULL; // not found
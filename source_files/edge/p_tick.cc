@@ -33,13 +33,16 @@
 #include "p_tick.h"
 
 #include "dm_state.h"
+#include "g_demo.h"
 #include "g_game.h"
 #include "n_network.h"
 #include "p_local.h"
 #include "p_spec.h"
+#include "r_interp.h"
 #include "rad_trig.h"
 
 #include "AlmostEquals.h"
+#include "edge_profiling.h"
 
 int leveltime;
 
@@ -48,27 +51,34 @@ bool fast_forward_active;
 bool erraticism_active = false;
 
 extern cvar_c g_erraticism;
-extern cvar_c r_doubleframes;
 
 //
 // P_Ticker
 //
-void P_Ticker(bool extra_tic)
+void P_Ticker(void)
 {
+    EDGE_ZoneScoped;
+
     if (paused)
         return;
 
     // pause if in menu and at least one tic has been run
-    if (!netgame && (menuactive || rts_menuactive) && !AlmostEquals(players[consoleplayer]->viewz, FLO_UNUSED))
+    // (but not when playing a demo, which was recorded without them)
+    if (!netgame && ((menuactive && !demoplayback) || rts_menuactive) &&
+        !AlmostEquals(players[consoleplayer]->viewz, FLO_UNUSED))
     {
         return;
     }
 
+    G_DemoTiccmds();
+
+    R_SaveInterpolation();
+
     erraticism_active = false;
 
     if (g_erraticism.d)
     {
-        bool keep_thinking = P_PlayerThink(players[consoleplayer], extra_tic);
+        bool keep_thinking = P_PlayerThink(players[consoleplayer]);
 
         if (!keep_thinking)
         {
@@ -79,35 +89,29 @@ void P_Ticker(bool extra_tic)
         for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
         {
             if (players[pnum] && players[pnum] != players[consoleplayer])
-                P_PlayerThink(players[pnum], extra_tic);
+                P_PlayerThink(players[pnum]);
         }
     }
     else
     {
         for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
             if (players[pnum])
-                P_PlayerThink(players[pnum], extra_tic);
+                P_PlayerThink(players[pnum]);
     }
 
-    if (!extra_tic || !r_doubleframes.d)
-        RAD_RunTriggers();
+    RAD_RunTriggers();
 
-    P_RunForces(extra_tic);
-    P_RunMobjThinkers(extra_tic);
+    P_RunForces();
+    P_RunMobjThinkers();
 
-    if (!extra_tic || !r_doubleframes.d)
-        P_RunLights();
+    P_RunLights();
 
     P_RunActivePlanes();
     P_RunActiveSliders();
 
-    if (!extra_tic || !r_doubleframes.d)
-        P_RunAmbientSFX();
+    P_RunAmbientSFX();
 
-    P_UpdateSpecials(extra_tic);
-
-    if (extra_tic && r_doubleframes.d)
-        return;
+    P_UpdateSpecials();
 
     P_MobjItemRespawn();
 
@@ -132,7 +136,7 @@ void P_HubFastForward(void)
     }
 
     for (int k = 0; k < TICRATE / 3; k++)
-        P_Ticker(false);
+        P_Ticker();
 
     fast_forward_active = false;
 }
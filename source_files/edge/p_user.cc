@@ -48,12 +48,7 @@
 #include "coal.h" // for coal::vm_c
 #include "vm_coal.h"
 #include "script/compat/lua_compat.h"
-
-extern coal::vm_c *ui_vm;
-extern void        VM_SetVector(coal::vm_c *vm, const char *mod_name, const char *var_name, double val_1, double val_2,
-                                double val_3);
-
-extern cvar_c r_doubleframes;
+#include "edge_profiling.h"
 
 DEF_CVAR(g_erraticism, "0", CVAR_ARCHIVE)
 
@@ -109,7 +104,7 @@ static sfx_t *sfx_jprise;
 static sfx_t *sfx_jpdown;
 static sfx_t *sfx_jpflow;
 
-static void CalcHeight(player_t *player, bool extra_tic)
+static void CalcHeight(player_t *player)
 {
     bool      onground  = player->mo->z <= player->mo->floorz;
     float     sink_mult = 1.0f;
@@ -161,7 +156,7 @@ static void CalcHeight(player_t *player, bool extra_tic)
     // ----CALCULATE VIEWHEIGHT----
     if (player->playerstate == PST_LIVE)
     {
-        player->viewheight += player->deltaviewheight * (r_doubleframes.d ? 0.5 : 1);
+        player->viewheight += player->deltaviewheight;
 
         if (player->viewheight > player->std_viewheight)
         {
@@ -192,8 +187,7 @@ static void CalcHeight(player_t *player, bool extra_tic)
         {
             // use a weird number to minimise chance of hitting
             // zero when deltaviewheight goes neg -> positive.
-            if (!extra_tic || !r_doubleframes.d)
-                player->deltaviewheight += 0.24162f;
+            player->deltaviewheight += 0.24162f;
         }
     }
 
@@ -229,9 +223,6 @@ static void CalcHeight(player_t *player, bool extra_tic)
             bob_z *= (6 - player->jumpwait) / 6.0;
     }
 
-    if (r_doubleframes.d)
-        bob_z *= 0.5;
-
     if (g_bobbing.d > 1)
         bob_z = 0;
 
@@ -271,7 +262,7 @@ void P_PlayerJump(player_t *pl, float dz, int wait)
     }
 }
 
-static void MovePlayer(player_t *player, bool extra_tic)
+static void MovePlayer(player_t *player)
 {
     ticcmd_t *cmd;
     mobj_t   *mo = player->mo;
@@ -333,8 +324,8 @@ static void MovePlayer(player_t *player, bool extra_tic)
     // compute XY and Z speeds, taking swimming (etc) into account
     // (we try to swim in view direction -- assumes no gravity).
 
-    base_xy_speed = player->mo->speed / (r_doubleframes.d ? 64.0f : 32.0f);
-    base_z_speed  = player->mo->speed / (r_doubleframes.d ? 57.0f : 64.0f);
+    base_xy_speed = player->mo->speed / 32.0f;
+    base_z_speed  = player->mo->speed / 64.0f;
 
     // Do not let the player control movement if not onground.
     // -MH- 1998/06/18  unless he has the JetPack!
@@ -427,15 +418,11 @@ static void MovePlayer(player_t *player, bool extra_tic)
     // -ACB- 1998/08/09 Check that jumping is allowed in the currmap
     //                  Make player pause before jumping again
 
-    if (!extra_tic || !r_doubleframes.d)
+    if (level_flags.jump && mo->info->jumpheight > 0 && (cmd->upwardmove > 4))
     {
-        if (level_flags.jump && mo->info->jumpheight > 0 && (cmd->upwardmove > 4))
+        if (!jumping && !crouching && !swimming && !flying && onground && !onladder)
         {
-            if (!jumping && !crouching && !swimming && !flying && onground && !onladder)
-            {
-                P_PlayerJump(player, player->mo->info->jumpheight / (r_doubleframes.d ? 1.25f : 1.4f),
-                             player->mo->info->jump_delay);
-            }
+            P_PlayerJump(player, player->mo->info->jumpheight / 1.4f, player->mo->info->jump_delay);
         }
     }
 
@@ -447,7 +434,7 @@ static void MovePlayer(player_t *player, bool extra_tic)
     {
         if (mo->height > mo->info->crouchheight)
         {
-            mo->height = HMM_MAX(mo->height - 2.0f / (r_doubleframes.d ? 2.0 : 1.0), mo->info->crouchheight);
+            mo->height = HMM_MAX(mo->height - 2.0f, mo->info->crouchheight);
             mo->player->deltaviewheight = -1.0f;
         }
     }
@@ -455,7 +442,7 @@ static void MovePlayer(player_t *player, bool extra_tic)
     {
         if (mo->height < mo->info->height)
         {
-            float new_height = HMM_MIN(mo->height + 2 / (r_doubleframes.d ? 2 : 1), mo->info->height);
+            float new_height = HMM_MIN(mo->height + 2, mo->info->height);
 
             // prevent standing up inside a solid area
             if ((mo->flags & MF_NOCLIP) || mo->z + new_height <= mo->ceilingz)
@@ -485,13 +472,8 @@ static void MovePlayer(player_t *player, bool extra_tic)
     }
 }
 
-static void DeathThink(player_t *player, bool extra_tic)
+static void DeathThink(player_t *player)
 {
-    int subtract = extra_tic ? 0 : 1;
-
-    if (!r_doubleframes.d)
-        subtract = 1;
-
     // fall on your face when dying.
 
     float dx, dy, dz;
@@ -503,19 +485,18 @@ static void DeathThink(player_t *player, bool extra_tic)
     // -AJA- 1999/12/07: don't die mid-air.
     player->powers[PW_Jetpack] = 0;
 
-    if (!extra_tic)
-        P_MovePsprites(player);
+    P_MovePsprites(player);
 
     // fall to the ground
     if (player->viewheight > player->std_viewheight)
-        player->viewheight -= 1.0f / (r_doubleframes.d ? 2.0 : 1.0);
+        player->viewheight -= 1.0f;
     else if (player->viewheight < player->std_viewheight)
         player->viewheight = player->std_viewheight;
 
     player->deltaviewheight = 0.0f;
     player->kick_offset     = 0.0f;
 
-    CalcHeight(player, extra_tic);
+    CalcHeight(player);
 
     if (player->attacker && player->attacker != player->mo)
     {
@@ -538,32 +519,31 @@ static void DeathThink(player_t *player, bool extra_tic)
             player->mo->vertangle = epi::BAMFromATan(slope);
 
             if (player->damagecount > 0)
-                player->damagecount -= subtract;
+                player->damagecount--;
         }
         else
         {
-            unsigned int factor = r_doubleframes.d ? 2 : 1;
             if (delta < kBAMAngle180)
-                delta /= (5 * factor);
+                delta /= 5;
             else
-                delta = (BAMAngle)(0 - (BAMAngle)(0 - delta) / (5 * factor));
+                delta = (BAMAngle)(0 - (BAMAngle)(0 - delta) / 5);
 
-            if (delta > kBAMAngle5 / factor && delta < (BAMAngle)(0 - kBAMAngle5 / factor))
-                delta = (delta < kBAMAngle180) ? kBAMAngle5 / factor : (BAMAngle)(0 - kBAMAngle5 / factor);
+            if (delta > kBAMAngle5 && delta < (BAMAngle)(0 - kBAMAngle5))
+                delta = (delta < kBAMAngle180) ? kBAMAngle5 : (BAMAngle)(0 - kBAMAngle5);
 
             if (delta_s < kBAMAngle180)
-                delta_s /= (5 * factor);
+                delta_s /= 5;
             else
-                delta_s = (BAMAngle)(0 - (BAMAngle)(0 - delta_s) / (5 * factor));
+                delta_s = (BAMAngle)(0 - (BAMAngle)(0 - delta_s) / 5);
 
-            if (delta_s > (kBAMAngle5 / (factor * 2)) && delta_s < (BAMAngle)(0 - kBAMAngle5 / (factor * 2)))
-                delta_s = (delta_s < kBAMAngle180) ? (kBAMAngle5 / (factor * 2)) : (BAMAngle)(0 - kBAMAngle5 / (factor * 2));
+            if (delta_s > (kBAMAngle5 / 2) && delta_s < (BAMAngle)(0 - kBAMAngle5 / 2))
+                delta_s = (delta_s < kBAMAngle180) ? (kBAMAngle5 / 2) : (BAMAngle)(0 - kBAMAngle5 / 2);
 
             player->mo->angle += delta;
             player->mo->vertangle += delta_s;
 
             if (player->damagecount && (leveltime % 3) == 0)
-                player->damagecount -= subtract;
+                player->damagecount--;
         }
     }
     else if (player->damagecount > 0)
@@ -571,7 +551,7 @@ static void DeathThink(player_t *player, bool extra_tic)
 
     // -AJA- 1999/08/07: Fade out armor points too.
     if (player->bonuscount)
-        player->bonuscount -= subtract;
+        player->bonuscount--;
 
     P_UpdatePowerups(player);
 
@@ -712,8 +692,10 @@ void P_DumpMobjsTemp(void)
     I_Warning("END OF MOBJs\n");
 }
 
-bool P_PlayerThink(player_t *player, bool extra_tic)
+bool P_PlayerThink(player_t *player)
 {
+    EDGE_ZoneScoped;
+
     ticcmd_t *cmd = &player->cmd;
 
     SYS_ASSERT(player->mo);
@@ -755,20 +737,17 @@ bool P_PlayerThink(player_t *player, bool extra_tic)
         player->mo->flags &= ~MF_NOCLIP;
 
     // chain saw run forward
-    if (extra_tic || !r_doubleframes.d)
+    if (player->mo->flags & MF_JUSTATTACKED)
     {
-        if (player->mo->flags & MF_JUSTATTACKED)
-        {
-            cmd->angleturn   = 0;
-            cmd->forwardmove = 64;
-            cmd->sidemove    = 0;
-            player->mo->flags &= ~MF_JUSTATTACKED;
-        }
+        cmd->angleturn   = 0;
+        cmd->forwardmove = 64;
+        cmd->sidemove    = 0;
+        player->mo->flags &= ~MF_JUSTATTACKED;
     }
 
     if (player->playerstate == PST_DEAD)
     {
-        DeathThink(player, extra_tic);
+        DeathThink(player);
         if (player->mo->props->special && player->mo->props->special->e_exit != EXIT_None)
         {
             exittype_e do_exit = player->mo->props->special->e_exit;
@@ -783,20 +762,16 @@ bool P_PlayerThink(player_t *player, bool extra_tic)
         return true;
     }
 
-    int subtract = extra_tic ? 0 : 1;
-    if (!r_doubleframes.d)
-        subtract = 1;
-
     // Move/Look around.  Reactiontime is used to prevent movement for a
     // bit after a teleport.
 
     if (player->mo->reactiontime)
-        player->mo->reactiontime -= subtract;
+        player->mo->reactiontime--;
 
     if (player->mo->reactiontime == 0)
-        MovePlayer(player, extra_tic);
+        MovePlayer(player);
 
-    CalcHeight(player, extra_tic);
+    CalcHeight(player);
 
     if (g_erraticism.d)
     {
@@ -883,12 +858,8 @@ bool P_PlayerThink(player_t *player, bool extra_tic)
                        HMM_Vec3{{cmd->extbuttons & EBT_INVPREV ? 1.0f : 0.0f, cmd->extbuttons & EBT_INVUSE ? 1.0f : 0.0f,
                                    cmd->extbuttons & EBT_INVNEXT ? 1.0f : 0.0f}});
     else
-        VM_SetVector(ui_vm, "player", "inventory_event_handler", cmd->extbuttons & EBT_INVPREV ? 1 : 0,
-                     cmd->extbuttons & EBT_INVUSE ? 1 : 0, cmd->extbuttons & EBT_INVNEXT ? 1 : 0);
-
-    // FIXME separate code more cleanly
-    if (extra_tic && r_doubleframes.d)
-        return should_think;
+        VM_SetInventoryEvents(cmd->extbuttons & EBT_INVPREV, cmd->extbuttons & EBT_INVUSE,
+                              cmd->extbuttons & EBT_INVNEXT);
 
     // decrement jumpwait counter
     if (player->jumpwait > 0)
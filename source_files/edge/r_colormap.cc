@@ -640,6 +640,9 @@ class colormap_shader_c : public abstract_shader_c
 
     GLuint fade_tex;
 
+    // colour of each colourmap index, for the GLSL lighting program
+    GLuint whites_tex;
+
     bool             simple_cmap;
     lighting_model_e lt_model;
 
@@ -653,7 +656,7 @@ class colormap_shader_c : public abstract_shader_c
 
   public:
     colormap_shader_c(const colourmap_c *CM)
-        : colmap(CM), light_lev(255), fade_tex(0), simple_cmap(true), lt_model(LMODEL_Doom), fog_color(kRGBANoValue),
+        : colmap(CM), light_lev(255), fade_tex(0), whites_tex(0), simple_cmap(true), lt_model(LMODEL_Doom), fog_color(kRGBANoValue),
           fog_density(0), sec(nullptr)
     {
     }
@@ -743,9 +746,19 @@ class colormap_shader_c : public abstract_shader_c
             }
         }
 
-        local_gl_vert_t *glvert =
-            RGL_BeginUnit(shape, num_vert, GL_MODULATE, tex, (simple_cmap || r_dumbmulti.d) ? GL_MODULATE : GL_DECAL,
-                          fade_tex, *pass_var, blending, fc_to_use, fd_to_use);
+        // the lighting program works out the distance itself, it only
+        // needs the light level (and whether to use flat lighting).
+        bool glsl = RGL_GLSLLighting();
+
+        local_gl_vert_t *glvert;
+
+        if (glsl)
+            glvert = RGL_BeginUnit(shape, num_vert, GL_MODULATE, tex, ENV_COLORMAP, whites_tex, *pass_var, blending,
+                                   fc_to_use, fd_to_use);
+        else
+            glvert = RGL_BeginUnit(shape, num_vert, GL_MODULATE, tex,
+                                   (simple_cmap || r_dumbmulti.d) ? GL_MODULATE : GL_DECAL, fade_tex, *pass_var,
+                                   blending, fc_to_use, fd_to_use);
 
         for (int v_idx = 0; v_idx < num_vert; v_idx++)
         {
@@ -757,7 +770,13 @@ class colormap_shader_c : public abstract_shader_c
 
             (*func)(data, v_idx, &dest->pos, dest->rgba, &dest->texc[0], &dest->normal, &lit_pos);
 
-            TexCoord(dest, 1, &lit_pos);
+            if (glsl)
+            {
+                dest->texc[1].X = (lt_model >= LMODEL_Flat) ? 1.0f : 0.0f;
+                dest->texc[1].Y = (light_lev / 4 + 0.5f) / 64.0f;
+            }
+            else
+                TexCoord(dest, 1, &lit_pos);
         }
 
         RGL_EndUnit(num_vert);
@@ -874,6 +893,31 @@ class colormap_shader_c : public abstract_shader_c
         }
 
         fade_tex = R_UploadTexture(&img, UPL_Smooth | UPL_Clamp);
+
+        // the same colours by colourmap index
+        image_data_c whites_img(32, 1, 4);
+
+        for (int index = 0; index < 32; index++)
+        {
+            uint8_t *dest = whites_img.PixelAt(index, 0);
+
+            if (colmap)
+            {
+                dest[0] = epi::GetRGBARed(whites[index]);
+                dest[1] = epi::GetRGBAGreen(whites[index]);
+                dest[2] = epi::GetRGBABlue(whites[index]);
+            }
+            else
+            {
+                dest[0] = 255 - index * 8;
+                dest[1] = dest[0];
+                dest[2] = dest[0];
+            }
+
+            dest[3] = 255;
+        }
+
+        whites_tex = R_UploadTexture(&whites_img, UPL_Clamp);
     }
 
   public:
@@ -882,10 +926,7 @@ class colormap_shader_c : public abstract_shader_c
         if (fade_tex == 0 || (r_forceflatlighting.d && lt_model != LMODEL_Flat) ||
             (!r_forceflatlighting.d && lt_model != currmap->episode->lighting))
         {
-            if (fade_tex != 0)
-            {
-                glDeleteTextures(1, &fade_tex);
-            }
+            DeleteTex();
 
             if (r_forceflatlighting.d)
                 lt_model = LMODEL_Flat;
@@ -903,6 +944,12 @@ class colormap_shader_c : public abstract_shader_c
             glDeleteTextures(1, &fade_tex);
             fade_tex = 0;
         }
+
+        if (whites_tex != 0)
+        {
+            glDeleteTextures(1, &whites_tex);
+            whites_tex = 0;
+        }
     }
 
     void SetLight(int _level)
@@ -447,6 +447,9 @@ typedef struct line_s
 
     struct line_s *portal_pair;
 
+    // next line with the same tag (see P_FindLineFromTag)
+    struct line_s *tag_next;
+
     bool old_stored = false;
 } line_t;
 
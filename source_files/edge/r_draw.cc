@@ -20,6 +20,8 @@
 #include "i_defs_gl.h"
 
 #include "g_game.h"
+#include "hu_draw.h"
+#include "image_data.h"
 #include "r_misc.h"
 #include "r_gldefs.h"
 #include "r_units.h"
@@ -56,6 +58,8 @@ void RGL_DrawImage(float x, float y, float w, float h, const image_c *image, flo
     GLuint tex_id = W_ImageCache(image, true, (textmap && (textmap->special & COLSP_Whiten)) ? NULL : palremap,
                                  (textmap && (textmap->special & COLSP_Whiten)) ? true : false);
 
+    HUD_FlushBatch();
+
     glEnable(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, tex_id);
 
@@ -102,16 +106,173 @@ void RGL_DrawImage(float x, float y, float w, float h, const image_c *image, flo
 
 void RGL_ReadScreen(int x, int y, int w, int h, uint8_t *rgb_buffer)
 {
-    glFlush();
+    HUD_FlushBatch();
 
     glPixelZoom(1.0f, 1.0f);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    glReadPixels(x, y, w, h, GL_RGB, GL_UNSIGNED_BYTE, rgb_buffer);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
+
+//----------------------------------------------------------------------------
+//  ASYNCHRONOUS READS
+//----------------------------------------------------------------------------
+//
+// glReadPixels() into a pixel buffer object only starts the copy, so
+// the pixels are fetched from the buffer a frame later when the GPU
+// has finished with it (by then it usually has).  Two buffers are
+// used, so that a read can be started every frame.
+//
+
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+
+#define READ_SCREEN_BUFFERS 2
+
+typedef struct
+{
+    GLuint pbo;
+    int    size; // allocated bytes
+
+    // the read in progress, if any
+    bool              busy;
+    int               frame;
+    int               width, height;
+    readscreen_func_t func;
+    void             *priv;
+} read_screen_t;
+
+static read_screen_t read_screens[READ_SCREEN_BUFFERS];
+
+static int read_screen_frame = 0;
+
+static void FinishReadScreen(read_screen_t *R)
+{
+    image_data_c *img = new image_data_c(R->width, R->height, 3);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, R->pbo);
+
+    const uint8_t *src = (const uint8_t *)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+
+    if (src)
+    {
+        memcpy(img->PixelAt(0, 0), src, R->width * R->height * 3);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    else
+        img->Clear();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    R->busy = false;
+
+    R->func(img, R->priv);
+}
+
+void RGL_QueueReadScreen(readscreen_func_t func, void *priv)
+{
+    if (!glcap_pixel_buffers)
+    {
+        image_data_c *img = new image_data_c(SCREENWIDTH, SCREENHEIGHT, 3);
+
+        RGL_ReadScreen(0, 0, SCREENWIDTH, SCREENHEIGHT, img->PixelAt(0, 0));
+
+        func(img, priv);
+        return;
+    }
+
+    // use a free buffer, or else finish the oldest read
+    read_screen_t *R = NULL;
+
+    for (int i = 0; i < READ_SCREEN_BUFFERS; i++)
+    {
+        read_screen_t *cur = &read_screens[i];
+
+        if (!cur->busy)
+        {
+            R = cur;
+            break;
+        }
+
+        if (!R || cur->frame < R->frame)
+            R = cur;
+    }
+
+    if (R->busy)
+        FinishReadScreen(R);
+
+    int size = SCREENWIDTH * SCREENHEIGHT * 3;
+
+    if (R->pbo == 0)
+        glGenBuffers(1, &R->pbo);
+
+    HUD_FlushBatch();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, R->pbo);
+
+    if (R->size != size)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        R->size = size;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    glReadPixels(0, 0, SCREENWIDTH, SCREENHEIGHT, GL_RGB, GL_UNSIGNED_BYTE, BUFFER_OFFSET(0));
 
-    for (; h > 0; h--, y++)
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    R->busy   = true;
+    R->frame  = read_screen_frame;
+    R->width  = SCREENWIDTH;
+    R->height = SCREENHEIGHT;
+    R->func   = func;
+    R->priv   = priv;
+}
+
+void RGL_UpdateReadScreens(bool wait_all)
+{
+    // finish them in the order they were started
+    for (;;)
     {
-        glReadPixels(x, y, w, 1, GL_RGB, GL_UNSIGNED_BYTE, rgb_buffer);
+        read_screen_t *R = NULL;
+
+        for (int i = 0; i < READ_SCREEN_BUFFERS; i++)
+        {
+            read_screen_t *cur = &read_screens[i];
+
+            if (cur->busy && (wait_all || cur->frame < read_screen_frame))
+                if (!R || cur->frame < R->frame)
+                    R = cur;
+        }
+
+        if (!R)
+            break;
+
+        FinishReadScreen(R);
+    }
+
+    read_screen_frame++;
+}
+
+void RGL_FreeReadScreens(void)
+{
+    RGL_UpdateReadScreens(true);
+
+    for (int i = 0; i < READ_SCREEN_BUFFERS; i++)
+    {
+        read_screen_t *R = &read_screens[i];
+
+        if (R->pbo != 0)
+            glDeleteBuffers(1, &R->pbo);
 
-        rgb_buffer += w * 3;
+        R->pbo  = 0;
+        R->size = 0;
     }
 }
 
@@ -29,12 +29,31 @@
 #include "main.h"
 #include "r_image.h"
 
+class image_data_c;
+
 // Move to somewhere appropriate later -ACB- 2004/08/19
 void RGL_DrawImage(float x, float y, float w, float h, const image_c *image, float tx1, float ty1, float tx2, float ty2,
                    const colourmap_c *textmap = NULL, float alpha = 1.0f, const colourmap_c *palremap = NULL);
 
 void RGL_ReadScreen(int x, int y, int w, int h, uint8_t *rgb_buffer);
 
+// called with the image read by RGL_QueueReadScreen(), which is RGB and
+// bottom-up like RGL_ReadScreen().  The function must delete the image.
+typedef void (*readscreen_func_t)(image_data_c *img, void *priv);
+
+// reads the whole screen without waiting for the GPU when pixel buffer
+// objects are supported, in which case the function is called by
+// RGL_UpdateReadScreens() during a later frame.  Otherwise the screen
+// is read (and the function called) straight away.
+void RGL_QueueReadScreen(readscreen_func_t func, void *priv);
+
+// calls the functions of reads started in earlier frames, or of all
+// of them when `wait_all' is true.  Called once per frame.
+void RGL_UpdateReadScreens(bool wait_all);
+
+// finishes any reads and frees the pixel buffers
+void RGL_FreeReadScreens(void);
+
 // This routine should inform the lower level system(s) that the
 // screen has changed size/depth.  New size/depth is given.  Must be
 // called before any rendering has occurred (e.g. just before
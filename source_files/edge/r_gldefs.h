@@ -53,6 +53,12 @@ extern int glmax_clip_planes;
 extern int glmax_tex_size;
 extern int glmax_tex_units;
 
+// pixel buffer objects (GL 2.1 or ARB_pixel_buffer_object) can be used
+extern bool glcap_pixel_buffers;
+
+// GLSL programs (GL 2.0) can be used
+extern bool glcap_glsl;
+
 void RGL_Init(void);
 void RGL_SoftInit(void);
 void RGL_SetupMatrices2D(void);
@@ -78,6 +84,31 @@ extern const colourmap_c *ren_fx_colmap;
 extern cvar_c r_nearclip;
 extern cvar_c r_farclip;
 
+//
+//  RGL_GLSL
+//
+
+typedef enum
+{
+    GLSL_FOG_None = 0,
+    GLSL_FOG_Exp,    // like GL_EXP
+    GLSL_FOG_Linear, // like GL_LINEAR
+} glsl_fog_mode_e;
+
+void RGL_InitGLSL(void);
+
+// should colourmap units use ENV_COLORMAP (the lighting program)
+// instead of the fixed function fade texture?
+bool RGL_GLSLLighting(void);
+
+// select the lighting program for the following units, with the fog
+// to apply (density already converted as for glFogf).
+void RGL_UseLightingProgram(int fog_mode, const sg_color &fog_color, float fog_density, float fog_start,
+                            float fog_end);
+
+// back to the fixed function pipeline.
+void RGL_StopLightingProgram(void);
+
 #define APPROX_DIST2(dx, dy) ((dx) + (dy)-0.5f * HMM_MIN((dx), (dy)))
 
 #define APPROX_DIST3(dx, dy, dz) APPROX_DIST2(APPROX_DIST2(dx, dy), dz)
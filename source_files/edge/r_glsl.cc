@@ -0,0 +1,376 @@
+//----------------------------------------------------------------------------
+//  EDGE OpenGL Rendering (GLSL Lighting)
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  On GL 2.0 and later, the sector lighting of walls and planes is done
+//  by a small GLSL program instead of the fixed function pipeline.  The
+//  fixed function path looks up the light in a "fade" texture made for
+//  each colourmap, indexed by the light level and the distance (given
+//  per vertex), then applies GL fog.  The program evaluates the DOOM
+//  lighting equation (R_DoomLightingEquation) for every pixel, takes the
+//  colour of the resulting colourmap index from a 32x1 texture, and
+//  applies the fog itself, all in one go.
+//
+//  Colourmap units using it have ENV_COLORMAP as their second texture
+//  environment, the light level in the T coordinate of the second
+//  texture and a flat lighting flag in S (see colormap_shader_c).
+//
+//  Only the GL 2.0 functions needed are loaded here, since the GL
+//  loader only knows GL 1.5.  The fixed function path stays for older
+//  GL versions, GLES, or when r_glsl is 0.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+#include "i_defs_gl.h"
+#include "epi_sdl.h"
+
+#include "r_gldefs.h"
+#include "r_units.h"
+
+DEF_CVAR(r_glsl, "1", CVAR_ARCHIVE)
+
+#ifndef GLAD_API_PTR
+#define GLAD_API_PTR APIENTRY
+#endif
+
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+
+typedef GLuint(GLAD_API_PTR *glsl_CreateShader_f)(GLenum type);
+typedef void(GLAD_API_PTR *glsl_ShaderSource_f)(GLuint shader, GLsizei count, const GLchar *const *string,
+                                                const GLint *length);
+typedef void(GLAD_API_PTR *glsl_CompileShader_f)(GLuint shader);
+typedef void(GLAD_API_PTR *glsl_GetShaderiv_f)(GLuint shader, GLenum pname, GLint *params);
+typedef void(GLAD_API_PTR *glsl_GetShaderInfoLog_f)(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog);
+typedef void(GLAD_API_PTR *glsl_DeleteShader_f)(GLuint shader);
+typedef GLuint(GLAD_API_PTR *glsl_CreateProgram_f)(void);
+typedef void(GLAD_API_PTR *glsl_AttachShader_f)(GLuint program, GLuint shader);
+typedef void(GLAD_API_PTR *glsl_LinkProgram_f)(GLuint program);
+typedef void(GLAD_API_PTR *glsl_GetProgramiv_f)(GLuint program, GLenum pname, GLint *params);
+typedef void(GLAD_API_PTR *glsl_GetProgramInfoLog_f)(GLuint program, GLsizei bufSize, GLsizei *length,
+                                                     GLchar *infoLog);
+typedef void(GLAD_API_PTR *glsl_DeleteProgram_f)(GLuint program);
+typedef void(GLAD_API_PTR *glsl_UseProgram_f)(GLuint program);
+typedef GLint(GLAD_API_PTR *glsl_GetUniformLocation_f)(GLuint program, const GLchar *name);
+typedef void(GLAD_API_PTR *glsl_Uniform1i_f)(GLint location, GLint v0);
+typedef void(GLAD_API_PTR *glsl_Uniform1f_f)(GLint location, GLfloat v0);
+typedef void(GLAD_API_PTR *glsl_Uniform2f_f)(GLint location, GLfloat v0, GLfloat v1);
+typedef void(GLAD_API_PTR *glsl_Uniform3f_f)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+
+static glsl_CreateShader_f       glsl_CreateShader;
+static glsl_ShaderSource_f       glsl_ShaderSource;
+static glsl_CompileShader_f      glsl_CompileShader;
+static glsl_GetShaderiv_f        glsl_GetShaderiv;
+static glsl_GetShaderInfoLog_f   glsl_GetShaderInfoLog;
+static glsl_DeleteShader_f       glsl_DeleteShader;
+static glsl_CreateProgram_f      glsl_CreateProgram;
+static glsl_AttachShader_f       glsl_AttachShader;
+static glsl_LinkProgram_f        glsl_LinkProgram;
+static glsl_GetProgramiv_f       glsl_GetProgramiv;
+static glsl_GetProgramInfoLog_f  glsl_GetProgramInfoLog;
+static glsl_DeleteProgram_f      glsl_DeleteProgram;
+static glsl_UseProgram_f         glsl_UseProgram;
+static glsl_GetUniformLocation_f glsl_GetUniformLocation;
+static glsl_Uniform1i_f          glsl_Uniform1i;
+static glsl_Uniform1f_f          glsl_Uniform1f;
+static glsl_Uniform2f_f          glsl_Uniform2f;
+static glsl_Uniform3f_f          glsl_Uniform3f;
+
+static const char *lighting_vertex_src = "#version 110\n"
+                                         "\n"
+                                         "varying float view_dist;\n"
+                                         "\n"
+                                         "void main()\n"
+                                         "{\n"
+                                         "    vec4 eye = gl_ModelViewMatrix * gl_Vertex;\n"
+                                         "\n"
+                                         "    view_dist = -eye.z;\n"
+                                         "\n"
+                                         "    gl_Position    = ftransform();\n"
+                                         "    gl_ClipVertex  = eye;\n"
+                                         "    gl_FrontColor  = gl_Color;\n"
+                                         "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+                                         "    gl_TexCoord[1] = gl_MultiTexCoord1;\n"
+                                         "}\n";
+
+static const char *lighting_fragment_src =
+    "#version 110\n"
+    "\n"
+    "uniform sampler2D tex_image;\n"
+    "uniform sampler2D tex_whites;\n"
+    "\n"
+    "uniform int   fog_mode;\n"
+    "uniform vec3  fog_color;\n"
+    "uniform float fog_density;\n"
+    "uniform vec2  fog_range;\n"
+    "\n"
+    "varying float view_dist;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 col = texture2D(tex_image, gl_TexCoord[0].st) * gl_Color;\n"
+    "\n"
+    "    float L = floor(gl_TexCoord[1].t * 64.0);\n"
+    "    float index;\n"
+    "\n"
+    "    if (gl_TexCoord[1].s > 0.5)\n"
+    "    {\n"
+    "        index = clamp(42.0 - floor(L * 2.0 / 3.0), 0.0, 31.0);\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "        float min_L = clamp(36.0 - L, 0.0, 31.0);\n"
+    "\n"
+    "        index = clamp((59.0 - L) - floor(1280.0 / max(1.0, view_dist)), min_L, 31.0);\n"
+    "    }\n"
+    "\n"
+    "    col.rgb *= texture2D(tex_whites, vec2((index + 0.5) / 32.0, 0.5)).rgb;\n"
+    "\n"
+    "    if (fog_mode == 1)\n"
+    "        col.rgb = mix(fog_color, col.rgb, clamp(exp(-fog_density * view_dist), 0.0, 1.0));\n"
+    "    else if (fog_mode == 2)\n"
+    "        col.rgb = mix(fog_color, col.rgb, clamp((fog_range.y - view_dist) / (fog_range.y - fog_range.x), 0.0, "
+    "1.0));\n"
+    "\n"
+    "    gl_FragColor = col;\n"
+    "}\n";
+
+static GLuint lighting_prog = 0;
+
+static GLint loc_fog_mode;
+static GLint loc_fog_color;
+static GLint loc_fog_density;
+static GLint loc_fog_range;
+
+// current state, to skip needless changes
+static bool     prog_active = false;
+static int      cur_fog_mode;
+static sg_color cur_fog_color;
+static float    cur_fog_density;
+static float    cur_fog_start;
+static float    cur_fog_end;
+
+static bool LoadFunctions(void)
+{
+    bool ok = true;
+
+#define LOAD_GL_FUNC(var, name)                                                                                        \
+    var = (decltype(var))SDL_GL_GetProcAddress(name);                                                                  \
+    if (!var)                                                                                                          \
+        ok = false;
+
+    LOAD_GL_FUNC(glsl_CreateShader, "glCreateShader");
+    LOAD_GL_FUNC(glsl_ShaderSource, "glShaderSource");
+    LOAD_GL_FUNC(glsl_CompileShader, "glCompileShader");
+    LOAD_GL_FUNC(glsl_GetShaderiv, "glGetShaderiv");
+    LOAD_GL_FUNC(glsl_GetShaderInfoLog, "glGetShaderInfoLog");
+    LOAD_GL_FUNC(glsl_DeleteShader, "glDeleteShader");
+    LOAD_GL_FUNC(glsl_CreateProgram, "glCreateProgram");
+    LOAD_GL_FUNC(glsl_AttachShader, "glAttachShader");
+    LOAD_GL_FUNC(glsl_LinkProgram, "glLinkProgram");
+    LOAD_GL_FUNC(glsl_GetProgramiv, "glGetProgramiv");
+    LOAD_GL_FUNC(glsl_GetProgramInfoLog, "glGetProgramInfoLog");
+    LOAD_GL_FUNC(glsl_DeleteProgram, "glDeleteProgram");
+    LOAD_GL_FUNC(glsl_UseProgram, "glUseProgram");
+    LOAD_GL_FUNC(glsl_GetUniformLocation, "glGetUniformLocation");
+    LOAD_GL_FUNC(glsl_Uniform1i, "glUniform1i");
+    LOAD_GL_FUNC(glsl_Uniform1f, "glUniform1f");
+    LOAD_GL_FUNC(glsl_Uniform2f, "glUniform2f");
+    LOAD_GL_FUNC(glsl_Uniform3f, "glUniform3f");
+
+#undef LOAD_GL_FUNC
+
+    return ok;
+}
+
+static GLuint CompileShader(GLenum type, const char *src)
+{
+    GLuint shader = glsl_CreateShader(type);
+
+    glsl_ShaderSource(shader, 1, &src, NULL);
+    glsl_CompileShader(shader);
+
+    GLint status = 0;
+    glsl_GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+    if (!status)
+    {
+        char log[1024];
+
+        log[0] = 0;
+        glsl_GetShaderInfoLog(shader, sizeof(log), NULL, log);
+
+        I_Warning("OpenGL: failed to compile %s shader:\n%s\n", (type == GL_VERTEX_SHADER) ? "vertex" : "fragment",
+                  log);
+
+        glsl_DeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+static GLuint LinkProgram(GLuint vert, GLuint frag)
+{
+    GLuint prog = glsl_CreateProgram();
+
+    glsl_AttachShader(prog, vert);
+    glsl_AttachShader(prog, frag);
+    glsl_LinkProgram(prog);
+
+    // they are kept until the program is deleted
+    glsl_DeleteShader(vert);
+    glsl_DeleteShader(frag);
+
+    GLint status = 0;
+    glsl_GetProgramiv(prog, GL_LINK_STATUS, &status);
+
+    if (!status)
+    {
+        char log[1024];
+
+        log[0] = 0;
+        glsl_GetProgramInfoLog(prog, sizeof(log), NULL, log);
+
+        I_Warning("OpenGL: failed to link lighting program:\n%s\n", log);
+
+        glsl_DeleteProgram(prog);
+        return 0;
+    }
+
+    return prog;
+}
+
+void RGL_InitGLSL(void)
+{
+    if (!glcap_glsl)
+        return;
+
+    if (!LoadFunctions())
+    {
+        I_Warning("OpenGL: GLSL functions are missing, using fixed function lighting.\n");
+        return;
+    }
+
+    GLuint vert = CompileShader(GL_VERTEX_SHADER, lighting_vertex_src);
+    GLuint frag = CompileShader(GL_FRAGMENT_SHADER, lighting_fragment_src);
+
+    if (vert == 0 || frag == 0)
+    {
+        if (vert)
+            glsl_DeleteShader(vert);
+        if (frag)
+            glsl_DeleteShader(frag);
+
+        return;
+    }
+
+    lighting_prog = LinkProgram(vert, frag);
+
+    if (lighting_prog == 0)
+        return;
+
+    loc_fog_mode    = glsl_GetUniformLocation(lighting_prog, "fog_mode");
+    loc_fog_color   = glsl_GetUniformLocation(lighting_prog, "fog_color");
+    loc_fog_density = glsl_GetUniformLocation(lighting_prog, "fog_density");
+    loc_fog_range   = glsl_GetUniformLocation(lighting_prog, "fog_range");
+
+    // the textures are always on the same units
+    glsl_UseProgram(lighting_prog);
+
+    glsl_Uniform1i(glsl_GetUniformLocation(lighting_prog, "tex_image"), 0);
+    glsl_Uniform1i(glsl_GetUniformLocation(lighting_prog, "tex_whites"), 1);
+    glsl_Uniform1i(loc_fog_mode, GLSL_FOG_None);
+
+    glsl_UseProgram(0);
+
+    cur_fog_mode = GLSL_FOG_None;
+
+    I_Printf("OpenGL: Using GLSL lighting\n");
+}
+
+bool RGL_GLSLLighting(void)
+{
+    if (lighting_prog == 0 || r_glsl.d == 0)
+        return false;
+
+    // the program takes the vertex colour from glColor
+    return r_colormaterial.d || !r_colorlighting.d;
+}
+
+void RGL_UseLightingProgram(int fog_mode, const sg_color &fog_color, float fog_density, float fog_start,
+                            float fog_end)
+{
+    SYS_ASSERT(lighting_prog);
+
+    if (!prog_active)
+    {
+        glsl_UseProgram(lighting_prog);
+        prog_active = true;
+    }
+
+    if (fog_mode != cur_fog_mode)
+    {
+        glsl_Uniform1i(loc_fog_mode, fog_mode);
+        cur_fog_mode = fog_mode;
+    }
+
+    if (fog_mode == GLSL_FOG_None)
+        return;
+
+    if (fog_color.r != cur_fog_color.r || fog_color.g != cur_fog_color.g || fog_color.b != cur_fog_color.b)
+    {
+        glsl_Uniform3f(loc_fog_color, fog_color.r, fog_color.g, fog_color.b);
+        cur_fog_color = fog_color;
+    }
+
+    if (fog_mode == GLSL_FOG_Exp && fog_density != cur_fog_density)
+    {
+        glsl_Uniform1f(loc_fog_density, fog_density);
+        cur_fog_density = fog_density;
+    }
+
+    if (fog_mode == GLSL_FOG_Linear && (fog_start != cur_fog_start || fog_end != cur_fog_end))
+    {
+        glsl_Uniform2f(loc_fog_range, fog_start, fog_end);
+        cur_fog_start = fog_start;
+        cur_fog_end   = fog_end;
+    }
+}
+
+void RGL_StopLightingProgram(void)
+{
+    if (prog_active)
+    {
+        glsl_UseProgram(0);
+        prog_active = false;
+    }
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
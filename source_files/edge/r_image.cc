@@ -77,8 +77,6 @@ extern image_data_c *ReadAsEpiBlock(image_c *rim);
 
 extern epi::File *OpenUserFileOrLump(imagedef_c *def);
 
-extern cvar_c r_doubleframes;
-
 extern void DeleteSkyTextures(void);
 extern void DeleteColourmapTextures(void);
 
@@ -153,7 +151,7 @@ static void do_Animate(real_image_container_c &bucket)
 
         SYS_ASSERT(rim->anim.count > 0);
 
-        rim->anim.count -= (!r_doubleframes.d || !(hudtic & 1)) ? 1 : 0;
+        rim->anim.count--;
 
         if (rim->anim.count == 0 && rim->anim.cur->anim.next)
         {
@@ -1333,7 +1331,7 @@ static GLuint LoadImageOGL(image_c *rim, const colourmap_c *trans, bool do_white
 
     if (rim->liquid_type > LIQ_None && (swirling_flats == SWIRL_SMMU || swirling_flats == SWIRL_SMMUSWIRL))
     {
-        rim->swirled_gametic = hudtic / (r_doubleframes.d ? 2 : 1);
+        rim->swirled_gametic = hudtic;
         tmp_img->Swirl(rim->swirled_gametic,
                        rim->liquid_type); // Using leveltime disabled swirl for intermission screens
     }
@@ -1878,7 +1876,7 @@ static cached_image_t *ImageCacheOGL(image_c *rim, const colourmap_c *trans, boo
 
     if (rim->liquid_type > LIQ_None && (swirling_flats == SWIRL_SMMU || swirling_flats == SWIRL_SMMUSWIRL))
     {
-        if (!erraticism_active && !time_stop_active && rim->swirled_gametic != hudtic / (r_doubleframes.d ? 2 : 1))
+        if (!erraticism_active && !time_stop_active && rim->swirled_gametic != hudtic)
         {
             if (rc->tex_id != 0)
             {
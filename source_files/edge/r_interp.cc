@@ -0,0 +1,365 @@
+//----------------------------------------------------------------------------
+//  EDGE Frame Interpolation
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  The game always runs at 35 tics per second.  When frames are drawn
+//  in between tics (r_doubleframes), the renderer sees everything
+//  which moves part way between where it was at the start of the last
+//  tic and where it is now.
+//
+//  Rather than teach each part of the renderer about this, the live
+//  fields (thing positions, plane heights, scrolling offsets, view
+//  height and weapon sprites) are swapped with the in-between values
+//  for the duration of R_Render() and then put back.
+//
+//  Extrafloors and sliding doors are not interpolated.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+
+#include <list>
+#include <vector>
+
+#include "AlmostEquals.h"
+#include "dm_defs.h"
+#include "dm_state.h"
+#include "e_player.h"
+#include "p_local.h"
+#include "r_image.h"
+#include "r_interp.h"
+#include "r_state.h"
+
+extern cvar_c r_doubleframes;
+
+extern std::list<line_t *>   active_line_anims;
+extern std::list<sector_t *> active_sector_anims;
+
+// things which move further than this in one tic (apart from being
+// teleported, which is handled separately) are not interpolated.
+#define INTERP_MAX_MOVE 128.0f
+
+float fractional_tic = 1.0f;
+
+static bool interp_valid = false;
+static int  interp_time  = 0; // I_GetTime() when the state was saved
+
+typedef struct
+{
+    float viewz;
+    float psp_sx[NUMPSPRITES];
+    float psp_sy[NUMPSPRITES];
+} interp_player_t;
+
+static interp_player_t interp_players[MAXPLAYERS];
+
+// plane heights, indexed by sector number
+static std::vector<float> interp_floor_h;
+static std::vector<float> interp_ceil_h;
+
+typedef struct
+{
+    surface_t *surf;
+    HMM_Vec2   offset;
+} interp_surface_t;
+
+static std::vector<interp_surface_t> interp_surfaces;
+
+// the real values while R_Render() is running
+typedef struct
+{
+    mobj_t  *mo;
+    float    x, y, z;
+    BAMAngle angle;
+    BAMAngle vertangle;
+} live_mobj_t;
+
+typedef struct
+{
+    sector_t *sec;
+    float     f_h, c_h;
+} live_sector_t;
+
+static std::vector<live_mobj_t>      live_mobjs;
+static std::vector<live_sector_t>    live_sectors;
+static std::vector<interp_surface_t> live_surfaces;
+static interp_player_t               live_players[MAXPLAYERS];
+
+static bool interp_active = false;
+
+static inline float LerpFloat(float from, float to)
+{
+    return from + (to - from) * fractional_tic;
+}
+
+static inline BAMAngle LerpAngle(BAMAngle from, BAMAngle to)
+{
+    return from + (BAMAngle)((float)(int32_t)(to - from) * fractional_tic);
+}
+
+// scrolling offsets wrap around at the image size
+static float LerpOffset(float from, float to, float size)
+{
+    float delta = to - from;
+
+    if (size > 0)
+    {
+        if (delta > size / 2)
+            delta -= size;
+        else if (delta < -size / 2)
+            delta += size;
+    }
+
+    return from + delta * fractional_tic;
+}
+
+static void SaveSurface(surface_t *surf)
+{
+    if (surf->image)
+        interp_surfaces.push_back({surf, surf->offset});
+}
+
+void R_SaveInterpolation(void)
+{
+    for (mobj_t *mo = mobjlisthead; mo; mo = mo->next)
+    {
+        mo->interp_from      = {{mo->x, mo->y, mo->z}};
+        mo->interp_angle     = mo->angle;
+        mo->interp_vertangle = mo->vertangle;
+        mo->interp_skip      = false;
+    }
+
+    interp_floor_h.resize(numsectors);
+    interp_ceil_h.resize(numsectors);
+
+    for (int i = 0; i < numsectors; i++)
+    {
+        interp_floor_h[i] = sectors[i].f_h;
+        interp_ceil_h[i]  = sectors[i].c_h;
+    }
+
+    interp_surfaces.clear();
+
+    for (line_t *ld : active_line_anims)
+    {
+        for (int s = 0; s < 2; s++)
+        {
+            if (!ld->side[s])
+                continue;
+
+            SaveSurface(&ld->side[s]->top);
+            SaveSurface(&ld->side[s]->middle);
+            SaveSurface(&ld->side[s]->bottom);
+        }
+    }
+
+    for (sector_t *sec : active_sector_anims)
+    {
+        SaveSurface(&sec->floor);
+        SaveSurface(&sec->ceil);
+    }
+
+    for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
+    {
+        player_t *p = players[pnum];
+        if (!p)
+            continue;
+
+        interp_players[pnum].viewz = p->viewz;
+
+        for (int k = 0; k < NUMPSPRITES; k++)
+        {
+            interp_players[pnum].psp_sx[k] = p->psprites[k].sx;
+            interp_players[pnum].psp_sy[k] = p->psprites[k].sy;
+        }
+    }
+
+    interp_valid = true;
+    interp_time  = I_GetTime();
+}
+
+void R_ClearInterpolation(void)
+{
+    interp_valid = false;
+
+    interp_floor_h.clear();
+    interp_ceil_h.clear();
+    interp_surfaces.clear();
+
+    fractional_tic = 1.0f;
+}
+
+void R_UpdateFractionalTic(void)
+{
+    fractional_tic = 1.0f;
+
+    if (!interp_valid || r_doubleframes.d == 0 || singletics || paused)
+        return;
+
+    // read the fraction first: if the tic count goes up in between, the
+    // result is too large (and gets clamped) rather than going backwards.
+    float frac = I_GetTimeFrac();
+
+    float elapsed = (float)(I_GetTime() - interp_time) + frac;
+
+    // no tic since the last one we saved, i.e. the game is waiting
+    fractional_tic = HMM_Clamp(0.0f, elapsed, 1.0f);
+}
+
+void R_BeginInterpolation(void)
+{
+    if (interp_active || fractional_tic >= 1.0f || !interp_valid)
+        return;
+
+    interp_active = true;
+
+    live_mobjs.clear();
+
+    for (mobj_t *mo = mobjlisthead; mo; mo = mo->next)
+    {
+        if (mo->interp_skip || mo->isRemoved())
+            continue;
+
+        float dx = mo->x - mo->interp_from.X;
+        float dy = mo->y - mo->interp_from.Y;
+        float dz = mo->z - mo->interp_from.Z;
+
+        if (AlmostEquals(dx, 0.0f) && AlmostEquals(dy, 0.0f) && AlmostEquals(dz, 0.0f) &&
+            mo->angle == mo->interp_angle && mo->vertangle == mo->interp_vertangle)
+            continue;
+
+        if (fabs(dx) + fabs(dy) + fabs(dz) > INTERP_MAX_MOVE)
+            continue;
+
+        live_mobjs.push_back({mo, mo->x, mo->y, mo->z, mo->angle, mo->vertangle});
+
+        mo->x         = LerpFloat(mo->interp_from.X, mo->x);
+        mo->y         = LerpFloat(mo->interp_from.Y, mo->y);
+        mo->z         = LerpFloat(mo->interp_from.Z, mo->z);
+        mo->angle     = LerpAngle(mo->interp_angle, mo->angle);
+        mo->vertangle = LerpAngle(mo->interp_vertangle, mo->vertangle);
+    }
+
+    live_sectors.clear();
+
+    if ((int)interp_floor_h.size() == numsectors)
+    {
+        for (int i = 0; i < numsectors; i++)
+        {
+            sector_t *sec = sectors + i;
+
+            if (AlmostEquals(sec->f_h, interp_floor_h[i]) && AlmostEquals(sec->c_h, interp_ceil_h[i]))
+                continue;
+
+            // sloped planes are built from vertex heights
+            if (sec->floor_vertex_slope || sec->ceil_vertex_slope)
+                continue;
+
+            live_sectors.push_back({sec, sec->f_h, sec->c_h});
+
+            sec->f_h = LerpFloat(interp_floor_h[i], sec->f_h);
+            sec->c_h = LerpFloat(interp_ceil_h[i], sec->c_h);
+
+            R_DirtySectorGeometry(sec);
+        }
+    }
+
+    live_surfaces.clear();
+
+    for (const interp_surface_t &old : interp_surfaces)
+    {
+        surface_t *surf = old.surf;
+
+        live_surfaces.push_back({surf, surf->offset});
+
+        surf->offset.X = LerpOffset(old.offset.X, surf->offset.X, surf->image->actual_w);
+        surf->offset.Y = LerpOffset(old.offset.Y, surf->offset.Y, surf->image->actual_h);
+    }
+
+    for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
+    {
+        player_t *p = players[pnum];
+        if (!p)
+            continue;
+
+        interp_player_t &live = live_players[pnum];
+        interp_player_t &old  = interp_players[pnum];
+
+        live.viewz = p->viewz;
+
+        // not after a teleport or respawn
+        if (p->mo && !p->mo->interp_skip && fabs(p->viewz - old.viewz) < INTERP_MAX_MOVE)
+            p->viewz = LerpFloat(old.viewz, p->viewz);
+
+        for (int k = 0; k < NUMPSPRITES; k++)
+        {
+            live.psp_sx[k] = p->psprites[k].sx;
+            live.psp_sy[k] = p->psprites[k].sy;
+
+            p->psprites[k].sx = LerpFloat(old.psp_sx[k], p->psprites[k].sx);
+            p->psprites[k].sy = LerpFloat(old.psp_sy[k], p->psprites[k].sy);
+        }
+    }
+}
+
+void R_EndInterpolation(void)
+{
+    if (!interp_active)
+        return;
+
+    interp_active = false;
+
+    for (const live_mobj_t &live : live_mobjs)
+    {
+        mobj_t *mo = live.mo;
+
+        mo->x         = live.x;
+        mo->y         = live.y;
+        mo->z         = live.z;
+        mo->angle     = live.angle;
+        mo->vertangle = live.vertangle;
+    }
+
+    for (const live_sector_t &live : live_sectors)
+    {
+        live.sec->f_h = live.f_h;
+        live.sec->c_h = live.c_h;
+
+        R_DirtySectorGeometry(live.sec);
+    }
+
+    for (const interp_surface_t &live : live_surfaces)
+        live.surf->offset = live.offset;
+
+    for (int pnum = 0; pnum < MAXPLAYERS; pnum++)
+    {
+        player_t *p = players[pnum];
+        if (!p)
+            continue;
+
+        p->viewz = live_players[pnum].viewz;
+
+        for (int k = 0; k < NUMPSPRITES; k++)
+        {
+            p->psprites[k].sx = live_players[pnum].psp_sx[k];
+            p->psprites[k].sy = live_players[pnum].psp_sy[k];
+        }
+    }
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
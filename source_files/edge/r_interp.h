@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------
+//  EDGE Frame Interpolation
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+
+#ifndef __R_INTERP_H__
+#define __R_INTERP_H__
+
+// how far the frame being drawn is between the previous tic and the
+// last one, 1.0 means no interpolation (draw the current state).
+extern float fractional_tic;
+
+void R_SaveInterpolation(void);
+// remember where things are at the start of a game tic.
+
+void R_ClearInterpolation(void);
+// forget the saved state, e.g. when a level or savegame is loaded.
+// Frames are drawn without interpolation until the next tic.
+
+void R_UpdateFractionalTic(void);
+// compute fractional_tic for a new frame.
+
+void R_BeginInterpolation(void);
+void R_EndInterpolation(void);
+// move things to their in-between positions before rendering the
+// view, and back again afterwards.
+
+#endif /* __R_INTERP_H__ */
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -20,6 +20,7 @@
 #include "i_defs_gl.h"
 
 #include "g_game.h"
+#include "hu_draw.h"
 #include "r_misc.h"
 #include "r_gldefs.h"
 #include "r_units.h"
@@ -37,6 +38,9 @@ int glmax_clip_planes;
 int glmax_tex_size;
 int glmax_tex_units;
 
+bool glcap_pixel_buffers = false;
+bool glcap_glsl          = false;
+
 DEF_CVAR(r_nearclip, "4", CVAR_ARCHIVE)
 DEF_CVAR(r_farclip, "64000", CVAR_ARCHIVE)
 DEF_CVAR(r_culling, "0", CVAR_ARCHIVE)
@@ -50,6 +54,8 @@ DEF_CVAR(r_cullfog, "0", CVAR_ARCHIVE)
 //
 void RGL_SetupMatrices2D(void)
 {
+    HUD_FlushBatch();
+
     glViewport(0, 0, SCREENWIDTH, SCREENHEIGHT);
 
     glMatrixMode(GL_PROJECTION);
@@ -73,6 +79,8 @@ void RGL_SetupMatrices2D(void)
 //
 void RGL_SetupMatricesWorld2D(void)
 {
+    HUD_FlushBatch();
+
     glViewport(viewwindow_x, viewwindow_y, viewwindow_w, viewwindow_h);
 
     glMatrixMode(GL_PROJECTION);
@@ -98,6 +106,8 @@ void RGL_SetupMatrices3D(void)
 {
     GLfloat ambient[4] = {1.0f, 1.0f, 1.0f, 1.0f};
 
+    HUD_FlushBatch();
+
     glViewport(viewwindow_x, viewwindow_y, viewwindow_w, viewwindow_h);
 
     // calculate perspective matrix
@@ -173,6 +183,16 @@ void RGL_CheckExtensions(void)
 #ifndef EDGE_GL_ES2
     if (!GLAD_GL_VERSION_1_5)
         I_Error("OpenGL supported version below minimum! (Requires OpenGL 1.5).\n");
+
+    int gl_major = 0;
+    int gl_minor = 0;
+
+    sscanf(glstr_version.c_str(), "%d.%d", &gl_major, &gl_minor);
+
+    glcap_pixel_buffers = (gl_major > 2 || (gl_major == 2 && gl_minor >= 1)) ||
+                          strstr(SafeStr(glGetString(GL_EXTENSIONS)), "GL_ARB_pixel_buffer_object") != NULL;
+
+    glcap_glsl = (gl_major >= 2);
 #endif
 }
 
@@ -242,6 +262,8 @@ void RGL_Init(void)
 
     RGL_SoftInit();
 
+    RGL_InitGLSL();
+
     R2_InitUtil();
 
     // initialise unit system
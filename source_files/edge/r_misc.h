@@ -98,6 +98,13 @@ void                 R_InitShaderTables();
 // Renders the view for the next frame.
 void R_Render(int x, int y, int w, int h, mobj_t *camera, bool full_height, float expand_w);
 
+// The wall and plane vertices cached between frames near this sector
+// are no longer valid (it has moved).
+void R_DirtySectorGeometry(sector_t *sec);
+
+// Forget all cached wall and plane vertices, e.g. for a new level.
+void R_ClearGeometryCache(void);
+
 // Called by startup code.
 void R_Init(void);
 // Called by shutdown code
@@ -43,6 +43,7 @@
 #include "r_colormap.h"
 #include "r_effects.h"
 #include "r_image.h"
+#include "r_interp.h"
 #include "r_occlude.h"
 #include "r_shader.h"
 #include "r_sky.h"
@@ -73,8 +74,10 @@
 DEF_CVAR(debug_hom, "0", CVAR_CHEAT)
 DEF_CVAR(r_forceflatlighting, "0", CVAR_ARCHIVE)
 
+// skip subsectors which the sector visibility table says can't be seen
+DEF_CVAR(r_pvs, "1", CVAR_ARCHIVE)
+
 extern cvar_c r_culling;
-extern cvar_c r_doubleframes;
 
 side_t   *sidedef;
 line_t   *linedef;
@@ -127,6 +130,10 @@ extern sector_t *backsector;
 static subsector_t *cur_sub;
 static seg_t       *cur_seg;
 
+// sector of the view point when the visibility table is in use,
+// otherwise NULL.
+static sector_t *pvs_view_sector;
+
 static bool solid_mode;
 
 static std::list<drawsub_c *> drawsubs;
@@ -474,6 +481,147 @@ static GLuint R_ImageCache(const image_c *image, bool anim = true, const colourm
     }
 }
 
+// ========= GEOMETRY CACHE ===========
+
+// The vertices and texture coordinates of the walls and planes of each
+// subsector are kept between frames, so most of the level only costs a
+// lookup.  Entries are found by the values they were computed from
+// (positions, heights, texture offsets and scales), hence surfaces that
+// move or scroll simply make new entries.  Wall vertices also depend on
+// the heights of the sectors around them (see GreetNeighbourSector), so
+// when a sector moves the subsectors nearby are marked dirty, and their
+// entries are thrown away the next time they are drawn.
+//
+// Not used in mirrors or portals, nor for swirling liquids.
+
+DEF_CVAR(r_geomcache, "1", 0)
+
+#define GEOM_KEY_SIZE 12
+
+// a subsector with this many entries is cleared and starts again
+#define MAX_GEOM_ENTRIES 48
+
+typedef struct
+{
+    // seg for walls, subsector for planes
+    const void *owner;
+
+    // slope for planes
+    const void *ref;
+
+    // flags for walls, rotation for planes
+    uint32_t extra;
+    float    key[GEOM_KEY_SIZE];
+
+    int first, count;
+} geom_entry_t;
+
+typedef struct
+{
+    bool dirty;
+
+    std::vector<geom_entry_t> entries;
+    std::vector<HMM_Vec3>     pos;
+    std::vector<HMM_Vec2>     texc;
+} geom_cache_t;
+
+// one per subsector, allocated when the level is first drawn
+static std::vector<geom_cache_t> geom_caches;
+
+static geom_cache_t *GeomCacheForSub(subsector_t *sub)
+{
+    if (r_geomcache.d == 0 || num_active_mirrors > 0)
+        return NULL;
+
+    if (geom_caches.empty())
+        geom_caches.resize(numsubsectors);
+
+    geom_cache_t *gc = &geom_caches[sub - subsectors];
+
+    if (gc->dirty || gc->entries.size() >= MAX_GEOM_ENTRIES)
+    {
+        gc->entries.clear();
+        gc->pos.clear();
+        gc->texc.clear();
+
+        gc->dirty = false;
+    }
+
+    return gc;
+}
+
+static const geom_entry_t *GeomCacheFind(const geom_cache_t *gc, const geom_entry_t &want)
+{
+    for (const geom_entry_t &E : gc->entries)
+    {
+        if (E.owner == want.owner && E.ref == want.ref && E.extra == want.extra &&
+            memcmp(E.key, want.key, sizeof(E.key)) == 0)
+        {
+            return &E;
+        }
+    }
+
+    return NULL;
+}
+
+static void GeomCacheStore(geom_cache_t *gc, geom_entry_t &entry, const HMM_Vec3 *pos, const HMM_Vec2 *texc,
+                           int count)
+{
+    entry.first = (int)gc->pos.size();
+    entry.count = count;
+
+    gc->pos.insert(gc->pos.end(), pos, pos + count);
+    gc->texc.insert(gc->texc.end(), texc, texc + count);
+
+    gc->entries.push_back(entry);
+}
+
+static void DirtySubsectorsNear(sector_t *sec)
+{
+    for (subsector_t *sub = sec->subsectors; sub; sub = sub->sec_next)
+    {
+        geom_caches[sub - subsectors].dirty = true;
+
+        // the vertex lists name every sector whose walls can meet
+        // this one at a corner
+        for (seg_t *seg = sub->segs; seg; seg = seg->sub_next)
+        {
+            for (int vert = 0; vert < 2; vert++)
+            {
+                const vertex_seclist_t *seclist = seg->nb_sec[vert];
+
+                if (!seclist)
+                    continue;
+
+                for (int k = 0; k < seclist->num; k++)
+                {
+                    sector_t *other = sectors + seclist->sec[k];
+
+                    for (subsector_t *sub2 = other->subsectors; sub2; sub2 = sub2->sec_next)
+                        geom_caches[sub2 - subsectors].dirty = true;
+                }
+            }
+        }
+    }
+}
+
+void R_DirtySectorGeometry(sector_t *sec)
+{
+    if (geom_caches.empty())
+        return;
+
+    DirtySubsectorsNear(sec);
+
+    // sectors using this one for an extrafloor
+    for (extrafloor_t *ef = sec->control_floors; ef; ef = ef->ctrl_next)
+        DirtySubsectorsNear(ef->sector);
+}
+
+void R_ClearGeometryCache(void)
+{
+    geom_caches.clear();
+}
+
 float Slope_GetHeight(slope_plane_t *slope, float x, float y)
 {
     // FIXME: precompute (store in slope_plane_t)
@@ -616,7 +764,7 @@ typedef struct wall_plane_data_s
 // Adapted from Quake 3 GPL release - Dasho (not used yet, but might be for future effects)
 /*static void CalcScrollTexCoords( float x_scroll, float y_scroll, HMM_Vec2 *texc )
 {
-    float timeScale = gametic / (r_doubleframes.d ? 200.0f : 100.0f);
+    float timeScale = gametic / 100.0f;
     float adjustedScrollS, adjustedScrollT;
 
     adjustedScrollS = x_scroll * timeScale;
@@ -701,6 +849,9 @@ typedef struct
     int           v_count;
     const HMM_Vec3 *vert;
 
+    // texture coordinates from the geometry cache (or NULL)
+    const HMM_Vec2 *texc;
+
     GLuint tex_id;
 
     int pass;
@@ -739,19 +890,26 @@ static void WallCoordFunc(void *d, int v_idx, HMM_Vec3 *pos, float *rgb, HMM_Vec
         rgb[2] = data->B;
     }
 
-    float along;
-
-    if (fabs(data->div.dx) > fabs(data->div.dy))
+    if (data->texc)
     {
-        along = (pos->X - data->div.x) / data->div.dx;
+        *texc = data->texc[v_idx];
     }
     else
     {
-        along = (pos->Y - data->div.y) / data->div.dy;
-    }
+        float along;
 
-    texc->X = data->tx0 + along * data->tx_mul;
-    texc->Y = data->ty0 + pos->Z * data->ty_mul;
+        if (fabs(data->div.dx) > fabs(data->div.dy))
+        {
+            along = (pos->X - data->div.x) / data->div.dx;
+        }
+        else
+        {
+            along = (pos->Y - data->div.y) / data->div.dy;
+        }
+
+        texc->X = data->tx0 + along * data->tx_mul;
+        texc->Y = data->ty0 + pos->Z * data->ty_mul;
+    }
 
     if (swirl_pass > 0)
         CalcTurbulentTexCoords(texc, pos);
@@ -764,6 +922,9 @@ typedef struct plane_coord_data_s
     int           v_count;
     const HMM_Vec3 *vert;
 
+    // texture coordinates from the geometry cache (or NULL)
+    const HMM_Vec2 *texc;
+
     GLuint tex_id;
 
     int pass;
@@ -808,16 +969,23 @@ static void PlaneCoordFunc(void *d, int v_idx, HMM_Vec3 *pos, float *rgb, HMM_Ve
         rgb[2] = data->B;
     }
 
-    HMM_Vec2 rxy = {{(data->tx0 + pos->X), (data->ty0 + pos->Y)}};
+    if (data->texc)
+    {
+        *texc = data->texc[v_idx];
+    }
+    else
+    {
+        HMM_Vec2 rxy = {{(data->tx0 + pos->X), (data->ty0 + pos->Y)}};
 
-    if (data->rotation)
-        HMM_RotateV2(rxy, epi::DegreesFromBAM(data->rotation));
+        if (data->rotation)
+            HMM_RotateV2(rxy, epi::DegreesFromBAM(data->rotation));
 
-    rxy.X /= data->image_w;
-    rxy.Y /= data->image_h;
+        rxy.X /= data->image_w;
+        rxy.Y /= data->image_h;
 
-    texc->X = rxy.X * data->x_mat.X + rxy.Y * data->x_mat.Y;
-    texc->Y = rxy.X * data->y_mat.X + rxy.Y * data->y_mat.Y;
+        texc->X = rxy.X * data->x_mat.X + rxy.Y * data->x_mat.Y;
+        texc->Y = rxy.X * data->y_mat.X + rxy.Y * data->y_mat.Y;
+    }
 
     if (swirl_pass > 0)
         CalcTurbulentTexCoords(texc, pos);
@@ -1051,67 +1219,107 @@ static void DrawWallPart(drawfloor_t *dfloor, float x1, float y1, float lz1, flo
     L_WriteDebug("WALL (%d,%d,%d) -> (%d,%d,%d)\n", (int)x1, (int)y1, (int)top, (int)x2, (int)y2, (int)bottom);
 #endif
 
-    // -AJA- 2007/08/07: ugly code here ensures polygon edges
-    //       match up with adjacent linedefs (otherwise small
-    //       gaps can appear which look bad).
+    // swirling liquids have moving texture coordinates
+    bool swirls = (surf->image && surf->image->liquid_type > LIQ_None && swirling_flats > SWIRL_SMMU);
 
-    float left_h[MAX_EDGE_VERT];
-    int   left_num = 2;
-    float right_h[MAX_EDGE_VERT];
-    int   right_num = 2;
+    geom_cache_t *gc = swirls ? NULL : GeomCacheForSub(cur_sub);
 
-    left_h[0]  = lz1;
-    left_h[1]  = lz2;
-    right_h[0] = rz1;
-    right_h[1] = rz2;
+    geom_entry_t        entry = {};
+    const geom_entry_t *found = NULL;
 
-    if (solid_mode && !mid_masked)
+    if (gc)
     {
-        GreetNeighbourSector(left_h, left_num, cur_seg->nb_sec[0]);
-        GreetNeighbourSector(right_h, right_num, cur_seg->nb_sec[1]);
+        entry.owner = cur_seg;
+        entry.extra = (mid_masked ? 1 : 0) | (solid_mode ? 2 : 0);
 
-#if DEBUG_GREET_NEIGHBOUR
-        SYS_ASSERT(left_num <= MAX_EDGE_VERT);
-        SYS_ASSERT(right_num <= MAX_EDGE_VERT);
+        float *key = entry.key;
 
-        for (int k = 0; k < MAX_EDGE_VERT; k++)
-        {
-            if (k + 1 < left_num)
-            {
-                SYS_ASSERT(left_h[k] <= left_h[k + 1]);
-            }
-            if (k + 1 < right_num)
-            {
-                SYS_ASSERT(right_h[k] <= right_h[k + 1]);
-            }
-        }
-#endif
+        key[0]  = x1;
+        key[1]  = y1;
+        key[2]  = x2;
+        key[3]  = y2;
+        key[4]  = lz1;
+        key[5]  = lz2;
+        key[6]  = rz1;
+        key[7]  = rz2;
+        key[8]  = tx0;
+        key[9]  = tx_mul;
+        key[10] = ty0;
+        key[11] = ty_mul;
+
+        found = GeomCacheFind(gc, entry);
     }
 
     HMM_Vec3 vertices[MAX_EDGE_VERT * 2];
 
     int v_count = 0;
 
-    for (int LI = 0; LI < left_num; LI++)
+    if (found)
     {
-        vertices[v_count].X = x1;
-        vertices[v_count].Y = y1;
-        vertices[v_count].Z = left_h[LI];
-
-        MIR_Height(vertices[v_count].Z);
+        v_count = found->count;
 
-        v_count++;
+        ecframe_stats.draw_geomcached++;
     }
-
-    for (int RI = right_num - 1; RI >= 0; RI--)
+    else
     {
-        vertices[v_count].X = x2;
-        vertices[v_count].Y = y2;
-        vertices[v_count].Z = right_h[RI];
+        // -AJA- 2007/08/07: ugly code here ensures polygon edges
+        //       match up with adjacent linedefs (otherwise small
+        //       gaps can appear which look bad).
+
+        float left_h[MAX_EDGE_VERT];
+        int   left_num = 2;
+        float right_h[MAX_EDGE_VERT];
+        int   right_num = 2;
+
+        left_h[0]  = lz1;
+        left_h[1]  = lz2;
+        right_h[0] = rz1;
+        right_h[1] = rz2;
+
+        if (solid_mode && !mid_masked)
+        {
+            GreetNeighbourSector(left_h, left_num, cur_seg->nb_sec[0]);
+            GreetNeighbourSector(right_h, right_num, cur_seg->nb_sec[1]);
+
+#if DEBUG_GREET_NEIGHBOUR
+            SYS_ASSERT(left_num <= MAX_EDGE_VERT);
+            SYS_ASSERT(right_num <= MAX_EDGE_VERT);
+
+            for (int k = 0; k < MAX_EDGE_VERT; k++)
+            {
+                if (k + 1 < left_num)
+                {
+                    SYS_ASSERT(left_h[k] <= left_h[k + 1]);
+                }
+                if (k + 1 < right_num)
+                {
+                    SYS_ASSERT(right_h[k] <= right_h[k + 1]);
+                }
+            }
+#endif
+        }
+
+        for (int LI = 0; LI < left_num; LI++)
+        {
+            vertices[v_count].X = x1;
+            vertices[v_count].Y = y1;
+            vertices[v_count].Z = left_h[LI];
+
+            MIR_Height(vertices[v_count].Z);
+
+            v_count++;
+        }
+
+        for (int RI = right_num - 1; RI >= 0; RI--)
+        {
+            vertices[v_count].X = x2;
+            vertices[v_count].Y = y2;
+            vertices[v_count].Z = right_h[RI];
 
-        MIR_Height(vertices[v_count].Z);
+            MIR_Height(vertices[v_count].Z);
 
-        v_count++;
+            v_count++;
+        }
     }
 
     int blending;
@@ -1134,7 +1342,8 @@ static void DrawWallPart(drawfloor_t *dfloor, float x1, float y1, float lz1, flo
     wall_coord_data_t data;
 
     data.v_count = v_count;
-    data.vert    = vertices;
+    data.vert    = found ? &gc->pos[found->first] : vertices;
+    data.texc    = found ? &gc->texc[found->first] : NULL;
 
     data.R = data.G = data.B = 1.0f;
 
@@ -1157,6 +1366,23 @@ static void DrawWallPart(drawfloor_t *dfloor, float x1, float y1, float lz1, flo
     data.trans      = trans;
     data.mid_masked = mid_masked;
 
+    HMM_Vec2 tex_coords[MAX_EDGE_VERT * 2];
+
+    if (gc && !found)
+    {
+        for (int v_idx = 0; v_idx < v_count; v_idx++)
+        {
+            HMM_Vec3 pos, normal, lit_pos;
+            float    rgb[3];
+
+            WallCoordFunc(&data, v_idx, &pos, rgb, &tex_coords[v_idx], &normal, &lit_pos);
+        }
+
+        GeomCacheStore(gc, entry, vertices, tex_coords, v_count);
+
+        data.texc = tex_coords;
+    }
+
     if (surf->image && surf->image->liquid_type == LIQ_Thick)
         thick_liquid = true;
     else
@@ -2529,20 +2755,35 @@ static void RGL_DrawPlane(drawfloor_t *dfloor, float h, surface_t *surf, int fac
     if ((trans < 0.99f || surf->image->opacity >= OPAC_Masked) == solid_mode)
         return;
 
-    // count number of actual vertices
-    seg_t *seg;
-    for (seg = cur_sub->segs, num_vert = 0; seg; seg = seg->sub_next, num_vert++)
+    // swirling liquids have moving texture coordinates
+    bool swirls = (surf->image->liquid_type > LIQ_None && swirling_flats > SWIRL_SMMU);
+
+    geom_cache_t *gc = swirls ? NULL : GeomCacheForSub(cur_sub);
+
+    geom_entry_t        entry = {};
+    const geom_entry_t *found = NULL;
+
+    if (gc)
     {
-        /* no other code needed */
-    }
+        entry.owner = cur_sub;
+        entry.ref   = slope;
+        entry.extra = surf->rotation;
 
-    // -AJA- make sure polygon has enough vertices.  Sometimes a subsector
-    // ends up with only 1 or 2 segs due to level problems (e.g. MAP22).
-    if (num_vert < 3)
-        return;
+        float *key = entry.key;
 
-    if (num_vert > MAX_PLVERT)
-        num_vert = MAX_PLVERT;
+        key[0] = orig_h;
+        key[1] = (float)face_dir;
+        key[2] = surf->offset.X;
+        key[3] = surf->offset.Y;
+        key[4] = IM_WIDTH(surf->image);
+        key[5] = IM_HEIGHT(surf->image);
+        key[6] = surf->x_mat.X;
+        key[7] = surf->x_mat.Y;
+        key[8] = surf->y_mat.X;
+        key[9] = surf->y_mat.Y;
+
+        found = GeomCacheFind(gc, entry);
+    }
 
     HMM_Vec3 vertices[MAX_PLVERT];
 
@@ -2552,45 +2793,76 @@ static void RGL_DrawPlane(drawfloor_t *dfloor, float h, surface_t *surf, int fac
 
     int v_count = 0;
 
-    for (seg = cur_sub->segs, i = 0; seg && (i < MAX_PLVERT); seg = seg->sub_next, i++)
+    if (found)
     {
-        if (v_count < MAX_PLVERT)
+        v_count = found->count;
+
+        for (i = 0; i < v_count; i++)
         {
-            float x = seg->v1->X;
-            float y = seg->v1->Y;
-            float z = h;
+            const HMM_Vec3 &pos = gc->pos[found->first + i];
 
-            // must do this before mirror adjustment
-            M_AddToBox(v_bbox, x, y);
+            M_AddToBox(v_bbox, pos.X, pos.Y);
+        }
 
-            if (cur_sub->sector->floor_vertex_slope && face_dir > 0)
-            {
-                // floor - check vertex heights
-                if (seg->v1->Z < 32767.0f && seg->v1->Z > -32768.0f)
-                    z = seg->v1->Z;
-            }
+        ecframe_stats.draw_geomcached++;
+    }
+    else
+    {
+        // count number of actual vertices
+        seg_t *seg;
+        for (seg = cur_sub->segs, num_vert = 0; seg; seg = seg->sub_next, num_vert++)
+        {
+            /* no other code needed */
+        }
 
-            if (cur_sub->sector->ceil_vertex_slope && face_dir < 0)
-            {
-                // ceiling - check vertex heights
-                if (seg->v1->W < 32767.0f && seg->v1->W > -32768.0f)
-                    z = seg->v1->W;
-            }
+        // -AJA- make sure polygon has enough vertices.  Sometimes a subsector
+        // ends up with only 1 or 2 segs due to level problems (e.g. MAP22).
+        if (num_vert < 3)
+            return;
 
-            if (slope)
+        if (num_vert > MAX_PLVERT)
+            num_vert = MAX_PLVERT;
+
+        for (seg = cur_sub->segs, i = 0; seg && (i < MAX_PLVERT); seg = seg->sub_next, i++)
+        {
+            if (v_count < MAX_PLVERT)
             {
-                z = orig_h + Slope_GetHeight(slope, x, y);
+                float x = seg->v1->X;
+                float y = seg->v1->Y;
+                float z = h;
 
-                MIR_Height(z);
-            }
+                // must do this before mirror adjustment
+                M_AddToBox(v_bbox, x, y);
 
-            MIR_Coordinate(x, y);
+                if (cur_sub->sector->floor_vertex_slope && face_dir > 0)
+                {
+                    // floor - check vertex heights
+                    if (seg->v1->Z < 32767.0f && seg->v1->Z > -32768.0f)
+                        z = seg->v1->Z;
+                }
 
-            vertices[v_count].X = x;
-            vertices[v_count].Y = y;
-            vertices[v_count].Z = z;
+                if (cur_sub->sector->ceil_vertex_slope && face_dir < 0)
+                {
+                    // ceiling - check vertex heights
+                    if (seg->v1->W < 32767.0f && seg->v1->W > -32768.0f)
+                        z = seg->v1->W;
+                }
 
-            v_count++;
+                if (slope)
+                {
+                    z = orig_h + Slope_GetHeight(slope, x, y);
+
+                    MIR_Height(z);
+                }
+
+                MIR_Coordinate(x, y);
+
+                vertices[v_count].X = x;
+                vertices[v_count].Y = y;
+                vertices[v_count].Z = z;
+
+                v_count++;
+            }
         }
     }
 
@@ -2609,7 +2881,8 @@ static void RGL_DrawPlane(drawfloor_t *dfloor, float h, surface_t *surf, int fac
     plane_coord_data_t data;
 
     data.v_count = v_count;
-    data.vert    = vertices;
+    data.vert    = found ? &gc->pos[found->first] : vertices;
+    data.texc    = found ? &gc->texc[found->first] : NULL;
     data.R = data.G = data.B = 1.0f;
     data.tx0                 = surf->offset.X;
     data.ty0                 = surf->offset.Y;
@@ -2630,6 +2903,23 @@ static void RGL_DrawPlane(drawfloor_t *dfloor, float h, surface_t *surf, int fac
     data.slope    = slope;
     data.rotation = surf->rotation;
 
+    HMM_Vec2 tex_coords[MAX_PLVERT];
+
+    if (gc && !found)
+    {
+        for (i = 0; i < v_count; i++)
+        {
+            HMM_Vec3 pos, normal, lit_pos;
+            float    rgb[3];
+
+            PlaneCoordFunc(&data, i, &pos, rgb, &tex_coords[i], &normal, &lit_pos);
+        }
+
+        GeomCacheStore(gc, entry, vertices, tex_coords, v_count);
+
+        data.texc = tex_coords;
+    }
+
     if (cur_sub->sector->props.special)
     {
         if (face_dir > 0)
@@ -2742,6 +3032,10 @@ static void RGL_WalkSubsector(int num)
     subsector_t *sub    = &subsectors[num];
     sector_t    *sector = sub->sector;
 
+    // mirrors and portals see things the view point can't
+    if (pvs_view_sector && num_active_mirrors == 0 && P_CheckReject(pvs_view_sector, sector))
+        return;
+
     // store subsector in a global var for other functions to use
     cur_sub = sub;
 
@@ -3224,6 +3518,33 @@ static void RGL_WalkBSPNode(unsigned int bspnum)
         RGL_WalkBSPNode(node->children[side ^ 1]);
 }
 
+//
+// RGL_PVSViewSector
+//
+// The visibility table only holds for points inside the map, so it is
+// not used when the view point has left its subsector (e.g. noclip
+// into the void).
+//
+static sector_t *RGL_PVSViewSector(void)
+{
+    if (!rejectmatrix || r_pvs.d == 0 || !viewsubsector)
+        return NULL;
+
+    // subsectors are convex, with the inside on the right of each seg
+    for (const seg_t *seg = viewsubsector->segs; seg; seg = seg->sub_next)
+    {
+        float dx = seg->v2->X - seg->v1->X;
+        float dy = seg->v2->Y - seg->v1->Y;
+
+        float side = (viewx - seg->v1->X) * dy - (viewy - seg->v1->Y) * dx;
+
+        if (side < -0.1f * seg->length)
+            return NULL;
+    }
+
+    return viewsubsector->sector;
+}
+
 //
 // RGL_RenderTrueBSP
 //
@@ -3262,6 +3583,8 @@ static void RGL_RenderTrueBSP(void)
     // needed for drawing the sky
     RGL_BeginSky();
 
+    pvs_view_sector = RGL_PVSViewSector();
+
     // walk the bsp tree
     RGL_WalkBSPNode(root_node);
 
@@ -3461,6 +3784,8 @@ void R_Render(int x, int y, int w, int h, mobj_t *camera, bool full_height, floa
 
     view_cam_mo = camera;
 
+    R_BeginInterpolation();
+
     // Load the details for the camera
     InitCamera(camera, full_height, expand_w);
 
@@ -3470,6 +3795,8 @@ void R_Render(int x, int y, int w, int h, mobj_t *camera, bool full_height, floa
 
     seen_dlights.clear();
     RGL_RenderTrueBSP();
+
+    R_EndInterpolation();
 }
 
 //--- editor settings ---
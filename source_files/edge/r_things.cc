@@ -64,9 +64,6 @@
 
 #include "edge_profiling.h"
 
-extern coal::vm_c *ui_vm;
-extern double      VM_GetFloat(coal::vm_c *vm, const char *mod_name, const char *var_name);
-
 extern bool erraticism_active;
 
 #define DEBUG 0
@@ -223,7 +220,7 @@ static void RGL_DrawPSprite(pspdef_t *psp, int which, player_t *player, region_p
     {
         // Lobo 2022: Apply sprite Y offset, mainly for Heretic weapons.
         if ((state->flags & SFF_Weapon) && (player->ready_wp >= 0))
-            ty1 += VM_GetFloat(ui_vm, "hud", "universal_y_adjust") + player->weapons[player->ready_wp].info->y_adjust;
+            ty1 += VM_UniversalYAdjust() + player->weapons[player->ready_wp].info->y_adjust;
     }
 
     float ty2 = ty1 + h;
@@ -646,7 +643,7 @@ void RGL_DrawWeaponModel(player_t *p)
     }
     else
     {
-        bias = VM_GetFloat(ui_vm, "hud", "universal_y_adjust") + p->weapons[p->ready_wp].info->y_adjust;        
+        bias = VM_UniversalYAdjust() + p->weapons[p->ready_wp].info->y_adjust;        
     }
 
     bias /= 5;
@@ -93,13 +93,24 @@ typedef struct local_gl_unit_s
 
     RGBAColor fog_color   = kRGBANoValue;
     float    fog_density = 0;
+
+    // the above packed for sorting, see MakeSortKey()
+    uint64_t sort_key;
 } local_gl_unit_t;
 
+typedef struct
+{
+    uint64_t key;
+    int      index;
+} unit_sort_t;
+
 static local_gl_vert_t local_verts[MAX_L_VERT];
 static local_gl_unit_t local_units[MAX_L_UNIT];
 
 static std::vector<local_gl_unit_t *> local_unit_map;
 
+static std::vector<unit_sort_t> unit_sort_buf[2];
+
 static int cur_vert;
 static int cur_unit;
 
@@ -207,6 +218,44 @@ local_gl_vert_t *RGL_BeginUnit(GLuint shape, int max_vert, GLuint env1, GLuint t
     return local_verts + cur_vert;
 }
 
+static inline uint64_t EnvSortIndex(GLuint env)
+{
+    switch (env)
+    {
+    case ENV_NONE:
+        return 0;
+    case GL_REPLACE:
+        return 1;
+    case GL_MODULATE:
+        return 2;
+    case GL_DECAL:
+        return 3;
+    case GL_ADD:
+        return 4;
+    case uint32_t(ENV_SKIP_RGB):
+        return 5;
+    default:
+        return 6;
+    }
+}
+
+//
+// Pack the state which units are sorted by into one number, highest
+// bits first: pass (8), texture 0 (20), texture 1 (20), environment
+// 0 and 1 (3 each) and blending (8).  Very large texture names or
+// pass numbers are clamped, so units with the same key are not always
+// the same, but they still sort close together.
+//
+static inline uint64_t MakeSortKey(const local_gl_unit_t *unit)
+{
+    uint64_t pass = HMM_MIN(unit->pass, 0xFF);
+    uint64_t tex0 = HMM_MIN(unit->tex[0], 0xFFFFFu);
+    uint64_t tex1 = HMM_MIN(unit->tex[1], 0xFFFFFu);
+
+    return (pass << 54) | (tex0 << 34) | (tex1 << 14) | (EnvSortIndex(unit->env[0]) << 11) |
+           (EnvSortIndex(unit->env[1]) << 8) | (uint64_t)(unit->blending & 0xFF);
+}
+
 //
 // RGL_EndUnit
 //
@@ -230,6 +279,8 @@ void RGL_EndUnit(int actual_vert)
         v->rgba[2] *= ren_blu_mul;
     }
 
+    unit->sort_key = MakeSortKey(unit);
+
     cur_vert += actual_vert;
     cur_unit++;
 
@@ -237,28 +288,91 @@ void RGL_EndUnit(int actual_vert)
     SYS_ASSERT(cur_unit <= MAX_L_UNIT);
 }
 
-struct Compare_Unit_pred
+//
+// Sort the units by their keys (least significant byte first, skipping
+// bytes which are the same in every key).  The sort is stable, so units
+// with the same state stay in the order they were made.
+//
+static void RadixSortUnits(void)
 {
-    inline bool operator()(const local_gl_unit_t *A, const local_gl_unit_t *B) const
+    unit_sort_buf[0].resize(cur_unit);
+    unit_sort_buf[1].resize(cur_unit);
+
+    unit_sort_t *src  = unit_sort_buf[0].data();
+    unit_sort_t *dest = unit_sort_buf[1].data();
+
+    uint64_t all_and = ~(uint64_t)0;
+    uint64_t all_or  = 0;
+
+    for (int i = 0; i < cur_unit; i++)
     {
-        if (A->pass != B->pass)
-            return A->pass < B->pass;
+        src[i].key   = local_units[i].sort_key;
+        src[i].index = i;
 
-        if (A->tex[0] != B->tex[0])
-            return A->tex[0] < B->tex[0];
+        all_and &= src[i].key;
+        all_or |= src[i].key;
+    }
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        // this byte is the same in every key?
+        if ((((all_and ^ all_or) >> shift) & 0xFF) == 0)
+            continue;
 
-        if (A->tex[1] != B->tex[1])
-            return A->tex[1] < B->tex[1];
+        int count[256];
 
-        if (A->env[0] != B->env[0])
-            return A->env[0] < B->env[0];
+        memset(count, 0, sizeof(count));
+
+        for (int i = 0; i < cur_unit; i++)
+            count[(src[i].key >> shift) & 0xFF]++;
+
+        int total = 0;
+
+        for (int b = 0; b < 256; b++)
+        {
+            int n    = count[b];
+            count[b] = total;
+            total += n;
+        }
 
-        if (A->env[1] != B->env[1])
-            return A->env[1] < B->env[1];
+        for (int i = 0; i < cur_unit; i++)
+            dest[count[(src[i].key >> shift) & 0xFF]++] = src[i];
 
-        return A->blending < B->blending;
+        std::swap(src, dest);
     }
-};
+
+    for (int i = 0; i < cur_unit; i++)
+        local_unit_map[i] = &local_units[src[i].index];
+}
+
+//
+// Can unit B be drawn together with unit A, in the same glBegin/glEnd?
+// Only for polygons (which are split into triangles to do it), and the
+// state must be identical, not just the sort key.
+//
+static inline bool CanMergeUnits(const local_gl_unit_t *A, const local_gl_unit_t *B)
+{
+    if (A->sort_key != B->sort_key)
+        return false;
+
+    if (A->shape != GL_POLYGON || B->shape != GL_POLYGON)
+        return false;
+
+    if (A->pass != B->pass || A->blending != B->blending)
+        return false;
+
+    if (A->tex[0] != B->tex[0] || A->tex[1] != B->tex[1] || A->env[0] != B->env[0] || A->env[1] != B->env[1])
+        return false;
+
+    if (A->fog_color != B->fog_color || !AlmostEquals(A->fog_density, B->fog_density))
+        return false;
+
+    // alpha test value is taken from the first vertex
+    if ((A->blending & BL_Less) && local_verts[A->first].rgba[3] != local_verts[B->first].rgba[3])
+        return false;
+
+    return true;
+}
 
 static void EnableCustomEnv(GLuint env, bool enable)
 {
@@ -280,6 +394,10 @@ static void EnableCustomEnv(GLuint env, bool enable)
         }
         break;
 
+    case uint32_t(ENV_COLORMAP):
+        // done by the lighting program, see below
+        break;
+
     default:
         I_Error("INTERNAL ERROR: no such custom env: %08x\n", env);
     }
@@ -325,17 +443,24 @@ void RGL_DrawUnits(void)
     RGBAColor active_fog_rgb     = kRGBANoValue;
     float    active_fog_density = 0;
 
-    for (int i = 0; i < cur_unit; i++)
-        local_unit_map[i] = &local_units[i];
-
     if (batch_sort)
     {
-        std::sort(local_unit_map.begin(), local_unit_map.begin() + cur_unit, Compare_Unit_pred());
+        int64_t sort_start = I_GetTimeMicros();
+
+        RadixSortUnits();
+
+        ecframe_stats.draw_sortmicros += (int)(I_GetTimeMicros() - sort_start);
+    }
+    else
+    {
+        for (int i = 0; i < cur_unit; i++)
+            local_unit_map[i] = &local_units[i];
     }
 
+    sg_color fogColor = cull_fog_color;
+
     if (r_culling.d)
     {
-        sg_color fogColor;
         switch (r_cullfog.d)
         {
         case 0:
@@ -525,14 +650,68 @@ void RGL_DrawUnits(void)
             }
         }
 
-        glBegin(unit->shape);
+        if (unit->env[1] == ENV_COLORMAP)
+        {
+            // same fog as the fixed function path would use
+            if (r_culling.d)
+            {
+                if (unit->pass > 0)
+                    RGL_UseLightingProgram(GLSL_FOG_None, fogColor, 0, 0, 0);
+                else
+                    RGL_UseLightingProgram(GLSL_FOG_Linear, fogColor, 0, r_farclip.f - 750.0f, r_farclip.f - 250.0f);
+            }
+            else if (unit->fog_color != kRGBANoValue && unit->fog_density > 0.00009f)
+            {
+                RGL_UseLightingProgram(GLSL_FOG_Exp, sg_make_color_1i(unit->fog_color), std::log1p(unit->fog_density),
+                                       0, 0);
+            }
+            else
+                RGL_UseLightingProgram(GLSL_FOG_None, fogColor, 0, 0, 0);
+        }
+        else
+            RGL_StopLightingProgram();
 
-        for (int v_idx = 0; v_idx < unit->count; v_idx++)
+        // following units with the same state are drawn along with
+        // this one, as triangle fans in a single glBegin/glEnd.
+        int last = j;
+
+        while (last + 1 < cur_unit && CanMergeUnits(unit, local_unit_map[last + 1]))
+            last++;
+
+        if (last > j)
         {
-            RGL_SendRawVector(local_verts + unit->first + v_idx);
+            glBegin(GL_TRIANGLES);
+
+            for (int k = j; k <= last; k++)
+            {
+                const local_gl_vert_t *V = local_verts + local_unit_map[k]->first;
+
+                for (int v_idx = 2; v_idx < local_unit_map[k]->count; v_idx++)
+                {
+                    RGL_SendRawVector(V);
+                    RGL_SendRawVector(V + v_idx - 1);
+                    RGL_SendRawVector(V + v_idx);
+                }
+            }
+
+            glEnd();
+
+            ecframe_stats.draw_runits += last - j;
+            ecframe_stats.draw_mergedunits += last - j;
+
+            j = last;
         }
+        else
+        {
+            glBegin(unit->shape);
 
-        glEnd();
+            for (int v_idx = 0; v_idx < unit->count; v_idx++)
+            {
+                RGL_SendRawVector(local_verts + unit->first + v_idx);
+            }
+
+            glEnd();
+        }
 
         // restore the clamping mode
         if (old_clamp != DUMMY_CLAMP)
@@ -541,6 +720,8 @@ void RGL_DrawUnits(void)
         }
     }
 
+    RGL_StopLightingProgram();
+
     // all done
     cur_vert = cur_unit = 0;
 
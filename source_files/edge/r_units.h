@@ -79,6 +79,10 @@ typedef enum
     // output of the texture unit is the same as the input
     // for the RGB components.  The alpha component is treated
     // normally, i.e. passed on to next texture unit.
+
+    ENV_COLORMAP = CUSTOM_ENV_BEGIN + 2,
+    // sector lighting by the GLSL lighting program (see r_glsl.cc),
+    // the texture holds the colour of each colourmap index.
 } edge_environment_e;
 
 local_gl_vert_t *RGL_BeginUnit(GLuint shape, int max_vert, GLuint env1, GLuint tex1, GLuint env2, GLuint tex2, int pass,
@@ -28,6 +28,8 @@
 
 #include "image_data.h"
 
+#include "dm_state.h"
+#include "hu_draw.h"
 #include "m_random.h"
 #include "r_gldefs.h"
 #include "r_wipe.h"
@@ -37,8 +39,6 @@
 
 // #include <vector>
 
-extern cvar_c r_doubleframes;
-
 // we're limited to one wipe at a time...
 static wipetype_e cur_wipe_effect = WIPE_None;
 
@@ -74,14 +74,19 @@ static void CaptureScreenAsTexture(bool speckly, bool spooky)
     cur_wipe_right = SCREENWIDTH / (float)total_w;
     cur_wipe_top   = SCREENHEIGHT / (float)total_h;
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    HUD_FlushBatch();
+
+    // read the whole screen at once, into the corner of the image
+    glPixelStorei(GL_PACK_ROW_LENGTH, total_w);
+
+    glReadPixels(0, 0, SCREENWIDTH, SCREENHEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, img.PixelAt(0, 0));
+
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
 
     for (int y = 0; y < SCREENHEIGHT; y++)
     {
         uint8_t *dest = img.PixelAt(0, y);
 
-        glReadPixels(0, y, SCREENWIDTH, 1, GL_RGBA, GL_UNSIGNED_BYTE, dest);
-
         int rnd_val = y;
 
         if (spooky)
@@ -370,12 +375,16 @@ bool RGL_DoWipe(void)
 
     // determine how many tics since we started.  If this is the first
     // call to DoWipe() since InitWipe(), then the clock starts now.
-    int nowtime = I_GetTime() / (r_doubleframes.d ? 2 : 1);
+    int nowtime = I_GetTime();
     int tics    = 0;
 
     if (cur_wipe_lasttime >= 0)
         tics = HMM_MAX(0, nowtime - cur_wipe_lasttime);
 
+    // one tic per frame when capturing (etc), as for the game
+    if (singletics && cur_wipe_lasttime >= 0)
+        tics = 1;
+
     cur_wipe_lasttime = nowtime;
 
     // hack for large delays (like when loading a level)
@@ -388,6 +397,8 @@ bool RGL_DoWipe(void)
 
     float how_far = (float)cur_wipe_progress / 40.0f;
 
+    HUD_FlushBatch();
+
     switch (cur_wipe_effect)
     {
     case WIPE_Melt:
@@ -408,7 +408,7 @@ void RAD_ActSpawnThing(rad_trigger_t *R, void *param)
 
     P_SetMobjDirAndSpeed(mo, t->angle, t->slope, 0);
 
-    mo->tag = t->tag;
+    P_SetMobjTag(mo, t->tag);
 
     mo->spawnpoint.x         = t->x;
     mo->spawnpoint.y         = t->y;
@@ -519,6 +519,27 @@ void RAD_ActBenefitPlayers(rad_trigger_t *R, void *param)
     }
 }
 
+//
+// Collects the things which a tagged action may affect: every thing
+// when the tag is zero, otherwise only things with that tag.  A copy
+// is made since the action itself can spawn things or change tags.
+//
+static void CollectTaggedMobjs(int tag, std::vector<mobj_t *> &list)
+{
+    list.clear();
+
+    if (tag)
+    {
+        for (mobj_t *mo = P_FindMobjFromTag(tag); mo != NULL; mo = mo->tag_next)
+            list.push_back(mo);
+    }
+    else
+    {
+        for (mobj_t *mo = mobjlisthead; mo != NULL; mo = mo->next)
+            list.push_back(mo);
+    }
+}
+
 void RAD_ActDamageMonsters(rad_trigger_t *R, void *param)
 {
     s_damage_monsters_t *mon = (s_damage_monsters_t *)param;
@@ -541,15 +562,14 @@ void RAD_ActDamageMonsters(rad_trigger_t *R, void *param)
     // scan the mobj list
     // FIXME: optimise for fixed-sized triggers
 
-    mobj_t *mo;
-    mobj_t *next;
+    std::vector<mobj_t *> list;
+
+    CollectTaggedMobjs(tag, list);
 
     player_t *player = GetWhoDunnit(R);
 
-    for (mo = mobjlisthead; mo != NULL; mo = next)
+    for (mobj_t *mo : list)
     {
-        next = mo->next;
-
         if (info && mo->info != info)
             continue;
 
@@ -591,13 +611,12 @@ void RAD_ActThingEvent(rad_trigger_t *R, void *param)
     // scan the mobj list
     // FIXME: optimise for fixed-sized triggers
 
-    mobj_t *mo;
-    mobj_t *next;
+    std::vector<mobj_t *> list;
 
-    for (mo = mobjlisthead; mo != NULL; mo = next)
-    {
-        next = mo->next;
+    CollectTaggedMobjs(tag, list);
 
+    for (mobj_t *mo : list)
+    {
         if (info && (mo->info != info))
             continue;
 
@@ -781,11 +800,11 @@ void RAD_ActChangeTex(rad_trigger_t *R, void *param)
     // handle the line changers
     SYS_ASSERT(ctex->what < CHTEX_Sky);
 
-    for (int i = 0; i < numlines; i++)
+    for (line_t *ld = P_FindLineFromTag(ctex->tag); ld; ld = ld->tag_next)
     {
-        side_t *side = (ctex->what <= CHTEX_RightLower) ? lines[i].side[0] : lines[i].side[1];
+        side_t *side = (ctex->what <= CHTEX_RightLower) ? ld->side[0] : ld->side[1];
 
-        if (lines[i].tag != ctex->tag || !side)
+        if (!side)
             continue;
 
         if (ctex->subtag && side->sector->tag != ctex->subtag)
@@ -847,7 +866,6 @@ static void MoveOneSector(sector_t *sec, s_movesector_t *t)
 void RAD_ActMoveSector(rad_trigger_t *R, void *param)
 {
     s_movesector_t *t = (s_movesector_t *)param;
-    int             i;
 
     // SectorV compatibility
     if (t->tag == 0)
@@ -859,12 +877,8 @@ void RAD_ActMoveSector(rad_trigger_t *R, void *param)
         return;
     }
 
-    // OPTIMISE !
-    for (i = 0; i < numsectors; i++)
-    {
-        if (sectors[i].tag == t->tag)
-            MoveOneSector(sectors + i, t);
-    }
+    for (sector_t *sec = P_FindSectorFromTag(t->tag); sec; sec = sec->tag_next)
+        MoveOneSector(sec, t);
 }
 
 static void LightOneSector(sector_t *sec, s_lightsector_t *t)
@@ -878,7 +892,6 @@ static void LightOneSector(sector_t *sec, s_lightsector_t *t)
 void RAD_ActLightSector(rad_trigger_t *R, void *param)
 {
     s_lightsector_t *t = (s_lightsector_t *)param;
-    int              i;
 
     // SectorL compatibility
     if (t->tag == 0)
@@ -890,54 +903,46 @@ void RAD_ActLightSector(rad_trigger_t *R, void *param)
         return;
     }
 
-    // OPTIMISE !
-    for (i = 0; i < numsectors; i++)
-    {
-        if (sectors[i].tag == t->tag)
-            LightOneSector(sectors + i, t);
-    }
+    for (sector_t *sec = P_FindSectorFromTag(t->tag); sec; sec = sec->tag_next)
+        LightOneSector(sec, t);
 }
 
 void RAD_ActFogSector(rad_trigger_t *R, void *param)
 {
     s_fogsector_t *t = (s_fogsector_t *)param;
-    int            i;
 
-    for (i = 0; i < numsectors; i++)
+    for (sector_t *sec = P_FindSectorFromTag(t->tag); sec; sec = sec->tag_next)
     {
-        if (sectors[i].tag == t->tag)
+        if (!t->leave_color)
         {
-            if (!t->leave_color)
-            {
-                if (t->colmap_color)
-                    sectors[i].props.fog_color = V_ParseFontColor(t->colmap_color);
-                else // should only happen with a CLEAR directive
-                    sectors[i].props.fog_color = kRGBANoValue;
-            }
-            if (!t->leave_density)
+            if (t->colmap_color)
+                sec->props.fog_color = V_ParseFontColor(t->colmap_color);
+            else // should only happen with a CLEAR directive
+                sec->props.fog_color = kRGBANoValue;
+        }
+        if (!t->leave_density)
+        {
+            if (t->relative)
             {
-                if (t->relative)
-                {
-                    sectors[i].props.fog_density += (0.01f * t->density);
-                    if (sectors[i].props.fog_density < 0.0001f)
-                        sectors[i].props.fog_density = 0;
-                    if (sectors[i].props.fog_density > 0.01f)
-                        sectors[i].props.fog_density = 0.01f;
-                }
-                else
-                    sectors[i].props.fog_density = 0.01f * t->density;
+                sec->props.fog_density += (0.01f * t->density);
+                if (sec->props.fog_density < 0.0001f)
+                    sec->props.fog_density = 0;
+                if (sec->props.fog_density > 0.01f)
+                    sec->props.fog_density = 0.01f;
             }
-            for (int j = 0; j < sectors[i].linecount; j++)
+            else
+                sec->props.fog_density = 0.01f * t->density;
+        }
+        for (int j = 0; j < sec->linecount; j++)
+        {
+            for (int k = 0; k < 2; k++)
             {
-                for (int k = 0; k < 2; k++)
+                side_t *side_check = sec->lines[j]->side[k];
+                if (side_check && side_check->middle.fogwall)
                 {
-                    side_t *side_check = sectors[i].lines[j]->side[k];
-                    if (side_check && side_check->middle.fogwall)
-                    {
-                        side_check->middle.image =
-                            nullptr; // will be rebuilt with proper color later
-                                     // don't delete the image in case other fogwalls use the same color
-                    }
+                    side_check->middle.image =
+                        nullptr; // will be rebuilt with proper color later
+                                 // don't delete the image in case other fogwalls use the same color
                 }
             }
         }
@@ -981,15 +986,8 @@ void RAD_ActUnblockLines(rad_trigger_t *R, void *param)
 {
     s_lineunblocker_t *ub = (s_lineunblocker_t *)param;
 
-    int i;
-
-    for (i = 0; i < numlines; i++)
+    for (line_t *ld = P_FindLineFromTag(ub->tag); ld; ld = ld->tag_next)
     {
-        line_t *ld = lines + i;
-
-        if (ld->tag != ub->tag)
-            continue;
-
         if (!ld->side[0] || !ld->side[1])
             continue;
 
@@ -1005,15 +1003,8 @@ void RAD_ActBlockLines(rad_trigger_t *R, void *param)
 {
     s_lineunblocker_t *ub = (s_lineunblocker_t *)param;
 
-    int i;
-
-    for (i = 0; i < numlines; i++)
+    for (line_t *ld = P_FindLineFromTag(ub->tag); ld; ld = ld->tag_next)
     {
-        line_t *ld = lines + i;
-
-        if (ld->tag != ub->tag)
-            continue;
-
         // set standard flags
         ld->flags |= (MLF_Blocking | MLF_BlockMonsters);
     }
@@ -62,6 +62,8 @@
 #include "s_sound.h"
 #include "w_wad.h"
 
+#include "edge_profiling.h"
+
 // Static Scripts.  Never change once all scripts have been read in.
 rad_script_t *r_scripts = NULL;
 
@@ -683,6 +685,8 @@ static void DoRemoveTrigger(rad_trigger_t *trig)
 //
 void RAD_RunTriggers(void)
 {
+    EDGE_ZoneScoped;
+
     rad_trigger_t *trig, *next;
 
     // Start looking through the trigger list.
@@ -26,7 +26,8 @@
 #include "i_defs.h"
 #include "epi_sdl.h"
 
-#include <list>
+#include <atomic>
+#include <vector>
 
 #include "m_misc.h"
 #include "r_misc.h"  // R_PointToAngle
@@ -36,6 +37,7 @@
 #include "s_cache.h"
 #include "s_blit.h"
 #include "s_music.h"
+#include "s_stream.h"
 
 #include "dm_state.h"
 
@@ -58,6 +60,8 @@
 mix_channel_c *mix_chan[MAX_CHANNELS];
 int            num_chan;
 
+bool mix_in_game = false;
+
 bool  vacuum_sfx       = false;
 bool  submerged_sfx    = false;
 bool  outdoor_reverb   = false;
@@ -73,10 +77,66 @@ static int  mix_buf_len;
 
 #define MAX_QUEUE_BUFS 16
 
-static std::list<sound_data_c *> free_qbufs;
-static std::list<sound_data_c *> playing_qbufs;
+// Music buffers are produced by the music thread and consumed by the
+// mixer (in the audio callback).  Filled buffers go to the mixer via
+// the playing ring, finished ones come back via the free ring.  Each
+// ring has a single producer and a single consumer, so neither side
+// ever needs to lock the audio device.
+//
+// S_QueueStop() just bumps the generation, and the mixer recycles any
+// buffers from older generations.
+
+#define QUEUE_RING_SIZE 32 // power of two, > MAX_QUEUE_BUFS
+
+struct queue_ring_t
+{
+    sound_data_c *bufs[QUEUE_RING_SIZE];
+    int           gens[QUEUE_RING_SIZE];
+
+    std::atomic<unsigned int> head; // next slot to write
+    std::atomic<unsigned int> tail; // next slot to read
+};
+
+static queue_ring_t playing_ring;
+static queue_ring_t free_ring;
+
+static std::atomic<int> queue_gen(0);
+
+// buffers given back by the producer via S_QueueReturnBuffer()
+static std::vector<sound_data_c *> spare_qbufs;
 
 static mix_channel_c *queue_chan;
+static int            queue_chan_gen;
+
+static void RingPush(queue_ring_t &R, sound_data_c *buf, int gen)
+{
+    unsigned int head = R.head.load(std::memory_order_relaxed);
+
+    // cannot overflow, there are fewer buffers than slots
+    SYS_ASSERT(head - R.tail.load(std::memory_order_acquire) < QUEUE_RING_SIZE);
+
+    R.bufs[head % QUEUE_RING_SIZE] = buf;
+    R.gens[head % QUEUE_RING_SIZE] = gen;
+
+    R.head.store(head + 1, std::memory_order_release);
+}
+
+static sound_data_c *RingPop(queue_ring_t &R, int *gen = NULL)
+{
+    unsigned int tail = R.tail.load(std::memory_order_relaxed);
+
+    if (tail == R.head.load(std::memory_order_acquire))
+        return NULL;
+
+    sound_data_c *buf = R.bufs[tail % QUEUE_RING_SIZE];
+
+    if (gen)
+        *gen = R.gens[tail % QUEUE_RING_SIZE];
+
+    R.tail.store(tail + 1, std::memory_order_release);
+
+    return buf;
+}
 
 DEF_CVAR(sfx_volume, "0.15", CVAR_ARCHIVE)
 
@@ -95,7 +155,7 @@ extern int dev_frag_pairs;
 
 extern bool dev_stereo;
 
-mix_channel_c::mix_channel_c() : state(CHAN_Empty), data(NULL)
+mix_channel_c::mix_channel_c() : state(CHAN_Empty), data(NULL), stream(NULL)
 {
 }
 
@@ -311,6 +371,61 @@ static void MixInterleaved(mix_channel_c *chan, int *dest, int pairs)
     SYS_ASSERT(offset - chan->delta < chan->length);
 }
 
+static void MixStream(mix_channel_c *chan, int *dest, int pairs)
+{
+    SYS_ASSERT(pairs > 0);
+
+    sfx_stream_c *S = chan->stream;
+
+    uint64_t avail = S->write_frame.load(std::memory_order_acquire);
+
+    int *d_pos = dest;
+    int *d_end = d_pos + pairs * (dev_stereo ? 2 : 1);
+
+    fixed22_t offset = chan->offset;
+
+    while (d_pos < d_end)
+    {
+        uint64_t frame = S->base + (offset >> 10);
+
+        // the worker has fallen behind: leave a gap rather than skip
+        if (frame >= avail)
+        {
+            if (S->ended.load(std::memory_order_acquire))
+                offset = chan->length;
+
+            break;
+        }
+
+        const int16_t *src = S->ring + (frame % STREAM_RING_FRAMES) * (S->stereo ? 2 : 1);
+
+        if (S->stereo)
+        {
+            *d_pos++ += src[0] * chan->volume_L;
+            *d_pos++ += src[1] * chan->volume_R;
+        }
+        else if (dev_stereo)
+        {
+            *d_pos++ += src[0] * chan->volume_L;
+            *d_pos++ += src[0] * chan->volume_R;
+        }
+        else
+        {
+            *d_pos++ += src[0] * chan->volume_L;
+        }
+
+        offset += chan->delta;
+    }
+
+    chan->offset = offset;
+
+    // frames before this one can be overwritten
+    if (offset < chan->length)
+        S->read_frame.store(S->base + (offset >> 10), std::memory_order_release);
+    else
+        S->read_frame.store(S->base + chan->data->length, std::memory_order_release);
+}
+
 static void MixOneChannel(mix_channel_c *chan, int pairs)
 {
     if (sfxpaused && chan->category >= SNCAT_Player)
@@ -341,7 +456,9 @@ static void MixOneChannel(mix_channel_c *chan, int pairs)
             SYS_ASSERT(chan->offset + count * chan->delta >= chan->length);
         }
 
-        if (chan->data->mode == SBUF_Interleaved)
+        if (chan->stream)
+            MixStream(chan, dest, count);
+        else if (chan->data->mode == SBUF_Interleaved)
             MixInterleaved(chan, dest, count);
         else if (dev_stereo)
             MixStereo(chan, dest, count);
@@ -361,6 +478,9 @@ static void MixOneChannel(mix_channel_c *chan, int pairs)
             chan->loop = false;
 
             chan->offset = 0;
+
+            if (chan->stream)
+                chan->stream->base += chan->data->length;
         }
 
         dest += count * (dev_stereo ? 2 : 1);
@@ -368,16 +488,44 @@ static void MixOneChannel(mix_channel_c *chan, int pairs)
     }
 }
 
+static void QueueFinishBuffer(void)
+{
+    // place current buffer onto free ring
+    if (queue_chan->data)
+        RingPush(free_ring, queue_chan->data, 0);
+
+    queue_chan->state = CHAN_Finished;
+    queue_chan->data  = NULL;
+}
+
 static bool QueueNextBuffer(void)
 {
-    if (playing_qbufs.empty())
+    sound_data_c *buf;
+
+    for (;;)
     {
-        queue_chan->state = CHAN_Finished;
-        queue_chan->data  = NULL;
-        return false;
-    }
+        int gen;
+
+        buf = RingPop(playing_ring, &gen);
+
+        if (!buf)
+        {
+            queue_chan->state = CHAN_Finished;
+            queue_chan->data  = NULL;
+            return false;
+        }
+
+        // check the generation *after* getting the buffer, since newer
+        // buffers are only added after the generation is bumped.
+        if (gen == queue_gen.load(std::memory_order_acquire))
+        {
+            queue_chan_gen = gen;
+            break;
+        }
 
-    sound_data_c *buf = playing_qbufs.front();
+        // stopped before it was played
+        RingPush(free_ring, buf, 0);
+    }
 
     queue_chan->data = buf;
 
@@ -394,9 +542,18 @@ static void MixQueues(int pairs)
 {
     mix_channel_c *chan = queue_chan;
 
-    if (!chan || !chan->data || chan->state != CHAN_Playing)
+    if (!chan)
         return;
 
+    if (chan->data && queue_chan_gen != queue_gen.load(std::memory_order_acquire))
+        QueueFinishBuffer();
+
+    if (!chan->data || chan->state != CHAN_Playing)
+    {
+        if (!QueueNextBuffer())
+            return;
+    }
+
     if (chan->volume_L == 0 && chan->volume_R == 0)
         return;
 
@@ -432,15 +589,10 @@ static void MixQueues(int pairs)
         if (chan->offset >= chan->length)
         {
             // reached end of current queued buffer.
-            // Place current buffer onto free list,
+            // Place current buffer onto free ring,
             // and enqueue the next buffer to play.
 
-            SYS_ASSERT(!playing_qbufs.empty());
-
-            sound_data_c *buf = playing_qbufs.front();
-            playing_qbufs.pop_front();
-
-            free_qbufs.push_back(buf);
+            QueueFinishBuffer();
 
             if (!QueueNextBuffer())
                 break;
@@ -517,6 +669,12 @@ void S_FreeChannels(void)
     {
         mix_channel_c *chan = mix_chan[i];
 
+        if (chan && chan->stream)
+        {
+            S_StopStream(chan->stream);
+            chan->stream = NULL;
+        }
+
         if (chan && chan->data)
         {
             S_CacheRelease(chan->data);
@@ -533,6 +691,12 @@ void S_KillChannel(int k)
 {
     mix_channel_c *chan = mix_chan[k];
 
+    if (chan->stream)
+    {
+        S_StopStream(chan->stream);
+        chan->stream = NULL;
+    }
+
     if (chan->state != CHAN_Empty)
     {
         S_CacheRelease(chan->data);
@@ -642,16 +806,19 @@ void S_QueueInit(void)
 
     I_LockAudio();
     {
-        if (free_qbufs.empty())
+        if (!queue_chan)
         {
+            queue_chan = new mix_channel_c();
+
             for (int i = 0; i < MAX_QUEUE_BUFS; i++)
             {
-                free_qbufs.push_back(new sound_data_c());
+                RingPush(free_ring, new sound_data_c(), 0);
             }
         }
 
-        if (!queue_chan)
-            queue_chan = new mix_channel_c();
+        // when re-initialising, give back the buffer being played
+        if (queue_chan->data)
+            RingPush(free_ring, queue_chan->data, 0);
 
         queue_chan->state = CHAN_Empty;
         queue_chan->data  = NULL;
@@ -666,22 +833,29 @@ void S_QueueShutdown(void)
     if (nosound)
         return;
 
+    // NOTE: the music thread must not be running here
+
     I_LockAudio();
     {
         if (queue_chan)
         {
-            // free all data on the playing / free lists.
+            // free all data in the rings (and the one being played).
             // The sound_data_c destructor takes care of data_L/R.
 
-            for (; !playing_qbufs.empty(); playing_qbufs.pop_front())
-            {
-                delete playing_qbufs.front();
-            }
-            for (; !free_qbufs.empty(); free_qbufs.pop_front())
-            {
-                delete free_qbufs.front();
-            }
+            sound_data_c *buf;
+
+            while ((buf = RingPop(playing_ring)) != NULL)
+                delete buf;
+
+            while ((buf = RingPop(free_ring)) != NULL)
+                delete buf;
+
+            for (sound_data_c *spare : spare_qbufs)
+                delete spare;
 
+            spare_qbufs.clear();
+
+            delete queue_chan->data;
             queue_chan->data = NULL;
 
             delete queue_chan;
@@ -698,17 +872,8 @@ void S_QueueStop(void)
 
     SYS_ASSERT(queue_chan);
 
-    I_LockAudio();
-    {
-        for (; !playing_qbufs.empty(); playing_qbufs.pop_front())
-        {
-            free_qbufs.push_back(playing_qbufs.front());
-        }
-
-        queue_chan->state = CHAN_Finished;
-        queue_chan->data  = NULL;
-    }
-    I_UnlockAudio();
+    // the mixer will recycle everything queued so far
+    queue_gen.fetch_add(1, std::memory_order_release);
 }
 
 sound_data_c *S_QueueGetFreeBuffer(int samples, int buf_mode)
@@ -716,19 +881,22 @@ sound_data_c *S_QueueGetFreeBuffer(int samples, int buf_mode)
     if (nosound)
         return NULL;
 
-    sound_data_c *buf = NULL;
+    sound_data_c *buf;
 
-    I_LockAudio();
+    if (!spare_qbufs.empty())
     {
-        if (!free_qbufs.empty())
-        {
-            buf = free_qbufs.front();
-            free_qbufs.pop_front();
+        buf = spare_qbufs.back();
+        spare_qbufs.pop_back();
+    }
+    else
+    {
+        buf = RingPop(free_ring);
 
-            buf->Allocate(samples, buf_mode);
-        }
+        if (!buf)
+            return NULL;
     }
-    I_UnlockAudio();
+
+    buf->Allocate(samples, buf_mode);
 
     return buf;
 }
@@ -738,18 +906,10 @@ void S_QueueAddBuffer(sound_data_c *buf, int freq)
     SYS_ASSERT(!nosound);
     SYS_ASSERT(buf);
 
-    I_LockAudio();
-    {
-        buf->freq = freq;
-
-        playing_qbufs.push_back(buf);
+    buf->freq = freq;
 
-        if (queue_chan->state != CHAN_Playing)
-        {
-            QueueNextBuffer();
-        }
-    }
-    I_UnlockAudio();
+    // only the producer changes the generation, so relaxed is fine
+    RingPush(playing_ring, buf, queue_gen.load(std::memory_order_relaxed));
 }
 
 void S_QueueReturnBuffer(sound_data_c *buf)
@@ -757,11 +917,7 @@ void S_QueueReturnBuffer(sound_data_c *buf)
     SYS_ASSERT(!nosound);
     SYS_ASSERT(buf);
 
-    I_LockAudio();
-    {
-        free_qbufs.push_back(buf);
-    }
-    I_UnlockAudio();
+    spare_qbufs.push_back(buf);
 }
 
 //--- editor settings ---
@@ -32,6 +32,7 @@
 
 // Forward declarations
 class sfxdef_c;
+class sfx_stream_c;
 struct position_c;
 
 // We use a 22.10 fixed point for sound offsets.  It's a reasonable
@@ -53,6 +54,9 @@ class mix_channel_c
 
     sound_data_c *data;
 
+    // for streamed sounds, where the samples come from
+    sfx_stream_c *stream;
+
     int         category;
     sfxdef_c   *def;
     position_c *pos;
@@ -102,9 +106,18 @@ void S_MixAllChannels(void *stream, int len);
 // 'len' is the number of samples (for stereo: pairs)
 // to mix into the stream.
 
+extern bool mix_in_game;
+// when true, the audio device just plays silence and the game calls
+// S_MixAllChannels() itself (used by frame capture).
+
 void S_UpdateSounds(position_c *listener, BAMAngle angle);
 
 //-------- API for Synthesised MUSIC --------------------
+//
+// All the calls below, apart from Init and Shutdown, are made by the
+// music producer (the music thread, or while holding the music lock)
+// and never lock the audio device.
+//
 
 void S_QueueInit(void);
 // initialise the queueing system.
@@ -115,7 +128,7 @@ void S_QueueShutdown(void);
 
 void S_QueueStop(void);
 // stop the currently playing queue.  All playing buffers
-// are moved into the free list.
+// are given back to the free list by the mixer.
 
 sound_data_c *S_QueueGetFreeBuffer(int samples, int buf_mode);
 // returns the next unused (or finished) buffer, or NULL
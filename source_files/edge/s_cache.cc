@@ -25,6 +25,12 @@
 
 #include "i_defs.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "file.h"
@@ -40,6 +46,7 @@
 #include "s_cache.h"
 #include "s_ogg.h"
 #include "s_mp3.h"
+#include "s_stream.h"
 #include "s_wav.h"
 
 #include "dm_state.h" // game_dir
@@ -56,6 +63,52 @@ extern bool var_pc_speaker_mode;
 
 static std::vector<sound_data_c *> fx_cache;
 
+// finds the cached sound for a sfxdef
+static std::unordered_map<const sfxdef_c *, sound_data_c *> fx_lookup;
+
+// sounds which are never dropped at the start of a level (menus etc)
+static std::unordered_set<const sfxdef_c *> fx_global;
+
+static int fx_hits   = 0;
+static int fx_misses = 0;
+
+typedef enum
+{
+    WARM_Queued = 0,
+    WARM_Decoding,
+    WARM_Done
+} warm_state_e;
+
+// a sound being decoded in the background.  The file data is read on
+// the game thread, only the decoding is done by the worker.
+typedef struct
+{
+    sfxdef_c *def;
+
+    uint8_t       *data;
+    int            length;
+    sound_format_e fmt;
+
+    sound_data_c *buf;
+
+    warm_state_e state;
+
+    // shown when the sound is taken from the job
+    std::string error;
+} warm_job_t;
+
+static std::thread             warm_thread;
+static bool                    warm_quit = false;
+static std::mutex              warm_lock;
+static std::condition_variable warm_cond;
+
+// jobs waiting for the worker, in priority order
+static std::deque<warm_job_t *> warm_queue;
+
+// every job whose sound has not been added to the cache yet.
+// only changed by the game thread (with the lock held).
+static std::unordered_map<const sfxdef_c *, warm_job_t *> warm_jobs;
+
 static void Load_Silence(sound_data_c *buf)
 {
     int length = 256;
@@ -66,12 +119,12 @@ static void Load_Silence(sound_data_c *buf)
     memset(buf->data_L, 0, length * sizeof(int16_t));
 }
 
-static bool Load_DOOM(sound_data_c *buf, const uint8_t *lump, int length)
+static bool Load_DOOM(sound_data_c *buf, const uint8_t *lump, int length, std::string &error)
 {
     buf->freq = lump[2] + (lump[3] << 8);
 
     if (buf->freq < 8000 || buf->freq > 48000)
-        I_Warning("Sound Load: weird frequency: %d Hz\n", buf->freq);
+        error = epi::StringFormat("Sound Load: weird frequency: %d Hz", buf->freq);
 
     if (buf->freq < 4000)
         buf->freq = 4000;
@@ -95,28 +148,23 @@ static bool Load_DOOM(sound_data_c *buf, const uint8_t *lump, int length)
     return true;
 }
 
-static bool Load_WAV(sound_data_c *buf, uint8_t *lump, int length, bool pc_speaker)
+static bool Load_WAV(sound_data_c *buf, uint8_t *lump, int length, bool pc_speaker, std::string &error)
 {
-    return S_LoadWAVSound(buf, lump, length, pc_speaker);
+    return S_LoadWAVSound(buf, lump, length, pc_speaker, error);
 }
 
-static bool Load_OGG(sound_data_c *buf, const uint8_t *lump, int length)
+static bool Load_OGG(sound_data_c *buf, const uint8_t *lump, int length, std::string &error)
 {
-    return S_LoadOGGSound(buf, lump, length);
+    return S_LoadOGGSound(buf, lump, length, error);
 }
 
-static bool Load_MP3(sound_data_c *buf, const uint8_t *lump, int length)
+static bool Load_MP3(sound_data_c *buf, const uint8_t *lump, int length, std::string &error)
 {
-    return S_LoadMP3Sound(buf, lump, length);
+    return S_LoadMP3Sound(buf, lump, length, error);
 }
 
 //----------------------------------------------------------------------------
 
-void S_CacheInit(void)
-{
-    // nothing to do
-}
-
 void S_FlushData(sound_data_c *fx)
 {
     SYS_ASSERT(fx->ref_count == 0);
@@ -124,15 +172,61 @@ void S_FlushData(sound_data_c *fx)
     fx->Free();
 }
 
+static void DeleteBuffer(sound_data_c *buf)
+{
+    // channels still playing it keep their own reference
+    if (buf->stream_src)
+        S_ReleaseStreamSource(buf->stream_src);
+
+    delete buf;
+}
+
+//
+// Waits for the worker to finish with any jobs it has started,
+// and removes every job which has not been added to the cache.
+//
+static void CancelWarmup(void)
+{
+    std::unique_lock<std::mutex> lock(warm_lock);
+
+    for (warm_job_t *job : warm_queue)
+    {
+        delete[] job->data;
+        job->state = WARM_Done;
+    }
+
+    warm_queue.clear();
+
+    for (auto &entry : warm_jobs)
+    {
+        warm_job_t *job = entry.second;
+
+        warm_cond.wait(lock, [job] { return job->state == WARM_Done; });
+
+        DeleteBuffer(job->buf);
+        delete job;
+    }
+
+    warm_jobs.clear();
+}
+
 void S_CacheClearAll(void)
 {
+    CancelWarmup();
+
     for (int i = 0; i < (int)fx_cache.size(); i++)
-        delete fx_cache[i];
+        DeleteBuffer(fx_cache[i]);
 
     fx_cache.erase(fx_cache.begin(), fx_cache.end());
+
+    fx_lookup.clear();
 }
 
-static bool DoCacheLoad(sfxdef_c *def, sound_data_c *buf)
+//
+// Reads the file or lump of a sound into memory.  Only called by the
+// game thread, as the WAD and pack code is not thread-safe.
+//
+static bool ReadSoundData(sfxdef_c *def, uint8_t **data_out, int *length_out, sound_format_e *fmt_out)
 {
     // open the file or lump, and read it into memory
     epi::File        *F;
@@ -235,33 +329,56 @@ static bool DoCacheLoad(sfxdef_c *def, sound_data_c *buf)
         fmt = Sound_DetectFormat(data, length);
     }
 
+    *data_out   = data;
+    *length_out = length;
+    *fmt_out    = fmt;
+
+    return true;
+}
+
+//
+// Converts the sound data into samples (or sets up streaming).
+// This is what the warmup worker does, so it only uses the sfxdef and
+// the data it is given, and nothing is logged: problems are put into
+// 'error' and shown by ReportSoundLoad() on the game thread.
+//
+static bool DecodeSoundData(sfxdef_c *def, sound_data_c *buf, uint8_t *data, int length, sound_format_e fmt,
+                            std::string &error)
+{
+    // long sounds are kept compressed, which takes over the data
+    if (!var_pc_speaker_mode && S_LoadStreamedSound(buf, data, length, fmt, def->streamed))
+    {
+        buf->is_sfx = false;
+        return true;
+    }
+
     bool OK = false;
 
     switch (fmt)
     {
     case FMT_WAV:
-        OK = Load_WAV(buf, data, length, false);
+        OK = Load_WAV(buf, data, length, false, error);
         break;
 
     case FMT_OGG:
-        OK = Load_OGG(buf, data, length);
+        OK = Load_OGG(buf, data, length, error);
         break;
 
     case FMT_MP3:
-        OK = Load_MP3(buf, data, length);
+        OK = Load_MP3(buf, data, length, error);
         break;
 
     // Double-check first byte here because pack filename detection could
     // return FMT_SPK for either
     case FMT_SPK:
         if (data[0] == 0x3)
-            OK = Load_DOOM(buf, data, length);
+            OK = Load_DOOM(buf, data, length, error);
         else
-            OK = Load_WAV(buf, data, length, true);
+            OK = Load_WAV(buf, data, length, true, error);
         break;
 
     case kDoomImage:
-        OK = Load_DOOM(buf, data, length);
+        OK = Load_DOOM(buf, data, length, error);
         break;
 
     default:
@@ -276,37 +393,190 @@ static bool DoCacheLoad(sfxdef_c *def, sound_data_c *buf)
     return OK;
 }
 
-sound_data_c *S_CacheLoad(sfxdef_c *def)
+
+static void LoadSoundDirect(sfxdef_c *def, sound_data_c *buf, std::string &error)
 {
-    bool pc_speaker_skip = false;
+    uint8_t       *data   = NULL;
+    int            length = 0;
+    sound_format_e fmt    = kUnknownImage;
 
-    if (var_pc_speaker_mode)
+    if (!ReadSoundData(def, &data, &length, &fmt) || !DecodeSoundData(def, buf, data, length, fmt, error))
+        Load_Silence(buf);
+}
+
+//
+// Shows what happened when loading a sound.  Only called by the game
+// thread (the console and the log files are not thread-safe).
+//
+static void ReportSoundLoad(sfxdef_c *def, sound_data_c *buf, const std::string &error)
+{
+    if (!error.empty())
+        I_Warning("%s [%s]\n", error.c_str(), def->name.c_str());
+
+    I_Debugf("SFX Loader: %s: %d frames, %d Hz, %s%s\n", def->name.c_str(), buf->length, buf->freq,
+             (buf->mode == SBUF_Mono) ? "mono" : "stereo", buf->stream_src ? ", streamed" : "");
+}
+
+static void WarmThreadLoop(void)
+{
+    std::unique_lock<std::mutex> lock(warm_lock);
+
+    for (;;)
     {
-        if (def->pc_speaker_sound.empty())
-            pc_speaker_skip = true;
+        warm_cond.wait(lock, [] { return warm_quit || !warm_queue.empty(); });
+
+        if (warm_quit)
+            break;
+
+        warm_job_t *job = warm_queue.front();
+        warm_queue.pop_front();
+
+        job->state = WARM_Decoding;
+
+        lock.unlock();
+
+        if (!DecodeSoundData(job->def, job->buf, job->data, job->length, job->fmt, job->error))
+            Load_Silence(job->buf);
+
+        lock.lock();
+
+        job->state = WARM_Done;
+
+        warm_cond.notify_all();
     }
+}
 
-    for (int i = 0; i < (int)fx_cache.size(); i++)
+void S_CacheInit(void)
+{
+    if (warm_thread.joinable())
+        return;
+
+    warm_quit = false;
+
+    warm_thread = std::thread(WarmThreadLoop);
+}
+
+void S_CacheShutdown(void)
+{
+    if (warm_thread.joinable())
     {
-        if (fx_cache[i]->priv_data == (void *)def)
         {
-            fx_cache[i]->ref_count++;
-            return fx_cache[i];
+            std::lock_guard<std::mutex> lock(warm_lock);
+            warm_quit = true;
         }
+
+        warm_cond.notify_all();
+
+        // can happen when a fatal error occurs while decoding, in which
+        // case the job would never be finished, so leave everything.
+        if (std::this_thread::get_id() == warm_thread.get_id())
+        {
+            warm_thread.detach();
+            return;
+        }
+
+        warm_thread.join();
     }
 
-    // create data structure
-    sound_data_c *buf = new sound_data_c();
+    S_CacheClearAll();
+}
+
+static void AddToCache(sfxdef_c *def, sound_data_c *buf)
+{
+    buf->priv_data = def;
 
     fx_cache.push_back(buf);
+    fx_lookup[def] = buf;
+}
 
-    buf->priv_data = def;
-    buf->ref_count = 1;
+//
+// Takes the sound for 'def' from the warmup jobs, waiting for the
+// worker or decoding it here as needed.  Returns NULL when there is
+// no job for the sound, otherwise 'error' gets any decoding problem.
+//
+static sound_data_c *TakeWarmJob(sfxdef_c *def, bool *was_ready, std::string &error)
+{
+    std::unique_lock<std::mutex> lock(warm_lock);
 
-    if (pc_speaker_skip)
-        Load_Silence(buf);
-    else if (!DoCacheLoad(def, buf))
-        Load_Silence(buf);
+    auto find = warm_jobs.find(def);
+
+    if (find == warm_jobs.end())
+        return NULL;
+
+    warm_job_t *job = find->second;
+
+    warm_jobs.erase(find);
+
+    *was_ready = (job->state == WARM_Done);
+
+    if (job->state == WARM_Queued)
+    {
+        // the worker has not got to it yet, so decode it now
+        for (auto iter = warm_queue.begin(); iter != warm_queue.end(); iter++)
+        {
+            if (*iter == job)
+            {
+                warm_queue.erase(iter);
+                break;
+            }
+        }
+
+        lock.unlock();
+
+        if (!DecodeSoundData(job->def, job->buf, job->data, job->length, job->fmt, job->error))
+            Load_Silence(job->buf);
+    }
+    else
+    {
+        warm_cond.wait(lock, [job] { return job->state == WARM_Done; });
+    }
+
+    sound_data_c *buf = job->buf;
+
+    error = job->error;
+
+    delete job;
+
+    return buf;
+}
+
+sound_data_c *S_CacheLoad(sfxdef_c *def)
+{
+    auto find = fx_lookup.find(def);
+
+    if (find != fx_lookup.end())
+    {
+        fx_hits++;
+
+        find->second->ref_count++;
+        return find->second;
+    }
+
+    bool          was_ready = false;
+    std::string   error;
+    sound_data_c *buf       = TakeWarmJob(def, &was_ready, error);
+
+    if (was_ready)
+        fx_hits++;
+    else
+        fx_misses++;
+
+    if (!buf)
+    {
+        // not warmed up, load it now
+        buf = new sound_data_c();
+
+        if (var_pc_speaker_mode && def->pc_speaker_sound.empty())
+            Load_Silence(buf);
+        else
+            LoadSoundDirect(def, buf, error);
+    }
+
+    ReportSoundLoad(def, buf, error);
+
+    AddToCache(def, buf);
+
+    buf->ref_count = 1;
 
     return buf;
 }
@@ -318,5 +588,175 @@ void S_CacheRelease(sound_data_c *data)
     data->ref_count--;
 }
 
+//
+// Drops the sounds which are not in use, not wanted by the new
+// level and are not global.
+//
+static void DropUnusedSounds(const std::unordered_set<const sfxdef_c *> &wanted)
+{
+    size_t dest = 0;
+
+    for (size_t i = 0; i < fx_cache.size(); i++)
+    {
+        sound_data_c   *buf = fx_cache[i];
+        const sfxdef_c *def = (const sfxdef_c *)buf->priv_data;
+
+        if (buf->ref_count == 0 && fx_global.count(def) == 0 && wanted.count(def) == 0)
+        {
+            fx_lookup.erase(def);
+            DeleteBuffer(buf);
+            continue;
+        }
+
+        fx_cache[dest++] = buf;
+    }
+
+    fx_cache.resize(dest);
+
+    // same for the warmup jobs, apart from ones being decoded (they
+    // will be dropped next time).
+    std::lock_guard<std::mutex> lock(warm_lock);
+
+    for (auto iter = warm_jobs.begin(); iter != warm_jobs.end();)
+    {
+        warm_job_t *job = iter->second;
+
+        if (fx_global.count(job->def) > 0 || wanted.count(job->def) > 0 || job->state == WARM_Decoding)
+        {
+            iter++;
+            continue;
+        }
+
+        if (job->state == WARM_Queued)
+        {
+            for (auto q = warm_queue.begin(); q != warm_queue.end(); q++)
+            {
+                if (*q == job)
+                {
+                    warm_queue.erase(q);
+                    break;
+                }
+            }
+
+            delete[] job->data;
+        }
+
+        DeleteBuffer(job->buf);
+        delete job;
+
+        iter = warm_jobs.erase(iter);
+    }
+}
+
+void S_CacheAddEffect(std::vector<sfxdef_c *> &defs, const sfx_t *sfx)
+{
+    if (!sfx)
+        return;
+
+    for (int i = 0; i < sfx->num; i++)
+        defs.push_back(sfxdefs[sfx->sounds[i]]);
+}
+
+void S_CacheWarmup(const std::vector<sfxdef_c *> &defs, bool level)
+{
+    if (!warm_thread.joinable())
+        return;
+
+    if (level)
+    {
+        std::unordered_set<const sfxdef_c *> wanted(defs.begin(), defs.end());
+
+        DropUnusedSounds(wanted);
+    }
+    else
+    {
+        fx_global.insert(defs.begin(), defs.end());
+    }
+
+    int count = 0;
+
+    for (sfxdef_c *def : defs)
+    {
+        if (fx_lookup.count(def) > 0)
+            continue;
+
+        if (var_pc_speaker_mode && def->pc_speaker_sound.empty())
+            continue;
+
+        {
+            std::lock_guard<std::mutex> lock(warm_lock);
+
+            if (warm_jobs.count(def) > 0)
+                continue;
+        }
+
+        warm_job_t *job = new warm_job_t;
+
+        job->def   = def;
+        job->data  = NULL;
+        job->state = WARM_Queued;
+
+        if (!ReadSoundData(def, &job->data, &job->length, &job->fmt))
+        {
+            delete job;
+            continue;
+        }
+
+        job->buf = new sound_data_c();
+
+        std::lock_guard<std::mutex> lock(warm_lock);
+
+        warm_jobs[def] = job;
+        warm_queue.push_back(job);
+
+        count++;
+    }
+
+    if (count > 0)
+        warm_cond.notify_all();
+
+    I_Debugf("SFX Cache: %d sounds queued for warmup\n", count);
+}
+
+static int64_t BufferBytes(const sound_data_c *buf)
+{
+    if (buf->stream_src)
+        return buf->stream_src->length;
+
+    int64_t bytes = (int64_t)buf->length * (buf->mode == SBUF_Mono ? 1 : 2) * sizeof(int16_t);
+
+    // the effect buffers are the same size
+    if (buf->fx_data_L)
+        bytes *= 2;
+
+    return bytes;
+}
+
+void S_CacheShowStats(void)
+{
+    int64_t bytes = 0;
+
+    for (sound_data_c *buf : fx_cache)
+        bytes += BufferBytes(buf);
+
+    int pending = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(warm_lock);
+
+        for (auto &entry : warm_jobs)
+        {
+            if (entry.second->state == WARM_Done)
+                bytes += BufferBytes(entry.second->buf);
+            else
+                pending++;
+        }
+    }
+
+    I_Printf("SFX Cache: %d sounds resident (%d KB), %d being warmed up\n", (int)fx_cache.size(),
+             (int)(bytes / 1024), pending);
+    I_Printf("SFX Cache: %d hits, %d misses\n", fx_hits, fx_misses);
+}
+
 //--- editor settings ---
 // vi:ts=4:sw=4:noexpandtab
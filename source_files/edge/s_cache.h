@@ -26,12 +26,17 @@
 #ifndef __S_CACHE_H__
 #define __S_CACHE_H__
 
+#include <vector>
+
 #include "sound_data.h"
 
 class sfxdef_c;
+struct sfx_s;
 
 void S_CacheInit(void);
-// setup the sound cache system.
+// setup the sound cache system (starts the warmup worker).
+
+void S_CacheShutdown(void);
 
 void S_CacheClearAll(void);
 // clear all sounds from the cache.
@@ -49,6 +54,17 @@ void S_CacheRelease(sound_data_c *data);
 // Typically though the sound is kept, as it will likely
 // be needed again shortly.
 
+void S_CacheAddEffect(std::vector<sfxdef_c *> &defs, const struct sfx_s *sfx);
+// add the sfxdef (or all of them for a wildcard) for a sound, if any.
+// Duplicates are fine.
+
+void S_CacheWarmup(const std::vector<sfxdef_c *> &defs, bool level);
+// read the given sounds and have them decoded in the background,
+// earlier ones first.  Sounds for a level replace the previous
+// level's (when not in use), other sounds are kept for good.
+
+void S_CacheShowStats(void);
+
 #endif /* __S_CACHE_H__ */
 
 //--- editor settings ---
@@ -22,6 +22,7 @@
 #include "file.h"
 #include "filesystem.h"
 #include "sound_gather.h"
+#include "str_util.h"
 
 #include "playlist.h"
 
@@ -29,6 +30,7 @@
 #include "s_blit.h"
 #include "s_music.h"
 #include "s_mp3.h"
+#include "s_stream.h"
 #include "w_wad.h"
 
 #define DR_MP3_NO_STDIO
@@ -289,19 +291,19 @@ abstract_music_c *S_PlayMP3Music(uint8_t *data, int length, bool looping)
     return player;
 }
 
-bool S_LoadMP3Sound(sound_data_c *buf, const uint8_t *data, int length)
+bool S_LoadMP3Sound(sound_data_c *buf, const uint8_t *data, int length, std::string &error)
 {
     drmp3 mp3;
 
     if (!drmp3_init_memory(&mp3, data, length, nullptr))
     {
-        I_Warning("Failed to load MP3 sound (corrupt mp3?)\n");
+        error = "Failed to load MP3 sound (corrupt mp3?)";
         return false;
     }
 
     if (mp3.channels > 2)
     {
-        I_Warning("MP3 SFX Loader: too many channels: %d\n", mp3.channels);
+        error = epi::StringFormat("MP3 SFX Loader: too many channels: %d", mp3.channels);
         drmp3_uninit(&mp3);
         return false;
     }
@@ -311,13 +313,11 @@ bool S_LoadMP3Sound(sound_data_c *buf, const uint8_t *data, int length)
     if (framecount <=
         0) // I think the initial loading would fail if this were the case, but just as a sanity check - Dasho
     {
-        I_Warning("MP3 SFX Loader: no samples!\n");
+        error = "MP3 SFX Loader: no samples!";
         drmp3_uninit(&mp3);
         return false;
     }
 
-    I_Debugf("MP3 SFX Loader: freq %d Hz, %d channels\n", mp3.sampleRate, mp3.channels);
-
     bool is_stereo = (mp3.channels > 1);
 
     buf->freq = mp3.sampleRate;
@@ -329,12 +329,59 @@ bool S_LoadMP3Sound(sound_data_c *buf, const uint8_t *data, int length)
     gather.CommitChunk(drmp3_read_pcm_frames_s16(&mp3, framecount, buffer));
 
     if (!gather.Finalise(buf, is_stereo))
-        I_Warning("MP3 SFX Loader: no samples!\n");
+        error = "MP3 SFX Loader: no samples!";
 
     drmp3_uninit(&mp3);
 
     return true;
 }
 
+//----------------------------------------------------------------------------
+
+class mp3_decoder_c : public sfx_decoder_c
+{
+  public:
+    drmp3 mp3;
+
+  public:
+    ~mp3_decoder_c()
+    {
+        drmp3_uninit(&mp3);
+    }
+
+    int Decode(int16_t *dest, int frames)
+    {
+        return (int)drmp3_read_pcm_frames_s16(&mp3, frames, dest);
+    }
+
+    void Rewind(void)
+    {
+        drmp3_seek_to_pcm_frame(&mp3, 0);
+    }
+};
+
+sfx_decoder_c *S_OpenMP3Decoder(const uint8_t *data, int length, int64_t total_frames)
+{
+    mp3_decoder_c *dec = new mp3_decoder_c;
+
+    if (!drmp3_init_memory(&dec->mp3, data, length, nullptr))
+    {
+        // nothing to uninit
+        memset(&dec->mp3, 0, sizeof(dec->mp3));
+
+        delete dec;
+        return NULL;
+    }
+
+    dec->freq         = dec->mp3.sampleRate;
+    dec->channels     = dec->mp3.channels;
+    dec->total_frames = total_frames;
+
+    if (total_frames < 0)
+        dec->total_frames = (int64_t)drmp3_get_pcm_frame_count(&dec->mp3);
+
+    return dec;
+}
+
 //--- editor settings ---
 // vi:ts=4:sw=4:noexpandtab
@@ -29,7 +29,15 @@
 
 abstract_music_c *S_PlayMP3Music(uint8_t *data, int length, bool looping);
 
-bool S_LoadMP3Sound(sound_data_c *buf, const uint8_t *data, int length);
+// 'error' is set when something went wrong, see S_LoadWAVSound()
+bool S_LoadMP3Sound(sound_data_c *buf, const uint8_t *data, int length, std::string &error);
+
+class sfx_decoder_c;
+
+// for streamed sound effects, the data must stay valid.  'total_frames'
+// is the length of the sound when already known, otherwise -1 (finding
+// it means reading through the whole file).
+sfx_decoder_c *S_OpenMP3Decoder(const uint8_t *data, int length, int64_t total_frames);
 
 #endif /* __MP3PLAYER_H__ */
 
@@ -44,6 +44,11 @@
 #include "w_files.h"
 #include "w_wad.h"
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 // music slider value
 DEF_CVAR(mus_volume, "0.15", CVAR_ARCHIVE)
 
@@ -52,6 +57,17 @@ bool nomusic = false;
 // Current music handle
 static abstract_music_c *music_player;
 
+// The music thread calls the player's Ticker() to decode or synthesise
+// music into the queue, the game thread only starts, stops, pauses and
+// resumes it.  The lock is held for any use of music_player.
+static std::mutex        music_lock;
+static std::thread       music_thread;
+static std::atomic<bool> music_thread_quit(false);
+
+// how long the music thread sleeps between ticks, in milliseconds.
+// the queue holds much more than this, even for small buffers.
+#define MUSIC_THREAD_SLEEP 5
+
 int         entry_playing = -1;
 static bool entry_looped;
 bool        var_pc_speaker_mode = false;
@@ -168,6 +184,9 @@ void S_ChangeMusic(int entrynum, bool loop)
 
     // NOTE: players are responsible for freeing 'data'
 
+    // starting a player fills the queue, so the music thread must wait
+    std::lock_guard<std::mutex> lock(music_lock);
+
     switch (fmt)
     {
     case FMT_OGG:
@@ -225,12 +244,16 @@ void S_ChangeMusic(int entrynum, bool loop)
 
 void S_ResumeMusic(void)
 {
+    std::lock_guard<std::mutex> lock(music_lock);
+
     if (music_player)
         music_player->Resume();
 }
 
 void S_PauseMusic(void)
 {
+    std::lock_guard<std::mutex> lock(music_lock);
+
     if (music_player)
         music_player->Pause();
 }
@@ -239,11 +262,15 @@ void S_StopMusic(void)
 {
     // You can't stop the rock!! This does...
 
-    if (music_player)
     {
-        music_player->Stop();
-        delete music_player;
-        music_player = NULL;
+        std::lock_guard<std::mutex> lock(music_lock);
+
+        if (music_player)
+        {
+            music_player->Stop();
+            delete music_player;
+            music_player = NULL;
+        }
     }
 
     entry_playing = -1;
@@ -252,8 +279,56 @@ void S_StopMusic(void)
 
 void S_MusicTicker(void)
 {
+    // the music thread does this when it is running
+    if (music_thread.joinable())
+        return;
+
+    std::lock_guard<std::mutex> lock(music_lock);
+
     if (music_player)
         music_player->Ticker();
 }
+
+static void MusicThreadLoop(void)
+{
+    while (!music_thread_quit.load(std::memory_order_acquire))
+    {
+        {
+            std::lock_guard<std::mutex> lock(music_lock);
+
+            if (music_player)
+                music_player->Ticker();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(MUSIC_THREAD_SLEEP));
+    }
+}
+
+void S_StartMusicThread(void)
+{
+    if (nomusic || music_thread.joinable())
+        return;
+
+    music_thread_quit.store(false, std::memory_order_release);
+
+    music_thread = std::thread(MusicThreadLoop);
+}
+
+void S_StopMusicThread(void)
+{
+    if (!music_thread.joinable())
+        return;
+
+    music_thread_quit.store(true, std::memory_order_release);
+
+    // can happen when a fatal error occurs while decoding
+    if (std::this_thread::get_id() == music_thread.get_id())
+    {
+        music_thread.detach();
+        return;
+    }
+
+    music_thread.join();
+}
 //--- editor settings ---
 // vi:ts=4:sw=4:noexpandtab
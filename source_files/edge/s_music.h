@@ -62,6 +62,10 @@ void S_PauseMusic(void);
 void S_StopMusic(void);
 void S_MusicTicker(void);
 
+// the music thread runs the player's Ticker while sound is active
+void S_StartMusicThread(void);
+void S_StopMusicThread(void);
+
 #endif /* __S_MUSIC_H__ */
 
 //--- editor settings ---
@@ -28,6 +28,7 @@
 #include "file.h"
 #include "filesystem.h"
 #include "sound_gather.h"
+#include "str_util.h"
 
 #include "playlist.h"
 
@@ -35,6 +36,7 @@
 #include "s_blit.h"
 #include "s_music.h"
 #include "s_ogg.h"
+#include "s_stream.h"
 #include "w_wad.h"
 
 #define OGGV_NUM_SAMPLES 1024
@@ -434,7 +436,7 @@ abstract_music_c *S_PlayOGGMusic(uint8_t *data, int length, bool looping)
     return player;
 }
 
-bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length)
+bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length, std::string &error)
 {
     datalump_t ogg_lump;
 
@@ -455,7 +457,7 @@ bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length)
 
     if (result < 0)
     {
-        I_Warning("Failed to load OGG sound (corrupt ogg?) error=%d\n", result);
+        error = epi::StringFormat("Failed to load OGG sound (corrupt ogg?) error=%d", result);
 
         return false;
     }
@@ -463,11 +465,9 @@ bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length)
     vorbis_info *vorbis_inf = ov_info(&ogg_stream, -1);
     SYS_ASSERT(vorbis_inf);
 
-    I_Debugf("OGG SFX Loader: freq %d Hz, %d channels\n", (int)vorbis_inf->rate, (int)vorbis_inf->channels);
-
     if (vorbis_inf->channels > 2)
     {
-        I_Warning("OGG Sfx Loader: too many channels: %d\n", vorbis_inf->channels);
+        error = epi::StringFormat("OGG Sfx Loader: too many channels: %d", vorbis_inf->channels);
 
         ogg_lump.size = 0;
         ov_clear(&ogg_stream);
@@ -507,7 +507,7 @@ bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length)
         {
             gather.DiscardChunk();
 
-            I_Warning("Problem occurred while loading OGG (%d)\n", got_size);
+            error = epi::StringFormat("Problem occurred while loading OGG (%d)", got_size);
             break;
         }
 
@@ -516,15 +516,97 @@ bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length)
         gather.CommitChunk(got_size);
     }
 
-    if (!gather.Finalise(buf, is_stereo))
-        I_Error("OGG SFX Loader: no samples!\n");
+    bool OK = gather.Finalise(buf, is_stereo);
+
+    if (!OK)
+        error = "OGG SFX Loader: no samples!";
 
     ov_clear(&ogg_stream);
 
     // free the data
     delete[] data;
 
-    return true;
+    return OK;
+}
+
+//----------------------------------------------------------------------------
+
+class ogg_decoder_c : public sfx_decoder_c
+{
+  public:
+    datalump_t     ogg_lump;
+    OggVorbis_File ogg_stream;
+
+  public:
+    ~ogg_decoder_c()
+    {
+        ov_clear(&ogg_stream);
+    }
+
+    int Decode(int16_t *dest, int frames)
+    {
+        int ogg_endian = (kByteOrder == kLittleEndian) ? 0 : 1;
+
+        int done = 0;
+
+        while (done < frames)
+        {
+            int section;
+            int got_size = ov_read(&ogg_stream, (char *)(dest + done * channels),
+                                   (frames - done) * channels * sizeof(int16_t), ogg_endian, sizeof(int16_t),
+                                   1 /* signed data */, &section);
+
+            if (got_size == OV_HOLE) // ignore corruption
+                continue;
+
+            if (got_size <= 0) // EOF or ERROR
+                break;
+
+            done += got_size / (channels * sizeof(int16_t));
+        }
+
+        return done;
+    }
+
+    void Rewind(void)
+    {
+        ov_raw_seek(&ogg_stream, 0);
+    }
+};
+
+sfx_decoder_c *S_OpenOGGDecoder(const uint8_t *data, int length)
+{
+    ogg_decoder_c *dec = new ogg_decoder_c;
+
+    dec->ogg_lump.data = data;
+    dec->ogg_lump.size = length;
+    dec->ogg_lump.pos  = 0;
+
+    ov_callbacks CB;
+
+    CB.read_func  = oggplayer_memread;
+    CB.seek_func  = oggplayer_memseek;
+    CB.close_func = oggplayer_memclose;
+    CB.tell_func  = oggplayer_memtell;
+
+    if (ov_open_callbacks((void *)&dec->ogg_lump, &dec->ogg_stream, NULL, 0, CB) < 0)
+    {
+        // ov_open_callbacks clears the stream on failure
+        dec->ogg_lump.size = 0;
+        memset(&dec->ogg_stream, 0, sizeof(dec->ogg_stream));
+
+        delete dec;
+        return NULL;
+    }
+
+    vorbis_info *vorbis_inf = ov_info(&dec->ogg_stream, -1);
+    SYS_ASSERT(vorbis_inf);
+
+    dec->freq         = vorbis_inf->rate;
+    dec->channels     = vorbis_inf->channels;
+    dec->total_frames = ov_pcm_total(&dec->ogg_stream, -1);
+
+    return dec;
 }
 
 //--- editor settings ---
@@ -29,7 +29,13 @@
 
 abstract_music_c *S_PlayOGGMusic(uint8_t *data, int length, bool looping);
 
-bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length);
+// 'error' is set when something went wrong, see S_LoadWAVSound()
+bool S_LoadOGGSound(sound_data_c *buf, const uint8_t *data, int length, std::string &error);
+
+class sfx_decoder_c;
+
+// for streamed sound effects, the data must stay valid
+sfx_decoder_c *S_OpenOGGDecoder(const uint8_t *data, int length);
 
 #endif /* __OGGPLAYER_H__ */
 
@@ -20,6 +20,10 @@
 #include "epi_sdl.h"
 #include "i_sound.h"
 
+#include "game.h"
+#include "style.h"
+#include "switch.h"
+
 #include "dm_state.h"
 #include "m_argv.h"
 #include "m_misc.h"
@@ -29,6 +33,8 @@
 #include "s_sound.h"
 #include "s_cache.h"
 #include "s_blit.h"
+#include "s_music.h"
+#include "s_stream.h"
 
 #include "p_local.h" // P_ApproxDistance
 #include "p_user.h"  // room_area
@@ -270,8 +276,14 @@ void S_Init(void)
 
     S_QueueInit();
 
+    S_StreamInit();
+
+    S_CacheInit();
+
     // okidoke, start the ball rolling!
     SDL_PauseAudioDevice(mydev_id, 0);
+
+    S_StartMusicThread();
 }
 
 void S_Shutdown(void)
@@ -279,6 +291,8 @@ void S_Shutdown(void)
     if (nosound)
         return;
 
+    S_StopMusicThread();
+
     SDL_PauseAudioDevice(mydev_id, 1);
 
     // make sure mixing thread is not running our code
@@ -288,6 +302,10 @@ void S_Shutdown(void)
     S_QueueShutdown();
 
     S_FreeChannels();
+
+    S_StreamShutdown();
+
+    S_CacheShutdown();
 }
 
 // Not-rejigged-yet stuff..
@@ -318,6 +336,14 @@ static void S_PlaySound(int idx, sfxdef_c *def, int category, position_c *pos, i
     chan->state = CHAN_Playing;
     chan->data  = buf;
 
+    if (chan->stream)
+        S_StopStream(chan->stream);
+
+    chan->stream = NULL;
+
+    if (buf->stream_src)
+        chan->stream = S_StartStream(buf, def->looping);
+
     // I_Printf("chan=%p data=%p\n", chan, chan->data);
 
     chan->def      = def;
@@ -449,7 +475,12 @@ void S_StartFX(sfx_t *sfx, int category, position_c *pos, int flags)
     if (!buf)
         return;
 
-    if (vacuum_sfx)
+    // streamed sounds are played without these effects
+    if (buf->stream_src)
+    {
+        // nothing to do
+    }
+    else if (vacuum_sfx)
         buf->Mix_Vacuum();
     else if (submerged_sfx)
         buf->Mix_Submerged();
@@ -570,16 +601,47 @@ void S_ChangeChannelNum(void)
     I_UnlockAudio();
 }
 
+//
+// Warms up the sounds which are not tied to a level: menus,
+// switches and intermissions.  The rest are done per level.
+//
 void S_PrecacheSounds(void)
 {
-    if (var_cache_sfx)
+    if (nosound || !var_cache_sfx)
+        return;
+
+    std::vector<sfxdef_c *> defs;
+
+    for (auto style : styledefs)
     {
-        E_ProgressMessage("Precaching SFX...");
-        for (int i = 0; i < sfxdefs.size(); i++)
-        {
-            S_CacheLoad(sfxdefs[i]);
-        }
+        const soundstyle_c &S = style->sounds;
+
+        S_CacheAddEffect(defs, S.begin);
+        S_CacheAddEffect(defs, S.end);
+        S_CacheAddEffect(defs, S.select);
+        S_CacheAddEffect(defs, S.back);
+        S_CacheAddEffect(defs, S.error);
+        S_CacheAddEffect(defs, S.move);
+        S_CacheAddEffect(defs, S.slider);
     }
+
+    for (auto sw : switchdefs)
+    {
+        S_CacheAddEffect(defs, sw->on_sfx);
+        S_CacheAddEffect(defs, sw->off_sfx);
+    }
+
+    for (auto game : gamedefs)
+    {
+        S_CacheAddEffect(defs, game->percent);
+        S_CacheAddEffect(defs, game->done);
+        S_CacheAddEffect(defs, game->endmap);
+        S_CacheAddEffect(defs, game->nextmap);
+        S_CacheAddEffect(defs, game->accel_snd);
+        S_CacheAddEffect(defs, game->frag_snd);
+    }
+
+    S_CacheWarmup(defs, false);
 }
 
 void S_ResumeAudioDevice()
@@ -0,0 +1,339 @@
+//----------------------------------------------------------------------------
+//  EDGE Streamed Sound Effects
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Long sounds (ambient loops, voice-overs) are kept compressed in the
+//  cache.  Each channel playing one gets its own decoder and a ring of
+//  samples, which a worker thread keeps topped up.  Each pass through
+//  the sound produces exactly as many frames as the sound's length,
+//  which the mixer relies on for looping.
+//
+//----------------------------------------------------------------------------
+
+#include "i_defs.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "s_mp3.h"
+#include "s_ogg.h"
+#include "s_stream.h"
+
+extern bool dev_stereo;
+
+// sounds which decode to more than this are streamed
+#define STREAM_MIN_BYTES (2 * 1024 * 1024)
+
+// frames decoded at a time
+#define STREAM_CHUNK 2048
+
+// how long the worker sleeps between passes, in milliseconds
+#define STREAM_WORKER_SLEEP 5
+
+static std::thread       stream_thread;
+static std::atomic<bool> stream_thread_quit(false);
+
+// streams started since the worker last looked
+static std::mutex                  stream_lock;
+static std::vector<sfx_stream_c *> new_streams;
+
+// only used by the worker
+static std::vector<sfx_stream_c *> active_streams;
+
+static sfx_decoder_c *OpenDecoder(sfx_stream_source_c *source)
+{
+    switch (source->fmt)
+    {
+    case FMT_OGG:
+        return S_OpenOGGDecoder(source->data, source->length);
+
+    case FMT_MP3:
+        return S_OpenMP3Decoder(source->data, source->length, source->total_frames);
+
+    default:
+        return NULL;
+    }
+}
+
+bool S_LoadStreamedSound(sound_data_c *buf, uint8_t *data, int length, sound_format_e fmt, bool force)
+{
+    if (fmt != FMT_OGG && fmt != FMT_MP3)
+        return false;
+
+    sfx_stream_source_c *source = new sfx_stream_source_c(data, length, fmt);
+
+    sfx_decoder_c *dec = OpenDecoder(source);
+
+    bool use_it = false;
+
+    if (dec && dec->channels >= 1 && dec->channels <= 2 && dec->total_frames > 0)
+    {
+        int64_t bytes = dec->total_frames * dec->channels * (int64_t)sizeof(int16_t);
+
+        use_it = force || bytes >= STREAM_MIN_BYTES;
+    }
+
+    if (!use_it)
+    {
+        // caller still owns the data
+        source->data = NULL;
+
+        delete dec;
+        delete source;
+        return false;
+    }
+
+    buf->Free();
+
+    buf->length = (int)dec->total_frames;
+    buf->freq   = dec->freq;
+    buf->mode   = (dec->channels == 2) ? SBUF_Stereo : SBUF_Mono;
+
+    buf->stream_src = source;
+
+    // keep it for the decoders of each channel
+    source->total_frames = dec->total_frames;
+
+    delete dec;
+    return true;
+}
+
+void S_ReleaseStreamSource(sfx_stream_source_c *source)
+{
+    if (source->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete source;
+}
+
+static void DeleteStream(sfx_stream_c *S)
+{
+    delete S->decoder;
+    delete[] S->ring;
+
+    S_ReleaseStreamSource(S->source);
+
+    delete S;
+}
+
+//
+// Decodes as much as fits in the ring, up to 'max_frames'.
+//
+static void FillStream(sfx_stream_c *S, int max_frames)
+{
+    int16_t temp[STREAM_CHUNK * 2];
+
+    int channels = S->decoder->channels;
+
+    while (max_frames > 0 && !S->ended.load(std::memory_order_relaxed))
+    {
+        uint64_t w = S->write_frame.load(std::memory_order_relaxed);
+        uint64_t r = S->read_frame.load(std::memory_order_acquire);
+
+        int space = STREAM_RING_FRAMES - (int)(w - r);
+
+        if (space <= 0)
+            break;
+
+        if (S->loop_pos >= S->total_frames)
+        {
+            if (!S->looping)
+            {
+                S->ended.store(true, std::memory_order_release);
+                break;
+            }
+
+            S->decoder->Rewind();
+            S->loop_pos = 0;
+        }
+
+        int want = HMM_MIN(HMM_MIN(space, STREAM_CHUNK), HMM_MIN(max_frames, S->total_frames - S->loop_pos));
+
+        int got = S->decoder->Decode(temp, want);
+
+        // the decoder ran out early (or failed), pad the rest of this
+        // pass with silence so the length stays what the mixer expects.
+        if (got <= 0)
+        {
+            memset(temp, 0, want * channels * sizeof(int16_t));
+            got = want;
+        }
+
+        for (int i = 0; i < got; i++)
+        {
+            int16_t *dest = S->ring + ((w + i) % STREAM_RING_FRAMES) * (S->stereo ? 2 : 1);
+
+            const int16_t *src = temp + i * channels;
+
+            if (S->stereo)
+            {
+                dest[0] = src[0];
+                dest[1] = src[1];
+            }
+            else if (channels == 2)
+                dest[0] = ((int)src[0] + (int)src[1]) >> 1;
+            else
+                dest[0] = src[0];
+        }
+
+        S->write_frame.store(w + got, std::memory_order_release);
+
+        S->loop_pos += got;
+        max_frames -= got;
+    }
+}
+
+sfx_stream_c *S_StartStream(sound_data_c *buf, bool looping)
+{
+    SYS_ASSERT(buf->stream_src);
+
+    sfx_stream_c *S = new sfx_stream_c;
+
+    buf->stream_src->refs.fetch_add(1, std::memory_order_relaxed);
+
+    S->source  = buf->stream_src;
+    S->decoder = NULL;
+    S->looping = looping;
+    S->stereo  = dev_stereo && (buf->mode == SBUF_Stereo);
+
+    S->total_frames = buf->length;
+    S->loop_pos     = 0;
+
+    S->ring = new int16_t[STREAM_RING_FRAMES * (S->stereo ? 2 : 1)];
+
+    S->write_frame.store(0);
+    S->read_frame.store(0);
+    S->ended.store(false);
+    S->dead.store(false);
+
+    S->base = 0;
+
+    std::lock_guard<std::mutex> lock(stream_lock);
+
+    new_streams.push_back(S);
+
+    return S;
+}
+
+void S_StopStream(sfx_stream_c *S)
+{
+    S->dead.store(true, std::memory_order_release);
+}
+
+static void UpdateStreams(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(stream_lock);
+
+        active_streams.insert(active_streams.end(), new_streams.begin(), new_streams.end());
+        new_streams.clear();
+    }
+
+    for (size_t i = 0; i < active_streams.size();)
+    {
+        sfx_stream_c *S = active_streams[i];
+
+        if (S->dead.load(std::memory_order_acquire))
+        {
+            DeleteStream(S);
+
+            active_streams[i] = active_streams.back();
+            active_streams.pop_back();
+            continue;
+        }
+
+        if (!S->decoder && !S->ended.load(std::memory_order_relaxed))
+        {
+            S->decoder = OpenDecoder(S->source);
+
+            // could not open it (again), the channel will finish
+            if (!S->decoder)
+            {
+                S->ended.store(true, std::memory_order_release);
+                i++;
+                continue;
+            }
+        }
+
+        FillStream(S, STREAM_RING_FRAMES);
+        i++;
+    }
+}
+
+static void StreamThreadLoop(void)
+{
+    while (!stream_thread_quit.load(std::memory_order_acquire))
+    {
+        UpdateStreams();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(STREAM_WORKER_SLEEP));
+    }
+}
+
+void S_StreamStopThread(void)
+{
+    if (!stream_thread.joinable())
+        return;
+
+    stream_thread_quit.store(true, std::memory_order_release);
+
+    // can happen when a fatal error occurs while decoding
+    if (std::this_thread::get_id() == stream_thread.get_id())
+    {
+        stream_thread.detach();
+        return;
+    }
+
+    stream_thread.join();
+}
+
+void S_StreamUpdate(void)
+{
+    // the worker does this when it is running
+    if (!stream_thread.joinable())
+        UpdateStreams();
+}
+
+void S_StreamInit(void)
+{
+    if (stream_thread.joinable())
+        return;
+
+    stream_thread_quit.store(false, std::memory_order_release);
+
+    stream_thread = std::thread(StreamThreadLoop);
+}
+
+void S_StreamShutdown(void)
+{
+    // NOTE: the channels must have stopped their streams already
+
+    S_StreamStopThread();
+
+    std::lock_guard<std::mutex> lock(stream_lock);
+
+    active_streams.insert(active_streams.end(), new_streams.begin(), new_streams.end());
+    new_streams.clear();
+
+    for (sfx_stream_c *S : active_streams)
+        DeleteStream(S);
+
+    active_streams.clear();
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//  EDGE Streamed Sound Effects
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024 The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+
+#ifndef __S_STREAM_H__
+#define __S_STREAM_H__
+
+#include <atomic>
+
+#include "sound_data.h"
+#include "sound_types.h"
+
+// number of frames held by each channel's ring buffer
+#define STREAM_RING_FRAMES 16384
+
+// decodes a compressed sound in pieces (see s_ogg.cc and s_mp3.cc)
+class sfx_decoder_c
+{
+  public:
+    int     freq         = 0;
+    int     channels     = 0;
+    int64_t total_frames = 0;
+
+  public:
+    virtual ~sfx_decoder_c()
+    {
+    }
+
+    // decode up to 'frames' frames of signed 16-bit samples, which are
+    // interleaved when there are two channels.  returns the number of
+    // frames decoded, zero at the end of the sound or on an error.
+    virtual int Decode(int16_t *dest, int frames) = 0;
+
+    virtual void Rewind(void) = 0;
+};
+
+// the compressed data of a streamed sound, shared by all the channels
+// playing it and the sound cache.
+class sfx_stream_source_c
+{
+  public:
+    uint8_t       *data;
+    int            length;
+    sound_format_e fmt;
+
+    // length of the sound, found when it is loaded (-1 before then)
+    int64_t total_frames;
+
+    std::atomic<int> refs;
+
+  public:
+    sfx_stream_source_c(uint8_t *_data, int _length, sound_format_e _fmt)
+        : data(_data), length(_length), fmt(_fmt), total_frames(-1), refs(1)
+    {
+    }
+
+    ~sfx_stream_source_c()
+    {
+        delete[] data;
+    }
+};
+
+// a streamed sound being played on one mixer channel.  The stream
+// worker decodes into the ring, the mixer reads from it.
+class sfx_stream_c
+{
+  public:
+    sfx_stream_source_c *source;
+    sfx_decoder_c       *decoder; // opened by the worker
+
+    bool looping;
+    bool stereo; // ring holds L/R pairs
+
+    // only used by the worker
+    int total_frames;
+    int loop_pos;
+
+    int16_t *ring;
+
+    // frame numbers count from the start of the stream, i.e. they keep
+    // going up when the sound loops.
+    std::atomic<uint64_t> write_frame;
+    std::atomic<uint64_t> read_frame;
+
+    std::atomic<bool> ended; // no more frames will be written
+    std::atomic<bool> dead;  // the channel has finished with it
+
+    // only used by the mixer: stream frame where the channel's offset
+    // of zero is.
+    uint64_t base;
+};
+
+bool S_LoadStreamedSound(sound_data_c *buf, uint8_t *data, int length, sound_format_e fmt, bool force);
+// check if a sound should be streamed (because 'force' is true, or it
+// is long), and if so setup 'buf' to refer to the compressed data, in
+// which case 'data' is now owned by the buffer.  Only OGG and MP3 are
+// streamed.  Returns false when the sound should be loaded normally.
+
+void S_ReleaseStreamSource(sfx_stream_source_c *source);
+
+sfx_stream_c *S_StartStream(sound_data_c *buf, bool looping);
+// begin streaming a sound for a mixer channel.  Audio must be locked,
+// so nothing is decoded here: the worker opens the decoder and fills
+// the ring, and the mixer waits for it.
+
+void S_StopStream(sfx_stream_c *stream);
+// the channel is done with the stream, the worker will free it.
+
+void S_StreamInit(void);
+void S_StreamShutdown(void);
+
+void S_StreamStopThread(void);
+// stop the worker, S_StreamUpdate() must then be called regularly to
+// keep the streams filled.  Used by frame capture, which mixes the
+// sound itself.
+
+void S_StreamUpdate(void);
+// fill the streams, when the worker is not running.
+
+#endif /* __S_STREAM_H__ */
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -22,6 +22,7 @@
 #include "file.h"
 #include "filesystem.h"
 #include "sound_gather.h"
+#include "str_util.h"
 
 #include "s_cache.h"
 #include "s_blit.h"
@@ -70,7 +71,7 @@ struct SpkSndHeader
     uint16_t samples;
 };
 
-uint8_t *Convert_PCSpeaker(const uint8_t *data, int *length)
+static uint8_t *Convert_PCSpeaker(const uint8_t *data, int *length, std::string &error)
 {
     static const double   ORIG_RATE     = 140.0;
     static const int      FACTOR        = 315; // 315*140 = 44100
@@ -91,7 +92,7 @@ uint8_t *Convert_PCSpeaker(const uint8_t *data, int *length)
 
     if (*length < 4)
     {
-        I_Warning("Invalid PC Speaker Sound\n");
+        error = "Invalid PC Speaker Sound";
         return NULL;
     }
 
@@ -102,12 +103,12 @@ uint8_t *Convert_PCSpeaker(const uint8_t *data, int *length)
     // Format checks
     if (header.zero != 0) // Check for magic number
     {
-        I_Warning("Invalid Doom PC Speaker Sound\n");
+        error = "Invalid Doom PC Speaker Sound";
         return NULL;
     }
     if (header.samples > (*length - 4) || header.samples < 4) // Check for sane values
     {
-        I_Warning("Invalid Doom PC Speaker Sound\n");
+        error = "Invalid Doom PC Speaker Sound";
         return NULL;
     }
     numsamples = header.samples;
@@ -125,7 +126,7 @@ uint8_t *Convert_PCSpeaker(const uint8_t *data, int *length)
     {
         if (osamples[s] > 127)
         {
-            I_Warning("Invalid PC Speaker counter value: %d > 127", osamples[s]);
+            error = epi::StringFormat("Invalid PC Speaker counter value: %d > 127", osamples[s]);
             return NULL;
         }
         if (osamples[s] > 0)
@@ -201,22 +202,27 @@ uint8_t *Convert_PCSpeaker(const uint8_t *data, int *length)
     return new_data;
 }
 
-bool S_LoadWAVSound(sound_data_c *buf, uint8_t *data, int length, bool pc_speaker)
+bool S_LoadWAVSound(sound_data_c *buf, uint8_t *data, int length, bool pc_speaker, std::string &error)
 {
     drwav wav;
 
     if (pc_speaker)
-        data = Convert_PCSpeaker(data, &length);
+    {
+        data = Convert_PCSpeaker(data, &length, error);
+
+        if (!data)
+            return false;
+    }
 
     if (!drwav_init_memory(&wav, data, length, nullptr))
     {
-        I_Warning("Failed to load WAV sound (corrupt wav?)\n");
+        error = "Failed to load WAV sound (corrupt wav?)";
         return false;
     }
 
     if (wav.channels > 2)
     {
-        I_Warning("WAV SFX Loader: too many channels: %d\n", wav.channels);
+        error = epi::StringFormat("WAV SFX Loader: too many channels: %d", wav.channels);
         drwav_uninit(&wav);
         return false;
     }
@@ -224,13 +230,11 @@ bool S_LoadWAVSound(sound_data_c *buf, uint8_t *data, int length, bool pc_speake
     if (wav.totalPCMFrameCount <=
         0) // I think the initial loading would fail if this were the case, but just as a sanity check - Dasho
     {
-        I_Warning("WAV SFX Loader: no samples!\n");
+        error = "WAV SFX Loader: no samples!";
         drwav_uninit(&wav);
         return false;
     }
 
-    I_Debugf("WAV SFX Loader: freq %d Hz, %d channels\n", wav.sampleRate, wav.channels);
-
     bool is_stereo = (wav.channels > 1);
 
     buf->freq = wav.sampleRate;
@@ -242,7 +246,7 @@ bool S_LoadWAVSound(sound_data_c *buf, uint8_t *data, int length, bool pc_speake
     gather.CommitChunk(drwav_read_pcm_frames_s16(&wav, wav.totalPCMFrameCount, buffer));
 
     if (!gather.Finalise(buf, is_stereo))
-        I_Warning("WAV SFX Loader: no samples!\n");
+        error = "WAV SFX Loader: no samples!";
 
     drwav_uninit(&wav);
 
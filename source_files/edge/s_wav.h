@@ -25,7 +25,10 @@
 
 /* FUNCTIONS */
 
-bool S_LoadWAVSound(sound_data_c *buf, uint8_t *data, int length, bool pc_speaker);
+// 'error' is set when something went wrong (even if a sound could still
+// be made), nothing is logged since the sound cache may call this from
+// its worker thread.
+bool S_LoadWAVSound(sound_data_c *buf, uint8_t *data, int length, bool pc_speaker, std::string &error);
 
 #endif /* __WAVLOADER_H__ */
 
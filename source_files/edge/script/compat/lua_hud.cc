@@ -13,7 +13,6 @@
 #include "rad_trig.h"
 #include "r_colormap.h"
 
-extern cvar_c      r_doubleframes;
 extern bool        erraticism_active;
 extern std::string w_map_title;
 
@@ -145,7 +144,7 @@ static int HD_check_automap(lua_State *L)
 //
 static int HD_get_time(lua_State *L)
 {
-    int time = I_GetTime() / (r_doubleframes.d ? 2 : 1);
+    int time = I_GetTime();
     lua_pushnumber(L, (double)time);
     return 1;
 }
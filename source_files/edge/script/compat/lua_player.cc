@@ -1375,18 +1375,21 @@ static int MO_query_tagged(lua_State *L)
     int whattag  = (int)luaL_checknumber(L, 1);
     int whatinfo = (int)luaL_checknumber(L, 2);
 
-    mobj_t *mo;
-    std::string temp_value;
+    // things with a tag are indexed, untagged ones are not
+    mobj_t *mo = P_FindMobjFromTag(whattag);
 
-    for (mo = mobjlisthead; mo; mo = mo->next)
+    if (whattag == 0)
     {
-        if (mo->tag == whattag)
-        {
-            temp_value = GetQueryInfoFromMobj(mo, whatinfo);
-            break;
-        }
+        mo = mobjlisthead;
+        while (mo && mo->tag != 0)
+            mo = mo->next;
     }
 
+    std::string temp_value;
+
+    if (mo)
+        temp_value = GetQueryInfoFromMobj(mo, whatinfo);
+
     if (temp_value.empty())
         lua_pushstring(L, "");
     else
@@ -1852,18 +1855,22 @@ static int MO_object_info(lua_State *L)
 static int MO_tagged_info(lua_State *L)
 {
     int whattag  = (int)luaL_checknumber(L, 1);
-    mobj_t *mo;
-    std::string temp_value;
 
-    for (mo = mobjlisthead; mo; mo = mo->next)
+    // things with a tag are indexed, untagged ones are not
+    mobj_t *mo = P_FindMobjFromTag(whattag);
+
+    if (whattag == 0)
     {
-        if (mo->tag == whattag)
-        {
-            temp_value = "FOUNDIT";
-            break;
-        }
+        mo = mobjlisthead;
+        while (mo && mo->tag != 0)
+            mo = mo->next;
     }
 
+    std::string temp_value;
+
+    if (mo)
+        temp_value = "FOUNDIT";
+
     if (temp_value.empty())
     {
         lua_pushstring(L, ""); //Found nothing
@@ -44,6 +44,8 @@ typedef enum
     RM_Large  = 3
 } reverb_room_size_e;
 
+class sfx_stream_source_c;
+
 class sound_data_c
 {
   public:
@@ -65,6 +67,10 @@ class sound_data_c
     // values for the engine to use
     void *priv_data;
 
+    // for streamed sounds: the compressed data (see s_stream.cc),
+    // data_L/R are not used then.
+    sfx_stream_source_c *stream_src;
+
     int ref_count;
 
     bool is_sfx;
@@ -359,6 +359,9 @@ void SV_MobjFinaliseElems(void)
         if (seen_monsters.count(mo->info) == 0)
             seen_monsters.insert(mo->info);
     }
+
+    // tags were loaded directly into the objects
+    P_RebuildMobjTagIndex();
 }
 
 //----------------------------------------------------------------------------
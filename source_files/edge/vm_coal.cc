@@ -39,8 +39,6 @@
 
 #include "m_random.h"
 
-extern cvar_c r_doubleframes;
-
 // user interface VM
 coal::vm_c *ui_vm = nullptr;
 
@@ -139,6 +137,67 @@ void VM_CallFunction(coal::vm_c *vm, const char *name)
         I_Error("Coal script terminated with an error.\n");
 }
 
+// Handle versions of the above, for anything accessed every frame or tic.
+// Resolve the variable or function once (after VM_LoadScripts has compiled
+// everything) and keep the handle.  Setting an unresolved variable is a
+// no-op, getting one is an error, same as the named versions.
+// var_type = coal::vm_c::VAR_FLOAT, VAR_STRING or VAR_VECTOR
+
+int VM_FindVariable(coal::vm_c *vm, const char *mod_name, const char *var_name, int var_type)
+{
+    int var = vm->FindVariable(mod_name, var_name, var_type);
+
+    if (var == coal::vm_c::NOT_FOUND)
+        I_Debugf("COAL: variable %s%s%s not found\n", mod_name ? mod_name : "", mod_name ? "." : "", var_name);
+
+    return var;
+}
+
+double VM_GetFloat(coal::vm_c *vm, int var)
+{
+    return vm->GetFloat(var);
+}
+
+const char *VM_GetString(coal::vm_c *vm, int var)
+{
+    return vm->GetString(var);
+}
+
+double *VM_GetVector(coal::vm_c *vm, int var)
+{
+    return vm->GetVector(var);
+}
+
+void VM_SetFloat(coal::vm_c *vm, int var, double value)
+{
+    vm->SetFloat(var, value);
+}
+
+void VM_SetString(coal::vm_c *vm, int var, const char *value)
+{
+    vm->SetString(var, value);
+}
+
+void VM_SetVector(coal::vm_c *vm, int var, double val_1, double val_2, double val_3)
+{
+    vm->SetVector(var, val_1, val_2, val_3);
+}
+
+// returns coal::vm_c::NOT_FOUND if the function does not exist
+int VM_FindFunction(coal::vm_c *vm, const char *name)
+{
+    return vm->FindFunction(name);
+}
+
+void VM_CallFunction(coal::vm_c *vm, int func, const char *name)
+{
+    if (func == coal::vm_c::NOT_FOUND)
+        I_Error("Missing coal function: %s\n", name);
+
+    if (vm->Execute(func) != 0)
+        I_Error("Coal script terminated with an error.\n");
+}
+
 //------------------------------------------------------------------------
 //  SYSTEM MODULE
 //------------------------------------------------------------------------
@@ -441,6 +500,8 @@ class pending_coal_script_c
 
 static std::vector<pending_coal_script_c> unread_scripts;
 
+static int sys_gametic_var = coal::vm_c::NOT_FOUND;
+
 void VM_InitCoal()
 {
     E_ProgressMessage("Starting COAL VM...");
@@ -458,6 +519,8 @@ void VM_QuitCoal()
 {
     unread_scripts.clear();
 
+    sys_gametic_var = coal::vm_c::NOT_FOUND;
+
     if (ui_vm)
     {
         delete ui_vm;
@@ -473,6 +536,11 @@ void VM_AddScript(int type, std::string &data, const std::string &source)
     unread_scripts.back().data.swap(data);
 }
 
+void VM_SetGameTic(int tic)
+{
+    VM_SetFloat(ui_vm, sys_gametic_var, tic);
+}
+
 void VM_LoadScripts()
 {
     for (auto &info : unread_scripts)
@@ -488,7 +556,12 @@ void VM_LoadScripts()
 
     unread_scripts.clear();
 
-    VM_SetFloat(ui_vm, "sys", "gametic", gametic / (r_doubleframes.d ? 2 : 1));
+    sys_gametic_var = VM_FindVariable(ui_vm, "sys", "gametic", coal::vm_c::VAR_FLOAT);
+
+    VM_ResolveHUD();
+    VM_ResolvePlaysim();
+
+    VM_SetGameTic(gametic);
 
     if (W_IsLumpInPwad("STBAR"))
     {
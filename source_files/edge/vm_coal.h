@@ -32,6 +32,14 @@ void VM_LoadScripts();
 void VM_RegisterHUD();
 void VM_RegisterPlaysim();
 
+// resolve the handles used every frame, once scripts are compiled
+void VM_ResolveHUD();
+void VM_ResolvePlaysim();
+
+void VM_SetGameTic(int tic);
+double VM_UniversalYAdjust(void);
+void VM_SetInventoryEvents(bool prev, bool use, bool next);
+
 // HUD stuff
 void VM_NewGame(void);
 void VM_LoadGame(void);
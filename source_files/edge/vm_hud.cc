@@ -43,11 +43,13 @@
 
 #include <math.h>
 
-extern cvar_c      r_doubleframes;
 extern coal::vm_c *ui_vm;
 
-extern void VM_SetFloat(coal::vm_c *vm, const char *mod, const char *name, double value);
-extern void VM_CallFunction(coal::vm_c *vm, const char *name);
+extern int    VM_FindVariable(coal::vm_c *vm, const char *mod_name, const char *var_name, int var_type);
+extern int    VM_FindFunction(coal::vm_c *vm, const char *name);
+extern double VM_GetFloat(coal::vm_c *vm, int var);
+extern void   VM_SetFloat(coal::vm_c *vm, int var, double value);
+extern void   VM_CallFunction(coal::vm_c *vm, int func, const char *name);
 
 // Needed for color functions
 extern image_data_c *ReadAsEpiBlock(image_c *rim);
@@ -65,6 +67,18 @@ extern bool erraticism_active;
 static int   ui_hud_automap_flags[2]; // 0 = disabled, 1 = enabled
 static float ui_hud_automap_zoom;
 
+// handles resolved by VM_ResolveHUD()
+static int hud_x_left_var             = coal::vm_c::NOT_FOUND;
+static int hud_x_right_var            = coal::vm_c::NOT_FOUND;
+static int hud_universal_y_adjust_var = coal::vm_c::NOT_FOUND;
+
+static int hud_new_game_func    = coal::vm_c::NOT_FOUND;
+static int hud_load_game_func   = coal::vm_c::NOT_FOUND;
+static int hud_save_game_func   = coal::vm_c::NOT_FOUND;
+static int hud_begin_level_func = coal::vm_c::NOT_FOUND;
+static int hud_end_level_func   = coal::vm_c::NOT_FOUND;
+static int hud_draw_all_func    = coal::vm_c::NOT_FOUND;
+
 //------------------------------------------------------------------------
 
 RGBAColor VM_VectorToColor(double *v)
@@ -103,8 +117,8 @@ static void HD_coord_sys(coal::vm_c *vm, int argc)
 
     HUD_SetCoordSys(w, h);
 
-    VM_SetFloat(ui_vm, "hud", "x_left", hud_x_left);
-    VM_SetFloat(ui_vm, "hud", "x_right", hud_x_right);
+    VM_SetFloat(ui_vm, hud_x_left_var, hud_x_left);
+    VM_SetFloat(ui_vm, hud_x_right_var, hud_x_right);
 }
 
 // hud.game_mode()
@@ -184,7 +198,7 @@ static void HD_get_time(coal::vm_c *vm, int argc)
 {
     (void)argc;
 
-    int time = I_GetTime() / (r_doubleframes.d ? 2 : 1);
+    int time = I_GetTime();
     vm->ReturnFloat((double)time);
 }
 
@@ -1055,9 +1069,28 @@ void VM_RegisterHUD()
     ui_vm->AddNativeFunction("hud.get_image_height", HD_get_image_height);
 }
 
+void VM_ResolveHUD()
+{
+    hud_x_left_var             = VM_FindVariable(ui_vm, "hud", "x_left", coal::vm_c::VAR_FLOAT);
+    hud_x_right_var            = VM_FindVariable(ui_vm, "hud", "x_right", coal::vm_c::VAR_FLOAT);
+    hud_universal_y_adjust_var = VM_FindVariable(ui_vm, "hud", "universal_y_adjust", coal::vm_c::VAR_FLOAT);
+
+    hud_new_game_func    = VM_FindFunction(ui_vm, "new_game");
+    hud_load_game_func   = VM_FindFunction(ui_vm, "load_game");
+    hud_save_game_func   = VM_FindFunction(ui_vm, "save_game");
+    hud_begin_level_func = VM_FindFunction(ui_vm, "begin_level");
+    hud_end_level_func   = VM_FindFunction(ui_vm, "end_level");
+    hud_draw_all_func    = VM_FindFunction(ui_vm, "draw_all");
+}
+
+double VM_UniversalYAdjust(void)
+{
+    return VM_GetFloat(ui_vm, hud_universal_y_adjust_var);
+}
+
 void VM_NewGame(void)
 {
-    VM_CallFunction(ui_vm, "new_game");
+    VM_CallFunction(ui_vm, hud_new_game_func, "new_game");
 }
 
 void VM_LoadGame(void)
@@ -1066,12 +1099,12 @@ void VM_LoadGame(void)
     ui_hud_who    = players[displayplayer];
     ui_player_who = players[displayplayer];
 
-    VM_CallFunction(ui_vm, "load_game");
+    VM_CallFunction(ui_vm, hud_load_game_func, "load_game");
 }
 
 void VM_SaveGame(void)
 {
-    VM_CallFunction(ui_vm, "save_game");
+    VM_CallFunction(ui_vm, hud_save_game_func, "save_game");
 }
 
 void VM_BeginLevel(void)
@@ -1079,12 +1112,12 @@ void VM_BeginLevel(void)
     // Need to set these to prevent NULL references if using player.xxx in the begin_level hook
     ui_hud_who    = players[displayplayer];
     ui_player_who = players[displayplayer];
-    VM_CallFunction(ui_vm, "begin_level");
+    VM_CallFunction(ui_vm, hud_begin_level_func, "begin_level");
 }
 
 void VM_EndLevel(void)
 {
-    VM_CallFunction(ui_vm, "end_level");
+    VM_CallFunction(ui_vm, hud_end_level_func, "end_level");
 }
 
 void VM_RunHud(void)
@@ -1098,7 +1131,7 @@ void VM_RunHud(void)
     ui_hud_automap_flags[1] = 0;
     ui_hud_automap_zoom     = -1;
 
-    VM_CallFunction(ui_vm, "draw_all");
+    VM_CallFunction(ui_vm, hud_draw_all_func, "draw_all");
 
     HUD_Reset();
 }
@@ -50,11 +50,14 @@
 
 extern coal::vm_c *ui_vm;
 
-extern void VM_SetFloat(coal::vm_c *vm, const char *mod_name, const char *var_name, double value);
-extern void VM_CallFunction(coal::vm_c *vm, const char *name);
+extern int  VM_FindVariable(coal::vm_c *vm, const char *mod_name, const char *var_name, int var_type);
+extern void VM_SetVector(coal::vm_c *vm, int var, double val_1, double val_2, double val_3);
 
 player_t *ui_player_who = NULL;
 
+// handles resolved by VM_ResolvePlaysim()
+static int player_inventory_event_handler_var = coal::vm_c::NOT_FOUND;
+
 //------------------------------------------------------------------------
 //  PLAYER MODULE
 //------------------------------------------------------------------------
@@ -1364,19 +1367,21 @@ static void MO_query_tagged(coal::vm_c *vm, int argc)
     whattag  = (int)*argTag;
     whatinfo = (int)*argInfo;
 
-    mobj_t *mo;
+    // things with a tag are indexed, untagged ones are not
+    mobj_t *mo = P_FindMobjFromTag(whattag);
+
+    if (whattag == 0)
+    {
+        mo = mobjlisthead;
+        while (mo && mo->tag != 0)
+            mo = mo->next;
+    }
 
     std::string temp_value;
     temp_value.clear();
 
-    for (mo = mobjlisthead; mo; mo = mo->next)
-    {
-        if (mo->tag == whattag)
-        {
-            temp_value = GetQueryInfoFromMobj(mo, whatinfo);
-            break;
-        }
-    }
+    if (mo)
+        temp_value = GetQueryInfoFromMobj(mo, whatinfo);
 
     if (temp_value.empty())
         vm->ReturnString("");
@@ -1636,5 +1641,16 @@ void VM_RegisterPlaysim()
     ui_vm->AddNativeFunction("player.is_outside", PL_is_outside);
 }
 
+void VM_ResolvePlaysim()
+{
+    player_inventory_event_handler_var =
+        VM_FindVariable(ui_vm, "player", "inventory_event_handler", coal::vm_c::VAR_VECTOR);
+}
+
+void VM_SetInventoryEvents(bool prev, bool use, bool next)
+{
+    VM_SetVector(ui_vm, player_inventory_event_handler_var, prev ? 1 : 0, use ? 1 : 0, next ? 1 : 0);
+}
+
 //--- editor settings ---
 // vi:ts=4:sw=4:noexpandtab
@@ -39,12 +39,29 @@
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
 
 // ZIP support
 #include "miniz.h"
 
 static std::string image_dirs[5] = {"flats", "graphics", "skins", "textures", "sprites"};
 
+// total size of the decompressed entry cache, and the largest entry
+// which may go in it.  bigger entries are decompressed into memory
+// owned by the open file (up to EPK_PRIVATE_MAX_BYTES), beyond that
+// a backwards seek has to decompress from the start again.
+#define EPK_CACHE_MAX_BYTES   (32 * 1024 * 1024)
+#define EPK_CACHE_MAX_ENTRY   (8 * 1024 * 1024)
+#define EPK_PRIVATE_MAX_BYTES (64 * 1024 * 1024)
+
+class pack_file_c;
+
+static void EPK_PurgeCache(const pack_file_c *pack);
+
 class pack_entry_c
 {
   public:
@@ -81,6 +98,26 @@ class pack_entry_c
     }
 };
 
+// an entry found by pack_file_c::ClassifyEntries().  the small text
+// files which are always read (DDF, DEH and scripts) get loaded at the
+// same time, so that can be done in parallel with other packs.
+class pack_preload_c
+{
+  public:
+    int dir   = -1; // -1 when not present
+    int entry = -1;
+
+    ddf_type_e ddf_type = DDF_UNKNOWN;
+
+    uint8_t *data   = NULL;
+    int      length = 0;
+
+    bool Present() const
+    {
+        return dir >= 0;
+    }
+};
+
 class pack_dir_c
 {
   public:
@@ -141,6 +178,22 @@ class pack_file_c
 
     mz_zip_archive *arch;
 
+    // problems found while indexing, which may be done on a worker
+    // thread.  they are reported when the pack is processed.
+    std::vector<std::string> index_warnings;
+    std::string              index_error;
+
+    // DDF, RTS and DEH/BEX files in directory order
+    std::vector<pack_preload_c> ddf_files;
+
+    pack_preload_c coal_api;
+    pack_preload_c coal_hud;
+    pack_preload_c lua_api;
+    pack_preload_c lua_hud;
+
+    // contents of these are not preloaded
+    std::vector<pack_preload_c> wad_files;
+
   public:
     pack_file_c(data_file_c *_par, bool _folder) : parent(_par), is_folder(_folder), dirs(), arch(NULL)
     {
@@ -148,6 +201,9 @@ class pack_file_c
 
     ~pack_file_c()
     {
+        EPK_PurgeCache(this);
+        FreePreloads();
+
         if (arch != NULL)
             delete arch;
     }
@@ -173,6 +229,22 @@ class pack_file_c
     }
 
     void SortEntries();
+    void ClassifyEntries(bool want_api);
+    void PreloadEntry(pack_preload_c &P);
+    void FreePreloads();
+
+    // returns the preloaded data (which the caller now owns), or loads it
+    uint8_t *TakePreload(pack_preload_c &P, int &length)
+    {
+        if (P.data == NULL)
+            return LoadEntry(P.dir, P.entry, length);
+
+        uint8_t *data = P.data;
+        length        = P.length;
+
+        P.data = NULL;
+        return data;
+    }
 
     epi::File *OpenEntry(size_t dir, size_t index)
     {
@@ -294,6 +366,84 @@ void pack_file_c::SortEntries()
         dirs[i].SortEntries();
 }
 
+//
+// Finds the entries which get read when the pack is processed, in the
+// same order the old per-type directory walks used.  Must be called
+// after SortEntries().
+//
+void pack_file_c::ClassifyEntries(bool want_api)
+{
+    for (int dir = 0; dir < (int)dirs.size(); dir++)
+    {
+        for (int entry = 0; entry < (int)dirs[dir].entries.size(); entry++)
+        {
+            pack_entry_c &ent = dirs[dir].entries[entry];
+
+            pack_preload_c P;
+            P.dir   = dir;
+            P.entry = entry;
+
+            // this handles RTS scripts too!
+            P.ddf_type = DDF_FilenameToType(ent.name);
+
+            if (P.ddf_type != DDF_UNKNOWN || ent.HasExtension(".deh") || ent.HasExtension(".bex"))
+                ddf_files.push_back(P);
+
+            std::string filename = epi::GetFilename(ent.name);
+
+            P.ddf_type = DDF_UNKNOWN;
+
+            if (!coal_api.Present() && filename == "coal_api.ec")
+                coal_api = P;
+
+            if (!coal_hud.Present() && (epi::StringCaseCompareASCII(filename, "coal_hud.ec") == 0 ||
+                                        epi::StringCaseCompareASCII(epi::GetStem(filename), "COALHUDS") == 0))
+                coal_hud = P;
+
+            if (!lua_api.Present() && filename == "edge_api.lua")
+                lua_api = P;
+
+            if (!lua_hud.Present() && epi::StringCaseCompareASCII(filename, "edge_hud.lua") == 0)
+                lua_hud = P;
+
+            if (ent.HasExtension(".wad"))
+                wad_files.push_back(P);
+        }
+    }
+
+    // with a DDF snapshot these are never read
+    if (!DDF_SnapshotLoaded())
+    {
+        for (pack_preload_c &P : ddf_files)
+            PreloadEntry(P);
+    }
+
+    PreloadEntry(coal_hud);
+    PreloadEntry(lua_hud);
+
+    if (want_api)
+    {
+        PreloadEntry(coal_api);
+        PreloadEntry(lua_api);
+    }
+}
+
+void pack_file_c::FreePreloads()
+{
+    for (pack_preload_c &P : ddf_files)
+        delete[] P.data;
+
+    delete[] coal_api.data;
+    delete[] coal_hud.data;
+    delete[] lua_api.data;
+    delete[] lua_hud.data;
+
+    ddf_files.clear();
+    wad_files.clear();
+
+    coal_api = coal_hud = lua_api = lua_hud = pack_preload_c();
+}
+
 //----------------------------------------------------------------------------
 //  DIRECTORY READING
 //----------------------------------------------------------------------------
@@ -306,7 +456,7 @@ void ProcessSubDir(pack_file_c *pack, std::string &fullpath)
 
     if (!epi::WalkDirectory(fsd, fullpath))
     {
-        I_Warning("Failed to read dir: %s\n", fullpath.c_str());
+        pack->index_warnings.push_back(epi::StringFormat("Failed to read dir: %s\n", fullpath.c_str()));
         return;
     }
 
@@ -318,8 +468,9 @@ void ProcessSubDir(pack_file_c *pack, std::string &fullpath)
         {
             if (epi::GetExtension(fsd[i].name).empty())
             {
-                I_Warning("%s has no extension. Bare filenames are not supported for mounted directories.\n",
-                          fsd[i].name.c_str());
+                pack->index_warnings.push_back(epi::StringFormat(
+                    "%s has no extension. Bare filenames are not supported for mounted directories.\n",
+                    fsd[i].name.c_str()));
                 continue;
             }
             std::string filename = epi::GetFilename(fsd[i].name);
@@ -332,17 +483,22 @@ void ProcessSubDir(pack_file_c *pack, std::string &fullpath)
     }
 }
 
+//
+// NOTE: the directory functions change the current directory while
+//       they run, so this must only be called from the main thread.
+//
 static pack_file_c *ProcessFolder(data_file_c *df)
 {
     std::vector<epi::DirectoryEntry> fsd;
 
+    pack_file_c *pack = new pack_file_c(df, true);
+
     if (!epi::ReadDirectory(fsd, df->name, "*.*"))
     {
-        I_Error("Failed to read dir: %s\n", df->name.c_str());
+        pack->index_error = epi::StringFormat("Failed to read dir: %s\n", df->name.c_str());
+        return pack;
     }
 
-    pack_file_c *pack = new pack_file_c(df, true);
-
     // top-level files go in here
     pack->AddDir("");
 
@@ -356,8 +512,9 @@ static pack_file_c *ProcessFolder(data_file_c *df)
         {
             if (epi::GetExtension(fsd[i].name).empty())
             {
-                I_Warning("%s has no extension. Bare filenames are not supported for mounted directories.\n",
-                          fsd[i].name.c_str());
+                pack->index_warnings.push_back(epi::StringFormat(
+                    "%s has no extension. Bare filenames are not supported for mounted directories.\n",
+                    fsd[i].name.c_str()));
                 continue;
             }
             std::string filename = fsd[i].name;
@@ -399,9 +556,13 @@ epi::File *pack_file_c::FileOpen_Folder(const std::string &name)
 //  ZIP READING
 //----------------------------------------------------------------------------
 
-static pack_file_c *ProcessZip(data_file_c *df)
+//
+// This may run on a worker thread, so it does not report any problems
+// itself (see ReportIndexProblems).
+//
+static void ProcessZip(pack_file_c *pack)
 {
-    pack_file_c *pack = new pack_file_c(df, false);
+    data_file_c *df = pack->parent;
 
     pack->arch = new mz_zip_archive;
 
@@ -415,11 +576,12 @@ static pack_file_c *ProcessZip(data_file_c *df)
         case MZ_ZIP_FILE_OPEN_FAILED:
         case MZ_ZIP_FILE_READ_FAILED:
         case MZ_ZIP_FILE_SEEK_FAILED:
-            I_Error("Failed to open EPK file: %s\n", df->name.c_str());
+            pack->index_error = epi::StringFormat("Failed to open EPK file: %s\n", df->name.c_str());
             break;
         default:
-            I_Error("Not a EPK file (or is corrupted): %s\n", df->name.c_str());
+            pack->index_error = epi::StringFormat("Not a EPK file (or is corrupted): %s\n", df->name.c_str());
         }
+        return;
     }
 
     // create the top-level directory
@@ -440,7 +602,8 @@ static pack_file_c *ProcessZip(data_file_c *df)
 
         if (epi::GetExtension(filename).empty())
         {
-            I_Warning("%s has no extension. Bare EPK filenames are not supported.\n", filename);
+            pack->index_warnings.push_back(
+                epi::StringFormat("%s has no extension. Bare EPK filenames are not supported.\n", filename));
             continue;
         }
 
@@ -473,10 +636,86 @@ static pack_file_c *ProcessZip(data_file_c *df)
         pack->dirs[dir_idx].AddEntry(epi::GetFilename(add_name), "", packpath, idx);
         pack->search_files.insert({stem, packpath});
     }
+}
 
-    return pack;
+//----------------------------------------------------------------------------
+//  DECOMPRESSED ENTRY CACHE
+//----------------------------------------------------------------------------
+
+typedef std::shared_ptr<std::vector<uint8_t>> epk_data_ptr;
+
+struct epk_cache_entry_t
+{
+    const pack_file_c *pack;
+    mz_uint            zip_idx;
+
+    epk_data_ptr data;
+};
+
+// most recently used first.  only entries which needed random access
+// end up here, so it stays small and a linear search is fine.
+static std::list<epk_cache_entry_t> epk_cache;
+static size_t                       epk_cache_bytes = 0;
+
+// packs are indexed on several threads at startup
+static std::mutex epk_cache_mutex;
+
+static epk_data_ptr EPK_CacheLookup(const pack_file_c *pack, mz_uint zip_idx)
+{
+    std::lock_guard<std::mutex> lock(epk_cache_mutex);
+
+    for (auto it = epk_cache.begin(); it != epk_cache.end(); ++it)
+    {
+        if (it->pack == pack && it->zip_idx == zip_idx)
+        {
+            if (it != epk_cache.begin())
+                epk_cache.splice(epk_cache.begin(), epk_cache, it);
+
+            return epk_cache.front().data;
+        }
+    }
+
+    return nullptr;
+}
+
+static void EPK_CacheInsert(const pack_file_c *pack, mz_uint zip_idx, epk_data_ptr data)
+{
+    std::lock_guard<std::mutex> lock(epk_cache_mutex);
+
+    epk_cache.push_front({pack, zip_idx, data});
+    epk_cache_bytes += data->size();
+
+    // files still open keep their data alive after it is dropped here
+    while (epk_cache_bytes > EPK_CACHE_MAX_BYTES && epk_cache.size() > 1)
+    {
+        epk_cache_bytes -= epk_cache.back().data->size();
+        epk_cache.pop_back();
+    }
+}
+
+static void EPK_PurgeCache(const pack_file_c *pack)
+{
+    std::lock_guard<std::mutex> lock(epk_cache_mutex);
+
+    for (auto it = epk_cache.begin(); it != epk_cache.end();)
+    {
+        if (it->pack == pack)
+        {
+            epk_cache_bytes -= it->data->size();
+            it = epk_cache.erase(it);
+        }
+        else
+            ++it;
+    }
 }
 
+//
+// An entry in a ZIP archive.  Stored (uncompressed) entries are read
+// directly from the archive.  Compressed entries are streamed, until a
+// seek backwards needs random access: then the whole entry is
+// decompressed into memory (shared via the cache above when not too
+// big) and used from there on, like a MemFile.
+//
 class epk_file_c : public epi::File
 {
   private:
@@ -487,6 +726,13 @@ class epk_file_c : public epi::File
     mz_uint length = 0;
     mz_uint pos    = 0;
 
+    // for stored entries: where the data begins in the archive
+    bool      stored   = false;
+    mz_uint64 data_ofs = 0;
+
+    // the whole entry, once random access was needed
+    epk_data_ptr memory;
+
     mz_zip_reader_extract_iter_state *iter = NULL;
 
   public:
@@ -495,8 +741,21 @@ class epk_file_c : public epi::File
         // determine length
         mz_zip_archive_file_stat stat;
         if (mz_zip_reader_file_stat(pack->arch, zip_idx, &stat))
+        {
             length = (mz_uint)stat.m_uncomp_size;
 
+            if (stat.m_method == 0 && !stat.m_is_encrypted && stat.m_comp_size == stat.m_uncomp_size)
+                stored = FindStoredData(stat.m_local_header_ofs);
+        }
+
+        if (stored)
+            return;
+
+        memory = EPK_CacheLookup(pack, zip_idx);
+
+        if (memory)
+            return;
+
         iter = mz_zip_reader_extract_iter_new(pack->arch, zip_idx, 0);
         SYS_ASSERT(iter);
     }
@@ -526,7 +785,23 @@ class epk_file_c : public epi::File
         if (count > length - pos)
             count = length - pos;
 
-        size_t got = mz_zip_reader_extract_iter_read(iter, dest, count);
+        size_t got;
+
+        if (stored)
+        {
+            mz_zip_archive *arch = pack->arch;
+
+            got = arch->m_pRead(arch->m_pIO_opaque, data_ofs + pos, dest, count);
+        }
+        else if (memory)
+        {
+            memcpy(dest, memory->data() + pos, count);
+            got = count;
+        }
+        else
+        {
+            got = mz_zip_reader_extract_iter_read(iter, dest, count);
+        }
 
         pos += got;
 
@@ -568,15 +843,22 @@ class epk_file_c : public epi::File
         if (want_pos > length)
             return false;
 
-        if (want_pos == length)
+        if (stored || memory || want_pos == length)
         {
-            pos = length;
+            pos = want_pos;
             return true;
         }
 
-        // to go backwards, we are forced to rewind to beginning
+        // to go backwards, we need the whole entry in memory (or as a
+        // last resort, to rewind to the beginning).
         if (want_pos < pos)
         {
+            if (LoadWhole())
+            {
+                pos = want_pos;
+                return true;
+            }
+
             Rewind();
         }
 
@@ -589,6 +871,49 @@ class epk_file_c : public epi::File
     }
 
   private:
+    bool FindStoredData(mz_uint64 header_ofs)
+    {
+        // the local header has its own name and extra field lengths,
+        // which can differ from the ones in the central directory.
+        uint8_t header[30];
+
+        mz_zip_archive *arch = pack->arch;
+
+        if (arch->m_pRead(arch->m_pIO_opaque, header_ofs, header, sizeof(header)) != sizeof(header))
+            return false;
+
+        if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4)
+            return false;
+
+        int name_len  = header[26] | (header[27] << 8);
+        int extra_len = header[28] | (header[29] << 8);
+
+        data_ofs = header_ofs + sizeof(header) + name_len + extra_len;
+
+        return (data_ofs + length <= arch->m_archive_size);
+    }
+
+    bool LoadWhole()
+    {
+        if (length > EPK_PRIVATE_MAX_BYTES)
+            return false;
+
+        epk_data_ptr data = std::make_shared<std::vector<uint8_t>>(length);
+
+        if (!mz_zip_reader_extract_to_mem(pack->arch, zip_idx, data->data(), length, 0))
+            return false;
+
+        mz_zip_reader_extract_iter_free(iter);
+        iter = NULL;
+
+        memory = data;
+
+        if (length <= EPK_CACHE_MAX_ENTRY)
+            EPK_CacheInsert(pack, zip_idx, data);
+
+        return true;
+    }
+
     void Rewind()
     {
         mz_zip_reader_extract_iter_free(iter);
@@ -617,6 +942,34 @@ class epk_file_c : public epi::File
     }
 };
 
+//
+// Unlike OpenEntry(), this is safe to call from a worker thread.  When
+// something goes wrong the entry is simply not preloaded, and loading
+// it later (on the main thread) will report the problem.
+//
+void pack_file_c::PreloadEntry(pack_preload_c &P)
+{
+    if (!P.Present() || P.data != NULL)
+        return;
+
+    pack_entry_c &ent = dirs[P.dir].entries[P.entry];
+
+    epi::File *f;
+
+    if (is_folder)
+        f = epi::FileOpen(ent.fullpath, epi::kFileAccessRead | epi::kFileAccessBinary);
+    else
+        f = new epk_file_c(this, ent.zip_idx);
+
+    if (f == NULL)
+        return;
+
+    P.data   = f->LoadIntoMemory();
+    P.length = (P.data != NULL) ? f->GetLength() : 0;
+
+    delete f;
+}
+
 epi::File *pack_file_c::OpenEntry_Zip(size_t dir, size_t index)
 {
     epk_file_c *F = new epk_file_c(this, dirs[dir].entries[index].zip_idx);
@@ -640,50 +993,44 @@ epi::File *pack_file_c::FileOpen_Zip(const std::string &name)
 
 static void ProcessDDFInPack(pack_file_c *pack)
 {
+    // everything was read from the DDF snapshot
+    if (DDF_SnapshotLoaded())
+        return;
+
     data_file_c *df = pack->parent;
 
     std::string bare_filename = epi::GetFilename(df->name);
     if (bare_filename.empty())
         bare_filename = df->name;
 
-    for (size_t dir = 0; dir < pack->dirs.size(); dir++)
+    for (pack_preload_c &P : pack->ddf_files)
     {
-        for (size_t entry = 0; entry < pack->dirs[dir].entries.size(); entry++)
-        {
-            pack_entry_c &ent = pack->dirs[dir].entries[entry];
-
-            std::string source = ent.name;
-            source += " in ";
-            source += bare_filename;
-
-            // this handles RTS scripts too!
-            ddf_type_e type = DDF_FilenameToType(ent.name);
+        pack_entry_c &ent = pack->dirs[P.dir].entries[P.entry];
 
-            if (type != DDF_UNKNOWN)
-            {
-                int         length   = -1;
-                const uint8_t *raw_data = pack->LoadEntry(dir, entry, length);
+        std::string source = ent.name;
+        source += " in ";
+        source += bare_filename;
 
-                std::string data((const char *)raw_data);
-                delete[] raw_data;
+        if (P.ddf_type != DDF_UNKNOWN)
+        {
+            int            length   = -1;
+            const uint8_t *raw_data = pack->TakePreload(P, length);
 
-                DDF_AddFile(type, data, source);
-                continue;
-            }
+            std::string data((const char *)raw_data);
+            delete[] raw_data;
 
-            if (ent.HasExtension(".deh") || ent.HasExtension(".bex"))
-            {
-                I_Printf("Converting DEH file%s: %s\n", pack->is_folder ? "" : " in EPK", ent.name.c_str());
+            DDF_AddFile(P.ddf_type, data, source);
+            continue;
+        }
 
-                int         length = -1;
-                const uint8_t *data   = pack->LoadEntry(dir, entry, length);
+        // must be DEH or BEX
+        I_Printf("Converting DEH file%s: %s\n", pack->is_folder ? "" : " in EPK", ent.name.c_str());
 
-                DEH_Convert(data, length, source);
-                delete[] data;
+        int            length = -1;
+        const uint8_t *data   = pack->TakePreload(P, length);
 
-                continue;
-            }
-        }
+        DEH_Convert(data, length, source);
+        delete[] data;
     }
 }
 
@@ -699,23 +1046,14 @@ static void ProcessCoalAPIInPack(pack_file_c *pack)
     source += " in ";
     source += bare_filename;
 
-    for (size_t dir = 0; dir < pack->dirs.size(); dir++)
-    {
-        for (size_t entry = 0; entry < pack->dirs[dir].entries.size(); entry++)
-        {
-            pack_entry_c &ent = pack->dirs[dir].entries[entry];
-            if (epi::GetFilename(ent.name) == "coal_api.ec")
-            {
-                int         length   = -1;
-                const uint8_t *raw_data = pack->LoadEntry(dir, entry, length);
-                std::string data((const char *)raw_data);
-                delete[] raw_data;
-                VM_AddScript(0, data, source);
-                return; // Should only be present once
-            }
-        }
-    }
-    I_Error("coal_api.ec not found in edge_defs; unable to initialize COAL!\n");
+    if (!pack->coal_api.Present())
+        I_Error("coal_api.ec not found in edge_defs; unable to initialize COAL!\n");
+
+    int            length   = -1;
+    const uint8_t *raw_data = pack->TakePreload(pack->coal_api, length);
+    std::string    data((const char *)raw_data);
+    delete[] raw_data;
+    VM_AddScript(0, data, source);
 }
 
 static void ProcessCoalHUDInPack(pack_file_c *pack)
@@ -730,28 +1068,19 @@ static void ProcessCoalHUDInPack(pack_file_c *pack)
     source += " in ";
     source += bare_filename;
 
-    for (size_t dir = 0; dir < pack->dirs.size(); dir++)
-    {
-        for (size_t entry = 0; entry < pack->dirs[dir].entries.size(); entry++)
-        {
-            pack_entry_c &ent = pack->dirs[dir].entries[entry];
-            std::string ent_fn = epi::GetFilename(ent.name);
-            if (epi::StringCaseCompareASCII(ent_fn, "coal_hud.ec") == 0 || epi::StringCaseCompareASCII(epi::GetStem(ent_fn), "COALHUDS") == 0)
-            {
-                if (epi::StringPrefixCaseCompareASCII(bare_filename, "edge_defs") != 0)
-                {
-                    VM_SetCoalDetected(true);
-                }
+    if (!pack->coal_hud.Present())
+        return;
 
-                int         length   = -1;
-                const uint8_t *raw_data = pack->LoadEntry(dir, entry, length);
-                std::string data((const char *)raw_data);
-                delete[] raw_data;
-                VM_AddScript(0, data, source);
-                return; // Should only be present once
-            }
-        }
+    if (epi::StringPrefixCaseCompareASCII(bare_filename, "edge_defs") != 0)
+    {
+        VM_SetCoalDetected(true);
     }
+
+    int            length   = -1;
+    const uint8_t *raw_data = pack->TakePreload(pack->coal_hud, length);
+    std::string    data((const char *)raw_data);
+    delete[] raw_data;
+    VM_AddScript(0, data, source);
 }
 
 static void ProcessLuaAPIInPack(pack_file_c *pack)
@@ -764,23 +1093,14 @@ static void ProcessLuaAPIInPack(pack_file_c *pack)
 
     std::string source = bare_filename + " => " + "edge_api.lua";
 
-    for (size_t dir = 0; dir < pack->dirs.size(); dir++)
-    {
-        for (size_t entry = 0; entry < pack->dirs[dir].entries.size(); entry++)
-        {
-            pack_entry_c &ent = pack->dirs[dir].entries[entry];
-            if (epi::GetFilename(ent.name) == "edge_api.lua")
-            {
-                int         length   = -1;
-                const uint8_t *raw_data = pack->LoadEntry(dir, entry, length);
-                std::string data((const char *)raw_data);
-                delete[] raw_data;
-                LUA_AddScript(data, source);
-                return; // Should only be present once
-            }
-        }
-    }
-    I_Error("edge_api.lua not found in edge_defs; unable to initialize LUA!\n");
+    if (!pack->lua_api.Present())
+        I_Error("edge_api.lua not found in edge_defs; unable to initialize LUA!\n");
+
+    int            length   = -1;
+    const uint8_t *raw_data = pack->TakePreload(pack->lua_api, length);
+    std::string    data((const char *)raw_data);
+    delete[] raw_data;
+    LUA_AddScript(data, source);
 }
 
 static void ProcessLuaHUDInPack(pack_file_c *pack)
@@ -793,27 +1113,19 @@ static void ProcessLuaHUDInPack(pack_file_c *pack)
 
     std::string source = bare_filename + " => " + "edge_hud.lua";
 
-    for (size_t dir = 0; dir < pack->dirs.size(); dir++)
-    {
-        for (size_t entry = 0; entry < pack->dirs[dir].entries.size(); entry++)
-        {
-            pack_entry_c &ent = pack->dirs[dir].entries[entry];
-            if (epi::StringCaseCompareASCII(epi::GetFilename(ent.name), "edge_hud.lua") == 0)
-            {
-                if (epi::StringPrefixCaseCompareASCII(bare_filename, "edge_defs") != 0)
-                {
-                    LUA_SetLuaHudDetected(true);
-                }
+    if (!pack->lua_hud.Present())
+        return;
 
-                int         length   = -1;
-                const uint8_t *raw_data = pack->LoadEntry(dir, entry, length);
-                std::string data((const char *)raw_data);
-                delete[] raw_data;
-                LUA_AddScript(data, source);
-                return; // Should only be present once
-            }
-        }
+    if (epi::StringPrefixCaseCompareASCII(bare_filename, "edge_defs") != 0)
+    {
+        LUA_SetLuaHudDetected(true);
     }
+
+    int            length   = -1;
+    const uint8_t *raw_data = pack->TakePreload(pack->lua_hud, length);
+    std::string    data((const char *)raw_data);
+    delete[] raw_data;
+    LUA_AddScript(data, source);
 }
 
 void Pack_ProcessSubstitutions(pack_file_c *pack, int pack_index)
@@ -1241,42 +1553,140 @@ std::vector<std::string> Pack_GetSpriteList(pack_file_c *pack)
 
 static void ProcessWADsInPack(pack_file_c *pack)
 {
-    for (size_t d = 0; d < pack->dirs.size(); d++)
+    for (pack_preload_c &P : pack->wad_files)
     {
-        for (size_t i = 0; i < pack->dirs[d].entries.size(); i++)
+        pack_entry_c &entry = pack->dirs[P.dir].entries[P.entry];
+
+        epi::File *pack_wad = Pack_FileOpen(pack, entry.packpath);
+
+        if (pack_wad)
         {
-            pack_entry_c &entry = pack->dirs[d].entries[i];
+            uint8_t      *raw_pack_wad = pack_wad->LoadIntoMemory();
+            epi::MemFile *pack_wad_mem = new epi::MemFile(raw_pack_wad, pack_wad->GetLength(), true);
+            delete[] raw_pack_wad; // copied on pack_wad_mem creation
+            data_file_c *pack_wad_df = new data_file_c(
+                entry.name, (pack->parent->kind == FLKIND_IFolder || pack->parent->kind == FLKIND_IPK)
+                                ? FLKIND_IPackWAD
+                                : FLKIND_PackWAD);
+            pack_wad_df->name = entry.name;
+            pack_wad_df->file = pack_wad_mem;
+            ProcessFile(pack_wad_df);
+        }
 
-            if (!entry.HasExtension(".wad"))
-                continue;
+        delete pack_wad;
+    }
+}
 
-            epi::File *pack_wad = Pack_FileOpen(pack, entry.packpath);
+static bool IsFolderKind(filekind_e kind)
+{
+    return (kind == FLKIND_Folder || kind == FLKIND_EFolder || kind == FLKIND_IFolder);
+}
 
-            if (pack_wad)
-            {
-                uint8_t            *raw_pack_wad = pack_wad->LoadIntoMemory();
-                epi::MemFile *pack_wad_mem = new epi::MemFile(raw_pack_wad, pack_wad->GetLength(), true);
-                delete[] raw_pack_wad; // copied on pack_wad_mem creation
-                data_file_c *pack_wad_df = new data_file_c(
-                    entry.name, (pack->parent->kind == FLKIND_IFolder || pack->parent->kind == FLKIND_IPK)
-                                    ? FLKIND_IPackWAD
-                                    : FLKIND_PackWAD);
-                pack_wad_df->name = entry.name;
-                pack_wad_df->file = pack_wad_mem;
-                ProcessFile(pack_wad_df);
-            }
+static bool IsPackKind(filekind_e kind)
+{
+    return IsFolderKind(kind) || kind == FLKIND_EPK || kind == FLKIND_EEPK || kind == FLKIND_IPK;
+}
 
-            delete pack_wad;
+//
+// First part of indexing a pack, which must be done on the main thread.
+//
+static pack_file_c *CreatePack(data_file_c *df)
+{
+    if (IsFolderKind(df->kind))
+        return ProcessFolder(df);
+
+    return new pack_file_c(df, false);
+}
+
+//
+// Second part, which may be done on a worker thread.
+//
+static void IndexPack(pack_file_c *pack)
+{
+    if (!pack->is_folder)
+        ProcessZip(pack);
+
+    if (!pack->index_error.empty())
+        return;
+
+    pack->SortEntries();
+
+    filekind_e kind = pack->parent->kind;
+
+    pack->ClassifyEntries(kind == FLKIND_EFolder || kind == FLKIND_EEPK);
+}
+
+static void ReportIndexProblems(pack_file_c *pack)
+{
+    for (const std::string &msg : pack->index_warnings)
+        I_Warning("%s", msg.c_str());
+
+    pack->index_warnings.clear();
+
+    if (!pack->index_error.empty())
+        I_Error("%s", pack->index_error.c_str());
+}
+
+//
+// Indexes all the packs in the list at the same time, which is mainly
+// reading the zip directories and the DDF/script files in them.
+// Nothing gets added to the game here, Pack_ProcessAll() does that
+// for each pack in load order (and reports any problems), so results
+// are the same as indexing them one by one.
+//
+void Pack_IndexAll(const std::vector<data_file_c *> &files)
+{
+    std::vector<pack_file_c *> todo;
+
+    for (data_file_c *df : files)
+    {
+        if (IsPackKind(df->kind) && df->pack == NULL)
+        {
+            df->pack = CreatePack(df);
+            todo.push_back(df->pack);
         }
     }
+
+    if (todo.empty())
+        return;
+
+    size_t num_threads = HMM_MAX(1U, std::thread::hardware_concurrency());
+
+    num_threads = HMM_MIN(num_threads, HMM_MIN(todo.size(), (size_t)8));
+
+    std::atomic<size_t> next_pack(0);
+
+    auto worker = [&]() {
+        for (;;)
+        {
+            size_t i = next_pack++;
+
+            if (i >= todo.size())
+                break;
+
+            IndexPack(todo[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t t = 1; t < num_threads; t++)
+        threads.push_back(std::thread(worker));
+
+    worker();
+
+    for (std::thread &th : threads)
+        th.join();
 }
 
 void Pack_PopulateOnly(data_file_c *df)
 {
-    if (df->kind == FLKIND_Folder || df->kind == FLKIND_EFolder || df->kind == FLKIND_IFolder)
-        df->pack = ProcessFolder(df);
-    else
-        df->pack = ProcessZip(df);
+    df->pack = CreatePack(df);
+
+    if (!df->pack->is_folder)
+        ProcessZip(df->pack);
+
+    ReportIndexProblems(df->pack);
 
     df->pack->SortEntries();
 }
@@ -1312,12 +1722,14 @@ int Pack_CheckForIWADs(data_file_c *df)
 
 void Pack_ProcessAll(data_file_c *df, size_t file_index)
 {
-    if (df->kind == FLKIND_Folder || df->kind == FLKIND_EFolder || df->kind == FLKIND_IFolder)
-        df->pack = ProcessFolder(df);
-    else
-        df->pack = ProcessZip(df);
+    // normally already done by Pack_IndexAll()
+    if (df->pack == NULL)
+    {
+        df->pack = CreatePack(df);
+        IndexPack(df->pack);
+    }
 
-    df->pack->SortEntries();
+    ReportIndexProblems(df->pack);
 
     // parse the WADFIXES file from edge_defs folder or `edge_defs.epk` immediately
     if ((df->kind == FLKIND_EFolder || df->kind == FLKIND_EEPK) && file_index == 0)
@@ -1348,6 +1760,9 @@ void Pack_ProcessAll(data_file_c *df, size_t file_index)
     ProcessLuaHUDInPack(df->pack);
 
     ProcessWADsInPack(df->pack);
+
+    // anything preloaded but not used (e.g. the API scripts)
+    df->pack->FreePreloads();
 }
 
 //--- editor settings ---
@@ -53,6 +53,9 @@ void Pack_PopulateOnly(data_file_c *df);
 // Check pack for valid IWADs. Return associated game_checker index if found
 int Pack_CheckForIWADs(data_file_c *df);
 
+// Index the directories of all packs in the list (in parallel)
+void Pack_IndexAll(const std::vector<data_file_c *> &files);
+
 // Populate pack directory and process appropriate files (COAL, DDF, etc)
 void Pack_ProcessAll(data_file_c *df, size_t file_index);
 
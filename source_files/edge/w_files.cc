@@ -26,12 +26,14 @@
 #include "i_defs.h"
 
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 
 // EPI
 #include "file.h"
 #include "filesystem.h"
+#include "math_crc.h"
 
 // DDF
 #include "main.h"
@@ -55,6 +57,7 @@
 #include "w_files.h"
 #include "w_epk.h"
 #include "w_wad.h"
+#include "version.h"
 
 std::vector<data_file_c *> data_files;
 
@@ -106,6 +109,10 @@ extern std::string W_BuildNodesForWad(data_file_c *df);
 
 static void DEH_ConvertFile(std::string &filename)
 {
+    // the converted entries are already in the DDF snapshot
+    if (DDF_SnapshotLoaded())
+        return;
+
     epi::File *F = epi::FileOpen(filename, epi::kFileAccessRead | epi::kFileAccessBinary);
     if (F == NULL)
     {
@@ -139,6 +146,9 @@ static void W_ExternalDDF(data_file_c *df)
     if (type == DDF_UNKNOWN)
         I_Error("Unknown DDF filename: %s\n", bare_name.c_str());
 
+    if (DDF_SnapshotLoaded())
+        return;
+
     I_Printf("Reading DDF file: %s\n", df->name.c_str());
 
     epi::File *F = epi::FileOpen(df->name, epi::kFileAccessRead);
@@ -159,6 +169,9 @@ static void W_ExternalDDF(data_file_c *df)
 
 static void W_ExternalRTS(data_file_c *df)
 {
+    if (DDF_SnapshotLoaded())
+        return;
+
     I_Printf("Reading RTS script: %s\n", df->name.c_str());
 
     epi::File *F = epi::FileOpen(df->name, epi::kFileAccessRead);
@@ -242,6 +255,9 @@ void W_ProcessMultipleFiles()
     std::vector<data_file_c *> copied_files(data_files);
     data_files.clear();
 
+    // the packs can be read ahead of time, which is the slow part
+    Pack_IndexAll(copied_files);
+
     for (size_t i = 0; i < copied_files.size(); i++)
     {
         ProcessFile(copied_files[i]);
@@ -255,6 +271,269 @@ void W_ProcessMultipleFiles()
     }
 }
 
+static uint32_t W_ReadFileCRC(const std::string &filename)
+{
+    epi::CRC32 crc;
+
+    epi::File *F = epi::FileOpen(filename, epi::kFileAccessRead | epi::kFileAccessBinary);
+    if (F == NULL)
+        return crc.GetCRC();
+
+    static uint8_t buffer[65536];
+
+    for (;;)
+    {
+        unsigned int got = F->Read(buffer, sizeof(buffer));
+        if (got == 0)
+            break;
+
+        crc.AddBlock(buffer, (int)got);
+    }
+
+    delete F;
+
+    return crc.GetCRC();
+}
+
+//
+// File content CRCs are cached between runs (keyed by the size and
+// modification time of each file), since reading every IWAD and PWAD
+// in full on each startup would cost far more than it saves.
+//
+#define FILE_HASH_CACHE "file_hashes.txt"
+
+typedef struct
+{
+    int64_t  size;
+    int64_t  mtime;
+    uint32_t crc;
+    bool     used;
+} file_hash_t;
+
+static std::unordered_map<std::string, file_hash_t> file_hashes;
+
+static bool file_hashes_loaded  = false;
+static bool file_hashes_changed = false;
+
+static void W_LoadFileHashes(void)
+{
+    file_hashes_loaded = true;
+
+    std::string filename = epi::PathAppend(cache_dir, FILE_HASH_CACHE);
+
+    FILE *fp = epi::FileOpenRaw(filename, epi::kFileAccessRead);
+    if (fp == NULL)
+        return;
+
+    char line[4096];
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        long long size, mtime;
+        unsigned int crc;
+        int pos = 0;
+
+        if (sscanf(line, "%lld %lld %x %n", &size, &mtime, &crc, &pos) < 3 || pos == 0)
+            continue;
+
+        std::string name(line + pos);
+
+        while (!name.empty() && (name.back() == '\n' || name.back() == '\r'))
+            name.pop_back();
+
+        if (name.empty())
+            continue;
+
+        file_hash_t &H = file_hashes[name];
+
+        H.size  = size;
+        H.mtime = mtime;
+        H.crc   = crc;
+        H.used  = false;
+    }
+
+    fclose(fp);
+}
+
+//
+// Writes the cache back if anything was added or updated, dropping
+// the entries not used by this run.
+//
+static void W_SaveFileHashes(void)
+{
+    for (auto &entry : file_hashes)
+        if (!entry.second.used)
+            file_hashes_changed = true;
+
+    if (!file_hashes_changed)
+        return;
+
+    std::string filename = epi::PathAppend(cache_dir, FILE_HASH_CACHE);
+
+    FILE *fp = epi::FileOpenRaw(filename, epi::kFileAccessWrite);
+    if (fp == NULL)
+    {
+        I_Warning("Unable to write %s\n", filename.c_str());
+        return;
+    }
+
+    for (auto it = file_hashes.begin(); it != file_hashes.end();)
+    {
+        if (!it->second.used)
+        {
+            it = file_hashes.erase(it);
+            continue;
+        }
+
+        fprintf(fp, "%lld %lld %08x %s\n", (long long)it->second.size, (long long)it->second.mtime, it->second.crc,
+                it->first.c_str());
+        it++;
+    }
+
+    fclose(fp);
+
+    file_hashes_changed = false;
+}
+
+//
+// Returns the CRC of a file's contents, only reading the file when
+// its size or modification time differ from the cached entry.
+//
+static uint32_t W_CachedFileCRC(const std::string &filename)
+{
+    if (!file_hashes_loaded)
+        W_LoadFileHashes();
+
+    int64_t size, mtime;
+
+    if (!epi::GetFileInfo(filename, size, mtime))
+        return W_ReadFileCRC(filename);
+
+    auto find = file_hashes.find(filename);
+
+    if (find != file_hashes.end() && find->second.size == size && find->second.mtime == mtime)
+    {
+        find->second.used = true;
+        return find->second.crc;
+    }
+
+    file_hash_t &H = file_hashes[filename];
+
+    H.size  = size;
+    H.mtime = mtime;
+    H.crc   = W_ReadFileCRC(filename);
+    H.used  = true;
+
+    file_hashes_changed = true;
+
+    return H.crc;
+}
+
+//
+// W_LoadOrderKey
+//
+// Computes a key for the current list of data files, which is used to
+// check whether things cached by a previous run (like the DDF snapshot)
+// are still valid.  Files are compared by name and contents, and so are
+// all the packs in edge_fixes, since which of those get added is only
+// known once the WADs have been read.  Changes to the snapshot format
+// itself are caught by its own version number (DDF_SNAPSHOT_VERSION).
+//
+uint32_t W_LoadOrderKey(void)
+{
+    epi::CRC32 crc;
+
+    crc.AddCString(edgeversion.s.c_str());
+
+    for (data_file_c *df : data_files)
+    {
+        crc += (int32_t)df->kind;
+
+        crc.AddCString(df->name.c_str());
+
+        if (df->kind == FLKIND_Folder || df->kind == FLKIND_EFolder || df->kind == FLKIND_IFolder)
+        {
+            std::vector<epi::DirectoryEntry> fsd;
+
+            if (!epi::WalkDirectory(fsd, df->name))
+                continue;
+
+            std::sort(fsd.begin(), fsd.end(), [](const epi::DirectoryEntry &A, const epi::DirectoryEntry &B) {
+                return A.name < B.name;
+            });
+
+            for (auto &entry : fsd)
+            {
+                crc.AddCString(entry.name.c_str());
+
+                if (!entry.is_dir)
+                    crc += W_CachedFileCRC(entry.name);
+            }
+
+            continue;
+        }
+
+        crc += W_CachedFileCRC(df->name);
+    }
+
+    // possible fix packs (see ProcessFixersForWad)
+    std::vector<epi::DirectoryEntry> fixes;
+
+    std::string fix_dir = epi::PathAppend(game_dir, "edge_fixes");
+
+    if (epi::ReadDirectory(fixes, fix_dir, "*.epk"))
+    {
+        std::sort(fixes.begin(), fixes.end(), [](const epi::DirectoryEntry &A, const epi::DirectoryEntry &B) {
+            return A.name < B.name;
+        });
+
+        for (auto &entry : fixes)
+        {
+            crc.AddCString(entry.name.c_str());
+            crc += W_CachedFileCRC(entry.name);
+        }
+    }
+
+    W_SaveFileHashes();
+
+    return crc.GetCRC();
+}
+
+//
+// W_FileContentHash
+//
+// Computes a checksum of a data file's contents (for folders, the names
+// and sizes of the files inside), which unlike W_LoadOrderKey does not
+// depend on where the file lives or the build being run.  Used to check
+// that a demo is played back with the same data it was recorded with.
+//
+uint32_t W_FileContentHash(data_file_c *df)
+{
+    epi::CRC32 crc;
+
+    if (df->kind == FLKIND_Folder || df->kind == FLKIND_EFolder || df->kind == FLKIND_IFolder)
+    {
+        std::vector<epi::DirectoryEntry> fsd;
+
+        if (!epi::WalkDirectory(fsd, df->name))
+            return crc.GetCRC();
+
+        std::sort(fsd.begin(), fsd.end(), [](const epi::DirectoryEntry &A, const epi::DirectoryEntry &B) {
+            return A.name < B.name;
+        });
+
+        for (auto &entry : fsd)
+        {
+            crc.AddCString(epi::MakePathRelative(df->name, entry.name).c_str());
+            crc += (uint32_t)(entry.size & 0xFFFFFFFF);
+        }
+
+        return crc.GetCRC();
+    }
+
+    return W_CachedFileCRC(df->name);
+}
+
 void W_BuildNodes(void)
 {
     for (size_t i = 0; i < data_files.size(); i++)
@@ -85,6 +85,8 @@ int    W_GetNumFiles();
 void   W_ShowFiles();
 
 void   W_ProcessMultipleFiles();
+uint32_t W_LoadOrderKey(void);
+uint32_t W_FileContentHash(data_file_c *df);
 size_t W_AddPending(std::string file, filekind_e kind);
 void   ProcessFile(data_file_c *df);
 
@@ -986,7 +986,7 @@ void ProcessFixersForWad(data_file_c *df)
 void ProcessDehackedInWad(data_file_c *df)
 {
     int deh_lump = df->wad->deh_lump;
-    if (deh_lump < 0)
+    if (deh_lump < 0 || DDF_SnapshotLoaded())
         return;
 
     const char *lump_name = lumpinfo[deh_lump].name;
@@ -1009,6 +1009,10 @@ void ProcessDehackedInWad(data_file_c *df)
 
 static void ProcessDDFInWad(data_file_c *df)
 {
+    // everything was read from the DDF snapshot
+    if (DDF_SnapshotLoaded())
+        return;
+
     std::string bare_filename = epi::GetFilename(df->name);
 
     for (size_t d = 0; d < DDF_NUM_TYPES; d++)
@@ -96,6 +96,17 @@ bool FileDelete(std::string_view name)
     std::wstring wname = epi::UTF8ToWString(name);
     return _wremove(wname.c_str()) == 0;
 }
+bool GetFileInfo(std::string_view name, int64_t &size, int64_t &mtime)
+{
+    SYS_ASSERT(!name.empty());
+    std::wstring wname = epi::UTF8ToWString(name);
+    struct _stat64 finfo;
+    if (_wstat64(wname.c_str(), &finfo) != 0)
+        return false;
+    size  = (int64_t)finfo.st_size;
+    mtime = (int64_t)finfo.st_mtime;
+    return true;
+}
 bool IsDirectory(std::string_view dir)
 {
     SYS_ASSERT(!dir.empty());
@@ -105,7 +116,7 @@ bool IsDirectory(std::string_view dir)
         return false;
     return(dircheck.st_mode & _S_IFDIR);
 }
-static std::string CurrentDirectoryGet()
+std::string CurrentDirectoryGet()
 {
     std::string directory;
     const wchar_t *dir = _wgetcwd(nullptr, 0);
@@ -302,6 +313,16 @@ bool FileDelete(std::string_view name)
     SYS_ASSERT(!name.empty());
     return remove(std::string(name).c_str()) == 0;
 }
+bool GetFileInfo(std::string_view name, int64_t &size, int64_t &mtime)
+{
+    SYS_ASSERT(!name.empty());
+    struct stat finfo;
+    if (stat(std::string(name).c_str(), &finfo) != 0)
+        return false;
+    size  = (int64_t)finfo.st_size;
+    mtime = (int64_t)finfo.st_mtime;
+    return true;
+}
 bool IsDirectory(std::string_view dir)
 {
     SYS_ASSERT(!dir.empty());
@@ -310,7 +331,7 @@ bool IsDirectory(std::string_view dir)
         return false;
     return S_ISDIR(dircheck.st_mode);
 }
-static std::string CurrentDirectoryGet()
+std::string CurrentDirectoryGet()
 {
     std::string directory;
     const char *dir = getcwd(nullptr, 0);
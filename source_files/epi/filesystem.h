@@ -57,6 +57,7 @@ bool IsPathAbsolute(std::string_view path);
 void ReplaceExtension(std::string &path, std::string_view ext);
 
 // Directory Functions
+std::string CurrentDirectoryGet();
 bool CurrentDirectorySet(std::string_view dir);
 bool IsDirectory(std::string_view dir);
 bool MakeDirectory(std::string_view dir);
@@ -72,6 +73,8 @@ FILE   *FileOpenRaw(std::string_view name, unsigned int flags);
 // NOTE: there's no CloseFile function, just delete the object.
 bool FileCopy(std::string_view src, std::string_view dest);
 bool FileDelete(std::string_view name);
+// Gets the size and time of last modification, false if the file is missing.
+bool GetFileInfo(std::string_view name, int64_t &size, int64_t &mtime);
 
 // General Filesystem Functions
 // Performs a sync for platforms with virtualized file systems
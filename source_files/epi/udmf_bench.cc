@@ -0,0 +1,659 @@
+//----------------------------------------------------------------------------
+//  EPI UDMF Parser Benchmark
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024  The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Standalone program (EDGE_UDMF_BENCH option) which reads a TEXTMAP
+//  the way level setup used to, with one epi::Lexer pass per type of
+//  block, then with epi::ParseUDMF, and reports the time taken and the
+//  allocations made by each, and whether the results are the same.
+//
+//  The TEXTMAP comes from a file (a saved lump, or a WAD plus the name
+//  of a UDMF map in it), or is generated with the given number of
+//  vertices:
+//
+//      udmf-bench 200000
+//      udmf-bench TEXTMAP.txt
+//      udmf-bench test.wad MAP01
+//
+//----------------------------------------------------------------------------
+
+#include "epi.h"
+#include "str_lexer.h"
+#include "str_util.h"
+#include "udmf_parser.h"
+
+#include <chrono>
+#include <new>
+
+void I_Error(const char *error, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, error);
+    vfprintf(stderr, error, argptr);
+    va_end(argptr);
+
+    exit(1);
+}
+
+void I_Warning(const char *warning, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, warning);
+    vfprintf(stderr, warning, argptr);
+    va_end(argptr);
+}
+
+void I_Printf(const char *message, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, message);
+    vprintf(message, argptr);
+    va_end(argptr);
+}
+
+void I_Debugf(const char *message, ...)
+{
+    (void)message;
+}
+
+//----------------------------------------------------------------------------
+//  ALLOCATION COUNTING
+//----------------------------------------------------------------------------
+
+static int64_t alloc_count = 0;
+
+static void *CountedAlloc(size_t size)
+{
+    alloc_count++;
+
+    void *p = malloc(size > 0 ? size : 1);
+
+    if (!p)
+        abort();
+
+    return p;
+}
+
+void *operator new(size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    free(p);
+}
+
+//----------------------------------------------------------------------------
+//  OLD PARSER
+//----------------------------------------------------------------------------
+
+// The reference reads TEXTMAP the way level setup used to: with one full
+// epi::Lexer pass for each type of block, keeping only the blocks of that
+// type (the extra pass which counted the blocks is left out).
+
+typedef void (*udmf_field_func_t)(epi::UDMFMap &map, const std::string &key, const std::string &value);
+
+static void OldUDMFPass(const std::string &data, const char *want, epi::UDMFMap &map, void (*begin_block)(epi::UDMFMap &map),
+                        udmf_field_func_t field)
+{
+    epi::Lexer lex(data);
+
+    for (;;)
+    {
+        std::string section;
+
+        epi::TokenKind tok = lex.Next(section);
+
+        if (tok == epi::kTokenEOF)
+            break;
+
+        if (tok != epi::kTokenIdentifier)
+            I_Error("udmf-bench: malformed TEXTMAP lump.\n");
+
+        // ignore top-level assignments
+        if (lex.Match("="))
+        {
+            lex.Next(section);
+
+            if (!lex.Match(";"))
+                I_Error("udmf-bench: malformed TEXTMAP lump: missing ';'\n");
+
+            continue;
+        }
+
+        if (!lex.Match("{"))
+            I_Error("udmf-bench: malformed TEXTMAP lump: missing '{'\n");
+
+        if (section != want)
+        {
+            // skip the whole block
+            for (;;)
+            {
+                tok = lex.Next(section);
+
+                if (lex.Match("}") || tok == epi::kTokenEOF)
+                    break;
+            }
+
+            continue;
+        }
+
+        (*begin_block)(map);
+
+        for (;;)
+        {
+            if (lex.Match("}"))
+                break;
+
+            std::string key;
+            std::string value;
+
+            tok = lex.Next(key);
+
+            if (tok == epi::kTokenEOF)
+                I_Error("udmf-bench: malformed TEXTMAP lump: unclosed block\n");
+
+            if (tok != epi::kTokenIdentifier)
+                I_Error("udmf-bench: malformed TEXTMAP lump: missing key\n");
+
+            if (!lex.Match("="))
+                I_Error("udmf-bench: malformed TEXTMAP lump: missing '='\n");
+
+            tok = lex.Next(value);
+
+            if (tok == epi::kTokenEOF || value == "}")
+                I_Error("udmf-bench: malformed TEXTMAP lump: missing value\n");
+
+            if (!lex.Match(";"))
+                I_Error("udmf-bench: malformed TEXTMAP lump: missing ';'\n");
+
+            (*field)(map, key, value);
+        }
+    }
+}
+
+#define UDMF_DOUBLE(k, f)                                                                                              \
+    else if (key == k) B.f = epi::LexDouble(value);
+#define UDMF_INT(k, f)                                                                                                 \
+    else if (key == k) B.f = epi::LexInteger(value);
+#define UDMF_TEXTURE(k, f)                                                                                             \
+    else if (key == k) Z_StrNCpy(B.f, value.c_str(), 8);
+#define UDMF_FLAG(k, f)                                                                                                \
+    else if (key == k) B.flags |= epi::LexBoolean(value) ? f : 0;
+
+static void OldUDMFVertex(epi::UDMFMap &map, const std::string &key, const std::string &value)
+{
+    epi::UDMFVertex &B = map.vertices.back();
+
+    if (false) {}
+    UDMF_DOUBLE("x", x)
+    UDMF_DOUBLE("y", y)
+    UDMF_DOUBLE("zfloor", zfloor)
+    UDMF_DOUBLE("zceiling", zceiling)
+}
+
+static void OldUDMFSector(epi::UDMFMap &map, const std::string &key, const std::string &value)
+{
+    epi::UDMFSector &B = map.sectors.back();
+
+    if (false) {}
+    UDMF_INT("heightfloor", heightfloor)
+    UDMF_INT("heightceiling", heightceiling)
+    UDMF_TEXTURE("texturefloor", texturefloor)
+    UDMF_TEXTURE("textureceiling", textureceiling)
+    UDMF_INT("lightlevel", lightlevel)
+    UDMF_INT("special", special)
+    UDMF_INT("id", id)
+    UDMF_INT("lightcolor", lightcolor)
+    UDMF_INT("fadecolor", fadecolor)
+    UDMF_INT("fogdensity", fogdensity)
+    UDMF_DOUBLE("xpanningfloor", xpanningfloor)
+    UDMF_DOUBLE("ypanningfloor", ypanningfloor)
+    UDMF_DOUBLE("xpanningceiling", xpanningceiling)
+    UDMF_DOUBLE("ypanningceiling", ypanningceiling)
+    UDMF_DOUBLE("xscalefloor", xscalefloor)
+    UDMF_DOUBLE("yscalefloor", yscalefloor)
+    UDMF_DOUBLE("xscaleceiling", xscaleceiling)
+    UDMF_DOUBLE("yscaleceiling", yscaleceiling)
+    UDMF_DOUBLE("rotationfloor", rotationfloor)
+    UDMF_DOUBLE("rotationceiling", rotationceiling)
+    UDMF_DOUBLE("gravity", gravity)
+}
+
+static void OldUDMFSidedef(epi::UDMFMap &map, const std::string &key, const std::string &value)
+{
+    epi::UDMFSidedef &B = map.sidedefs.back();
+
+    if (false) {}
+    UDMF_INT("offsetx", offsetx)
+    UDMF_INT("offsety", offsety)
+    UDMF_DOUBLE("offsetx_bottom", offsetx_bottom)
+    UDMF_DOUBLE("offsetx_mid", offsetx_mid)
+    UDMF_DOUBLE("offsetx_top", offsetx_top)
+    UDMF_DOUBLE("offsety_bottom", offsety_bottom)
+    UDMF_DOUBLE("offsety_mid", offsety_mid)
+    UDMF_DOUBLE("offsety_top", offsety_top)
+    UDMF_DOUBLE("scalex_bottom", scalex_bottom)
+    UDMF_DOUBLE("scalex_mid", scalex_mid)
+    UDMF_DOUBLE("scalex_top", scalex_top)
+    UDMF_DOUBLE("scaley_bottom", scaley_bottom)
+    UDMF_DOUBLE("scaley_mid", scaley_mid)
+    UDMF_DOUBLE("scaley_top", scaley_top)
+    UDMF_TEXTURE("texturetop", texturetop)
+    UDMF_TEXTURE("texturebottom", texturebottom)
+    UDMF_TEXTURE("texturemiddle", texturemiddle)
+    UDMF_INT("sector", sector)
+}
+
+static void OldUDMFLinedef(epi::UDMFMap &map, const std::string &key, const std::string &value)
+{
+    epi::UDMFLinedef &B = map.linedefs.back();
+
+    if (false) {}
+    UDMF_INT("id", id)
+    UDMF_INT("v1", v1)
+    UDMF_INT("v2", v2)
+    UDMF_INT("special", special)
+    UDMF_INT("sidefront", sidefront)
+    UDMF_INT("sideback", sideback)
+    UDMF_FLAG("blocking", epi::kUDMFLineBlocking)
+    UDMF_FLAG("blockmonsters", epi::kUDMFLineBlockMonsters)
+    UDMF_FLAG("twosided", epi::kUDMFLineTwoSided)
+    UDMF_FLAG("dontpegtop", epi::kUDMFLineDontPegTop)
+    UDMF_FLAG("dontpegbottom", epi::kUDMFLineDontPegBottom)
+    UDMF_FLAG("secret", epi::kUDMFLineSecret)
+    UDMF_FLAG("blocksound", epi::kUDMFLineBlockSound)
+    UDMF_FLAG("dontdraw", epi::kUDMFLineDontDraw)
+    UDMF_FLAG("mapped", epi::kUDMFLineMapped)
+    UDMF_FLAG("passuse", epi::kUDMFLinePassUse)
+    UDMF_FLAG("blockplayers", epi::kUDMFLineBlockPlayers)
+    UDMF_FLAG("blocksight", epi::kUDMFLineBlockSight)
+}
+
+static void OldUDMFThing(epi::UDMFMap &map, const std::string &key, const std::string &value)
+{
+    epi::UDMFThing &B = map.things.back();
+
+    if (false) {}
+    UDMF_INT("id", id)
+    UDMF_DOUBLE("x", x)
+    UDMF_DOUBLE("y", y)
+    UDMF_DOUBLE("height", height)
+    UDMF_INT("angle", angle)
+    UDMF_INT("type", type)
+    UDMF_FLAG("skill1", epi::kUDMFThingSkill1)
+    UDMF_FLAG("skill2", epi::kUDMFThingSkill2)
+    UDMF_FLAG("skill3", epi::kUDMFThingSkill3)
+    UDMF_FLAG("skill4", epi::kUDMFThingSkill4)
+    UDMF_FLAG("skill5", epi::kUDMFThingSkill5)
+    UDMF_FLAG("ambush", epi::kUDMFThingAmbush)
+    UDMF_FLAG("single", epi::kUDMFThingSingle)
+    UDMF_FLAG("dm", epi::kUDMFThingDM)
+    UDMF_FLAG("coop", epi::kUDMFThingCoop)
+    UDMF_FLAG("friend", epi::kUDMFThingFriend)
+    UDMF_DOUBLE("health", health)
+    UDMF_DOUBLE("alpha", alpha)
+    UDMF_DOUBLE("scale", scale)
+    UDMF_DOUBLE("scalex", scalex)
+    UDMF_DOUBLE("scaley", scaley)
+}
+
+#undef UDMF_DOUBLE
+#undef UDMF_INT
+#undef UDMF_TEXTURE
+#undef UDMF_FLAG
+
+static void OldParseUDMF(const char *data, size_t length, epi::UDMFMap &map)
+{
+    map.Clear();
+
+    // the old code also copied the lump into a string
+    std::string text(data, length);
+
+    OldUDMFPass(text, "vertex", map, [](epi::UDMFMap &M) { M.vertices.emplace_back(); }, OldUDMFVertex);
+    OldUDMFPass(text, "sector", map, [](epi::UDMFMap &M) { M.sectors.emplace_back(); }, OldUDMFSector);
+    OldUDMFPass(text, "sidedef", map, [](epi::UDMFMap &M) { M.sidedefs.emplace_back(); }, OldUDMFSidedef);
+    OldUDMFPass(text, "linedef", map, [](epi::UDMFMap &M) { M.linedefs.emplace_back(); }, OldUDMFLinedef);
+    OldUDMFPass(text, "thing", map, [](epi::UDMFMap &M) { M.things.emplace_back(); }, OldUDMFThing);
+}
+
+// field by field, since the padding in the structs may differ
+#define SAME(f)                                                                                                        \
+    if (A.f != B.f)                                                                                                    \
+        return false;
+#define SAME_TEX(f)                                                                                                    \
+    if (strcmp(A.f, B.f) != 0)                                                                                         \
+        return false;
+
+static bool SameUDMFVertex(const epi::UDMFVertex &A, const epi::UDMFVertex &B)
+{
+    SAME(x) SAME(y) SAME(zfloor) SAME(zceiling)
+    return true;
+}
+
+static bool SameUDMFSector(const epi::UDMFSector &A, const epi::UDMFSector &B)
+{
+    SAME(heightfloor) SAME(heightceiling) SAME_TEX(texturefloor) SAME_TEX(textureceiling)
+    SAME(lightlevel) SAME(special) SAME(id) SAME(lightcolor) SAME(fadecolor) SAME(fogdensity)
+    SAME(xpanningfloor) SAME(ypanningfloor) SAME(xpanningceiling) SAME(ypanningceiling)
+    SAME(xscalefloor) SAME(yscalefloor) SAME(xscaleceiling) SAME(yscaleceiling)
+    SAME(rotationfloor) SAME(rotationceiling) SAME(gravity)
+    return true;
+}
+
+static bool SameUDMFSidedef(const epi::UDMFSidedef &A, const epi::UDMFSidedef &B)
+{
+    SAME(offsetx) SAME(offsety)
+    SAME(offsetx_bottom) SAME(offsetx_mid) SAME(offsetx_top)
+    SAME(offsety_bottom) SAME(offsety_mid) SAME(offsety_top)
+    SAME(scalex_bottom) SAME(scalex_mid) SAME(scalex_top)
+    SAME(scaley_bottom) SAME(scaley_mid) SAME(scaley_top)
+    SAME_TEX(texturetop) SAME_TEX(texturebottom) SAME_TEX(texturemiddle) SAME(sector)
+    return true;
+}
+
+static bool SameUDMFLinedef(const epi::UDMFLinedef &A, const epi::UDMFLinedef &B)
+{
+    SAME(id) SAME(v1) SAME(v2) SAME(special) SAME(sidefront) SAME(sideback) SAME(flags)
+    return true;
+}
+
+static bool SameUDMFThing(const epi::UDMFThing &A, const epi::UDMFThing &B)
+{
+    SAME(id) SAME(x) SAME(y) SAME(height) SAME(angle) SAME(type) SAME(flags)
+    SAME(health) SAME(alpha) SAME(scale) SAME(scalex) SAME(scaley)
+    return true;
+}
+
+#undef SAME
+#undef SAME_TEX
+
+template <typename T>
+static bool SameUDMFArray(const std::vector<T> &A, const std::vector<T> &B, bool (*same)(const T &, const T &))
+{
+    if (A.size() != B.size())
+        return false;
+
+    for (size_t i = 0; i < A.size(); i++)
+        if (!(*same)(A[i], B[i]))
+            return false;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+//  TEST DATA
+//----------------------------------------------------------------------------
+
+// simple LCG, so the generated map is the same everywhere
+static uint32_t udmf_bench_seed;
+
+static int UDMFBenchRandom(int low, int high)
+{
+    udmf_bench_seed = udmf_bench_seed * 1664525 + 1013904223;
+
+    return low + (int)((udmf_bench_seed >> 8) % (uint32_t)(high - low + 1));
+}
+
+// makes a TEXTMAP with the given number of vertices (and in proportion,
+// sectors, sidedefs, linedefs and things), using comments, strings with
+// escapes, optional and unknown keys like real maps do.
+static void GenerateUDMFBenchData(int num_vertices, std::string &text)
+{
+    static const char *line_flags[] = {"blocking", "twosided", "dontpegtop", "secret", "mapped", "passuse",
+                                       "blocksight"};
+    static const char *thing_flags[] = {"skill1", "skill2", "skill3", "single", "dm", "coop", "ambush", "friend"};
+
+    int num_sectors  = HMM_MAX(1, num_vertices / 10);
+    int num_sidedefs = HMM_MAX(1, num_vertices * 3 / 2);
+    int num_linedefs = num_vertices;
+    int num_things   = num_vertices * 3 / 20;
+
+    udmf_bench_seed = 7;
+
+    text = "namespace = \"edge-classic\";\n// comment\n/* block\ncomment */\n";
+
+    for (int i = 0; i < num_vertices; i++)
+    {
+        text += epi::StringFormat("vertex // %d\n{\nx = %d.000;\ny = %d.5;\n%s}\n", i, UDMFBenchRandom(-9000, 9000),
+                                  UDMFBenchRandom(-9000, 9000), (i % 7 == 0) ? "zfloor = 12.0;\n" : "");
+    }
+
+    for (int i = 0; i < num_sectors; i++)
+    {
+        text += epi::StringFormat("sector\n{\nheightfloor = %d;\nheightceiling = %d;\ntexturefloor = \"FLOOR%d_1\";\n"
+                                  "textureceiling = \"CEIL\\x41\\101\";\nlightlevel = %d;\nspecial = %d;\nid = %d;\n",
+                                  UDMFBenchRandom(-100, 100), UDMFBenchRandom(100, 300), i % 9,
+                                  UDMFBenchRandom(0, 255), i % 20, i % 50);
+
+        if (i % 5 == 0)
+            text += "lightcolor = 0xFF8040;\nfogdensity = 2000;\n";
+
+        if (i % 3 == 0)
+            text += "xpanningfloor = 3.25;\nrotationceiling = 45.0;\ngravity = 0.5;\nunknownkey = \"x\";\n";
+
+        text += "}\n";
+    }
+
+    for (int i = 0; i < num_sidedefs; i++)
+    {
+        text += epi::StringFormat("sidedef\n{\nsector = %d;\ntexturemiddle = \"STARTAN3\";\n%soffsetx = %d;\n",
+                                  UDMFBenchRandom(0, num_sectors - 1), (i % 2) ? "texturetop = \"BIGDOOR2\";\n" : "",
+                                  UDMFBenchRandom(-64, 64));
+
+        if (i % 11 == 0)
+            text += "offsety_mid = -1.5e1;\nscalex_top = 2.0;\ncomment = \"a \\\"quoted\\\" // string\";\n";
+
+        text += "}\n";
+    }
+
+    for (int i = 0; i < num_linedefs; i++)
+    {
+        text += epi::StringFormat("linedef\n{\nv1 = %d;\nv2 = %d;\nsidefront = %d;\n",
+                                  UDMFBenchRandom(0, num_vertices - 1), UDMFBenchRandom(0, num_vertices - 1),
+                                  UDMFBenchRandom(0, num_sidedefs - 1));
+
+        if (i % 3 == 0)
+            text += epi::StringFormat("sideback = %d;\n", UDMFBenchRandom(0, num_sidedefs - 1));
+
+        text += epi::StringFormat("special = %d;\n", (i % 4 == 0) ? 97 : 0);
+
+        for (int f = UDMFBenchRandom(0, 3); f > 0; f--)
+            text += epi::StringFormat("%s = true;\n", line_flags[UDMFBenchRandom(0, 6)]);
+
+        text += epi::StringFormat("id = %d;\n}\n", (i % 2) ? 5 : -1);
+    }
+
+    for (int i = 0; i < num_things; i++)
+    {
+        text += epi::StringFormat("thing\n{\nx = %d.0;\ny = %d;\nangle = %d;\ntype = %d;\n",
+                                  UDMFBenchRandom(-9000, 9000), UDMFBenchRandom(-9000, 9000),
+                                  UDMFBenchRandom(0, 3) * 90, (i % 3 == 0) ? 3001 : 2001);
+
+        for (int f = UDMFBenchRandom(0, 8); f > 0; f--)
+            text += epi::StringFormat("%s = %s;\n", thing_flags[UDMFBenchRandom(0, 7)],
+                                      UDMFBenchRandom(0, 1) ? "true" : "false");
+
+        if (i % 4 == 0)
+            text += "health = -2.0;\nscalex = 1.5;\nalpha = 0.5;\n";
+
+        text += "}\n";
+    }
+}
+
+static bool LoadFile(const char *filename, std::string &data)
+{
+    FILE *fp = fopen(filename, "rb");
+
+    if (fp == NULL)
+        return false;
+
+    char buffer[65536];
+
+    for (;;)
+    {
+        size_t got = fread(buffer, 1, sizeof(buffer), fp);
+
+        if (got == 0)
+            break;
+
+        data.append(buffer, got);
+    }
+
+    fclose(fp);
+    return true;
+}
+
+static uint32_t WADLong(const std::string &wad, size_t pos)
+{
+    const uint8_t *p = (const uint8_t *)wad.data() + pos;
+
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// replaces the WAD in data with the TEXTMAP of the given map
+static void FindWADTextmap(std::string &data, const char *map_name)
+{
+    if (data.size() < 12 || (data.compare(0, 4, "IWAD") != 0 && data.compare(0, 4, "PWAD") != 0))
+        I_Error("udmf-bench: not a WAD file\n");
+
+    uint32_t num_lumps = WADLong(data, 4);
+    uint32_t dir_start = WADLong(data, 8);
+
+    if (dir_start > data.size() || num_lumps > (data.size() - dir_start) / 16)
+        I_Error("udmf-bench: bad WAD directory\n");
+
+    for (uint32_t i = 0; i + 1 < num_lumps; i++)
+    {
+        size_t entry = dir_start + i * 16;
+
+        char name[9];
+        char next[9];
+
+        Z_StrNCpy(name, data.data() + entry + 8, 8);
+        Z_StrNCpy(next, data.data() + entry + 16 + 8, 8);
+
+        if (epi::StringCaseCompareASCII(name, map_name) != 0 || strcmp(next, "TEXTMAP") != 0)
+            continue;
+
+        uint32_t pos    = WADLong(data, entry + 16);
+        uint32_t length = WADLong(data, entry + 16 + 4);
+
+        if (pos > data.size() || length > data.size() - pos)
+            I_Error("udmf-bench: bad TEXTMAP lump in %s\n", map_name);
+
+        data = data.substr(pos, length);
+        return;
+    }
+
+    I_Error("udmf-bench: no UDMF map %s in the WAD\n", map_name);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: udmf-bench <vertex count>\n"
+                        "       udmf-bench <textmap file>\n"
+                        "       udmf-bench <wad file> <map>\n");
+        return 1;
+    }
+
+    std::string data;
+
+    if (isdigit(argv[1][0]))
+        GenerateUDMFBenchData(HMM_MAX(1, atoi(argv[1])), data);
+    else if (!LoadFile(argv[1], data))
+        I_Error("udmf-bench: unable to read %s\n", argv[1]);
+    else if (argc > 2)
+        FindWADTextmap(data, argv[2]);
+
+    epi::UDMFMap old_map;
+    epi::UDMFMap new_map;
+
+    int64_t start_count = alloc_count;
+    auto    start       = std::chrono::steady_clock::now();
+
+    OldParseUDMF(data.data(), data.size(), old_map);
+
+    double  old_time  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    int64_t old_count = alloc_count - start_count;
+
+    start_count = alloc_count;
+    start       = std::chrono::steady_clock::now();
+
+    epi::ParseUDMF(data.data(), data.size(), new_map, "udmf-bench: ");
+
+    double  new_time  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    int64_t new_count = alloc_count - start_count;
+
+    bool same = SameUDMFArray(old_map.vertices, new_map.vertices, SameUDMFVertex) &&
+                SameUDMFArray(old_map.sectors, new_map.sectors, SameUDMFSector) &&
+                SameUDMFArray(old_map.sidedefs, new_map.sidedefs, SameUDMFSidedef) &&
+                SameUDMFArray(old_map.linedefs, new_map.linedefs, SameUDMFLinedef) &&
+                SameUDMFArray(old_map.things, new_map.things, SameUDMFThing);
+
+    printf("UDMF parser benchmark\n\n");
+
+    printf("  %1.1f MB, %d vertices, %d sectors, %d sidedefs, %d linedefs, %d things\n\n", data.size() / 1048576.0,
+           (int)new_map.vertices.size(), (int)new_map.sectors.size(), (int)new_map.sidedefs.size(),
+           (int)new_map.linedefs.size(), (int)new_map.things.size());
+
+    printf("  one lexer pass per type  %10.1f ms %12lld allocations\n", old_time, (long long)old_count);
+    printf("  single pass (ParseUDMF)  %10.1f ms %12lld allocations\n\n", new_time, (long long)new_count);
+
+    printf("  results are %s\n", same ? "identical" : "DIFFERENT");
+
+    return same ? 0 : 1;
+}
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
@@ -0,0 +1,1027 @@
+//----------------------------------------------------------------------------
+//  EPI UDMF (TEXTMAP) Parser
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024  The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  The tokenizer follows the same rules as epi::Lexer (see str_lexer.cc),
+//  but works directly on the lump memory and keeps the current token in
+//  a reused buffer, so no memory is allocated per token.
+//
+//----------------------------------------------------------------------------
+
+#include "epi.h"
+#include "udmf_parser.h"
+
+#include <stdlib.h>
+#include <ctype.h>
+
+namespace epi
+{
+
+// keys we care about.  these MUST be kept in the same (sorted) order as
+// the udmf_key_names[] table below.
+enum UDMFKey
+{
+    kKeyAlpha,
+    kKeyAmbush,
+    kKeyAngle,
+    kKeyBlocking,
+    kKeyBlockmonsters,
+    kKeyBlockplayers,
+    kKeyBlocksight,
+    kKeyBlocksound,
+    kKeyCoop,
+    kKeyDm,
+    kKeyDontdraw,
+    kKeyDontpegbottom,
+    kKeyDontpegtop,
+    kKeyFadecolor,
+    kKeyFogdensity,
+    kKeyFriend,
+    kKeyGravity,
+    kKeyHealth,
+    kKeyHeight,
+    kKeyHeightceiling,
+    kKeyHeightfloor,
+    kKeyId,
+    kKeyLightcolor,
+    kKeyLightlevel,
+    kKeyMapped,
+    kKeyOffsetx,
+    kKeyOffsetxBottom,
+    kKeyOffsetxMid,
+    kKeyOffsetxTop,
+    kKeyOffsety,
+    kKeyOffsetyBottom,
+    kKeyOffsetyMid,
+    kKeyOffsetyTop,
+    kKeyPassuse,
+    kKeyRotationceiling,
+    kKeyRotationfloor,
+    kKeyScale,
+    kKeyScalex,
+    kKeyScalexBottom,
+    kKeyScalexMid,
+    kKeyScalexTop,
+    kKeyScaley,
+    kKeyScaleyBottom,
+    kKeyScaleyMid,
+    kKeyScaleyTop,
+    kKeySecret,
+    kKeySector,
+    kKeySideback,
+    kKeySidefront,
+    kKeySingle,
+    kKeySkill1,
+    kKeySkill2,
+    kKeySkill3,
+    kKeySkill4,
+    kKeySkill5,
+    kKeySpecial,
+    kKeyTexturebottom,
+    kKeyTextureceiling,
+    kKeyTexturefloor,
+    kKeyTexturemiddle,
+    kKeyTexturetop,
+    kKeyTwosided,
+    kKeyType,
+    kKeyV1,
+    kKeyV2,
+    kKeyX,
+    kKeyXpanningceiling,
+    kKeyXpanningfloor,
+    kKeyXscaleceiling,
+    kKeyXscalefloor,
+    kKeyY,
+    kKeyYpanningceiling,
+    kKeyYpanningfloor,
+    kKeyYscaleceiling,
+    kKeyYscalefloor,
+    kKeyZceiling,
+    kKeyZfloor,
+    kTotalUDMFKeys,
+    kKeyUnknown = kTotalUDMFKeys
+};
+
+static const char *udmf_key_names[kTotalUDMFKeys] = {
+    "alpha",
+    "ambush",
+    "angle",
+    "blocking",
+    "blockmonsters",
+    "blockplayers",
+    "blocksight",
+    "blocksound",
+    "coop",
+    "dm",
+    "dontdraw",
+    "dontpegbottom",
+    "dontpegtop",
+    "fadecolor",
+    "fogdensity",
+    "friend",
+    "gravity",
+    "health",
+    "height",
+    "heightceiling",
+    "heightfloor",
+    "id",
+    "lightcolor",
+    "lightlevel",
+    "mapped",
+    "offsetx",
+    "offsetx_bottom",
+    "offsetx_mid",
+    "offsetx_top",
+    "offsety",
+    "offsety_bottom",
+    "offsety_mid",
+    "offsety_top",
+    "passuse",
+    "rotationceiling",
+    "rotationfloor",
+    "scale",
+    "scalex",
+    "scalex_bottom",
+    "scalex_mid",
+    "scalex_top",
+    "scaley",
+    "scaley_bottom",
+    "scaley_mid",
+    "scaley_top",
+    "secret",
+    "sector",
+    "sideback",
+    "sidefront",
+    "single",
+    "skill1",
+    "skill2",
+    "skill3",
+    "skill4",
+    "skill5",
+    "special",
+    "texturebottom",
+    "textureceiling",
+    "texturefloor",
+    "texturemiddle",
+    "texturetop",
+    "twosided",
+    "type",
+    "v1",
+    "v2",
+    "x",
+    "xpanningceiling",
+    "xpanningfloor",
+    "xscaleceiling",
+    "xscalefloor",
+    "y",
+    "ypanningceiling",
+    "ypanningfloor",
+    "yscaleceiling",
+    "yscalefloor",
+    "zceiling",
+    "zfloor",
+};
+
+static UDMFKey LookupKey(const std::string &name)
+{
+    int lo = 0;
+    int hi = kTotalUDMFKeys - 1;
+
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        int cmp = strcmp(name.c_str(), udmf_key_names[mid]);
+
+        if (cmp == 0)
+            return (UDMFKey)mid;
+
+        if (cmp < 0)
+            hi = mid - 1;
+        else
+            lo = mid + 1;
+    }
+
+    return kKeyUnknown;
+}
+
+enum UDMFBlock
+{
+    kBlockOther = 0,
+    kBlockVertex,
+    kBlockSector,
+    kBlockSidedef,
+    kBlockLinedef,
+    kBlockThing
+};
+
+enum UDMFToken
+{
+    kUDMFTokenEOF = 0,
+    kUDMFTokenIdentifier,
+    kUDMFTokenSymbol,
+    kUDMFTokenNumber,
+    kUDMFTokenString
+};
+
+class UDMFReader
+{
+  public:
+    UDMFReader(const char *data, size_t length, const char *who)
+        : pos_(data), end_(data + length), who_(who ? who : "")
+    {
+        token_.reserve(64);
+    }
+
+    ~UDMFReader()
+    {
+    }
+
+    void Parse(UDMFMap &map);
+
+  private:
+    const char *pos_;
+    const char *end_;
+    const char *who_;
+
+    // contents of the last token (lowercased for identifiers, unescaped
+    // for strings).  capacity is kept between tokens.
+    std::string token_;
+
+    void Malformed(const char *what);
+
+    void      SkipToNext();
+    bool      Match(char ch);
+    UDMFToken Next();
+
+    void ParseIdentifier();
+    void ParseNumber();
+    void ParseString();
+    void ParseEscape();
+
+    int    ValueInteger() const;
+    double ValueDouble() const;
+    bool   ValueBoolean() const;
+    void   ValueTexture(char *dest) const;
+
+    void ParseBlock(UDMFMap &map, UDMFBlock kind);
+
+    void SetVertexField(UDMFVertex &V, UDMFKey key);
+    void SetSectorField(UDMFSector &S, UDMFKey key);
+    void SetSidedefField(UDMFSidedef &SD, UDMFKey key);
+    void SetLinedefField(UDMFLinedef &L, UDMFKey key);
+    void SetThingField(UDMFThing &T, UDMFKey key);
+};
+
+void UDMFReader::Malformed(const char *what)
+{
+    if (what)
+        I_Error("%sMalformed TEXTMAP lump: %s\n", who_, what);
+    else
+        I_Error("%sMalformed TEXTMAP lump.\n", who_);
+}
+
+void UDMFReader::SkipToNext()
+{
+    while (pos_ < end_)
+    {
+        unsigned char ch = (unsigned char)*pos_;
+
+        // skip whitespace and control chars
+        if (ch <= 32 || ch == 127)
+        {
+            pos_++;
+            continue;
+        }
+
+        if (ch == '/' && pos_ + 1 < end_)
+        {
+            // single line comment?
+            if (pos_[1] == '/')
+            {
+                pos_ += 2;
+
+                while (pos_ < end_ && *pos_ != '\n')
+                    pos_++;
+
+                continue;
+            }
+
+            // multi-line comment?
+            if (pos_[1] == '*')
+            {
+                pos_ += 2;
+
+                while (pos_ < end_)
+                {
+                    if (pos_ + 1 < end_ && pos_[0] == '*' && pos_[1] == '/')
+                    {
+                        pos_ += 2;
+                        break;
+                    }
+
+                    pos_++;
+                }
+
+                continue;
+            }
+        }
+
+        // reached a token!
+        return;
+    }
+}
+
+bool UDMFReader::Match(char ch)
+{
+    SkipToNext();
+
+    if (pos_ < end_ && *pos_ == ch)
+    {
+        pos_++;
+        return true;
+    }
+
+    return false;
+}
+
+UDMFToken UDMFReader::Next()
+{
+    token_.clear();
+
+    SkipToNext();
+
+    if (pos_ >= end_)
+        return kUDMFTokenEOF;
+
+    unsigned char ch = (unsigned char)*pos_;
+
+    if (ch == '"')
+    {
+        ParseString();
+        return kUDMFTokenString;
+    }
+
+    if (ch == '-' || ch == '+')
+    {
+        // no digits after the sign?
+        if (pos_ + 1 >= end_ || !isdigit((unsigned char)pos_[1]))
+        {
+            token_.push_back(*pos_++);
+            return kUDMFTokenSymbol;
+        }
+    }
+
+    if (ch == '-' || ch == '+' || isdigit(ch))
+    {
+        ParseNumber();
+        return kUDMFTokenNumber;
+    }
+
+    if (isalpha(ch) || ch == '_' || ch >= 128)
+    {
+        ParseIdentifier();
+        return kUDMFTokenIdentifier;
+    }
+
+    // anything else is a single-character symbol
+    token_.push_back(*pos_++);
+
+    return kUDMFTokenSymbol;
+}
+
+void UDMFReader::ParseIdentifier()
+{
+    // NOTE: we lowercase the identifier, like epi::Lexer does.
+
+    for (; pos_ < end_; pos_++)
+    {
+        unsigned char ch = (unsigned char)*pos_;
+
+        // don't change a char when high-bit is set (for UTF-8)
+        if (ch < 128)
+            ch = tolower(ch);
+
+        if (!(isalnum(ch) || ch == '_' || ch >= 128))
+            break;
+
+        token_.push_back((char)ch);
+    }
+}
+
+void UDMFReader::ParseNumber()
+{
+    const char *start = pos_;
+
+    for (pos_++; pos_ < end_; pos_++)
+    {
+        unsigned char ch = (unsigned char)*pos_;
+
+        // this is fairly lax, but adequate for our purposes
+        if (!(isalnum(ch) || ch == '+' || ch == '-' || ch == '.'))
+            break;
+    }
+
+    token_.append(start, pos_ - start);
+}
+
+void UDMFReader::ParseString()
+{
+    // NOTE: we allow newlines ('\n') in the string, rather than produce an
+    //       an unterminated-string error.
+
+    pos_++;
+
+    while (pos_ < end_)
+    {
+        unsigned char ch = (unsigned char)*pos_++;
+
+        if (ch == '"')
+            break;
+
+        if (ch == '\\')
+        {
+            ParseEscape();
+            continue;
+        }
+
+        // skip all control characters except TAB and NEWLINE
+        if (ch < 32 && !(ch == '\t' || ch == '\n'))
+            continue;
+
+        if (ch == 127) // DEL
+            continue;
+
+        token_.push_back((char)ch);
+    }
+}
+
+void UDMFReader::ParseEscape()
+{
+    if (pos_ >= end_)
+    {
+        token_.push_back('\\');
+        return;
+    }
+
+    unsigned char ch = (unsigned char)*pos_;
+
+    // avoid control chars, especially newline
+    if (ch < 32 || ch == 127)
+    {
+        token_.push_back('\\');
+        return;
+    }
+
+    pos_++;
+
+    // octal sequence?  1 to 3 digits.
+    if ('0' <= ch && ch <= '7')
+    {
+        int val = (int)(ch - '0');
+
+        for (int i = 0; i < 2 && pos_ < end_ && '0' <= *pos_ && *pos_ <= '7'; i++)
+            val = val * 8 + (int)(*pos_++ - '0');
+
+        token_.push_back((char)val);
+        return;
+    }
+
+    // hexadecimal sequence?  followed by 1 to 2 hex digits.
+    if (ch == 'x' || ch == 'X')
+    {
+        int val = 0;
+
+        for (int i = 0; i < 2 && pos_ < end_ && isxdigit((unsigned char)*pos_); i++, pos_++)
+        {
+            char c = (char)tolower((unsigned char)*pos_);
+            val    = val * 16 + (isdigit((unsigned char)c) ? c - '0' : c - 'a' + 10);
+        }
+
+        token_.push_back((char)val);
+        return;
+    }
+
+    switch (ch)
+    {
+    case 'a':
+        token_.push_back('\a');
+        break; // bell
+    case 'b':
+        token_.push_back('\b');
+        break; // backspace
+    case 'f':
+        token_.push_back('\f');
+        break; // form feed
+    case 'n':
+        token_.push_back('\n');
+        break; // newline
+    case 't':
+        token_.push_back('\t');
+        break; // tab
+    case 'r':
+        token_.push_back('\r');
+        break; // carriage return
+    case 'v':
+        token_.push_back('\v');
+        break; // vertical tab
+
+    default:
+        // everything else, including '\\' and '"', is the char itself
+        token_.push_back((char)ch);
+        break;
+    }
+}
+
+// these mirror epi::LexInteger() and friends, using the token buffer
+
+int UDMFReader::ValueInteger() const
+{
+    return (int)strtol(token_.c_str(), NULL, 0);
+}
+
+double UDMFReader::ValueDouble() const
+{
+    return strtod(token_.c_str(), NULL);
+}
+
+bool UDMFReader::ValueBoolean() const
+{
+    if (token_.empty())
+        return false;
+
+    return (token_[0] == 't' || token_[0] == 'T');
+}
+
+void UDMFReader::ValueTexture(char *dest) const
+{
+    Z_StrNCpy(dest, token_.c_str(), 8);
+}
+
+void UDMFReader::SetVertexField(UDMFVertex &V, UDMFKey key)
+{
+    switch (key)
+    {
+    case kKeyX:
+        V.x = ValueDouble();
+        break;
+    case kKeyY:
+        V.y = ValueDouble();
+        break;
+    case kKeyZfloor:
+        V.zfloor = ValueDouble();
+        break;
+    case kKeyZceiling:
+        V.zceiling = ValueDouble();
+        break;
+    default:
+        break;
+    }
+}
+
+void UDMFReader::SetSectorField(UDMFSector &S, UDMFKey key)
+{
+    switch (key)
+    {
+    case kKeyHeightfloor:
+        S.heightfloor = ValueInteger();
+        break;
+    case kKeyHeightceiling:
+        S.heightceiling = ValueInteger();
+        break;
+    case kKeyTexturefloor:
+        ValueTexture(S.texturefloor);
+        break;
+    case kKeyTextureceiling:
+        ValueTexture(S.textureceiling);
+        break;
+    case kKeyLightlevel:
+        S.lightlevel = ValueInteger();
+        break;
+    case kKeySpecial:
+        S.special = ValueInteger();
+        break;
+    case kKeyId:
+        S.id = ValueInteger();
+        break;
+    case kKeyLightcolor:
+        S.lightcolor = ValueInteger();
+        break;
+    case kKeyFadecolor:
+        S.fadecolor = ValueInteger();
+        break;
+    case kKeyFogdensity:
+        S.fogdensity = ValueInteger();
+        break;
+    case kKeyXpanningfloor:
+        S.xpanningfloor = ValueDouble();
+        break;
+    case kKeyYpanningfloor:
+        S.ypanningfloor = ValueDouble();
+        break;
+    case kKeyXpanningceiling:
+        S.xpanningceiling = ValueDouble();
+        break;
+    case kKeyYpanningceiling:
+        S.ypanningceiling = ValueDouble();
+        break;
+    case kKeyXscalefloor:
+        S.xscalefloor = ValueDouble();
+        break;
+    case kKeyYscalefloor:
+        S.yscalefloor = ValueDouble();
+        break;
+    case kKeyXscaleceiling:
+        S.xscaleceiling = ValueDouble();
+        break;
+    case kKeyYscaleceiling:
+        S.yscaleceiling = ValueDouble();
+        break;
+    case kKeyRotationfloor:
+        S.rotationfloor = ValueDouble();
+        break;
+    case kKeyRotationceiling:
+        S.rotationceiling = ValueDouble();
+        break;
+    case kKeyGravity:
+        S.gravity = ValueDouble();
+        break;
+    default:
+        break;
+    }
+}
+
+void UDMFReader::SetSidedefField(UDMFSidedef &SD, UDMFKey key)
+{
+    switch (key)
+    {
+    case kKeyOffsetx:
+        SD.offsetx = ValueInteger();
+        break;
+    case kKeyOffsety:
+        SD.offsety = ValueInteger();
+        break;
+    case kKeyOffsetxBottom:
+        SD.offsetx_bottom = ValueDouble();
+        break;
+    case kKeyOffsetxMid:
+        SD.offsetx_mid = ValueDouble();
+        break;
+    case kKeyOffsetxTop:
+        SD.offsetx_top = ValueDouble();
+        break;
+    case kKeyOffsetyBottom:
+        SD.offsety_bottom = ValueDouble();
+        break;
+    case kKeyOffsetyMid:
+        SD.offsety_mid = ValueDouble();
+        break;
+    case kKeyOffsetyTop:
+        SD.offsety_top = ValueDouble();
+        break;
+    case kKeyScalexBottom:
+        SD.scalex_bottom = ValueDouble();
+        break;
+    case kKeyScalexMid:
+        SD.scalex_mid = ValueDouble();
+        break;
+    case kKeyScalexTop:
+        SD.scalex_top = ValueDouble();
+        break;
+    case kKeyScaleyBottom:
+        SD.scaley_bottom = ValueDouble();
+        break;
+    case kKeyScaleyMid:
+        SD.scaley_mid = ValueDouble();
+        break;
+    case kKeyScaleyTop:
+        SD.scaley_top = ValueDouble();
+        break;
+    case kKeyTexturetop:
+        ValueTexture(SD.texturetop);
+        break;
+    case kKeyTexturebottom:
+        ValueTexture(SD.texturebottom);
+        break;
+    case kKeyTexturemiddle:
+        ValueTexture(SD.texturemiddle);
+        break;
+    case kKeySector:
+        SD.sector = ValueInteger();
+        break;
+    default:
+        break;
+    }
+}
+
+void UDMFReader::SetLinedefField(UDMFLinedef &L, UDMFKey key)
+{
+    int flag = 0;
+
+    switch (key)
+    {
+    case kKeyId:
+        L.id = ValueInteger();
+        return;
+    case kKeyV1:
+        L.v1 = ValueInteger();
+        return;
+    case kKeyV2:
+        L.v2 = ValueInteger();
+        return;
+    case kKeySpecial:
+        L.special = ValueInteger();
+        return;
+    case kKeySidefront:
+        L.sidefront = ValueInteger();
+        return;
+    case kKeySideback:
+        L.sideback = ValueInteger();
+        return;
+
+    case kKeyBlocking:
+        flag = kUDMFLineBlocking;
+        break;
+    case kKeyBlockmonsters:
+        flag = kUDMFLineBlockMonsters;
+        break;
+    case kKeyTwosided:
+        flag = kUDMFLineTwoSided;
+        break;
+    case kKeyDontpegtop:
+        flag = kUDMFLineDontPegTop;
+        break;
+    case kKeyDontpegbottom:
+        flag = kUDMFLineDontPegBottom;
+        break;
+    case kKeySecret:
+        flag = kUDMFLineSecret;
+        break;
+    case kKeyBlocksound:
+        flag = kUDMFLineBlockSound;
+        break;
+    case kKeyDontdraw:
+        flag = kUDMFLineDontDraw;
+        break;
+    case kKeyMapped:
+        flag = kUDMFLineMapped;
+        break;
+    case kKeyPassuse:
+        flag = kUDMFLinePassUse;
+        break;
+    case kKeyBlockplayers:
+        flag = kUDMFLineBlockPlayers;
+        break;
+    case kKeyBlocksight:
+        flag = kUDMFLineBlockSight;
+        break;
+
+    default:
+        return;
+    }
+
+    if (ValueBoolean())
+        L.flags |= flag;
+}
+
+void UDMFReader::SetThingField(UDMFThing &T, UDMFKey key)
+{
+    int flag = 0;
+
+    switch (key)
+    {
+    case kKeyId:
+        T.id = ValueInteger();
+        return;
+    case kKeyX:
+        T.x = ValueDouble();
+        return;
+    case kKeyY:
+        T.y = ValueDouble();
+        return;
+    case kKeyHeight:
+        T.height = ValueDouble();
+        return;
+    case kKeyAngle:
+        T.angle = ValueInteger();
+        return;
+    case kKeyType:
+        T.type = ValueInteger();
+        return;
+    case kKeyHealth:
+        T.health = ValueDouble();
+        return;
+    case kKeyAlpha:
+        T.alpha = ValueDouble();
+        return;
+    case kKeyScale:
+        T.scale = ValueDouble();
+        return;
+    case kKeyScalex:
+        T.scalex = ValueDouble();
+        return;
+    case kKeyScaley:
+        T.scaley = ValueDouble();
+        return;
+
+    case kKeySkill1:
+        flag = kUDMFThingSkill1;
+        break;
+    case kKeySkill2:
+        flag = kUDMFThingSkill2;
+        break;
+    case kKeySkill3:
+        flag = kUDMFThingSkill3;
+        break;
+    case kKeySkill4:
+        flag = kUDMFThingSkill4;
+        break;
+    case kKeySkill5:
+        flag = kUDMFThingSkill5;
+        break;
+    case kKeyAmbush:
+        flag = kUDMFThingAmbush;
+        break;
+    case kKeySingle:
+        flag = kUDMFThingSingle;
+        break;
+    case kKeyDm:
+        flag = kUDMFThingDM;
+        break;
+    case kKeyCoop:
+        flag = kUDMFThingCoop;
+        break;
+    case kKeyFriend:
+        flag = kUDMFThingFriend;
+        break;
+
+    default:
+        return;
+    }
+
+    if (ValueBoolean())
+        T.flags |= flag;
+}
+
+void UDMFReader::ParseBlock(UDMFMap &map, UDMFBlock kind)
+{
+    switch (kind)
+    {
+    case kBlockVertex:
+        map.vertices.emplace_back();
+        break;
+    case kBlockSector:
+        map.sectors.emplace_back();
+        break;
+    case kBlockSidedef:
+        map.sidedefs.emplace_back();
+        break;
+    case kBlockLinedef:
+        map.linedefs.emplace_back();
+        break;
+    case kBlockThing:
+        map.things.emplace_back();
+        break;
+    default:
+        break;
+    }
+
+    for (;;)
+    {
+        if (Match('}'))
+            break;
+
+        UDMFToken tok = Next();
+
+        if (tok == kUDMFTokenEOF)
+            Malformed("unclosed block");
+
+        if (tok != kUDMFTokenIdentifier)
+            Malformed("missing key");
+
+        // unknown keys (and every key of other blocks) are skipped
+        UDMFKey key = (kind == kBlockOther) ? kKeyUnknown : LookupKey(token_);
+
+        if (!Match('='))
+            Malformed("missing '='");
+
+        tok = Next();
+
+        if (tok == kUDMFTokenEOF || (token_.size() == 1 && token_[0] == '}'))
+            Malformed("missing value");
+
+        if (!Match(';'))
+            Malformed("missing ';'");
+
+        if (key == kKeyUnknown)
+            continue;
+
+        switch (kind)
+        {
+        case kBlockVertex:
+            SetVertexField(map.vertices.back(), key);
+            break;
+        case kBlockSector:
+            SetSectorField(map.sectors.back(), key);
+            break;
+        case kBlockSidedef:
+            SetSidedefField(map.sidedefs.back(), key);
+            break;
+        case kBlockLinedef:
+            SetLinedefField(map.linedefs.back(), key);
+            break;
+        case kBlockThing:
+            SetThingField(map.things.back(), key);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void UDMFReader::Parse(UDMFMap &map)
+{
+    for (;;)
+    {
+        UDMFToken tok = Next();
+
+        if (tok == kUDMFTokenEOF)
+            break;
+
+        if (tok != kUDMFTokenIdentifier)
+            Malformed(NULL);
+
+        // top-level assignment?  only the namespace is remembered.
+        if (Match('='))
+        {
+            bool is_namespace = (token_ == "namespace");
+
+            Next();
+
+            if (is_namespace)
+                map.name_space = token_;
+
+            if (!Match(';'))
+                Malformed("missing ';'");
+            continue;
+        }
+
+        if (!Match('{'))
+            Malformed("missing '{'");
+
+        UDMFBlock kind = kBlockOther;
+
+        if (token_ == "vertex")
+            kind = kBlockVertex;
+        else if (token_ == "sector")
+            kind = kBlockSector;
+        else if (token_ == "sidedef")
+            kind = kBlockSidedef;
+        else if (token_ == "linedef")
+            kind = kBlockLinedef;
+        else if (token_ == "thing")
+            kind = kBlockThing;
+
+        ParseBlock(map, kind);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void UDMFMap::Clear()
+{
+    name_space.clear();
+
+    vertices.clear();
+    sectors.clear();
+    sidedefs.clear();
+    linedefs.clear();
+    things.clear();
+}
+
+void ParseUDMF(const char *data, size_t length, UDMFMap &map, const char *who)
+{
+    map.Clear();
+
+    UDMFReader reader(data, length, who);
+
+    reader.Parse(map);
+}
+
+} // namespace epi
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab
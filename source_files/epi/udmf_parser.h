@@ -0,0 +1,191 @@
+//----------------------------------------------------------------------------
+//  EPI UDMF (TEXTMAP) Parser
+//----------------------------------------------------------------------------
+//
+//  Copyright (c) 2024  The EDGE Team.
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//----------------------------------------------------------------------------
+//
+//  Reads a whole TEXTMAP lump in a single pass, producing typed arrays
+//  of vertices, sectors, sidedefs, linedefs and things.  Only the keys
+//  used by the engine and the node builder are kept, everything else is
+//  skipped.  Defaults match the UDMF spec (and what the old per-type
+//  loaders used), with -1 meaning "not given" for references.
+//
+//----------------------------------------------------------------------------
+
+#ifndef __EPI_UDMF_PARSER_H__
+#define __EPI_UDMF_PARSER_H__
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+namespace epi
+{
+
+enum UDMFLineFlag
+{
+    kUDMFLineBlocking      = (1 << 0),
+    kUDMFLineBlockMonsters = (1 << 1),
+    kUDMFLineTwoSided      = (1 << 2),
+    kUDMFLineDontPegTop    = (1 << 3),
+    kUDMFLineDontPegBottom = (1 << 4),
+    kUDMFLineSecret        = (1 << 5),
+    kUDMFLineBlockSound    = (1 << 6),
+    kUDMFLineDontDraw      = (1 << 7),
+    kUDMFLineMapped        = (1 << 8),
+    kUDMFLinePassUse       = (1 << 9),
+    kUDMFLineBlockPlayers  = (1 << 10),
+    kUDMFLineBlockSight    = (1 << 11)
+};
+
+// thing flags are only set for keys which are "true"
+enum UDMFThingFlag
+{
+    kUDMFThingSkill1 = (1 << 0),
+    kUDMFThingSkill2 = (1 << 1),
+    kUDMFThingSkill3 = (1 << 2),
+    kUDMFThingSkill4 = (1 << 3),
+    kUDMFThingSkill5 = (1 << 4),
+    kUDMFThingAmbush = (1 << 5),
+    kUDMFThingSingle = (1 << 6),
+    kUDMFThingDM     = (1 << 7),
+    kUDMFThingCoop   = (1 << 8),
+    kUDMFThingFriend = (1 << 9)
+};
+
+struct UDMFVertex
+{
+    double x        = 0;
+    double y        = 0;
+    double zfloor   = -40000.0;
+    double zceiling = 40000.0;
+};
+
+struct UDMFSector
+{
+    int heightfloor   = 0;
+    int heightceiling = 0;
+
+    char texturefloor[10]   = "-";
+    char textureceiling[10] = "-";
+
+    int lightlevel = 160;
+    int special    = 0;
+    int id         = 0;
+
+    // raw 0xRRGGBB values
+    int lightcolor  = 0xFFFFFF;
+    int fadecolor   = 0;
+    int fogdensity  = 0;
+
+    double xpanningfloor   = 0;
+    double ypanningfloor   = 0;
+    double xpanningceiling = 0;
+    double ypanningceiling = 0;
+
+    double xscalefloor   = 1.0;
+    double yscalefloor   = 1.0;
+    double xscaleceiling = 1.0;
+    double yscaleceiling = 1.0;
+
+    double rotationfloor   = 0;
+    double rotationceiling = 0;
+
+    double gravity = 1.0;
+};
+
+struct UDMFSidedef
+{
+    int offsetx = 0;
+    int offsety = 0;
+
+    double offsetx_bottom = 0;
+    double offsetx_mid    = 0;
+    double offsetx_top    = 0;
+    double offsety_bottom = 0;
+    double offsety_mid    = 0;
+    double offsety_top    = 0;
+
+    double scalex_bottom = 1.0;
+    double scalex_mid    = 1.0;
+    double scalex_top    = 1.0;
+    double scaley_bottom = 1.0;
+    double scaley_mid    = 1.0;
+    double scaley_top    = 1.0;
+
+    char texturetop[10]    = "-";
+    char texturebottom[10] = "-";
+    char texturemiddle[10] = "-";
+
+    int sector = -1;
+};
+
+struct UDMFLinedef
+{
+    int id        = -1;
+    int v1        = -1;
+    int v2        = -1;
+    int special   = 0;
+    int sidefront = -1;
+    int sideback  = -1;
+
+    int flags = 0; // UDMFLineFlag bits
+};
+
+struct UDMFThing
+{
+    int id = 0;
+
+    double x      = 0;
+    double y      = 0;
+    double height = 0;
+
+    int angle = 0; // degrees
+    int type  = -1;
+
+    int flags = 0; // UDMFThingFlag bits
+
+    double health = 1.0;
+    double alpha  = 1.0;
+    double scale  = 0;
+    double scalex = 0;
+    double scaley = 0;
+};
+
+struct UDMFMap
+{
+    std::string name_space;
+
+    std::vector<UDMFVertex>  vertices;
+    std::vector<UDMFSector>  sectors;
+    std::vector<UDMFSidedef> sidedefs;
+    std::vector<UDMFLinedef> linedefs;
+    std::vector<UDMFThing>   things;
+
+    void Clear();
+};
+
+// parse a TEXTMAP lump into 'map' (which is cleared first).  the data does
+// not need to be NUL-terminated.  malformed input is a fatal error, the
+// message is prefixed with 'who' (e.g. "AJBSP: ") when given.
+void ParseUDMF(const char *data, size_t length, UDMFMap &map, const char *who = "");
+
+} // namespace epi
+
+#endif /* __EPI_UDMF_PARSER_H__ */
+
+//--- editor settings ---
+// vi:ts=4:sw=4:noexpandtab